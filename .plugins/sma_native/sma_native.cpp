@@ -2,90 +2,95 @@
 // Created by Daniel Griffiths on 11/5/25.
 //
 
-#include "plugin_api.h"
-#include <vector>
-#include <string>
+#include <cstdlib>
 #include <cstring>
+#include <string>
+
+#include "../../src/plugins/abi/abi.h"
 
 struct SMAState {
     int fast = 10, slow = 30;
-    std::string symbol;
-    std::vector<double> closes;
-    bool long_on = false;
-    double entry_px = 0.0;
-    double pnl = 0.0;
+    std::string symbol = "AAPL";
 };
 
-static double sma(const std::vector<double>& v, int w) {
-    if ((int)v.size() < w) return 0.0;
-    double s=0.0; for (int i=v.size()-w;i<(int)v.size();++i) s+=v[i];
-    return s / w;
+// Minimal lookup of a scalar value in the flat strategy_params object, e.g. {"fast":10,"symbol":"AAPL"}
+static std::string find_json_value(const std::string& json, const char* key) {
+    const std::string needle = std::string("\"") + key + "\"";
+    auto pos = json.find(needle);
+    if (pos == std::string::npos) return {};
+    pos = json.find(':', pos + needle.size());
+    if (pos == std::string::npos) return {};
+    pos = json.find_first_not_of(" \t\n\"", pos + 1);
+    if (pos == std::string::npos) return {};
+    const auto end = json.find_first_of(",}\"", pos);
+    return json.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
 }
 
 static PluginResult init_fn(void* self, const PluginOptions* o) {
     auto& S = *static_cast<SMAState*>(self);
     if (o) {
-        for (size_t i=0;i<o->count;++i) {
-            auto k=o->items[i].key, v=o->items[i].value;
-            if (strcmp(k,"fast")==0) S.fast = std::atoi(v);
-            else if (strcmp(k,"slow")==0) S.slow = std::atoi(v);
-            else if (strcmp(k,"symbol")==0) S.symbol = v;
+        for (size_t i = 0; i < o->count_; ++i) {
+            if (std::strcmp(o->items_[i].key_, "strategy_params") != 0) continue;
+            const std::string params = o->items_[i].value_;
+            if (auto v = find_json_value(params, "fast"); !v.empty()) S.fast = std::atoi(v.c_str());
+            if (auto v = find_json_value(params, "slow"); !v.empty()) S.slow = std::atoi(v.c_str());
+            if (auto v = find_json_value(params, "symbol"); !v.empty()) S.symbol = v;
         }
     }
-    return {0,nullptr};
+    return PluginResult{0, nullptr, nullptr, 0};
 }
 
-static PluginResult prep_fn(void* /*self*/, const char*, int64_t, int64_t, int32_t) {
-    return PluginResult{0,nullptr};
-}
+static PluginResult start_fn(void* /*self*/) { return PluginResult{0, nullptr, nullptr, 0}; }
 
-static PluginResult on_bar_fn(void* self, const Bar* b) {
+// Crossover of the fast and slow SMAs over the whole series at once: long on a golden cross, flat on a death cross.
+// The host replays the column, so the plugin never sees individual bars and keeps nothing between them.
+static PluginResult precompute_signals_fn(void* self, const CSeries* series, CSignalColumn* signals, size_t series_count) {
     auto& S = *static_cast<SMAState*>(self);
-    S.closes.push_back(b->close);
-    double f = sma(S.closes, S.fast);
-    double s = sma(S.closes, S.slow);
-    if (f==0 || s==0) return PluginResult{0,nullptr};
+    const size_t fast = S.fast, slow = S.slow;
+
+    for (size_t k = 0; k < series_count; ++k) {
+        if (S.symbol != series[k].symbol_) continue;
 
-    // simple crossover: go long on golden cross, flat on death cross
-    if (!S.long_on && f > s) { S.long_on = true; S.entry_px = b->close; }
-    else if (S.long_on && f < s) {
-        S.pnl += (b->close - S.entry_px);
-        S.long_on = false;
+        const double* close = series[k].close_;
+        int8_t* out = signals[k].signals_;
+        double fast_sum = 0.0, slow_sum = 0.0;
+        bool long_on = false;
+
+        for (size_t i = 0; i < series[k].count_; ++i) {
+            fast_sum += close[i];
+            slow_sum += close[i];
+            if (i >= fast) fast_sum -= close[i - fast];
+            if (i >= slow) slow_sum -= close[i - slow];
+            if (i + 1 < slow || i + 1 < fast) continue;
+
+            const double f = fast_sum / fast;
+            const double s = slow_sum / slow;
+            if (!long_on && f > s) {
+                long_on = true;
+                out[i] = SIGNAL_VALUE_BUY;
+            } else if (long_on && f < s) {
+                long_on = false;
+                out[i] = SIGNAL_VALUE_SELL;
+            }
+        }
     }
-    return PluginResult{0,nullptr};
+    return PluginResult{0, nullptr, nullptr, 0};
 }
 
-static PluginResult on_tick_fn(void*, const Tick*) { return PluginResult{0,nullptr}; }
-
-static PluginResult finalize_fn(void* self, const char** out) {
+static PluginResult end_fn(void* self, const char** out) {
     auto& S = *static_cast<SMAState*>(self);
-    if (S.long_on && !S.closes.empty()) {
-        S.pnl += (S.closes.back() - S.entry_px);
-        S.long_on = false;
-    }
-    std::string json = std::string("{\"symbol\":\"")+S.symbol+
-                       "\",\"pnl\":"+std::to_string(S.pnl)+
-                       ",\"fast\":"+std::to_string(S.fast)+
-                       ",\"slow\":"+std::to_string(S.slow)+"}";
-    char* heap = new char[json.size()+1];
-    std::memcpy(heap, json.c_str(), json.size()+1);
+    std::string json = std::string("{\"symbol\":\"") + S.symbol + "\",\"fast\":" + std::to_string(S.fast) + ",\"slow\":" + std::to_string(S.slow) + "}";
+    char* heap = new char[json.size() + 1];
+    std::memcpy(heap, json.c_str(), json.size() + 1);
     *out = heap;
-    return PluginResult{0,nullptr};
+    return PluginResult{0, nullptr, nullptr, 0};
 }
 
-static void free_str_fn(void*, const char* p){ delete[] p; }
-static void destroy_fn(void* self){ delete static_cast<SMAState*>(self); }
+static void free_str_fn(void*, const char* p) { delete[] p; }
+static void destroy_fn(void* self) { delete static_cast<SMAState*>(self); }
 
-extern "C" PluginExport create_plugin(const PluginContext* /*ctx*/) {
+extern "C" PluginExport create_plugin(const SimulatorContext* /*ctx*/) {
     auto* S = new SMAState{};
-    PluginVTable vt{
-            &destroy_fn,
-            &init_fn,
-            &prep_fn,
-            &on_bar_fn,
-            &on_tick_fn,
-            &finalize_fn,
-            &free_str_fn
-    };
-    return PluginExport{ PLUGIN_API_VERSION, S, vt };
+    PluginVTable vt{&destroy_fn, &init_fn, &start_fn, nullptr, &end_fn, &free_str_fn, sizeof(PluginVTable), &precompute_signals_fn, nullptr, nullptr, nullptr};
+    return PluginExport{PLUGIN_API_VERSION_V1_SIZED, S, vt};
 }
@@ -1,46 +1,54 @@
 # plugins/sma_python/sma_python.py
+import json
+
+
 class Plugin:
     def __init__(self, ctx_capsule):
-        # ctx_capsule is a py::capsule containing PluginContext*, not used here
+        # ctx_capsule is a py::capsule containing SimulatorContext*, not used here
         self.fast = 10
         self.slow = 30
-        self.symbol = ""
-        self.closes = []
+        self.symbol = "AAPL"
         self.long_on = False
-        self.entry = 0.0
-        self.pnl = 0.0
+        # The host keeps the last window_size bars per symbol and passes them to on_bar_numpy as numpy views.
+        self.window_size = self.slow
 
-    def init(self, options: dict) -> int:
-        self.fast = int(options.get("fast", self.fast))
-        self.slow = int(options.get("slow", self.slow))
-        self.symbol = options.get("symbol", self.symbol)
+    def on_init(self, options: dict) -> int:
+        strategy_params = json.loads(options.get("strategy_params", "{}"))
+        self.fast = int(strategy_params.get("fast", self.fast))
+        self.slow = int(strategy_params.get("slow", self.slow))
+        self.symbol = strategy_params.get("symbol", self.symbol)
+        self.window_size = max(self.fast, self.slow)
         return 0
 
-    def prepare_data(self, symbol: str, start_ns: int, end_ns: int, bar_sec: int) -> int:
+    def on_start(self) -> int:
         return 0
 
-    def on_bar(self, ts_ns: int, o: float, h: float, l: float, c: float, v: float) -> int:
-        self.closes.append(c)
-        if len(self.closes) < max(self.fast, self.slow):
-            return 0
-        f = sum(self.closes[-self.fast:]) / self.fast
-        s = sum(self.closes[-self.slow:]) / self.slow
-        if not self.long_on and f > s:
+    def on_bar_numpy(self, symbol: str, window: dict, state: dict):
+        closes = window["close"]
+        if symbol != self.symbol or len(closes) < self.slow:
+            return 0, []
+
+        fast = closes[-self.fast:].mean()
+        slow = closes[-self.slow:].mean()
+
+        if not self.long_on and fast > slow:
             self.long_on = True
-            self.entry = c
-        elif self.long_on and f < s:
-            self.pnl += (c - self.entry)
+            return 0, [{"symbol": symbol, "action": "buy"}]
+        if self.long_on and fast < slow:
             self.long_on = False
-        return 0
+            return 0, [{"symbol": symbol, "action": "sell"}]
+        return 0, []
 
-    def on_tick(self, ts_ns: int, price: float, size: float) -> int:
-        return 0
+    # Checkpoints keep the numpy windows themselves; only what the plugin holds goes through these.
+    def save_state(self) -> bytes:
+        return b"\x01" if self.long_on else b"\x00"
+
+    def restore_state(self, data: bytes):
+        self.long_on = data == b"\x01"
+
+    def on_end(self) -> str:
+        return json.dumps({"symbol": self.symbol, "fast": self.fast, "slow": self.slow})
 
-    def finalize(self) -> str:
-        if self.long_on and self.closes:
-            self.pnl += (self.closes[-1] - self.entry)
-            self.long_on = False
-        return f'{{"symbol":"{self.symbol}","pnl":{self.pnl},"fast":{self.fast},"slow":{self.slow}}}'
 
 def create_plugin(ctx_capsule):
     return Plugin(ctx_capsule)
@@ -0,0 +1,59 @@
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> allocation_count{0};
+    std::atomic<uint64_t> allocated_bytes{0};
+
+    void count_allocation(std::size_t size) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void* allocate(std::size_t size) {
+        count_allocation(size);
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+        if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* allocate_aligned(std::size_t size, std::align_val_t alignment) {
+        count_allocation(size);
+        const auto align = static_cast<std::size_t>(alignment);
+        // aligned_alloc wants a multiple of the alignment.
+        const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+        if (void* ptr = std::aligned_alloc(align, rounded)) {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+}  // namespace
+
+namespace benchmarks::allocations {
+
+    AllocationCounts get_allocation_counts() {
+        return AllocationCounts{.allocations_ = allocation_count.load(std::memory_order_relaxed), .bytes_ = allocated_bytes.load(std::memory_order_relaxed)};
+    }
+
+    void reset_allocation_counts() {
+        allocation_count.store(0, std::memory_order_relaxed);
+        allocated_bytes.store(0, std::memory_order_relaxed);
+    }
+
+}  // namespace benchmarks::allocations
+
+// The array and nothrow forms forward to these by default.
+// NOLINTBEGIN(cppcoreguidelines-no-malloc, misc-new-delete-overloads)
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocate_aligned(size, alignment); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t /*alignment*/) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept { std::free(ptr); }
+// NOLINTEND(cppcoreguidelines-no-malloc, misc-new-delete-overloads)
@@ -0,0 +1,22 @@
+#ifndef QUANT_FORGE_BENCHMARKS_ALLOCATION_COUNTER_HPP
+#define QUANT_FORGE_BENCHMARKS_ALLOCATION_COUNTER_HPP
+
+#pragma once
+
+#include <cstdint>
+
+// Counts every operator new in the process. Linking allocation_counter.cpp replaces the global allocation functions,
+// so only the throughput harness does.
+namespace benchmarks::allocations {
+
+    struct AllocationCounts {
+        uint64_t allocations_ = 0;
+        uint64_t bytes_ = 0;
+    };
+
+    [[nodiscard]] AllocationCounts get_allocation_counts();
+    void reset_allocation_counts();
+
+}  // namespace benchmarks::allocations
+
+#endif
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <optional>
+
+#include "../src/simulators/back_test/abi_converter.hpp"
+#include "../src/simulators/back_test/executor.hpp"
+#include "../src/simulators/back_test/features.hpp"
+#include "../src/simulators/back_test/state.hpp"
+#include "./generators.hpp"
+
+namespace {
+    // A bracketed market buy against a book of range(0) open fills. The MinimalFeatures run shows what the
+    // specialised variants save per order.
+    template <typename FeaturesT>
+    void BM_ExecuteOrder(benchmark::State& bench) {
+        const auto policy = benchmarks::generators::make_policy();
+        const auto state = benchmarks::generators::make_state(static_cast<size_t>(bench.range(0)));
+
+        const models::Order order{1.0,
+                                  BAR_START_NS,
+                                  benchmarks::generators::symbol_for(0),
+                                  constants::BUY,
+                                  constants::MARKET,
+                                  std::nullopt,
+                                  Money::from_dollars(BAR_CLOSE - ORDER_PRICE_SPREAD),
+                                  Money::from_dollars(BAR_CLOSE + ORDER_PRICE_SPREAD)};
+
+        for (auto _ : bench) {
+            auto result = simulators::executor::execute_order<FeaturesT>(order, policy, state);
+            benchmark::DoNotOptimize(result);
+        }
+
+        bench.SetItemsProcessed(bench.iterations());
+    }
+
+    // Books range(0) fills into an empty state, half of them closing earlier ones. Building the state is not timed.
+    void BM_StateUpdateState(benchmark::State& bench) {
+        const auto results = benchmarks::generators::make_execution_results(static_cast<size_t>(bench.range(0)));
+
+        for (auto _ : bench) {
+            bench.PauseTiming();
+            std::optional<simulators::State> state(benchmarks::generators::make_state(0));
+            bench.ResumeTiming();
+
+            for (const auto& result : results) {
+                state->update_state(result);
+            }
+            benchmark::DoNotOptimize(state->cash_);
+
+            bench.PauseTiming();
+            state.reset();
+            bench.ResumeTiming();
+        }
+
+        bench.SetItemsProcessed(bench.iterations() * bench.range(0));
+    }
+
+    // What every plugin call pays on a bar where range(0) fills and their exit orders are new.
+    void BM_ABIConverterToCState(benchmark::State& bench) {
+        const auto state = benchmarks::generators::make_state(static_cast<size_t>(bench.range(0)));
+        simulators::ABIConverter converter;
+
+        for (auto _ : bench) {
+            auto c_state = converter.to_c_state(state);
+            benchmark::DoNotOptimize(c_state);
+        }
+
+        bench.SetItemsProcessed(bench.iterations() * bench.range(0));
+    }
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ExecuteOrder, simulators::AllFeatures)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK_TEMPLATE(BM_ExecuteOrder, simulators::MinimalFeatures)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_StateUpdateState)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_ABIConverterToCState)->Apply(benchmarks::generators::apply_scales);
@@ -0,0 +1,193 @@
+#ifndef QUANT_FORGE_BENCHMARKS_GENERATORS_HPP
+#define QUANT_FORGE_BENCHMARKS_GENERATORS_HPP
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/simulators/back_test/execution_policy.hpp"
+#include "../src/simulators/back_test/models.hpp"
+#include "../src/simulators/back_test/state.hpp"
+#include "../src/utils/constants.hpp"
+
+static constexpr size_t SMALL_SCALE = 10;
+static constexpr size_t MEDIUM_SCALE = 1'000;
+static constexpr size_t LARGE_SCALE = 100'000;
+
+static constexpr size_t SYMBOL_COUNT = 50;
+static constexpr uint64_t GENERATOR_SEED = 42;
+static constexpr int64_t BAR_START_NS = 1'700'000'000'000'000'000;
+static constexpr int64_t BAR_INTERVAL_NS = 60'000'000'000;
+static constexpr int64_t BAR_VOLUME = 1'000'000;
+static constexpr double BAR_CLOSE = 100.0;
+static constexpr double BAR_HALF_RANGE = 1.0;
+static constexpr double ORDER_PRICE_SPREAD = 5.0;
+static constexpr double INITIAL_CASH = 1'000'000'000.0;
+
+// Synthetic inputs for the benchmarks. Every generator is seeded, so runs are comparable over time.
+namespace benchmarks::generators {
+
+    // Open orders, fills or bars: a handful, a busy strategy, and a long or wide back test.
+    inline void apply_scales(benchmark::internal::Benchmark* bench) {
+        bench->Arg(SMALL_SCALE)->Arg(MEDIUM_SCALE)->Arg(LARGE_SCALE);
+    }
+
+    [[nodiscard]] inline std::string symbol_for(size_t i) { return "SYM" + std::to_string(i % SYMBOL_COUNT); }
+
+    [[nodiscard]] inline simulators::ExecutionPolicy make_policy() {
+        simulators::ExecutionPolicy policy;
+        policy.allow_fractional_shares_ = true;
+        policy.commission_type_ = simulators::CommissionType::PER_SHARE;
+        policy.commission_ = 0.005;
+        policy.position_size_value_ = 0.1;
+        policy.symbol_count_ = SYMBOL_COUNT;
+        policy.fill_max_pct_of_volume_ = 0.1;
+        return policy;
+    }
+
+    // Every symbol priced at 99/100/101 for the current bar, cash to spare, and open_fills long fills spread across the
+    // symbols, each with a stop loss and a take profit.
+    [[nodiscard]] inline simulators::State make_state(size_t open_fills) {
+        simulators::State state;
+        state.cash_ = Money::from_dollars(INITIAL_CASH);
+        state.margin_in_use_ = Money(0);
+        state.current_timestamp_ns_ = BAR_START_NS;
+        state.peak_equity_ = state.cash_;
+        state.max_drawdown_ = 0.0;
+
+        for (size_t i = 0; i < SYMBOL_COUNT; ++i) {
+            const std::string symbol = symbol_for(i);
+            state.current_bar_prices_[symbol] = simulators::CurrentBarPrices{
+                .close_ = Money::from_dollars(BAR_CLOSE),
+                .open_ = Money::from_dollars(BAR_CLOSE),
+                .high_ = Money::from_dollars(BAR_CLOSE + BAR_HALF_RANGE),
+                .low_ = Money::from_dollars(BAR_CLOSE - BAR_HALF_RANGE),
+            };
+            state.current_bar_volumes_[symbol] = BAR_VOLUME;
+        }
+
+        state.fills_.reserve(open_fills);
+        for (size_t i = 0; i < open_fills; ++i) {
+            const std::string symbol = symbol_for(i);
+            const auto& fill = state.fills_.emplace_back(symbol, constants::BUY, 1.0, Money::from_dollars(BAR_CLOSE), BAR_START_NS);
+
+            state.active_buy_fills_[fill.uuid_] = fill.quantity_;
+            state.active_margin_for_fills_[fill.uuid_] = fill.margin_used_;
+            state.active_leverage_for_fills_[fill.uuid_] = fill.leverage_;
+
+            auto& position = state.positions_[symbol];
+            position.symbol_ = symbol;
+            position.quantity_ += fill.quantity_;
+            position.average_price_ = fill.price_;
+
+            state.exit_orders_.emplace_back(models::StopLossExitOrder(symbol, fill.quantity_, Money::from_dollars(BAR_CLOSE - ORDER_PRICE_SPREAD),
+                                                                      fill.price_, BAR_START_NS, fill.uuid_, false));
+            state.exit_orders_.emplace_back(models::TakeProfitExitOrder(symbol, fill.quantity_, Money::from_dollars(BAR_CLOSE + ORDER_PRICE_SPREAD),
+                                                                        fill.price_, BAR_START_NS, fill.uuid_, false));
+        }
+
+        state.new_fills_ = state.fills_;
+        state.new_exit_orders_ = state.exit_orders_;
+
+        return state;
+    }
+
+    // Alternating buy and sell limits priced uniformly within ORDER_PRICE_SPREAD of the close, so roughly a fifth of
+    // each side crosses the current bar.
+    [[nodiscard]] inline std::vector<models::ScheduledLimitOrder> make_limit_orders(size_t count) {
+        std::mt19937_64 rng(GENERATOR_SEED);
+        std::uniform_real_distribution<double> price(BAR_CLOSE - ORDER_PRICE_SPREAD, BAR_CLOSE + ORDER_PRICE_SPREAD);
+
+        std::vector<models::ScheduledLimitOrder> orders;
+        orders.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            const Money limit_price = Money::from_dollars(price(rng));
+            const bool is_buy = i % 2 == 0;
+            models::Order order{
+                1.0, BAR_START_NS, symbol_for(i), is_buy ? constants::BUY : constants::SELL, constants::LIMIT, limit_price, std::nullopt, std::nullopt};
+
+            if (is_buy) {
+                orders.emplace_back(models::LimitBuyOrder(std::move(order), limit_price));
+            } else {
+                orders.emplace_back(models::LimitSellOrder(std::move(order), limit_price));
+            }
+        }
+
+        return orders;
+    }
+
+    // Stop losses and take profits on the fills of make_state, triggered at random prices within ORDER_PRICE_SPREAD.
+    [[nodiscard]] inline std::vector<models::ExitOrder> make_exit_orders(const simulators::State& state) {
+        std::mt19937_64 rng(GENERATOR_SEED);
+        std::uniform_real_distribution<double> offset(0.0, ORDER_PRICE_SPREAD);
+
+        std::vector<models::ExitOrder> orders;
+        orders.reserve(state.fills_.size() * 2);
+
+        for (const auto& fill : state.fills_) {
+            orders.emplace_back(models::StopLossExitOrder(fill.symbol_, fill.quantity_, Money::from_dollars(BAR_CLOSE - offset(rng)), fill.price_,
+                                                          fill.created_at_ns_, fill.uuid_, false));
+            orders.emplace_back(models::TakeProfitExitOrder(fill.symbol_, fill.quantity_, Money::from_dollars(BAR_CLOSE + offset(rng)), fill.price_,
+                                                            fill.created_at_ns_, fill.uuid_, false));
+        }
+
+        return orders;
+    }
+
+    // Buys and sells in equal measure, so about half of them close out earlier fills.
+    [[nodiscard]] inline std::vector<models::ExecutionResultSuccess> make_execution_results(size_t count) {
+        std::mt19937_64 rng(GENERATOR_SEED);
+        std::bernoulli_distribution is_buy(0.5);
+
+        std::vector<models::ExecutionResultSuccess> results;
+        results.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            const std::string symbol = symbol_for(i);
+            const std::string action = is_buy(rng) ? constants::BUY : constants::SELL;
+            const Money price = Money::from_dollars(BAR_CLOSE);
+            const Money notional = action == constants::BUY ? price * -1.0 : price;
+
+            results.emplace_back(notional, price, 1.0, std::nullopt, models::Position(symbol, 1.0, price),
+                                 models::Fill(symbol, action, 1.0, price, BAR_START_NS + (static_cast<int64_t>(i) * BAR_INTERVAL_NS), 1.0, price),
+                                 std::vector<models::ExitOrder>{});
+        }
+
+        return results;
+    }
+
+    // An aggregate bars payload in Polygon's shape with bar_count minute bars.
+    [[nodiscard]] inline std::string make_polygon_body(size_t bar_count) {
+        std::mt19937_64 rng(GENERATOR_SEED);
+        std::normal_distribution<double> step(0.0, 0.1);
+
+        std::string body = R"({"ticker":"SYM0","adjusted":true,"queryCount":)" + std::to_string(bar_count) +
+                           R"(,"resultsCount":)" + std::to_string(bar_count) + R"(,"status":"OK","results":[)";
+
+        double close = BAR_CLOSE;
+        for (size_t i = 0; i < bar_count; ++i) {
+            const double open = close;
+            close += step(rng);
+            const int64_t timestamp_ms = (BAR_START_NS + (static_cast<int64_t>(i) * BAR_INTERVAL_NS)) / constants::NANOSECONDS_PER_MILLISECOND;
+
+            body += (i == 0 ? "" : ",");
+            body += R"({"T":"SYM0","ticker":"SYM0","v":)" + std::to_string(BAR_VOLUME) + R"(,"vw":)" + std::to_string((open + close) / 2) +
+                    R"(,"o":)" + std::to_string(open) + R"(,"c":)" + std::to_string(close) + R"(,"h":)" +
+                    std::to_string(std::max(open, close) + BAR_HALF_RANGE) + R"(,"l":)" + std::to_string(std::min(open, close) - BAR_HALF_RANGE) +
+                    R"(,"t":)" + std::to_string(timestamp_ms) + R"(,"n":)" + std::to_string(i % 1000) + "}";
+        }
+
+        body += "]}";
+        return body;
+    }
+
+}  // namespace benchmarks::generators
+
+#endif
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../src/utils/max_heap.hpp"
+#include "../src/utils/min_heap.hpp"
+#include "./generators.hpp"
+
+namespace {
+    std::vector<int64_t> make_prices(size_t count) {
+        std::mt19937_64 rng(GENERATOR_SEED);
+        std::uniform_int_distribution<int64_t> price(1, 1'000'000'000);
+
+        std::vector<int64_t> prices(count);
+        for (auto& value : prices) {
+            value = price(rng);
+        }
+        return prices;
+    }
+
+    template <typename HeapT>
+    void push_pop_all(benchmark::State& bench) {
+        const auto prices = make_prices(static_cast<size_t>(bench.range(0)));
+
+        for (auto _ : bench) {
+            HeapT heap;
+            for (const auto price : prices) {
+                heap.push(price);
+            }
+            while (!heap.empty()) {
+                benchmark::DoNotOptimize(heap.top());
+                heap.pop();
+            }
+        }
+
+        bench.SetItemsProcessed(bench.iterations() * bench.range(0));
+    }
+
+    void BM_MinHeapPushPop(benchmark::State& bench) { push_pop_all<data_structures::MinHeap<int64_t>>(bench); }
+    void BM_MaxHeapPushPop(benchmark::State& bench) { push_pop_all<data_structures::MaxHeap<int64_t>>(bench); }
+
+    // The exit order books carry full orders rather than prices, so a push or pop also moves two strings.
+    void BM_MinHeapPushPopStopLoss(benchmark::State& bench) {
+        const auto state = benchmarks::generators::make_state(static_cast<size_t>(bench.range(0)));
+        const auto exit_orders = benchmarks::generators::make_exit_orders(state);
+
+        for (auto _ : bench) {
+            data_structures::MinHeap<models::StopLossExitOrder> heap;
+            for (const auto& exit_order : exit_orders) {
+                if (const auto* stop_loss = std::get_if<models::StopLossExitOrder>(&exit_order)) {
+                    heap.push(*stop_loss);
+                }
+            }
+            while (!heap.empty()) {
+                benchmark::DoNotOptimize(heap.top());
+                heap.pop();
+            }
+        }
+
+        bench.SetItemsProcessed(bench.iterations() * bench.range(0));
+    }
+}  // namespace
+
+BENCHMARK(BM_MinHeapPushPop)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_MaxHeapPushPop)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_MinHeapPushPopStopLoss)->Apply(benchmarks::generators::apply_scales);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "../src/http/cache/memory_cache.hpp"
+#include "../src/http/cache/network_cache.hpp"
+#include "../src/http/model/model.hpp"
+#include "../src/http/provider/polygon.hpp"
+#include "./generators.hpp"
+
+static constexpr long HTTP_OK = 200;
+
+namespace {
+    http::model::Response make_response(size_t bar_count) {
+        http::model::Response response;
+        response.status_ = HTTP_OK;
+        response.body_ = benchmarks::generators::make_polygon_body(bar_count);
+        response.effective_url_ = "https://bench.invalid/aggs/" + std::to_string(bar_count);
+        response.content_type_ = "application/json";
+        response.cache_control_ = "max-age=3600";
+        return response;
+    }
+
+    void BM_PolygonParseAggregateBars(benchmark::State& bench) {
+        const http::provider::PolygonProvider provider("benchmark");
+        const auto response = make_response(static_cast<size_t>(bench.range(0)));
+
+        for (auto _ : bench) {
+            auto bars = provider.parse_custom_aggregate_bars(response);
+            benchmark::DoNotOptimize(bars);
+        }
+
+        bench.SetItemsProcessed(bench.iterations() * bench.range(0));
+        bench.SetBytesProcessed(bench.iterations() * static_cast<int64_t>(response.body_.size()));
+    }
+
+    // A cached response of range(0) bars read back through probe and get_cached_response, from disk or, with
+    // use_memory_cache, from the in-process LRU.
+    void network_cache_read(benchmark::State& bench, bool use_memory_cache) {
+        const auto root = std::filesystem::temp_directory_path() / ("quant_forge_bench_cache_" + std::to_string(bench.range(0)));
+        std::filesystem::remove_all(root);
+
+        auto policy = std::make_unique<http::cache::NetworkCachePolicy>();
+        policy->root_ = root;
+        auto memory_cache = use_memory_cache ? std::make_shared<http::cache::MemoryCache>(std::make_unique<http::cache::MemoryCachePolicy>()) : nullptr;
+        const http::cache::NetworkCache cache(std::move(policy), std::move(memory_cache));
+
+        const auto response = make_response(static_cast<size_t>(bench.range(0)));
+        const http::model::Request request{.url_ = response.effective_url_, .method_ = "GET", .body_ = "", .headers_ = {}};
+        cache.cache_response(request, response);
+
+        for (auto _ : bench) {
+            auto hit = cache.probe(request);
+            if (!hit.has_value() || !cache.fresh_enough(hit->meta_)) {
+                bench.SkipWithError("Cache miss");
+                break;
+            }
+            auto cached = cache.get_cached_response(std::move(hit.value()));
+            benchmark::DoNotOptimize(cached);
+        }
+
+        bench.SetBytesProcessed(bench.iterations() * static_cast<int64_t>(response.body_.size()));
+        std::filesystem::remove_all(root);
+    }
+
+    void BM_NetworkCacheReadDisk(benchmark::State& bench) { network_cache_read(bench, false); }
+    void BM_NetworkCacheReadMemory(benchmark::State& bench) { network_cache_read(bench, true); }
+
+    void BM_NetworkCacheProbeMiss(benchmark::State& bench) {
+        const auto root = std::filesystem::temp_directory_path() / "quant_forge_bench_cache_miss";
+        auto policy = std::make_unique<http::cache::NetworkCachePolicy>();
+        policy->root_ = root;
+        const http::cache::NetworkCache cache(std::move(policy));
+
+        const http::model::Request request{.url_ = "https://bench.invalid/aggs/missing", .method_ = "GET", .body_ = "", .headers_ = {}};
+        for (auto _ : bench) {
+            benchmark::DoNotOptimize(cache.probe(request));
+        }
+
+        std::filesystem::remove_all(root);
+    }
+}  // namespace
+
+BENCHMARK(BM_PolygonParseAggregateBars)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_NetworkCacheReadDisk)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_NetworkCacheReadMemory)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_NetworkCacheProbeMiss);
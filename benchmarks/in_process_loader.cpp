@@ -0,0 +1,132 @@
+#include "in_process_loader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "../src/plugins/abi/export_compat.hpp"
+
+namespace benchmarks {
+
+    InProcessLoader::InProcessLoader(std::string plugin_name, plugins::manifest::HostParams host_params, CreateFn create)
+        : plugin_name_(std::move(plugin_name)), host_params_(std::move(host_params)), create_(std::move(create)) {}
+
+    InProcessLoader::~InProcessLoader() { unload_plugin(); }
+
+    void InProcessLoader::load_plugin(const SimulatorContext& ctx) {
+        exp_ = create_(ctx);
+
+        if (!plugins::abi::normalize_export(exp_) || exp_.instance_ == nullptr) {
+            exp_ = {};
+            throw std::runtime_error("API mismatch or null instance");
+        }
+
+        if (exp_.vtable_.destroy == nullptr || exp_.vtable_.on_end == nullptr) {
+            exp_ = {};
+            throw std::runtime_error("Required vtable methods missing");
+        }
+    }
+
+    void InProcessLoader::on_init() const {
+        if (exp_.vtable_.on_init != nullptr) {
+            const PluginOptions options{.items_ = nullptr, .count_ = 0};
+            exp_.vtable_.on_init(exp_.instance_, &options);
+        }
+    }
+
+    PluginResult InProcessLoader::on_start() const {
+        if (exp_.vtable_.on_start == nullptr) {
+            return PluginResult{.code_ = 1, .message_ = "Undefined Method on_start", .instructions_ = nullptr, .instructions_count_ = 0};
+        }
+
+        return exp_.vtable_.on_start(exp_.instance_);
+    }
+
+    PluginResult InProcessLoader::on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state, CInstructionBuffer& instructions) const {
+        bar_start_ns_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        instructions.count_ = 0;
+
+        if (exp_.vtable_.on_bar == nullptr && exp_.vtable_.on_bar_into == nullptr) {
+            return PluginResult{.code_ = 1, .message_ = "Undefined Method on_bar", .instructions_ = nullptr, .instructions_count_ = 0};
+        }
+
+        const CBar plugin_bar = plugins::loaders::to_plugin_bar(bar);
+        const CState c_state = abi_converter_.to_c_state(state);
+        fill_count_ += c_state.new_fills_count_;
+
+        const PluginResult result = exp_.vtable_.on_bar_into != nullptr ? exp_.vtable_.on_bar_into(exp_.instance_, &plugin_bar, &c_state, &instructions)
+                                                                        : exp_.vtable_.on_bar(exp_.instance_, &plugin_bar, &c_state);
+
+        order_count_ += std::min(instructions.count_, instructions.capacity_) + result.instructions_count_;
+        return result;
+    }
+
+    bool InProcessLoader::has_precompute_signals() const { return exp_.vtable_.precompute_signals != nullptr; }
+
+    PluginResult InProcessLoader::precompute_signals(const CSeries* series, CSignalColumn* signals, size_t series_count) const {
+        if (exp_.vtable_.precompute_signals == nullptr) {
+            return PluginResult{.code_ = 1, .message_ = "Undefined Method precompute_signals", .instructions_ = nullptr, .instructions_count_ = 0};
+        }
+
+        return exp_.vtable_.precompute_signals(exp_.instance_, series, signals, series_count);
+    }
+
+    bool InProcessLoader::has_state_hooks() const { return exp_.vtable_.save_state != nullptr && exp_.vtable_.restore_state != nullptr; }
+
+    PluginResult InProcessLoader::save_state(const uint8_t** data_out, size_t* size_out) const {
+        if (exp_.vtable_.save_state == nullptr) {
+            return PluginResult{.code_ = 1, .message_ = "Undefined Method save_state", .instructions_ = nullptr, .instructions_count_ = 0};
+        }
+
+        return exp_.vtable_.save_state(exp_.instance_, data_out, size_out);
+    }
+
+    PluginResult InProcessLoader::restore_state(const uint8_t* data, size_t size) const {
+        if (exp_.vtable_.restore_state == nullptr) {
+            return PluginResult{.code_ = 1, .message_ = "Undefined Method restore_state", .instructions_ = nullptr, .instructions_count_ = 0};
+        }
+
+        return exp_.vtable_.restore_state(exp_.instance_, data, size);
+    }
+
+    PluginResult InProcessLoader::on_end(const char** json_out) const { return exp_.vtable_.on_end(exp_.instance_, json_out); }
+
+    void InProcessLoader::free_string(const char* str) const {
+        if (exp_.vtable_.free_string != nullptr) {
+            exp_.vtable_.free_string(exp_.instance_, str);
+        }
+    }
+
+    std::string InProcessLoader::get_plugin_name() const { return plugin_name_; }
+
+    void InProcessLoader::unload_plugin() {
+        if (exp_.instance_ != nullptr && exp_.vtable_.destroy != nullptr) {
+            exp_.vtable_.destroy(exp_.instance_);
+        }
+        exp_ = {};
+    }
+
+    PluginExport* InProcessLoader::get_plugin_export() const { return &exp_; }
+
+    plugins::manifest::HostParams InProcessLoader::get_host_params() const { return host_params_; }
+
+    std::unique_ptr<plugins::loaders::IPluginLoader> InProcessLoader::create_instance(const SimulatorContext& ctx,
+                                                                                      const plugins::loaders::PluginInstanceOptions& instance_options) const {
+        auto instance = std::make_unique<InProcessLoader>(instance_options.instance_name_.empty() ? plugin_name_ : instance_options.instance_name_,
+                                                          host_params_, create_);
+        instance->load_plugin(ctx);
+        return instance;
+    }
+
+    const std::vector<int64_t>& InProcessLoader::get_bar_start_ns() const { return bar_start_ns_; }
+
+    size_t InProcessLoader::get_order_count() const { return order_count_; }
+
+    size_t InProcessLoader::get_fill_count() const { return fill_count_; }
+
+    void InProcessLoader::reserve_bars(size_t bar_count) const { bar_start_ns_.reserve(bar_count); }
+
+}  // namespace benchmarks
@@ -0,0 +1,73 @@
+#ifndef QUANT_FORGE_BENCHMARKS_IN_PROCESS_LOADER_HPP
+#define QUANT_FORGE_BENCHMARKS_IN_PROCESS_LOADER_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../src/plugins/abi/abi.h"
+#include "../src/plugins/loaders/interface.hpp"
+#include "../src/plugins/manifest/manifest.hpp"
+#include "../src/simulators/back_test/abi_converter.hpp"
+
+namespace benchmarks {
+
+    // Serves a plugin compiled into the binary through the same vtable a NativeLoader would, so a run measures the
+    // engine rather than dlopen. Also records when each on_bar starts and how many orders and fills it sees.
+    class InProcessLoader : public plugins::loaders::IPluginLoader {
+       public:
+        using CreateFn = std::function<PluginExport(const SimulatorContext&)>;
+
+        InProcessLoader(std::string plugin_name, plugins::manifest::HostParams host_params, CreateFn create);
+        ~InProcessLoader() override;
+
+        InProcessLoader(const InProcessLoader&) = delete;
+        InProcessLoader& operator=(const InProcessLoader&) = delete;
+        InProcessLoader(InProcessLoader&&) = delete;
+        InProcessLoader& operator=(InProcessLoader&&) = delete;
+
+        void load_plugin(const SimulatorContext& ctx) override;
+        void on_init() const override;
+        [[nodiscard]] PluginResult on_start() const override;
+        [[nodiscard]] PluginResult on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state,
+                                          CInstructionBuffer& instructions) const override;
+        [[nodiscard]] bool has_precompute_signals() const override;
+        [[nodiscard]] PluginResult precompute_signals(const CSeries* series, CSignalColumn* signals, size_t series_count) const override;
+        [[nodiscard]] bool has_state_hooks() const override;
+        [[nodiscard]] PluginResult save_state(const uint8_t** data_out, size_t* size_out) const override;
+        [[nodiscard]] PluginResult restore_state(const uint8_t* data, size_t size) const override;
+        [[nodiscard]] PluginResult on_end(const char** json_out) const override;
+        void free_string(const char* str) const override;
+        [[nodiscard]] std::string get_plugin_name() const override;
+        void unload_plugin() override;
+        [[nodiscard]] PluginExport* get_plugin_export() const override;
+        [[nodiscard]] plugins::manifest::HostParams get_host_params() const override;
+        [[nodiscard]] std::unique_ptr<IPluginLoader> create_instance(const SimulatorContext& ctx,
+                                                                     const plugins::loaders::PluginInstanceOptions& instance_options) const override;
+
+        // steady_clock nanoseconds at the start of every on_bar.
+        [[nodiscard]] const std::vector<int64_t>& get_bar_start_ns() const;
+        [[nodiscard]] size_t get_order_count() const;
+        [[nodiscard]] size_t get_fill_count() const;
+        void reserve_bars(size_t bar_count) const;
+
+       private:
+        std::string plugin_name_;
+        plugins::manifest::HostParams host_params_;
+        CreateFn create_;
+        mutable PluginExport exp_{};
+        mutable simulators::ABIConverter abi_converter_;
+
+        mutable std::vector<int64_t> bar_start_ns_;
+        mutable size_t order_count_ = 0;
+        mutable size_t fill_count_ = 0;
+    };
+
+}  // namespace benchmarks
+
+#endif
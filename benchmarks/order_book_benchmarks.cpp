@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/simulators/back_test/exit_order_book.hpp"
+#include "../src/simulators/back_test/limit_order_book.hpp"
+#include "./generators.hpp"
+
+namespace {
+    void BM_LimitOrderBookAdd(benchmark::State& bench) {
+        const auto orders = benchmarks::generators::make_limit_orders(static_cast<size_t>(bench.range(0)));
+
+        for (auto _ : bench) {
+            simulators::LimitOrderBook book;
+            for (const auto& order : orders) {
+                book.add_limit_order(order);
+            }
+            benchmark::DoNotOptimize(book.empty());
+        }
+
+        bench.SetItemsProcessed(bench.iterations() * bench.range(0));
+    }
+
+    // A bar's pass over a resting book: the crossing limits fill and the rest stay put. Rebuilding the book is not timed.
+    void BM_LimitOrderBookProcess(benchmark::State& bench) {
+        const auto state = benchmarks::generators::make_state(0);
+        const auto orders = benchmarks::generators::make_limit_orders(static_cast<size_t>(bench.range(0)));
+
+        size_t filled = 0;
+        for (auto _ : bench) {
+            bench.PauseTiming();
+            simulators::LimitOrderBook book;
+            for (const auto& order : orders) {
+                book.add_limit_order(order);
+            }
+            bench.ResumeTiming();
+
+            book.process_buy_limits(state, [&](const models::Order& order) { benchmark::DoNotOptimize(&order); ++filled; });
+            book.process_sell_limits(state, [&](const models::Order& order) { benchmark::DoNotOptimize(&order); ++filled; });
+        }
+
+        bench.counters["filled"] = benchmark::Counter(static_cast<double>(filled), benchmark::Counter::kAvgIterations);
+        bench.SetItemsProcessed(bench.iterations() * bench.range(0));
+    }
+
+    void BM_ExitOrderBookAdd(benchmark::State& bench) {
+        const auto state = benchmarks::generators::make_state(static_cast<size_t>(bench.range(0)));
+        const auto exit_orders = benchmarks::generators::make_exit_orders(state);
+
+        for (auto _ : bench) {
+            simulators::ExitOrderBook book;
+            for (const auto& exit_order : exit_orders) {
+                book.add_exit_order(exit_order);
+            }
+        }
+
+        bench.SetItemsProcessed(bench.iterations() * static_cast<int64_t>(exit_orders.size()));
+    }
+
+    // Stop losses and take profits mostly survive a bar, so this is dominated by draining and refilling both heaps.
+    void BM_ExitOrderBookProcess(benchmark::State& bench) {
+        const auto state = benchmarks::generators::make_state(static_cast<size_t>(bench.range(0)));
+        const auto exit_orders = benchmarks::generators::make_exit_orders(state);
+
+        size_t triggered = 0;
+        for (auto _ : bench) {
+            bench.PauseTiming();
+            simulators::ExitOrderBook book;
+            for (const auto& exit_order : exit_orders) {
+                book.add_exit_order(exit_order);
+            }
+            bench.ResumeTiming();
+
+            book.process_stop_loss_heap(state, [&](const models::StopLossExitOrder& order) { benchmark::DoNotOptimize(&order); ++triggered; });
+            book.process_take_profit_heap(state, [&](const models::TakeProfitExitOrder& order) { benchmark::DoNotOptimize(&order); ++triggered; });
+        }
+
+        bench.counters["triggered"] = benchmark::Counter(static_cast<double>(triggered), benchmark::Counter::kAvgIterations);
+        bench.SetItemsProcessed(bench.iterations() * static_cast<int64_t>(exit_orders.size()));
+    }
+
+    // One closing fill against a book of range(0) fills' exit orders, as after every sell.
+    void BM_ExitOrderBookReduceByFill(benchmark::State& bench) {
+        const auto state = benchmarks::generators::make_state(static_cast<size_t>(bench.range(0)));
+        const auto exit_orders = benchmarks::generators::make_exit_orders(state);
+
+        simulators::ExitOrderBook book;
+        for (const auto& exit_order : exit_orders) {
+            book.add_exit_order(exit_order);
+        }
+
+        // Reducing by zero leaves the book as it was, so every iteration sees the same heaps.
+        const std::string& fill_uuid = state.fills_.front().uuid_;
+        for (auto _ : bench) {
+            book.reduce_exit_orders_by_fill_uuid(fill_uuid, 0.0);
+        }
+
+        bench.SetItemsProcessed(bench.iterations() * static_cast<int64_t>(exit_orders.size()));
+    }
+}  // namespace
+
+BENCHMARK(BM_LimitOrderBookAdd)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_LimitOrderBookProcess)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_ExitOrderBookAdd)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_ExitOrderBookProcess)->Apply(benchmarks::generators::apply_scales);
+BENCHMARK(BM_ExitOrderBookReduceByFill)->Apply(benchmarks::generators::apply_scales);
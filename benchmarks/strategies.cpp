@@ -0,0 +1,192 @@
+#include "strategies.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "../src/utils/constants.hpp"
+
+// Unused order prices, as the ABI expects.
+static constexpr int64_t NO_PRICE = INT64_MIN;
+static constexpr double RANDOM_TRADE_PROBABILITY = 0.1;
+static constexpr int RANDOM_TRADE_MAX_QUANTITY = 10;
+static constexpr double CHURN_QUANTITY = 10.0;
+static constexpr double BRACKET_QUANTITY = 5.0;
+static constexpr double BRACKET_WIDTH_PCT = 0.002;
+static constexpr double LIMIT_QUANTITY = 5.0;
+static constexpr double LIMIT_MAX_OFFSET_PCT = 0.01;
+
+namespace benchmarks::strategies {
+    namespace {
+        struct Strategy {
+            StrategyKind kind_;
+            std::mt19937_64 rng_;
+            // Instructions point at this rather than at the bar, which the ABI only guarantees for the call.
+            std::string symbol_;
+            // Bytes handed out by the last save_state call.
+            std::string saved_state_;
+        };
+
+        constexpr PluginResult OK_RESULT = {.code_ = 0, .message_ = nullptr, .instructions_ = nullptr, .instructions_count_ = 0};
+
+        int64_t to_microdollars(double dollars) { return static_cast<int64_t>(std::llround(dollars * constants::MONEY_SCALED_BASE)); }
+
+        COrder make_order(const Strategy& strategy, const char* action, double quantity) {
+            return COrder{
+                .symbol_ = strategy.symbol_.c_str(),
+                .action_ = action,
+                .quantity_ = quantity,
+                .leverage_ = 0.0,
+                .limit_price_ = NO_PRICE,
+                .stop_loss_price_ = NO_PRICE,
+                .take_profit_price_ = NO_PRICE,
+                .order_type_ = constants::MARKET,
+            };
+        }
+
+        void push(CInstructionBuffer* out, const COrder& order) {
+            if (out->count_ < out->capacity_) {
+                out->instructions_[out->count_++] = CInstruction{.type_ = INSTRUCTION_TYPE_ORDER, .data_ = {.order_ = order}};
+            }
+        }
+
+        void trade_randomly(Strategy& strategy, CInstructionBuffer* out) {
+            std::bernoulli_distribution should_trade(RANDOM_TRADE_PROBABILITY);
+            std::bernoulli_distribution is_buy(0.5);
+            std::uniform_int_distribution<int> quantity(1, RANDOM_TRADE_MAX_QUANTITY);
+
+            if (should_trade(strategy.rng_)) {
+                push(out, make_order(strategy, is_buy(strategy.rng_) ? constants::BUY : constants::SELL, quantity(strategy.rng_)));
+            }
+        }
+
+        void churn(Strategy& strategy, CInstructionBuffer* out) {
+            push(out, make_order(strategy, constants::BUY, CHURN_QUANTITY));
+            push(out, make_order(strategy, constants::SELL, CHURN_QUANTITY));
+        }
+
+        void buy_bracketed(Strategy& strategy, const Bar& bar, CInstructionBuffer* out) {
+            COrder order = make_order(strategy, constants::BUY, BRACKET_QUANTITY);
+            order.stop_loss_price_ = to_microdollars(bar.close_ * (1.0 - BRACKET_WIDTH_PCT));
+            order.take_profit_price_ = to_microdollars(bar.close_ * (1.0 + BRACKET_WIDTH_PCT));
+            push(out, order);
+        }
+
+        void quote_limits(Strategy& strategy, const Bar& bar, CInstructionBuffer* out) {
+            std::uniform_real_distribution<double> offset(0.0, LIMIT_MAX_OFFSET_PCT);
+
+            COrder buy = make_order(strategy, constants::BUY, LIMIT_QUANTITY);
+            buy.order_type_ = constants::LIMIT;
+            buy.limit_price_ = to_microdollars(bar.close_ * (1.0 - offset(strategy.rng_)));
+            push(out, buy);
+
+            COrder sell = make_order(strategy, constants::SELL, LIMIT_QUANTITY);
+            sell.order_type_ = constants::LIMIT;
+            sell.limit_price_ = to_microdollars(bar.close_ * (1.0 + offset(strategy.rng_)));
+            push(out, sell);
+        }
+
+        void destroy(void* self) { delete static_cast<Strategy*>(self); }
+
+        PluginResult on_init(void* /*self*/, const PluginOptions* /*opts*/) { return OK_RESULT; }
+
+        PluginResult on_start(void* /*self*/) { return OK_RESULT; }
+
+        PluginResult on_bar_into(void* self, const Bar* bar, const CState* /*state*/, CInstructionBuffer* out) {
+            auto& strategy = *static_cast<Strategy*>(self);
+            strategy.symbol_ = bar->symbol_;
+
+            switch (strategy.kind_) {
+                case StrategyKind::RANDOM_TRADER:
+                    trade_randomly(strategy, out);
+                    break;
+                case StrategyKind::CHURNER:
+                    churn(strategy, out);
+                    break;
+                case StrategyKind::STOP_HEAVY:
+                    buy_bracketed(strategy, *bar, out);
+                    break;
+                case StrategyKind::LIMIT_HEAVY:
+                    quote_limits(strategy, *bar, out);
+                    break;
+            }
+
+            return OK_RESULT;
+        }
+
+        // The generator is all a strategy carries between bars, so a resumed run draws the same trades.
+        PluginResult save_state(void* self, const uint8_t** data_out, size_t* size_out) {
+            auto& strategy = *static_cast<Strategy*>(self);
+            std::ostringstream out;
+            out << strategy.rng_;
+            strategy.saved_state_ = out.str();
+
+            *data_out = reinterpret_cast<const uint8_t*>(strategy.saved_state_.data());  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            *size_out = strategy.saved_state_.size();
+            return OK_RESULT;
+        }
+
+        PluginResult restore_state(void* self, const uint8_t* data, size_t size) {
+            auto& strategy = *static_cast<Strategy*>(self);
+            std::istringstream in(std::string(reinterpret_cast<const char*>(data), size));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            in >> strategy.rng_;
+            return OK_RESULT;
+        }
+
+        PluginResult on_end(void* /*self*/, const char** json_out) {
+            *json_out = nullptr;
+            return OK_RESULT;
+        }
+
+        void free_string(void* /*self*/, const char* /*json_out_str*/) {}
+    }  // namespace
+
+    std::string_view to_string(StrategyKind kind) {
+        switch (kind) {
+            case StrategyKind::RANDOM_TRADER:
+                return "random_trader";
+            case StrategyKind::CHURNER:
+                return "churner";
+            case StrategyKind::STOP_HEAVY:
+                return "stop_heavy";
+            case StrategyKind::LIMIT_HEAVY:
+                return "limit_heavy";
+        }
+        return "unknown";
+    }
+
+    std::optional<StrategyKind> parse_strategy(std::string_view name) {
+        for (const auto kind : ALL_STRATEGIES) {
+            if (to_string(kind) == name) {
+                return kind;
+            }
+        }
+        return std::nullopt;
+    }
+
+    PluginExport create_strategy(StrategyKind kind, uint64_t seed) {
+        return PluginExport{
+            .api_version_ = PLUGIN_API_VERSION_V1_SIZED,
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+            .instance_ = new Strategy{.kind_ = kind, .rng_ = std::mt19937_64(seed), .symbol_ = {}, .saved_state_ = {}},
+            .vtable_ =
+                PluginVTable{
+                    .destroy = destroy,
+                    .on_init = on_init,
+                    .on_start = on_start,
+                    .on_bar = nullptr,
+                    .on_end = on_end,
+                    .free_string = free_string,
+                    .vtable_size_ = sizeof(PluginVTable),
+                    .precompute_signals = nullptr,
+                    .on_bar_into = on_bar_into,
+                    .save_state = save_state,
+                    .restore_state = restore_state,
+                },
+        };
+    }
+
+}  // namespace benchmarks::strategies
@@ -0,0 +1,34 @@
+#ifndef QUANT_FORGE_BENCHMARKS_STRATEGIES_HPP
+#define QUANT_FORGE_BENCHMARKS_STRATEGIES_HPP
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "../src/plugins/abi/abi.h"
+
+// Canned v1 strategies compiled into the harness, each leaning on a different part of the engine. They write
+// through on_bar_into, as a tuned native plugin would.
+namespace benchmarks::strategies {
+
+    enum class StrategyKind : uint8_t {
+        RANDOM_TRADER,  // Occasional market orders in either direction
+        CHURNER,        // A buy and a sell on every bar, so fills and position flips dominate
+        STOP_HEAVY,     // Bracketed buys with tight stops and targets, so the exit book churns
+        LIMIT_HEAVY,    // Limits on both sides just off the close, so the limit books stay deep
+    };
+
+    inline constexpr std::array<StrategyKind, 4> ALL_STRATEGIES = {StrategyKind::RANDOM_TRADER, StrategyKind::CHURNER, StrategyKind::STOP_HEAVY,
+                                                                   StrategyKind::LIMIT_HEAVY};
+
+    [[nodiscard]] std::string_view to_string(StrategyKind kind);
+    [[nodiscard]] std::optional<StrategyKind> parse_strategy(std::string_view name);
+
+    [[nodiscard]] PluginExport create_strategy(StrategyKind kind, uint64_t seed);
+
+}  // namespace benchmarks::strategies
+
+#endif
@@ -0,0 +1,112 @@
+#include "synthetic_market.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/utils/constants.hpp"
+
+// 252 sessions of 6.5 hours, for scaling annual drift and volatility to a bar.
+static constexpr double TRADING_SECONDS_PER_YEAR = 252.0 * 6.5 * 3600.0;
+static constexpr double BASE_VOLUME = 1'000'000.0;
+static constexpr double VOLUME_LOG_STDDEV = 0.5;
+static constexpr double WICK_SCALE = 0.5;
+
+namespace benchmarks::market {
+
+    std::vector<std::string> make_symbols(size_t symbol_count) {
+        std::vector<std::string> symbols;
+        symbols.reserve(symbol_count);
+        for (size_t i = 0; i < symbol_count; ++i) {
+            symbols.push_back("SYN" + std::to_string(i));
+        }
+        return symbols;
+    }
+
+    http::stock_api::AggregateBars generate_bars(const SyntheticMarketOptions& options, const std::string& symbol, size_t symbol_index) {
+        if (options.model_ == PriceModel::BOOTSTRAP && options.bootstrap_returns_.empty()) {
+            throw std::runtime_error("Bootstrap price model needs at least one return");
+        }
+
+        std::mt19937_64 rng(options.seed_ + symbol_index);
+        std::normal_distribution<double> standard_normal(0.0, 1.0);
+        std::uniform_int_distribution<size_t> bootstrap_index(0, std::max<size_t>(options.bootstrap_returns_.size(), 1) - 1);
+
+        const double dt = static_cast<double>(options.timespan_s_) / TRADING_SECONDS_PER_YEAR;
+        const double step_drift = (options.annual_drift_ - (0.5 * options.annual_volatility_ * options.annual_volatility_)) * dt;
+        const double step_volatility = options.annual_volatility_ * std::sqrt(dt);
+
+        http::stock_api::AggregateBars bars{};
+        bars.ticker_ = symbol;
+        bars.adjusted_ = true;
+        bars.query_count_ = options.bars_per_symbol_;
+        bars.result_count_ = options.bars_per_symbol_;
+        bars.results_.reserve(options.bars_per_symbol_);
+
+        double close = options.initial_price_;
+        for (size_t i = 0; i < options.bars_per_symbol_; ++i) {
+            const double log_return = options.model_ == PriceModel::GBM ? step_drift + (step_volatility * standard_normal(rng))
+                                                                          : options.bootstrap_returns_[bootstrap_index(rng)];
+            const double open = close;
+            close = open * std::exp(log_return);
+
+            const double wick = std::abs(log_return) + (step_volatility * std::abs(standard_normal(rng)) * WICK_SCALE);
+            const long long unix_ts_s = options.start_unix_ts_s_ + (static_cast<long long>(i) * options.timespan_s_);
+
+            http::stock_api::AggregateBarResult bar{};
+            bar.symbol_ = symbol;
+            bar.open_ = open;
+            bar.close_ = close;
+            bar.high_ = std::max(open, close) * std::exp(wick);
+            bar.low_ = std::min(open, close) * std::exp(-wick);
+            bar.volume_ = std::round(BASE_VOLUME * std::exp(VOLUME_LOG_STDDEV * standard_normal(rng)));
+            bar.volume_weighted_price_ = (bar.high_ + bar.low_ + close) / 3.0;
+            bar.unix_ts_ns_ = unix_ts_s * constants::NANOSECONDS_PER_SECOND;
+            bars.results_.push_back(std::move(bar));
+        }
+
+        return bars;
+    }
+
+    void load_into(forge::DataStore& data_store, const std::string& plugin_name, const SyntheticMarketOptions& options) {
+        const auto symbols = make_symbols(options.symbol_count_);
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            auto bars = std::make_shared<const http::stock_api::AggregateBars>(generate_bars(options, symbols[i], i));
+            data_store.store_bars_by_plugin_name(plugin_name, symbols[i], std::move(bars));
+        }
+        data_store.create_iterable_plugin_data(plugin_name);
+    }
+
+    std::vector<double> read_log_returns(const std::filesystem::path& closes_path) {
+        std::ifstream in(closes_path);
+        if (!in) {
+            throw std::runtime_error("Failed to open closes file: " + closes_path.string());
+        }
+
+        std::vector<double> log_returns;
+        double previous = 0.0;
+        double close = 0.0;
+        while (in >> close) {
+            if (close <= 0.0) {
+                throw std::runtime_error("Closes must be positive: " + closes_path.string());
+            }
+            if (previous > 0.0) {
+                log_returns.push_back(std::log(close / previous));
+            }
+            previous = close;
+        }
+
+        if (log_returns.empty()) {
+            throw std::runtime_error("Closes file needs at least two closes: " + closes_path.string());
+        }
+
+        return log_returns;
+    }
+
+}  // namespace benchmarks::market
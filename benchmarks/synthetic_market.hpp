@@ -0,0 +1,45 @@
+#ifndef QUANT_FORGE_BENCHMARKS_SYNTHETIC_MARKET_HPP
+#define QUANT_FORGE_BENCHMARKS_SYNTHETIC_MARKET_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "../src/forge/stores/data_store.hpp"
+#include "../src/http/api/stock_api.hpp"
+
+namespace benchmarks::market {
+
+    enum class PriceModel : uint8_t { GBM, BOOTSTRAP };
+
+    struct SyntheticMarketOptions {
+        size_t symbol_count_ = 10;
+        size_t bars_per_symbol_ = 2'000;
+        int64_t timespan_s_ = 60;
+        int64_t start_unix_ts_s_ = 1'700'000'000;
+        uint64_t seed_ = 42;
+        PriceModel model_ = PriceModel::GBM;
+        double initial_price_ = 100.0;
+        double annual_drift_ = 0.05;
+        double annual_volatility_ = 0.2;
+        // Per-bar log returns resampled by PriceModel::BOOTSTRAP.
+        std::vector<double> bootstrap_returns_;
+    };
+
+    [[nodiscard]] std::vector<std::string> make_symbols(size_t symbol_count);
+
+    // Each symbol draws from its own seed, so a symbol's bars do not change when the symbol count does.
+    [[nodiscard]] http::stock_api::AggregateBars generate_bars(const SyntheticMarketOptions& options, const std::string& symbol, size_t symbol_index);
+
+    void load_into(forge::DataStore& data_store, const std::string& plugin_name, const SyntheticMarketOptions& options);
+
+    // Log returns between consecutive closes in a file of one close per line, for bootstrapping from real prices.
+    [[nodiscard]] std::vector<double> read_log_returns(const std::filesystem::path& closes_path);
+
+}  // namespace benchmarks::market
+
+#endif
@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#include "../src/utils/thread_pool.hpp"
+#include "./generators.hpp"
+
+namespace {
+    // Enqueue and drain range(0) empty tasks, so the cost measured is the queue's rather than the work's.
+    void BM_ThreadPoolEnqueue(benchmark::State& bench) {
+        concurrency::ThreadPool pool(std::max(1U, std::thread::hardware_concurrency()));
+        std::atomic<size_t> completed = 0;
+
+        for (auto _ : bench) {
+            for (int64_t i = 0; i < bench.range(0); ++i) {
+                pool.enqueue([&completed] { completed.fetch_add(1, std::memory_order_relaxed); });
+            }
+            pool.wait_all();
+        }
+
+        benchmark::DoNotOptimize(completed.load());
+        bench.SetItemsProcessed(bench.iterations() * bench.range(0));
+    }
+}  // namespace
+
+BENCHMARK(BM_ThreadPoolEnqueue)->Apply(benchmarks::generators::apply_scales)->UseRealTime();
@@ -0,0 +1,442 @@
+// End-to-end throughput of the back test: a synthetic market in a DataStore, replayed by BackTestEngine through
+// in-process strategies. Each scenario runs in its own process, so its peak RSS and allocation count are its own.
+//
+//   quant_forge_throughput [--symbols N] [--bars N] [--timespan-s N] [--seed N] [--model gbm|bootstrap]
+//                          [--closes PATH] [--strategy NAME]... [--json PATH] [--no-fork] [--replay] [--features]
+//
+// --closes reads one close per line and implies --model bootstrap. --strategy may repeat; all four run by default.
+// --replay also times each scenario replayed from its event log, and fails it if the replay diverges from the run.
+// --features also times each scenario under a cash-only, long-only, market-order policy, on MinimalFeatures and on
+// AllFeatures, so the two columns show what the compiled-out features cost.
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../src/forge/stores/data_store.hpp"
+#include "../src/plugins/manifest/manifest.hpp"
+#include "../src/simulators/back_test/back_test_engine.hpp"
+#include "../src/simulators/back_test/event_log.hpp"
+#include "../src/simulators/back_test/features.hpp"
+#include "../src/utils/money_utils.hpp"
+#include "./allocation_counter.hpp"
+#include "./in_process_loader.hpp"
+#include "./strategies.hpp"
+#include "./synthetic_market.hpp"
+
+static constexpr double INITIAL_CAPITAL = 100'000'000.0;
+static constexpr size_t ERROR_MESSAGE_LENGTH = 256;
+static constexpr double NANOSECONDS_PER_MICROSECOND = 1'000.0;
+static constexpr double BYTES_PER_MEGABYTE = 1024.0 * 1024.0;
+#ifdef __APPLE__
+static constexpr uint64_t MAX_RSS_UNIT_BYTES = 1;
+#else
+static constexpr uint64_t MAX_RSS_UNIT_BYTES = 1024;
+#endif
+
+namespace {
+    using benchmarks::strategies::StrategyKind;
+
+    struct HarnessOptions {
+        benchmarks::market::SyntheticMarketOptions market_;
+        std::vector<StrategyKind> strategies_;
+        std::string json_path_;
+        bool is_fork_enabled_ = true;
+        bool is_replay_enabled_ = false;
+        bool is_features_enabled_ = false;
+    };
+
+    // Plain data, so a forked run can hand it back through a pipe.
+    struct ScenarioResult {
+        bool is_ok_ = false;
+        std::array<char, ERROR_MESSAGE_LENGTH> error_{};
+        uint64_t bar_count_ = 0;
+        uint64_t order_count_ = 0;
+        uint64_t fill_count_ = 0;
+        double elapsed_s_ = 0.0;
+        double replay_elapsed_s_ = 0.0;
+        double minimal_features_elapsed_s_ = 0.0;
+        double all_features_elapsed_s_ = 0.0;
+        double bar_latency_p50_us_ = 0.0;
+        double bar_latency_p90_us_ = 0.0;
+        double bar_latency_p99_us_ = 0.0;
+        double bar_latency_max_us_ = 0.0;
+        uint64_t allocations_ = 0;
+        uint64_t allocated_bytes_ = 0;
+        uint64_t peak_rss_bytes_ = 0;
+    };
+
+    plugins::manifest::HostParams make_host_params(const benchmarks::market::SyntheticMarketOptions& market) {
+        plugins::manifest::HostParams host_params{};
+        host_params.initial_capital_ = money_utils::Money::from_dollars(INITIAL_CAPITAL).to_abi_int64();
+        host_params.allow_fractional_shares_ = true;
+        host_params.allow_short_selling_ = true;
+
+        const auto symbols = benchmarks::market::make_symbols(market.symbol_count_);
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            host_params.symbols_.emplace_back(i == 0, static_cast<int>(market.timespan_s_), symbols[i], "second");
+        }
+
+        return host_params;
+    }
+
+    // Rules out every optional feature, so both MinimalFeatures and AllFeatures may run it.
+    plugins::manifest::HostParams make_cash_only_host_params(const benchmarks::market::SyntheticMarketOptions& market) {
+        auto host_params = make_host_params(market);
+        host_params.allow_short_selling_ = false;
+        host_params.allow_limit_orders_ = false;
+        host_params.allow_exit_orders_ = false;
+        return host_params;
+    }
+
+    double to_us(int64_t ns) { return static_cast<double>(ns) / NANOSECONDS_PER_MICROSECOND; }
+
+    // Nearest rank on sorted values.
+    int64_t percentile(const std::vector<int64_t>& sorted, double pct) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        const auto rank = static_cast<size_t>(pct * static_cast<double>(sorted.size() - 1));
+        return sorted[rank];
+    }
+
+    std::unique_ptr<benchmarks::InProcessLoader> make_loader(StrategyKind kind, const HarnessOptions& options,
+                                                             const plugins::manifest::HostParams& host_params) {
+        const auto create = [kind, seed = options.market_.seed_](const SimulatorContext&) { return benchmarks::strategies::create_strategy(kind, seed); };
+        auto loader = std::make_unique<benchmarks::InProcessLoader>(std::string(benchmarks::strategies::to_string(kind)), host_params, create);
+        loader->load_plugin(SimulatorContext{.api_version_ = PLUGIN_API_VERSION});
+        loader->on_init();
+        return loader;
+    }
+
+    // Records a fresh run of the strategy, times a replay of it, then checks that a recorded replay matches event for event.
+    double time_replay(StrategyKind kind, const HarnessOptions& options, const forge::DataStore& data_store) {
+        simulators::EventLog recorded;
+        {
+            const auto loader = make_loader(kind, options, make_host_params(options.market_));
+            simulators::BackTestEngine engine(loader.get(), &data_store);
+            engine.set_event_log(&recorded);
+            engine.run();
+        }
+
+        const auto host_params = make_host_params(options.market_);
+        const auto start = std::chrono::steady_clock::now();
+        {
+            simulators::BackTestEngine engine(nullptr, nullptr);
+            engine.run_from_event_log(recorded, host_params);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        simulators::EventLog replayed;
+        {
+            simulators::BackTestEngine engine(nullptr, nullptr);
+            engine.set_event_log(&replayed);
+            engine.run_from_event_log(recorded, host_params);
+        }
+
+        const auto divergence = simulators::find_first_divergence(recorded, replayed);
+        if (divergence.has_value()) {
+            throw std::runtime_error("Replay diverged from the recorded run at event " + std::to_string(divergence.value()));
+        }
+
+        return std::chrono::duration<double>(elapsed).count();
+    }
+
+    template <typename FeaturesT>
+    double time_features(StrategyKind kind, const HarnessOptions& options, const forge::DataStore& data_store) {
+        const auto loader = make_loader(kind, options, make_cash_only_host_params(options.market_));
+        const auto start = std::chrono::steady_clock::now();
+        {
+            simulators::BackTestEngine engine(loader.get(), &data_store);
+            engine.run_with_features<FeaturesT>();
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    ScenarioResult run_scenario(StrategyKind kind, const HarnessOptions& options) {
+        const std::string plugin_name(benchmarks::strategies::to_string(kind));
+
+        forge::DataStore data_store;
+        benchmarks::market::load_into(data_store, plugin_name, options.market_);
+
+        const auto loader_ptr = make_loader(kind, options, make_host_params(options.market_));
+        auto& loader = *loader_ptr;
+        loader.reserve_bars(options.market_.symbol_count_ * options.market_.bars_per_symbol_);
+
+        benchmarks::allocations::reset_allocation_counts();
+        const auto start = std::chrono::steady_clock::now();
+        {
+            simulators::BackTestEngine engine(&loader, &data_store);
+            engine.run();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const auto allocations = benchmarks::allocations::get_allocation_counts();
+
+        // A bar's latency is the time from its on_bar to the next one's, which covers the engine's work on both sides.
+        const auto& bar_start_ns = loader.get_bar_start_ns();
+        std::vector<int64_t> latencies_ns;
+        latencies_ns.reserve(bar_start_ns.size());
+        for (size_t i = 1; i < bar_start_ns.size(); ++i) {
+            latencies_ns.push_back(bar_start_ns[i] - bar_start_ns[i - 1]);
+        }
+        std::ranges::sort(latencies_ns);
+
+        ScenarioResult result;
+        result.is_ok_ = true;
+        result.bar_count_ = bar_start_ns.size();
+        result.order_count_ = loader.get_order_count();
+        result.fill_count_ = loader.get_fill_count();
+        result.elapsed_s_ = std::chrono::duration<double>(elapsed).count();
+        result.bar_latency_p50_us_ = to_us(percentile(latencies_ns, 0.50));
+        result.bar_latency_p90_us_ = to_us(percentile(latencies_ns, 0.90));
+        result.bar_latency_p99_us_ = to_us(percentile(latencies_ns, 0.99));
+        result.bar_latency_max_us_ = to_us(latencies_ns.empty() ? 0 : latencies_ns.back());
+        result.allocations_ = allocations.allocations_;
+        result.allocated_bytes_ = allocations.bytes_;
+
+        if (options.is_replay_enabled_) {
+            result.replay_elapsed_s_ = time_replay(kind, options, data_store);
+        }
+
+        if (options.is_features_enabled_) {
+            result.minimal_features_elapsed_s_ = time_features<simulators::MinimalFeatures>(kind, options, data_store);
+            result.all_features_elapsed_s_ = time_features<simulators::AllFeatures>(kind, options, data_store);
+        }
+
+        return result;
+    }
+
+    ScenarioResult run_scenario_or_error(StrategyKind kind, const HarnessOptions& options) {
+        try {
+            return run_scenario(kind, options);
+        } catch (const std::exception& e) {
+            ScenarioResult result;
+            std::strncpy(result.error_.data(), e.what(), result.error_.size() - 1);
+            return result;
+        }
+    }
+
+    uint64_t get_peak_rss_bytes(const rusage& usage) { return static_cast<uint64_t>(usage.ru_maxrss) * MAX_RSS_UNIT_BYTES; }
+
+    ScenarioResult run_isolated(StrategyKind kind, const HarnessOptions& options) {
+        if (!options.is_fork_enabled_) {
+            auto result = run_scenario_or_error(kind, options);
+            rusage usage{};
+            getrusage(RUSAGE_SELF, &usage);
+            result.peak_rss_bytes_ = get_peak_rss_bytes(usage);
+            return result;
+        }
+
+        std::array<int, 2> fds{};
+        if (pipe(fds.data()) != 0) {
+            throw std::runtime_error("Failed to create pipe: " + std::string(std::strerror(errno)));
+        }
+
+        const pid_t pid = fork();
+        if (pid < 0) {
+            throw std::runtime_error("Failed to fork: " + std::string(std::strerror(errno)));
+        }
+
+        if (pid == 0) {
+            close(fds[0]);
+            const ScenarioResult result = run_scenario_or_error(kind, options);
+            const bool is_written = write(fds[1], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+            close(fds[1]);
+            _exit(is_written ? 0 : 1);
+        }
+
+        close(fds[1]);
+        ScenarioResult result;
+        const bool is_read = read(fds[0], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+        close(fds[0]);
+
+        int status = 0;
+        rusage usage{};
+        wait4(pid, &status, 0, &usage);
+
+        if (!is_read || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            result = ScenarioResult{};
+            std::strncpy(result.error_.data(), "Scenario process exited abnormally", result.error_.size() - 1);
+        }
+
+        result.peak_rss_bytes_ = get_peak_rss_bytes(usage);
+        return result;
+    }
+
+    double per_second(uint64_t count, double elapsed_s) { return elapsed_s > 0.0 ? static_cast<double>(count) / elapsed_s : 0.0; }
+
+    void print_results(const std::vector<std::pair<StrategyKind, ScenarioResult>>& results) {
+        std::cout << std::left << std::setw(16) << "scenario" << std::right << std::setw(12) << "bars" << std::setw(12) << "orders" << std::setw(12)
+                  << "fills" << std::setw(14) << "bars/s" << std::setw(14) << "orders/s" << std::setw(10) << "p50 us" << std::setw(10) << "p90 us"
+                  << std::setw(10) << "p99 us" << std::setw(12) << "max us" << std::setw(12) << "rss MB" << std::setw(14) << "allocs"
+                  << std::setw(12) << "alloc MB" << std::setw(14) << "replay bars/s" << std::setw(14) << "min bars/s" << std::setw(14) << "all bars/s"
+                  << "\n";
+
+        for (const auto& [kind, result] : results) {
+            std::cout << std::left << std::setw(16) << benchmarks::strategies::to_string(kind) << std::right;
+
+            if (!result.is_ok_) {
+                std::cout << "  failed: " << result.error_.data() << "\n";
+                continue;
+            }
+
+            std::cout << std::fixed << std::setprecision(0) << std::setw(12) << result.bar_count_ << std::setw(12) << result.order_count_ << std::setw(12)
+                      << result.fill_count_ << std::setw(14) << per_second(result.bar_count_, result.elapsed_s_) << std::setw(14)
+                      << per_second(result.order_count_, result.elapsed_s_) << std::setprecision(2) << std::setw(10) << result.bar_latency_p50_us_
+                      << std::setw(10) << result.bar_latency_p90_us_ << std::setw(10) << result.bar_latency_p99_us_ << std::setw(12)
+                      << result.bar_latency_max_us_ << std::setprecision(1) << std::setw(12)
+                      << static_cast<double>(result.peak_rss_bytes_) / BYTES_PER_MEGABYTE << std::setw(14) << result.allocations_ << std::setw(12)
+                      << static_cast<double>(result.allocated_bytes_) / BYTES_PER_MEGABYTE << std::setprecision(0) << std::setw(14);
+
+            if (result.replay_elapsed_s_ > 0.0) {
+                std::cout << per_second(result.bar_count_, result.replay_elapsed_s_);
+            } else {
+                std::cout << "-";
+            }
+
+            if (result.minimal_features_elapsed_s_ > 0.0) {
+                std::cout << std::setw(14) << per_second(result.bar_count_, result.minimal_features_elapsed_s_) << std::setw(14)
+                          << per_second(result.bar_count_, result.all_features_elapsed_s_) << "\n";
+            } else {
+                std::cout << std::setw(14) << "-" << std::setw(14) << "-" << "\n";
+            }
+        }
+    }
+
+    void write_json(const std::string& path, const HarnessOptions& options, const std::vector<std::pair<StrategyKind, ScenarioResult>>& results) {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Failed to open results file: " + path);
+        }
+
+        const auto& market = options.market_;
+        out << std::fixed << std::setprecision(3) << "{\"market\":{\"symbols\":" << market.symbol_count_ << ",\"bars_per_symbol\":" << market.bars_per_symbol_
+            << ",\"timespan_s\":" << market.timespan_s_ << ",\"seed\":" << market.seed_ << ",\"model\":\""
+            << (market.model_ == benchmarks::market::PriceModel::GBM ? "gbm" : "bootstrap") << "\"},\"scenarios\":[";
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& [kind, result] = results[i];
+            out << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << benchmarks::strategies::to_string(kind) << "\",\"ok\":" << (result.is_ok_ ? "true" : "false");
+
+            if (result.is_ok_) {
+                out << ",\"bars\":" << result.bar_count_ << ",\"orders\":" << result.order_count_ << ",\"fills\":" << result.fill_count_
+                    << ",\"elapsed_s\":" << result.elapsed_s_ << ",\"bars_per_s\":" << per_second(result.bar_count_, result.elapsed_s_)
+                    << ",\"orders_per_s\":" << per_second(result.order_count_, result.elapsed_s_) << ",\"bar_latency_us\":{\"p50\":"
+                    << result.bar_latency_p50_us_ << ",\"p90\":" << result.bar_latency_p90_us_ << ",\"p99\":" << result.bar_latency_p99_us_
+                    << ",\"max\":" << result.bar_latency_max_us_ << "},\"peak_rss_bytes\":" << result.peak_rss_bytes_
+                    << ",\"allocations\":" << result.allocations_ << ",\"allocated_bytes\":" << result.allocated_bytes_;
+
+                if (result.replay_elapsed_s_ > 0.0) {
+                    out << ",\"replay_elapsed_s\":" << result.replay_elapsed_s_ << ",\"replay_bars_per_s\":"
+                        << per_second(result.bar_count_, result.replay_elapsed_s_);
+                }
+
+                if (result.minimal_features_elapsed_s_ > 0.0) {
+                    out << ",\"minimal_features_bars_per_s\":" << per_second(result.bar_count_, result.minimal_features_elapsed_s_)
+                        << ",\"all_features_bars_per_s\":" << per_second(result.bar_count_, result.all_features_elapsed_s_);
+                }
+            }
+
+            out << "}";
+        }
+
+        out << "\n]}\n";
+    }
+
+    HarnessOptions parse_args(int argc, char** argv) {
+        HarnessOptions options;
+        const std::vector<std::string_view> args(argv + 1, argv + argc);
+
+        for (size_t i = 0; i < args.size(); ++i) {
+            const std::string_view arg = args[i];
+            const auto next_value = [&]() -> std::string {
+                if (i + 1 >= args.size()) {
+                    throw std::runtime_error("Missing value for " + std::string(arg));
+                }
+                return std::string(args[++i]);
+            };
+
+            if (arg == "--symbols") {
+                options.market_.symbol_count_ = std::stoul(next_value());
+            } else if (arg == "--bars") {
+                options.market_.bars_per_symbol_ = std::stoul(next_value());
+            } else if (arg == "--timespan-s") {
+                options.market_.timespan_s_ = std::stoll(next_value());
+            } else if (arg == "--seed") {
+                options.market_.seed_ = std::stoull(next_value());
+            } else if (arg == "--model") {
+                const std::string model = next_value();
+                if (model != "gbm" && model != "bootstrap") {
+                    throw std::runtime_error("Unknown price model: " + model);
+                }
+                options.market_.model_ = model == "gbm" ? benchmarks::market::PriceModel::GBM : benchmarks::market::PriceModel::BOOTSTRAP;
+            } else if (arg == "--closes") {
+                options.market_.bootstrap_returns_ = benchmarks::market::read_log_returns(next_value());
+                options.market_.model_ = benchmarks::market::PriceModel::BOOTSTRAP;
+            } else if (arg == "--strategy") {
+                const std::string name = next_value();
+                const auto kind = benchmarks::strategies::parse_strategy(name);
+                if (!kind.has_value()) {
+                    throw std::runtime_error("Unknown strategy: " + name);
+                }
+                options.strategies_.push_back(kind.value());
+            } else if (arg == "--json") {
+                options.json_path_ = next_value();
+            } else if (arg == "--no-fork") {
+                options.is_fork_enabled_ = false;
+            } else if (arg == "--replay") {
+                options.is_replay_enabled_ = true;
+            } else if (arg == "--features") {
+                options.is_features_enabled_ = true;
+            } else {
+                throw std::runtime_error("Unknown argument: " + std::string(arg));
+            }
+        }
+
+        if (options.strategies_.empty()) {
+            options.strategies_.assign(benchmarks::strategies::ALL_STRATEGIES.begin(), benchmarks::strategies::ALL_STRATEGIES.end());
+        }
+
+        return options;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const HarnessOptions options = parse_args(argc, argv);
+
+        std::vector<std::pair<StrategyKind, ScenarioResult>> results;
+        bool is_all_ok = true;
+        for (const auto kind : options.strategies_) {
+            results.emplace_back(kind, run_isolated(kind, options));
+            is_all_ok = is_all_ok && results.back().second.is_ok_;
+        }
+
+        print_results(results);
+
+        if (!options.json_path_.empty()) {
+            write_json(options.json_path_, options, results);
+        }
+
+        return is_all_ok ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
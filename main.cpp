@@ -1,14 +1,25 @@
+#include <filesystem>
 #include <iostream>
 #include <thread>
 
 #include "src/forge/forge_engine/forge.hpp"
+#include "src/http/api/bar_cache.hpp"
+#include "src/http/cache/memory_cache.hpp"
 #include "src/http/cache/network_cache.hpp"
 #include "src/http/client/curl_easy.hpp"
 #include "src/http/client/curl_global.hpp"
+#include "src/http/client/file_client.hpp"
+#include "src/http/client/rate_limiter.hpp"
+#include "src/http/client/replay_client.hpp"
 #include "src/http/error/http_error.hpp"
+#include "src/http/provider/local_file.hpp"
 #include "src/http/provider/polygon.hpp"
+#include "src/renderers/columnar_renderer.hpp"
+#include "src/renderers/composite_renderer.hpp"
 #include "src/renderers/console_renderer.hpp"
 #include "src/utils/constants.hpp"
+#include "src/utils/profiler.hpp"
+#include "src/utils/thread_pool.hpp"
 
 int main() {
     try {
@@ -19,38 +30,146 @@ int main() {
         const char* plugin_loader = "directory";
         const char* plugin_root_path = "plugins";
         const unsigned int max_threads = std::thread::hardware_concurrency();
-        const std::string polygon_api_key = std::getenv("POLYGON_API_KEY");
+        const char* polygon_api_key_env = std::getenv("POLYGON_API_KEY");
+        const std::string polygon_api_key = polygon_api_key_env != nullptr ? polygon_api_key_env : "";
+        // Offline modes: bars from local files, or a replay of a recorded cache directory (its bars and http subdirectories).
+        const char* local_data_dir = std::getenv("QUANT_FORGE_DATA_DIR");
+        const char* replay_dir = std::getenv("QUANT_FORGE_REPLAY_DIR");
+        // Record each plugin's back test as an event log, or replay recorded logs without fetching bars or calling plugins.
+        const char* event_log_dir = std::getenv("QUANT_FORGE_EVENT_LOG_DIR");
+        const char* event_replay_dir = std::getenv("QUANT_FORGE_EVENT_REPLAY_DIR");
+        // Checkpoint long back tests and resume them, skipping plugins a previous run over the same directory completed.
+        const char* checkpoint_dir = std::getenv("QUANT_FORGE_CHECKPOINT_DIR");
+        const char* checkpoint_interval_env = std::getenv("QUANT_FORGE_CHECKPOINT_INTERVAL");
+        const size_t checkpoint_interval_bars =
+            checkpoint_interval_env != nullptr ? std::stoull(checkpoint_interval_env) : constants::DEFAULT_CHECKPOINT_INTERVAL_BARS;
+        // Stream fills and equity curves to per-plugin journals, keeping a window of the curve and every Nth snapshot.
+        const char* journal_dir = std::getenv("QUANT_FORGE_JOURNAL_DIR");
+        const char* equity_window_env = std::getenv("QUANT_FORGE_EQUITY_WINDOW");
+        const char* equity_stride_env = std::getenv("QUANT_FORGE_EQUITY_STRIDE");
+        const size_t equity_window = equity_window_env != nullptr ? std::stoull(equity_window_env) : constants::DEFAULT_STREAMING_EQUITY_WINDOW;
+        const size_t equity_stride = equity_stride_env != nullptr ? std::stoull(equity_stride_env) : 1;
+        // Also write every report as columnar tables here.
+        const char* report_dir = std::getenv("QUANT_FORGE_REPORT_DIR");
+        // Keep running after the first report, rerunning native plugins as they are rebuilt.
+        const bool is_watch_enabled = std::getenv("QUANT_FORGE_WATCH") != nullptr;
+        // Profiling builds only: where to write a Chrome trace of the run.
+        [[maybe_unused]] const char* trace_path = std::getenv("QUANT_FORGE_TRACE");
         const std::vector<std::string> enabled_plugin_names = {"sma_native", "sma_python"};
         const bool is_cache_enabled = true;
         const int cache_ttl_s = constants::ONE_DAY_S;
+        // Unmetered by default, paced only by Polygon's rate limit headers and 429s. Polygon's free tier allows 5 requests
+        // a minute, so set this to 5 there to avoid running into 429s; paid plans allow far more.
+        const char* polygon_requests_per_minute_env = std::getenv("QUANT_FORGE_POLYGON_REQUESTS_PER_MINUTE");
+        const long polygon_requests_per_minute =
+            polygon_requests_per_minute_env != nullptr ? std::stol(polygon_requests_per_minute_env) : http::client::DEFAULT_REQUESTS_PER_WINDOW;
 
-        if (polygon_api_key.empty()) {
-            std::cout << "POLYGON_API_KEY not set" << std::endl;
-            return 1;
+        std::unique_ptr<renderers::IRenderer> renderer = std::make_unique<renderers::ConsoleRenderer>();
+        if (report_dir != nullptr) {
+            std::vector<std::unique_ptr<renderers::IRenderer>> renderers;
+            renderers.push_back(std::move(renderer));
+            renderers.push_back(std::make_unique<renderers::ColumnarRenderer>(report_dir));
+            renderer = std::make_unique<renderers::CompositeRenderer>(std::move(renderers));
         }
 
+        std::unique_ptr<http::stock_api::IStockDataProvider> data_provider;
+        std::function<std::unique_ptr<http::client::IHttpClient>()> http_client_factory;
+        std::shared_ptr<http::stock_api::BarCache> bar_cache;
+        // Only online runs go through the memory cache; its counters are reported once the data is fetched.
+        std::shared_ptr<http::cache::MemoryCache> memory_cache;
+
         http::client::CurlGlobal curl_global;
 
-        auto data_provider = std::make_unique<http::provider::PolygonProvider>(polygon_api_key);
+        if (local_data_dir != nullptr) {
+            // One parse pool for every IO thread, instead of each request spinning up its own.
+            data_provider = std::make_unique<http::provider::LocalFileProvider>(local_data_dir, std::make_shared<concurrency::ThreadPool>(max_threads));
+            http_client_factory = []() { return std::make_unique<http::client::FileClient>(); };
+        } else if (replay_dir != nullptr) {
+            // A recording is a copy of the cache directory of an online run. Requests go through a bar cache over its bars, exactly as
+            // they did when recorded, so they resolve to the same gap requests, which are answered from its http responses.
+            const std::filesystem::path recording_dir = replay_dir;
+
+            data_provider = std::make_unique<http::provider::PolygonProvider>(polygon_api_key);
+            http_client_factory = [recording_dir]() {
+                auto recording_policy = std::make_unique<http::cache::NetworkCachePolicy>(
+                    http::cache::NetworkCachePolicy{.enable_caching_ = true, .root_ = recording_dir / "http"});
+                return std::make_unique<http::client::ReplayClient>(std::make_unique<http::cache::NetworkCache>(std::move(recording_policy)));
+            };
+
+            bar_cache = std::make_shared<http::stock_api::BarCache>(std::make_unique<http::stock_api::BarCachePolicy>(
+                http::stock_api::BarCachePolicy{.enable_caching_ = true, .root_ = recording_dir / "bars", .is_replay_only_ = true}));
+        } else if (event_replay_dir != nullptr) {
+            // Nothing is fetched when replaying event logs, so no data provider is set up.
+        } else {
+            if (polygon_api_key.empty()) {
+                std::cout << "POLYGON_API_KEY not set (or set QUANT_FORGE_DATA_DIR / QUANT_FORGE_REPLAY_DIR to run offline)" << std::endl;
+                return 1;
+            }
+
+            data_provider = std::make_unique<http::provider::PolygonProvider>(polygon_api_key);
+
+            // Shared by every client the factory creates, so identical requests across plugins and runs stay in memory.
+            memory_cache = std::make_shared<http::cache::MemoryCache>(std::make_unique<http::cache::MemoryCachePolicy>());
+
+            if (polygon_requests_per_minute > 0) {
+                std::cout << "Polygon requests limited to " << polygon_requests_per_minute << " per minute" << std::endl;
+            }
+
+            // One bucket for the whole process, so IO threads share the quota instead of discovering it independently.
+            auto rate_limiter = std::make_shared<http::client::RateLimiter>(
+                std::make_unique<http::client::RateLimitPolicy>(http::client::RateLimitPolicy{.requests_per_window_ = polygon_requests_per_minute}));
+
+            http_client_factory = [memory_cache, rate_limiter]() {
+                auto network_cache_policy = std::make_unique<http::cache::NetworkCachePolicy>(
+                    http::cache::NetworkCachePolicy{.enable_caching_ = is_cache_enabled, .ttl_s_ = cache_ttl_s});
+                auto network_cache = std::make_unique<http::cache::NetworkCache>(std::move(network_cache_policy), memory_cache);
+                return std::make_unique<http::client::CurlEasy>(std::move(network_cache), rate_limiter);
+            };
+
+            bar_cache = std::make_shared<http::stock_api::BarCache>(
+                std::make_unique<http::stock_api::BarCachePolicy>(http::stock_api::BarCachePolicy{.enable_caching_ = is_cache_enabled}));
+        }
 
         auto engine = forge::ForgeEngineBuilder()
-                          .with_http_client_factory([]() {
-                              auto network_cache_policy = std::make_unique<http::cache::NetworkCachePolicy>(
-                                  http::cache::NetworkCachePolicy{.enable_caching_ = is_cache_enabled, .ttl_s_ = cache_ttl_s});
-                              auto network_cache = std::make_unique<http::cache::NetworkCache>(std::move(network_cache_policy));
-                              return std::make_unique<http::client::CurlEasy>(std::move(network_cache));
-                          })
+                          .with_http_client_factory(std::move(http_client_factory))
                           .with_data_provider(std::move(data_provider))
+                          .with_bar_cache(bar_cache)
                           .with_thread_pools(forge::ThreadPoolOptions{.io_threads_ = max_threads / 2, .compute_threads_ = max_threads})
                           .with_plugin_names(enabled_plugin_names)
-                          .with_renderer(std::make_unique<renderers::ConsoleRenderer>())
+                          .with_renderer(std::move(renderer))
+                          .with_event_log_options(forge::EventLogOptions{.record_dir_ = event_log_dir != nullptr ? event_log_dir : "",
+                                                                         .replay_dir_ = event_replay_dir != nullptr ? event_replay_dir : ""})
+                          .with_checkpoint_options(forge::CheckpointOptions{.dir_ = checkpoint_dir != nullptr ? checkpoint_dir : "",
+                                                                            .interval_bars_ = checkpoint_interval_bars})
+                          .with_streaming_options(forge::StreamingOptions{.dir_ = journal_dir != nullptr ? journal_dir : "",
+                                                                          .equity_window_ = equity_window,
+                                                                          .equity_stride_ = equity_stride})
                           .validate()
                           .build();
 
         engine->initialize(forge::InitializationOptions{.loader_ = plugin_loader, .root_path_ = plugin_root_path});
-        engine->fetch_data();
+        if (event_replay_dir == nullptr) {
+            engine->fetch_data();
+        }
         engine->run();
         engine->report();
+
+        if (memory_cache != nullptr) {
+            const auto cache_stats = memory_cache->stats();
+            std::cout << "\nHTTP memory cache: " << cache_stats.hits_ << " hits, " << cache_stats.misses_ << " misses, " << cache_stats.evictions_
+                      << " evictions, " << cache_stats.entries_ << " entries (" << cache_stats.bytes_ << " bytes)\n";
+        }
+
+#ifdef QUANT_FORGE_PROFILE
+        profiler::write_summary(std::cout);
+        if (trace_path != nullptr) {
+            profiler::write_chrome_trace(trace_path);
+        }
+#endif
+
+        if (is_watch_enabled) {
+            engine->watch();
+        }
     } catch (const http::http_error::HttpError& e) {
         std::cerr << "HTTP Error: " << e.what() << " (URL: " << e.url_ << ")\n";
         return 2;
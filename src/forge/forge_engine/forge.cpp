@@ -1,12 +1,21 @@
 #include "forge.hpp"
 
+#include <exception>
+#include <filesystem>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "../../http/api/stock_api.hpp"
 #include "../../plugins/manager/plugin_manager.hpp"
+#include "../../plugins/manager/plugin_watcher.hpp"
 #include "../../simulators/back_test/back_test_engine.hpp"
+#include "../../simulators/back_test/checkpoint.hpp"
+#include "../../simulators/back_test/event_log.hpp"
 #include "../../simulators/monte_carlo/monte_carlo_engine.hpp"
+#include "../../utils/profiler.hpp"
 #include "../../utils/thread_pool.hpp"
 #include "../stores/data_store.hpp"
 #include "../stores/report_store.hpp"
@@ -29,11 +38,22 @@ namespace forge {
         return *this;
     }
 
+    ForgeEngineBuilder& ForgeEngineBuilder::with_bar_cache(std::shared_ptr<http::stock_api::BarCache> bar_cache) {
+        forge_engine_->set_bar_cache(std::move(bar_cache));
+        return *this;
+    }
+
     ForgeEngineBuilder& ForgeEngineBuilder::with_plugin_names(const std::vector<std::string>& plugin_names) {
         plugin_names_ = plugin_names;
         return *this;
     }
 
+    ForgeEngineBuilder& ForgeEngineBuilder::with_plugin_instances(const std::string& plugin_name,
+                                                                  const std::vector<plugins::loaders::PluginInstanceOptions>& instances) {
+        plugin_instances_[plugin_name] = instances;
+        return *this;
+    }
+
     ForgeEngineBuilder& ForgeEngineBuilder::with_thread_pools(const ThreadPoolOptions& thread_pool_options) {
         forge_engine_->set_thread_pools(thread_pool_options);
         return *this;
@@ -44,11 +64,28 @@ namespace forge {
         return *this;
     }
 
+    ForgeEngineBuilder& ForgeEngineBuilder::with_event_log_options(const EventLogOptions& event_log_options) {
+        forge_engine_->set_event_log_options(event_log_options);
+        return *this;
+    }
+
+    ForgeEngineBuilder& ForgeEngineBuilder::with_checkpoint_options(const CheckpointOptions& checkpoint_options) {
+        forge_engine_->set_checkpoint_options(checkpoint_options);
+        return *this;
+    }
+
+    ForgeEngineBuilder& ForgeEngineBuilder::with_streaming_options(const StreamingOptions& streaming_options) {
+        forge_engine_->set_streaming_options(streaming_options);
+        return *this;
+    }
+
     ForgeEngineBuilder& ForgeEngineBuilder::validate() {
-        if (data_provider_ == nullptr) {
+        // Replayed event logs carry their own bars, so nothing is fetched.
+        const bool is_replaying_event_logs = !forge_engine_->get_event_log_options().replay_dir_.empty();
+        if (forge_engine_->get_data_provider() == nullptr && !is_replaying_event_logs) {
             throw std::runtime_error("Data provider is required");
         }
-        if (forge_engine_->get_http_client_factory() == nullptr) {
+        if (forge_engine_->get_http_client_factory() == nullptr && !is_replaying_event_logs) {
             throw std::runtime_error("HTTP client is required");
         }
         if (plugin_names_.empty()) {
@@ -67,6 +104,8 @@ namespace forge {
         forge_engine_->set_plugin_manager(std::make_unique<plugins::manager::PluginManager>(plugin_names_));
         forge_engine_->set_data_store(std::make_unique<DataStore>());
         forge_engine_->set_report_store(std::make_unique<ReportStore>());
+        forge_engine_->set_aggregate_bars_flight(std::make_shared<http::stock_api::AggregateBarsFlight>());
+        forge_engine_->set_plugin_instances(std::move(plugin_instances_));
         return std::move(forge_engine_);
     };
 
@@ -92,80 +131,290 @@ namespace forge {
         http_client_factory_ = std::move(http_client_factory);
     }
 
+    void ForgeEngine::set_bar_cache(std::shared_ptr<http::stock_api::BarCache> bar_cache) { bar_cache_ = std::move(bar_cache); }
+
+    void ForgeEngine::set_aggregate_bars_flight(std::shared_ptr<http::stock_api::AggregateBarsFlight> aggregate_bars_flight) {
+        aggregate_bars_flight_ = std::move(aggregate_bars_flight);
+    }
+
+    void ForgeEngine::set_plugin_instances(std::unordered_map<std::string, std::vector<plugins::loaders::PluginInstanceOptions>> plugin_instances) {
+        plugin_instances_ = std::move(plugin_instances);
+    }
+
+    void ForgeEngine::set_event_log_options(const EventLogOptions& event_log_options) { event_log_options_ = event_log_options; }
+
+    void ForgeEngine::set_checkpoint_options(const CheckpointOptions& checkpoint_options) { checkpoint_options_ = checkpoint_options; }
+
+    void ForgeEngine::set_streaming_options(const StreamingOptions& streaming_options) { streaming_options_ = streaming_options; }
+
     const std::function<std::unique_ptr<http::client::IHttpClient>()>& ForgeEngine::get_http_client_factory() const { return http_client_factory_; }
 
     const ThreadPoolOptions& ForgeEngine::get_thread_pool_options() const { return thread_pool_options_; }
 
+    const EventLogOptions& ForgeEngine::get_event_log_options() const { return event_log_options_; }
+
+    const CheckpointOptions& ForgeEngine::get_checkpoint_options() const { return checkpoint_options_; }
+
+    const StreamingOptions& ForgeEngine::get_streaming_options() const { return streaming_options_; }
+
+    const http::stock_api::IStockDataProvider* ForgeEngine::get_data_provider() const { return data_provider_.get(); }
+
     void ForgeEngine::initialize(const InitializationOptions& initialization_options) const {
         if (initialization_options.loader_ == "directory") {
-            plugin_manager_->load_plugins_from_dir(initialization_options.root_path_);
+            concurrency::ThreadPool pool(thread_pool_options_.io_threads_);
+            plugin_manager_->load_plugins_from_dir(initialization_options.root_path_, pool);
         } else {
             // In the future we could have other loader types...
             throw std::runtime_error("Invalid loader type");
         }
+
+        for (const auto& [plugin_name, instances] : plugin_instances_) {
+            plugin_manager_->create_plugin_instances(plugin_name, instances);
+        }
+
+        if (!checkpoint_options_.dir_.empty()) {
+            discard_stale_checkpoints();
+        }
+
+        plugin_manager_->with_plugins([&](auto* plugin_ptr) { report_store_->add_plugin(plugin_ptr->get_plugin_name()); });
+        report_store_->subscribe([renderer = renderer_.get()](const ReportEvent& event) {
+            if (event.back_test_report_ != nullptr) {
+                renderer->render_back_test_report(*event.back_test_report_);
+            }
+            if (event.monte_carlo_report_ != nullptr) {
+                renderer->render_monte_carlo_report(*event.monte_carlo_report_);
+            }
+        });
     }
 
     void ForgeEngine::fetch_data() const {
         concurrency::ThreadPool pool(thread_pool_options_.io_threads_);
 
         plugin_manager_->with_plugins([&](auto* plugin_ptr) {
-            auto host_params = plugin_ptr->get_host_params();
+            if (is_back_test_completed(plugin_ptr->get_plugin_name())) {
+                return;
+            }
+
+            fetch_plugin_data(plugin_ptr, pool);
+        });
+
+        pool.wait_all();
+    }
 
-            auto* data_store_ptr = data_store_.get();
-            auto* data_provider_ptr = data_provider_.get();
+    void ForgeEngine::fetch_plugin_data(const plugins::loaders::IPluginLoader* plugin_ptr, concurrency::ThreadPool& pool) const {
+        auto host_params = plugin_ptr->get_host_params();
 
-            for (const auto& symbol : host_params.symbols_) {
-                pool.enqueue([data_store_ptr, plugin_ptr, data_provider_ptr, symbol, host_params, this]() {
-                    auto http_client = http_client_factory_();
+        auto* data_store_ptr = data_store_.get();
+        auto* data_provider_ptr = data_provider_.get();
 
-                    auto stock_api = std::make_unique<http::stock_api::StockAPI>(data_provider_ptr, std::move(http_client));
+        for (const auto& symbol : host_params.symbols_) {
+            pool.enqueue([data_store_ptr, plugin_ptr, data_provider_ptr, symbol, host_params, this]() {
+                PROFILE_PLUGIN(plugin_ptr->get_plugin_name());
+                PROFILE_SCOPE("fetch_symbol");
 
-                    auto bars = stock_api->custom_aggregate_bars(http::stock_api::AggregateBarsArgs{
-                        .symbol_ = symbol.symbol_,
-                        .timespan_unit_ = symbol.timespan_unit_,
-                        .timespan_ = symbol.timespan_,
-                        .from_ = host_params.backtest_start_datetime_,
-                        .to_ = host_params.backtest_end_datetime_,
-                    });
+                auto http_client = http_client_factory_();
 
-                    data_store_ptr->store_bars_by_plugin_name(plugin_ptr->get_plugin_name(), symbol.symbol_, bars);
+                auto stock_api = std::make_unique<http::stock_api::StockAPI>(data_provider_ptr, std::move(http_client), bar_cache_, aggregate_bars_flight_);
+
+                auto bars = stock_api->custom_aggregate_bars(http::stock_api::AggregateBarsArgs{
+                    .symbol_ = symbol.symbol_,
+                    .timespan_unit_ = symbol.timespan_unit_,
+                    .timespan_ = symbol.timespan_,
+                    .from_ = host_params.backtest_start_datetime_,
+                    .to_ = host_params.backtest_end_datetime_,
                 });
-            }
-        });
 
-        pool.wait_all();
+                data_store_ptr->store_bars_by_plugin_name(plugin_ptr->get_plugin_name(), symbol.symbol_, std::move(bars));
+            });
+        }
     }
 
     void ForgeEngine::run() const {
         concurrency::ThreadPool pool(thread_pool_options_.compute_threads_);
 
         // Goal: Embarrassingly parallelize
+        size_t plugin_count = 0;
         plugin_manager_->with_plugins([&](auto* plugin_ptr) {
-            auto* data_store_ptr = data_store_.get();
-            auto* report_store_ptr = report_store_.get();
+            pool.enqueue([plugin_ptr, this]() { run_plugin(plugin_ptr); });
+            plugin_count++;
+        });
 
-            pool.enqueue([plugin_ptr, data_store_ptr, report_store_ptr]() {
-                std::string plugin_name = plugin_ptr->get_plugin_name();
+        render_as_finished(plugin_count);
+        pool.wait_all();
+    }
 
-                if (!data_store_ptr->has_plugin_data(plugin_name)) {
-                    throw std::runtime_error("Plugin data not found, exiting simulation...");
-                }
+    // A failing plugin, including one whose worker process crashed, is recorded and skipped; the others keep running.
+    void ForgeEngine::run_plugin(const plugins::loaders::IPluginLoader* plugin_ptr) const {
+        std::string plugin_name = plugin_ptr->get_plugin_name();
+        PROFILE_PLUGIN(plugin_name);
 
-                simulators::BackTestEngine back_test_engine(plugin_ptr, data_store_ptr);
-                back_test_engine.run();
-                report_store_ptr->store_back_test_report(plugin_name, back_test_engine.get_report());
+        try {
+            auto back_test_report = std::make_shared<const simulators::BackTestReport>(run_back_test(plugin_ptr));
+            report_store_->store_back_test_report(plugin_name, back_test_report);
 
-                simulators::MonteCarloEngine monte_carlo_engine(plugin_ptr, data_store_ptr);
-                monte_carlo_engine.run();
-                report_store_ptr->store_monte_carlo_report(plugin_name, monte_carlo_engine.get_report());
+            simulators::MonteCarloEngine monte_carlo_engine(plugin_ptr, data_store_.get());
+            {
+                PROFILE_SCOPE("monte_carlo");
+                monte_carlo_engine.run(*back_test_report);
+            }
+            report_store_->store_monte_carlo_report(plugin_name, std::make_shared<const simulators::MonteCarloReport>(monte_carlo_engine.get_report()));
+        } catch (const std::exception& e) {
+            report_store_->store_plugin_failure(plugin_name, e.what());
+        }
+
+        report_store_->finish_plugin(plugin_name);
+    }
+
+    // Renders on the calling thread while the pool runs, so renderers see one report at a time, as soon as it is published.
+    void ForgeEngine::render_as_finished(size_t plugin_count) const {
+        size_t finished_count = 0;
+        while (finished_count < plugin_count) {
+            const uint64_t seen_count = report_store_->get_event_count();
+            finished_count += report_store_->dispatch_events();
+            if (finished_count < plugin_count) {
+                report_store_->wait_for_events(seen_count);
+            }
+        }
+    }
+
+    simulators::BackTestReport ForgeEngine::run_back_test(const plugins::loaders::IPluginLoader* plugin_ptr) const {
+        const std::string plugin_name = plugin_ptr->get_plugin_name();
+        const std::string event_log_name = plugin_name + ".events";
+        simulators::BackTestEngine back_test_engine(plugin_ptr, data_store_.get());
+
+        if (!streaming_options_.dir_.empty()) {
+            const std::filesystem::path streaming_dir(streaming_options_.dir_);
+            std::filesystem::create_directories(streaming_dir);
+            back_test_engine.set_streaming_options(simulators::StreamingOptions{
+                .fill_journal_path_ = streaming_dir / (plugin_name + ".fills"),
+                .equity_journal_path_ = streaming_dir / (plugin_name + ".equity"),
+                .equity_window_ = streaming_options_.equity_window_,
+                .equity_stride_ = streaming_options_.equity_stride_,
             });
-        });
+        }
 
-        pool.wait_all();
+        if (!event_log_options_.replay_dir_.empty()) {
+            const auto event_log = simulators::EventLog::load(std::filesystem::path(event_log_options_.replay_dir_) / event_log_name);
+            {
+                PROFILE_SCOPE("back_test");
+                back_test_engine.run_from_event_log(event_log, plugin_ptr->get_host_params());
+            }
+            return back_test_engine.get_report();
+        }
+
+        if (is_back_test_completed(plugin_name)) {
+            return simulators::checkpoint::load_report(get_checkpoint_path(plugin_name, ".done"));
+        }
+
+        if (!data_store_->has_plugin_data(plugin_name)) {
+            throw std::runtime_error("Plugin data not found, exiting simulation...");
+        }
+
+        simulators::EventLog event_log;
+        if (!event_log_options_.record_dir_.empty()) {
+            back_test_engine.set_event_log(&event_log);
+        }
+
+        if (!checkpoint_options_.dir_.empty()) {
+            std::filesystem::create_directories(checkpoint_options_.dir_);
+            back_test_engine.set_checkpoint_options(simulators::CheckpointOptions{
+                .path_ = get_checkpoint_path(plugin_name, ".checkpoint"),
+                .interval_bars_ = checkpoint_options_.interval_bars_,
+                .fingerprint_ = plugin_manager_->get_plugin_fingerprint(plugin_name),
+            });
+        }
+
+        {
+            PROFILE_SCOPE("back_test");
+            back_test_engine.run();
+        }
+
+        if (!checkpoint_options_.dir_.empty()) {
+            simulators::checkpoint::save_report(get_checkpoint_path(plugin_name, ".done"), plugin_manager_->get_plugin_fingerprint(plugin_name),
+                                                back_test_engine.get_report());
+        }
+
+        if (!event_log_options_.record_dir_.empty()) {
+            std::filesystem::create_directories(event_log_options_.record_dir_);
+            event_log.save(std::filesystem::path(event_log_options_.record_dir_) / event_log_name);
+        }
+
+        return back_test_engine.get_report();
     }
 
-    void ForgeEngine::report() const {
-        renderer_->render_back_test_report(report_store_->get_back_test_reports());
-        renderer_->render_monte_carlo_report(report_store_->get_monte_carlo_reports());
+    std::filesystem::path ForgeEngine::get_checkpoint_path(const std::string& plugin_name, const char* extension) const {
+        return std::filesystem::path(checkpoint_options_.dir_) / (plugin_name + extension);
     }
+
+    bool ForgeEngine::is_back_test_completed(const std::string& plugin_name) const {
+        return !checkpoint_options_.dir_.empty() && std::filesystem::exists(get_checkpoint_path(plugin_name, ".done"));
+    }
+
+    // A checkpoint or report left by another build or configuration of the plugin describes a different run, so it is
+    // removed and the plugin runs from the start.
+    void ForgeEngine::discard_stale_checkpoints() const {
+        plugin_manager_->with_plugins([&](auto* plugin_ptr) {
+            const std::string plugin_name = plugin_ptr->get_plugin_name();
+            const uint64_t fingerprint = plugin_manager_->get_plugin_fingerprint(plugin_name);
+            for (const char* extension : {".done", ".checkpoint"}) {
+                const auto path = get_checkpoint_path(plugin_name, extension);
+                if (simulators::checkpoint::read_fingerprint(path) != fingerprint) {
+                    std::filesystem::remove(path);
+                }
+            }
+        });
+    }
+
+    // Bars stay resident in the data store, so a rebuilt plugin is back in a backtest as soon as it is reopened.
+    void ForgeEngine::watch() const {
+        plugins::manager::PluginWatcher watcher;
+        plugin_manager_->watch_plugins(watcher);
+
+        while (true) {
+            std::vector<std::string> rerun_names;
+
+            for (const auto& plugin_name : watcher.wait_for_changes()) {
+                try {
+                    const auto reloaded_names = plugin_manager_->reload_plugin(plugin_name);
+                    rerun_names.insert(rerun_names.end(), reloaded_names.begin(), reloaded_names.end());
+                } catch (const std::exception& e) {
+                    report_store_->clear_plugin_failures(plugin_name);
+                    report_store_->store_plugin_failure(plugin_name, std::string("Reload failed: ") + e.what());
+                }
+            }
+
+            concurrency::ThreadPool pool(thread_pool_options_.compute_threads_);
+            for (const auto& plugin_name : rerun_names) {
+                report_store_->clear_plugin_failures(plugin_name);
+                // A rebuilt plugin is a new run, not the completed or interrupted one its checkpoints describe.
+                if (!checkpoint_options_.dir_.empty()) {
+                    std::filesystem::remove(get_checkpoint_path(plugin_name, ".done"));
+                    std::filesystem::remove(get_checkpoint_path(plugin_name, ".checkpoint"));
+                }
+                report_store_->add_plugin(plugin_name);
+            }
+            // A plugin that was already complete at startup had nothing fetched, and its checkpoints are gone now.
+            if (event_log_options_.replay_dir_.empty()) {
+                concurrency::ThreadPool io_pool(thread_pool_options_.io_threads_);
+                for (const auto& plugin_name : rerun_names) {
+                    if (!data_store_->has_plugin_data(plugin_name)) {
+                        fetch_plugin_data(plugin_manager_->get_plugin(plugin_name), io_pool);
+                    }
+                }
+                io_pool.wait_all();
+            }
+
+            // Every slot exists before the first rerun starts, since runs look slots up without a lock.
+            for (const auto& plugin_name : rerun_names) {
+                const auto* plugin_ptr = plugin_manager_->get_plugin(plugin_name);
+                pool.enqueue([plugin_ptr, this]() { run_plugin(plugin_ptr); });
+            }
+            render_as_finished(rerun_names.size());
+            pool.wait_all();
+
+            report();
+        }
+    }
+
+    void ForgeEngine::report() const { renderer_->render_plugin_failures(report_store_->get_plugin_failures()); }
 }  // namespace forge
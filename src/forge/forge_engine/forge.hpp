@@ -3,11 +3,17 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "../../http/api/bar_cache.hpp"
 #include "../../http/api/stock_api.hpp"
 #include "../../plugins/manager/plugin_manager.hpp"
 #include "../../renderers/interface.hpp"
+#include "../../utils/thread_pool.hpp"
 #include "../stores/data_store.hpp"
 #include "../stores/report_store.hpp"
 
@@ -22,6 +28,29 @@ namespace forge {
         unsigned int compute_threads_ = 2;
     };
 
+    // Back test event logs, one <plugin name>.events file per plugin. Replaying needs neither bars nor plugin calls.
+    struct EventLogOptions {
+        std::string record_dir_;
+        std::string replay_dir_;
+    };
+
+    // Back test checkpoints, one <plugin name>.checkpoint file per plugin saved every interval_bars_ bars, so an
+    // interrupted run of a plugin that can restore its state resumes where it stopped. A finished run leaves
+    // <plugin name>.done with its report, and later runs over the same directory skip it, fetching included. Both are
+    // discarded once the plugin's manifest, library or instance options change.
+    struct CheckpointOptions {
+        std::string dir_;
+        size_t interval_bars_ = 0;
+    };
+
+    // Streaming back tests, journaling each plugin's fills to <plugin name>.fills and its equity curve to
+    // <plugin name>.equity. Only open fills and the last equity_window_ snapshots stay in memory.
+    struct StreamingOptions {
+        std::string dir_;
+        size_t equity_window_ = 0;
+        size_t equity_stride_ = 1;
+    };
+
     class ForgeEngine {
        public:
         void set_stock_api(std::unique_ptr<http::stock_api::StockAPI> stock_api);
@@ -32,17 +61,34 @@ namespace forge {
         void set_renderer(std::unique_ptr<renderers::IRenderer> renderer);
         void set_data_provider(std::unique_ptr<http::stock_api::IStockDataProvider> data_provider);
         void set_http_client_factory(std::function<std::unique_ptr<http::client::IHttpClient>()> http_client_factory);
+        void set_bar_cache(std::shared_ptr<http::stock_api::BarCache> bar_cache);
+        void set_aggregate_bars_flight(std::shared_ptr<http::stock_api::AggregateBarsFlight> aggregate_bars_flight);
+        void set_plugin_instances(std::unordered_map<std::string, std::vector<plugins::loaders::PluginInstanceOptions>> plugin_instances);
+        void set_event_log_options(const EventLogOptions& event_log_options);
+        void set_checkpoint_options(const CheckpointOptions& checkpoint_options);
+        void set_streaming_options(const StreamingOptions& streaming_options);
 
         [[nodiscard]] const ThreadPoolOptions& get_thread_pool_options() const;
+        [[nodiscard]] const EventLogOptions& get_event_log_options() const;
+        [[nodiscard]] const CheckpointOptions& get_checkpoint_options() const;
+        [[nodiscard]] const StreamingOptions& get_streaming_options() const;
+        [[nodiscard]] const http::stock_api::IStockDataProvider* get_data_provider() const;
         [[nodiscard]] const std::function<std::unique_ptr<http::client::IHttpClient>()>& get_http_client_factory() const;
 
         void initialize(const InitializationOptions& initialization_options) const;
         void fetch_data() const;
+        // Reports are rendered as each plugin finishes, before run returns.
         void run() const;
+        // Renders the failures of the run.
         void report() const;
+        // Blocks, reloading native plugins whose library or manifest is rewritten and rerunning only those, then reporting.
+        [[noreturn]] void watch() const;
 
        private:
         ThreadPoolOptions thread_pool_options_;
+        EventLogOptions event_log_options_;
+        CheckpointOptions checkpoint_options_;
+        StreamingOptions streaming_options_;
         std::unique_ptr<plugins::manager::PluginManager> plugin_manager_;
         std::unique_ptr<http::stock_api::StockAPI> stock_api_;
         std::unique_ptr<forge::DataStore> data_store_;
@@ -50,6 +96,18 @@ namespace forge {
         std::unique_ptr<renderers::IRenderer> renderer_;
         std::unique_ptr<http::stock_api::IStockDataProvider> data_provider_;
         std::function<std::unique_ptr<http::client::IHttpClient>()> http_client_factory_;
+        std::shared_ptr<http::stock_api::BarCache> bar_cache_;
+        std::shared_ptr<http::stock_api::AggregateBarsFlight> aggregate_bars_flight_;
+        std::unordered_map<std::string, std::vector<plugins::loaders::PluginInstanceOptions>> plugin_instances_;
+
+        // Queues one fetch per symbol of the plugin; the caller waits on the pool.
+        void fetch_plugin_data(const plugins::loaders::IPluginLoader* plugin_ptr, concurrency::ThreadPool& pool) const;
+        void run_plugin(const plugins::loaders::IPluginLoader* plugin_ptr) const;
+        void render_as_finished(size_t plugin_count) const;
+        [[nodiscard]] simulators::BackTestReport run_back_test(const plugins::loaders::IPluginLoader* plugin_ptr) const;
+        [[nodiscard]] std::filesystem::path get_checkpoint_path(const std::string& plugin_name, const char* extension) const;
+        [[nodiscard]] bool is_back_test_completed(const std::string& plugin_name) const;
+        void discard_stale_checkpoints() const;
     };
 
     class ForgeEngineBuilder {
@@ -58,16 +116,21 @@ namespace forge {
 
         ForgeEngineBuilder& with_data_provider(std::unique_ptr<http::stock_api::IStockDataProvider> provider);
         ForgeEngineBuilder& with_http_client_factory(std::function<std::unique_ptr<http::client::IHttpClient>()> http_client_factory);
+        ForgeEngineBuilder& with_bar_cache(std::shared_ptr<http::stock_api::BarCache> bar_cache);
         ForgeEngineBuilder& with_thread_pools(const ThreadPoolOptions& thread_pool_options);
         ForgeEngineBuilder& with_plugin_names(const std::vector<std::string>& plugin_names);
+        ForgeEngineBuilder& with_plugin_instances(const std::string& plugin_name, const std::vector<plugins::loaders::PluginInstanceOptions>& instances);
         ForgeEngineBuilder& with_renderer(std::unique_ptr<renderers::IRenderer> renderer);
+        ForgeEngineBuilder& with_event_log_options(const EventLogOptions& event_log_options);
+        ForgeEngineBuilder& with_checkpoint_options(const CheckpointOptions& checkpoint_options);
+        ForgeEngineBuilder& with_streaming_options(const StreamingOptions& streaming_options);
         ForgeEngineBuilder& validate();
         std::unique_ptr<ForgeEngine> build();
 
        private:
         std::unique_ptr<ForgeEngine> forge_engine_;
-        std::unique_ptr<http::stock_api::IStockDataProvider> data_provider_;
         std::vector<std::string> plugin_names_;
+        std::unordered_map<std::string, std::vector<plugins::loaders::PluginInstanceOptions>> plugin_instances_;
     };
 
 }  // namespace forge
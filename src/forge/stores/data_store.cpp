@@ -1,43 +1,48 @@
 #include "data_store.hpp"
 
 #include <algorithm>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "../../http/api/stock_api.hpp"
 
 namespace forge {
-    void DataStore::store_bars_by_plugin_name(const std::string& plugin_name, const std::string& symbol, const http::stock_api::AggregateBars& bars) {
+    void DataStore::store_bars_by_plugin_name(const std::string& plugin_name, const std::string& symbol,
+                                              std::shared_ptr<const http::stock_api::AggregateBars> bars) {
         std::lock_guard<std::mutex> lock(mutex_);
 
         if (bars_.find(plugin_name) == bars_.end()) {
-            bars_[plugin_name] = std::unordered_map<std::string, http::stock_api::AggregateBars>();
+            bars_[plugin_name] = std::unordered_map<std::string, std::shared_ptr<const http::stock_api::AggregateBars>>();
         }
 
-        bars_[plugin_name][symbol] = bars;
+        bars_[plugin_name][symbol] = std::move(bars);
     }
 
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    std::optional<http::stock_api::AggregateBars> DataStore::get_bars(const std::string& plugin_name, const std::string& symbol) const {
+    std::shared_ptr<const http::stock_api::AggregateBars> DataStore::get_bars(const std::string& plugin_name, const std::string& symbol) const {
         std::lock_guard<std::mutex> lock(mutex_);
 
         auto plugin_it = bars_.find(plugin_name);
         if (plugin_it == bars_.end()) {
-            return std::nullopt;
+            return nullptr;
         }
 
         auto symbol_it = plugin_it->second.find(symbol);
         if (symbol_it == plugin_it->second.end()) {
-            return std::nullopt;
+            return nullptr;
         }
 
         return symbol_it->second;
     }
 
-    std::optional<std::unordered_map<std::string, http::stock_api::AggregateBars>> DataStore::get_all_bars_for_plugin(const std::string& plugin_name) const {
+    std::optional<std::unordered_map<std::string, std::shared_ptr<const http::stock_api::AggregateBars>>> DataStore::get_all_bars_for_plugin(
+        const std::string& plugin_name) const {
         std::lock_guard<std::mutex> lock(mutex_);
 
         auto it = bars_.find(plugin_name);
@@ -81,35 +86,38 @@ namespace forge {
 
     void DataStore::create_iterable_plugin_data(const std::string& plugin_name) const {
         std::lock_guard<std::mutex> lock(mutex_);
+        create_iterable_plugin_data_locked(plugin_name);
+    }
 
-        if (has_iterable_plugin_data(plugin_name)) {
-            return;
+    std::vector<http::stock_api::AggregateBarResult> DataStore::get_iterable_plugin_data(const std::string& plugin_name) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        create_iterable_plugin_data_locked(plugin_name);
+
+        const auto it = iterable_plugin_data_.find(plugin_name);
+        if (it == iterable_plugin_data_.end()) {
+            throw std::runtime_error("No bars stored for plugin " + plugin_name);
         }
+        return it->second;
+    }
 
-        auto bars = get_all_bars_for_plugin(plugin_name);
+    void DataStore::create_iterable_plugin_data_locked(const std::string& plugin_name) const {
+        if (iterable_plugin_data_.contains(plugin_name)) {
+            return;
+        }
 
-        if (!bars) {
+        const auto it = bars_.find(plugin_name);
+        if (it == bars_.end()) {
             return;
         }
 
         std::vector<http::stock_api::AggregateBarResult> iterable_bars;
 
-        for (const auto& [symbol, bars] : *bars) {
-            iterable_bars.insert(iterable_bars.end(), bars.results_.begin(), bars.results_.end());
+        for (const auto& [symbol, bars] : it->second) {
+            iterable_bars.insert(iterable_bars.end(), bars->results_.begin(), bars->results_.end());
         }
 
         std::sort(iterable_bars.begin(), iterable_bars.end(), [](const auto& a, const auto& b) { return a.unix_ts_ns_ < b.unix_ts_ns_; });
 
-        iterable_plugin_data_[plugin_name] = iterable_bars;
-    }
-
-    std::vector<http::stock_api::AggregateBarResult> DataStore::get_iterable_plugin_data(const std::string& plugin_name) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        if (!has_iterable_plugin_data(plugin_name)) {
-            create_iterable_plugin_data(plugin_name);
-        }
-
-        return iterable_plugin_data_.at(plugin_name);
+        iterable_plugin_data_[plugin_name] = std::move(iterable_bars);
     }
 }  // namespace forge
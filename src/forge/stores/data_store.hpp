@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -15,20 +16,25 @@ namespace forge {
 
     class DataStore {
        public:
-        void store_bars_by_plugin_name(const std::string& plugin_name, const std::string& symbol, const http::stock_api::AggregateBars& bars);
-        [[nodiscard]] std::optional<http::stock_api::AggregateBars> get_bars(const std::string& plugin_name, const std::string& symbol) const;
-        [[nodiscard]] std::optional<std::unordered_map<std::string, http::stock_api::AggregateBars>> get_all_bars_for_plugin(
+        // Bars are held shared and immutable, so plugins fetching the same request hold one copy between them.
+        void store_bars_by_plugin_name(const std::string& plugin_name, const std::string& symbol, std::shared_ptr<const http::stock_api::AggregateBars> bars);
+        [[nodiscard]] std::shared_ptr<const http::stock_api::AggregateBars> get_bars(const std::string& plugin_name, const std::string& symbol) const;
+        [[nodiscard]] std::optional<std::unordered_map<std::string, std::shared_ptr<const http::stock_api::AggregateBars>>> get_all_bars_for_plugin(
             const std::string& plugin_name) const;
         [[nodiscard]] std::vector<std::string> get_symbols_for_plugin(const std::string& plugin_name) const;
         [[nodiscard]] bool has_plugin_data(const std::string& plugin_name) const;
         void create_iterable_plugin_data(const std::string& plugin_name) const;
+        // Every bar of the plugin across its symbols, in time order, merged on the first call. Throws when it has none.
         [[nodiscard]] std::vector<http::stock_api::AggregateBarResult> get_iterable_plugin_data(const std::string& plugin_name) const;
         [[nodiscard]] bool has_iterable_plugin_data(const std::string& plugin_name) const;
         void clear();
 
        private:
+        // Callers hold mutex_. It is not recursive, so nothing here may call a public accessor.
+        void create_iterable_plugin_data_locked(const std::string& plugin_name) const;
+
         mutable std::mutex mutex_;
-        std::unordered_map<std::string, std::unordered_map<std::string, http::stock_api::AggregateBars>> bars_;
+        std::unordered_map<std::string, std::unordered_map<std::string, std::shared_ptr<const http::stock_api::AggregateBars>>> bars_;
         mutable std::unordered_map<std::string, std::vector<http::stock_api::AggregateBarResult>> iterable_plugin_data_;
     };
 }  // namespace forge
@@ -1,44 +1,137 @@
 #include "report_store.hpp"
 
+#include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "../../simulators/back_test/back_test_engine.hpp"
 #include "../../simulators/monte_carlo/monte_carlo_engine.hpp"
 
 namespace forge {
-    void ReportStore::store_back_test_report(const std::string& plugin_name, const simulators::BackTestReport& report) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    ReportStore::~ReportStore() {
+        EventNode* node = pending_events_.exchange(nullptr);
+        while (node != nullptr) {
+            std::unique_ptr<EventNode> owned(node);
+            node = owned->next_;
+        }
+    }
+
+    void ReportStore::add_plugin(const std::string& plugin_name) {
+        if (!slots_.contains(plugin_name)) {
+            slots_.emplace(plugin_name, std::make_unique<ReportSlot>());
+        }
+    }
+
+    void ReportStore::subscribe(ReportSubscriber subscriber) { subscribers_.push_back(std::move(subscriber)); }
 
-        back_test_reports_[plugin_name] = report;
+    void ReportStore::store_back_test_report(const std::string& plugin_name, std::shared_ptr<const simulators::BackTestReport> report) {
+        auto& slot = get_slot(plugin_name);
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex_);
+            slot.back_test_report_ = report;
+        }
+        publish(ReportEvent{
+            .kind_ = ReportEventKind::BACK_TEST_REPORT, .plugin_name_ = plugin_name, .back_test_report_ = std::move(report), .monte_carlo_report_ = nullptr});
     }
 
-    void ReportStore::store_monte_carlo_report(const std::string& plugin_name, const simulators::MonteCarloReport& report) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    void ReportStore::store_monte_carlo_report(const std::string& plugin_name, std::shared_ptr<const simulators::MonteCarloReport> report) {
+        auto& slot = get_slot(plugin_name);
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex_);
+            slot.monte_carlo_report_ = report;
+        }
+        publish(ReportEvent{
+            .kind_ = ReportEventKind::MONTE_CARLO_REPORT, .plugin_name_ = plugin_name, .back_test_report_ = nullptr, .monte_carlo_report_ = std::move(report)});
+    }
 
-        monte_carlo_reports_[plugin_name] = report;
+    void ReportStore::finish_plugin(const std::string& plugin_name) {
+        publish(
+            ReportEvent{.kind_ = ReportEventKind::PLUGIN_FINISHED, .plugin_name_ = plugin_name, .back_test_report_ = nullptr, .monte_carlo_report_ = nullptr});
     }
 
-    std::vector<simulators::BackTestReport> ReportStore::get_back_test_reports() const {
-        std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::shared_ptr<const simulators::BackTestReport>> ReportStore::get_back_test_reports() const {
+        std::vector<std::shared_ptr<const simulators::BackTestReport>> reports;
+        reports.reserve(slots_.size());
+        for (const auto& [plugin_name, slot] : slots_) {
+            std::lock_guard<std::mutex> lock(slot->mutex_);
+            if (slot->back_test_report_ != nullptr) {
+                reports.push_back(slot->back_test_report_);
+            }
+        }
+        return reports;
+    }
 
-        std::vector<simulators::BackTestReport> reports;
-        reports.reserve(back_test_reports_.size());
-        for (const auto& [plugin_name, report] : back_test_reports_) {
-            reports.emplace_back(report);
+    std::vector<std::shared_ptr<const simulators::MonteCarloReport>> ReportStore::get_monte_carlo_reports() const {
+        std::vector<std::shared_ptr<const simulators::MonteCarloReport>> reports;
+        reports.reserve(slots_.size());
+        for (const auto& [plugin_name, slot] : slots_) {
+            std::lock_guard<std::mutex> lock(slot->mutex_);
+            if (slot->monte_carlo_report_ != nullptr) {
+                reports.push_back(slot->monte_carlo_report_);
+            }
         }
         return reports;
     }
 
-    std::vector<simulators::MonteCarloReport> ReportStore::get_monte_carlo_reports() const {
-        std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t ReportStore::get_event_count() const { return event_count_.load(std::memory_order_acquire); }
 
-        std::vector<simulators::MonteCarloReport> reports;
-        reports.reserve(monte_carlo_reports_.size());
-        for (const auto& [plugin_name, report] : monte_carlo_reports_) {
-            reports.emplace_back(report);
+    void ReportStore::wait_for_events(uint64_t seen_count) const { event_count_.wait(seen_count, std::memory_order_acquire); }
+
+    size_t ReportStore::dispatch_events() {
+        std::vector<std::unique_ptr<EventNode>> events;
+        for (EventNode* node = pending_events_.exchange(nullptr, std::memory_order_acquire); node != nullptr; node = events.back()->next_) {
+            events.emplace_back(node);
         }
-        return reports;
+
+        size_t finished_count = 0;
+        for (auto it = events.rbegin(); it != events.rend(); ++it) {
+            const auto& event = (*it)->event_;
+            for (const auto& subscriber : subscribers_) {
+                subscriber(event);
+            }
+            if (event.kind_ == ReportEventKind::PLUGIN_FINISHED) {
+                finished_count++;
+            }
+        }
+        return finished_count;
+    }
+
+    void ReportStore::store_plugin_failure(const std::string& plugin_name, const std::string& message) {
+        std::lock_guard<std::mutex> lock(failures_mutex_);
+
+        plugin_failures_.emplace_back(plugin_name, message);
+    }
+
+    void ReportStore::clear_plugin_failures(const std::string& plugin_name) {
+        std::lock_guard<std::mutex> lock(failures_mutex_);
+
+        std::erase_if(plugin_failures_, [&plugin_name](const auto& failure) { return failure.first == plugin_name; });
+    }
+
+    std::vector<std::pair<std::string, std::string>> ReportStore::get_plugin_failures() const {
+        std::lock_guard<std::mutex> lock(failures_mutex_);
+
+        return plugin_failures_;
+    }
+
+    ReportStore::ReportSlot& ReportStore::get_slot(const std::string& plugin_name) const {
+        const auto it = slots_.find(plugin_name);
+        if (it == slots_.end()) {
+            throw std::runtime_error("No report slot for plugin " + plugin_name);
+        }
+        return *it->second;
+    }
+
+    void ReportStore::publish(ReportEvent event) {
+        // Owned by pending_events_ until dispatched.
+        auto* node = std::make_unique<EventNode>(EventNode{.event_ = std::move(event), .next_ = pending_events_.load(std::memory_order_relaxed)}).release();
+        while (!pending_events_.compare_exchange_weak(node->next_, node, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+
+        event_count_.fetch_add(1, std::memory_order_release);
+        event_count_.notify_all();
     }
 }  // namespace forge
@@ -3,8 +3,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "../../simulators/back_test/back_test_engine.hpp"
@@ -12,17 +18,85 @@
 
 namespace forge {
 
+    enum class ReportEventKind : uint8_t {
+        BACK_TEST_REPORT,
+        MONTE_CARLO_REPORT,
+        // Published once per run of a plugin, after its last report or failure.
+        PLUGIN_FINISHED,
+    };
+
+    // The report rides along with the event, so a subscriber never looks it up.
+    struct ReportEvent {
+        ReportEventKind kind_;
+        std::string plugin_name_;
+        std::shared_ptr<const simulators::BackTestReport> back_test_report_;
+        std::shared_ptr<const simulators::MonteCarloReport> monte_carlo_report_;
+    };
+
+    using ReportSubscriber = std::function<void(const ReportEvent&)>;
+
+    // Plugins publish immutable reports into their own slot and push an event for each, without a lock shared across
+    // plugins; reports are handed around by shared_ptr and never copied. Events reach subscribers on whichever thread
+    // calls dispatch_events, in the order they were published.
     class ReportStore {
        public:
-        void store_back_test_report(const std::string& plugin_name, const simulators::BackTestReport& report);
-        void store_monte_carlo_report(const std::string& plugin_name, const simulators::MonteCarloReport& report);
-        [[nodiscard]] std::vector<simulators::BackTestReport> get_back_test_reports() const;
-        [[nodiscard]] std::vector<simulators::MonteCarloReport> get_monte_carlo_reports() const;
+        ReportStore() = default;
+        ~ReportStore();
+
+        ReportStore(const ReportStore&) = delete;
+        ReportStore& operator=(const ReportStore&) = delete;
+        ReportStore(ReportStore&&) = delete;
+        ReportStore& operator=(ReportStore&&) = delete;
+
+        // Slots and subscribers are added while no plugin runs; adding a slot that exists is a no-op.
+        void add_plugin(const std::string& plugin_name);
+        void subscribe(ReportSubscriber subscriber);
+
+        void store_back_test_report(const std::string& plugin_name, std::shared_ptr<const simulators::BackTestReport> report);
+        void store_monte_carlo_report(const std::string& plugin_name, std::shared_ptr<const simulators::MonteCarloReport> report);
+        void finish_plugin(const std::string& plugin_name);
+        // The latest report of every plugin that has one.
+        [[nodiscard]] std::vector<std::shared_ptr<const simulators::BackTestReport>> get_back_test_reports() const;
+        [[nodiscard]] std::vector<std::shared_ptr<const simulators::MonteCarloReport>> get_monte_carlo_reports() const;
+
+        // Events published so far. wait_for_events blocks until that moves past seen_count.
+        [[nodiscard]] uint64_t get_event_count() const;
+        void wait_for_events(uint64_t seen_count) const;
+        // Hands every pending event to the subscribers; returns how many were PLUGIN_FINISHED.
+        size_t dispatch_events();
+
+        // A plugin that failed mid run keeps whatever reports it stored before failing.
+        void store_plugin_failure(const std::string& plugin_name, const std::string& message);
+        // Used before a plugin is run again, so only failures of its latest run are reported.
+        void clear_plugin_failures(const std::string& plugin_name);
+        // Pairs of plugin name and failure message, in the order the failures happened.
+        [[nodiscard]] std::vector<std::pair<std::string, std::string>> get_plugin_failures() const;
 
        private:
-        std::unordered_map<std::string, simulators::BackTestReport> back_test_reports_;
-        std::unordered_map<std::string, simulators::MonteCarloReport> monte_carlo_reports_;
-        mutable std::mutex mutex_;
+        // Each slot has its own lock, held only to swap a pointer, so plugins never wait on one another. Not
+        // std::atomic<std::shared_ptr>, which libc++ lacks.
+        struct ReportSlot {
+            std::shared_ptr<const simulators::BackTestReport> back_test_report_;
+            std::shared_ptr<const simulators::MonteCarloReport> monte_carlo_report_;
+            mutable std::mutex mutex_;
+        };
+
+        struct EventNode {
+            ReportEvent event_;
+            EventNode* next_ = nullptr;
+        };
+
+        std::unordered_map<std::string, std::unique_ptr<ReportSlot>> slots_;
+        std::vector<ReportSubscriber> subscribers_;
+        // Newest first; dispatch_events takes the whole list at once, so pushes never race a pop of the same node.
+        std::atomic<EventNode*> pending_events_ = nullptr;
+        std::atomic<uint64_t> event_count_ = 0;
+
+        std::vector<std::pair<std::string, std::string>> plugin_failures_;
+        mutable std::mutex failures_mutex_;
+
+        [[nodiscard]] ReportSlot& get_slot(const std::string& plugin_name) const;
+        void publish(ReportEvent event);
     };
 }  // namespace forge
 
@@ -0,0 +1,380 @@
+#include "bar_cache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../utils/constants.hpp"
+#include "../../utils/time_utils.hpp"
+#include "stock_api.hpp"
+
+static constexpr const char* SEGMENT_FILE_EXT = ".bars";
+static constexpr int DAYS_PER_QUARTER = 92;
+static constexpr int DAYS_PER_LEAP_YEAR = 366;
+// One row across every column of a segment, as encode writes them.
+static constexpr size_t SEGMENT_BYTES_PER_BAR = sizeof(int64_t) + (6 * sizeof(double)) + sizeof(int32_t) + sizeof(uint8_t);
+
+namespace http::stock_api {
+    namespace bar_codec {
+        template <typename T, typename Fn>
+        static void append_column(std::string& out, const std::vector<AggregateBarResult>& bars, Fn&& field) {
+            for (const auto& bar : bars) {
+                const T value = field(bar);
+                out.append(reinterpret_cast<const char*>(&value), sizeof(T));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            }
+        }
+
+        template <typename T, typename Fn>
+        static void read_column(std::string_view bytes, size_t& offset, std::vector<AggregateBarResult>& bars, Fn&& assign) {
+            if (offset + (sizeof(T) * bars.size()) > bytes.size()) {
+                throw std::runtime_error("Truncated bar segment");
+            }
+            for (auto& bar : bars) {
+                T value{};
+                std::memcpy(&value, bytes.data() + offset, sizeof(T));
+                assign(bar, value);
+                offset += sizeof(T);
+            }
+        }
+
+        std::string encode(const std::vector<AggregateBarResult>& bars) {
+            std::string out;
+            const uint64_t count = bars.size();
+            out.reserve(MAGIC.size() + sizeof(count) + (count * SEGMENT_BYTES_PER_BAR));
+
+            out.append(MAGIC);
+            out.append(reinterpret_cast<const char*>(&count), sizeof(count));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+            append_column<int64_t>(out, bars, [](const auto& bar) { return static_cast<int64_t>(bar.unix_ts_ns_); });
+            append_column<double>(out, bars, [](const auto& bar) { return bar.open_; });
+            append_column<double>(out, bars, [](const auto& bar) { return bar.high_; });
+            append_column<double>(out, bars, [](const auto& bar) { return bar.low_; });
+            append_column<double>(out, bars, [](const auto& bar) { return bar.close_; });
+            append_column<double>(out, bars, [](const auto& bar) { return bar.volume_; });
+            append_column<double>(out, bars, [](const auto& bar) { return bar.volume_weighted_price_; });
+            append_column<int32_t>(out, bars, [](const auto& bar) { return static_cast<int32_t>(bar.tx_count_); });
+            append_column<uint8_t>(out, bars, [](const auto& bar) { return static_cast<uint8_t>(bar.is_otc_ ? 1 : 0); });
+
+            return out;
+        }
+
+        std::vector<AggregateBarResult> decode(std::string_view bytes, const std::string& symbol) {
+            if (bytes.size() < MAGIC.size() + sizeof(uint64_t) || bytes.substr(0, MAGIC.size()) != MAGIC) {
+                throw std::runtime_error("Invalid bar segment header");
+            }
+
+            uint64_t count = 0;
+            std::memcpy(&count, bytes.data() + MAGIC.size(), sizeof(count));
+            size_t offset = MAGIC.size() + sizeof(count);
+
+            // Checked before allocating, so a corrupt count cannot ask for more bars than the file could hold.
+            if (count > (bytes.size() - offset) / SEGMENT_BYTES_PER_BAR) {
+                throw std::runtime_error("Truncated bar segment");
+            }
+
+            std::vector<AggregateBarResult> bars(count);
+            for (auto& bar : bars) {
+                bar.symbol_ = symbol;
+            }
+
+            read_column<int64_t>(bytes, offset, bars, [](auto& bar, int64_t v) { bar.unix_ts_ns_ = v; });
+            read_column<double>(bytes, offset, bars, [](auto& bar, double v) { bar.open_ = v; });
+            read_column<double>(bytes, offset, bars, [](auto& bar, double v) { bar.high_ = v; });
+            read_column<double>(bytes, offset, bars, [](auto& bar, double v) { bar.low_ = v; });
+            read_column<double>(bytes, offset, bars, [](auto& bar, double v) { bar.close_ = v; });
+            read_column<double>(bytes, offset, bars, [](auto& bar, double v) { bar.volume_ = v; });
+            read_column<double>(bytes, offset, bars, [](auto& bar, double v) { bar.volume_weighted_price_ = v; });
+            read_column<int32_t>(bytes, offset, bars, [](auto& bar, int32_t v) { bar.tx_count_ = v; });
+            read_column<uint8_t>(bytes, offset, bars, [](auto& bar, uint8_t v) { bar.is_otc_ = v != 0; });
+
+            return bars;
+        }
+    }  // namespace bar_codec
+
+    BarCache::BarCache(std::unique_ptr<BarCachePolicy> policy) : policy_(std::move(policy)) {}
+
+    AggregateBars BarCache::get_or_fetch(const AggregateBarsArgs& args, const Fetcher& fetch) {
+        if (!policy_->enable_caching_) {
+            return fetch(args);
+        }
+
+        const int64_t from_ms = time_utils::parse_datetime_ms(args.from_);
+        const int64_t requested_to_ms = time_utils::parse_datetime_end_ms(args.to_);
+
+        const std::filesystem::path key_path = create_key_path(args);
+        const auto key_mutex = get_key_mutex(key_path.string());
+        std::lock_guard<std::mutex> lock(*key_mutex);
+
+        if (!policy_->is_replay_only_) {
+            std::filesystem::create_directories(key_path);
+        }
+        const std::vector<BarSegment> segments = list_segments(key_path);
+
+        // Bars that have not happened yet cannot be materialized, so coverage never extends past now. A replay stands at the
+        // moment the recording ended instead, so the same request resolves to the same gaps however much later it runs.
+        const int64_t to_ms = std::min(requested_to_ms, policy_->is_replay_only_ ? get_recorded_end_ms(segments) : time_utils::now_ms());
+
+        if (from_ms > to_ms) {
+            return fetch(args);
+        }
+
+        std::vector<TimeInterval> covered;
+        covered.reserve(segments.size());
+        for (const auto& segment : segments) {
+            covered.push_back(segment.interval_);
+        }
+
+        const std::vector<TimeInterval> gaps = find_gaps(covered, TimeInterval{.from_ms_ = from_ms, .to_ms_ = to_ms});
+
+        std::vector<AggregateBarResult> merged;
+        std::vector<BarSegment> absorbed;
+        std::vector<TimeInterval> coverage;
+
+        for (const auto& segment : segments) {
+            // Touching segments are absorbed as well, so contiguous coverage collapses into a single file.
+            if (segment.interval_.to_ms_ + 1 < from_ms || segment.interval_.from_ms_ > to_ms + 1) {
+                continue;
+            }
+
+            auto segment_bars = read_segment(segment, args.symbol_);
+            merged.insert(merged.end(), std::make_move_iterator(segment_bars.begin()), std::make_move_iterator(segment_bars.end()));
+            absorbed.push_back(segment);
+            coverage.push_back(segment.interval_);
+        }
+
+        // A bar starting after the cutoff may still be forming, so it is served but never recorded as covered.
+        const int64_t complete_to_ms = time_utils::now_ms() - get_bar_duration_ms(args);
+
+        bool adjusted = true;
+        bool is_truncated = false;
+        for (const auto& gap : gaps) {
+            AggregateBarsArgs gap_args = args;
+            gap_args.from_ = std::to_string(gap.from_ms_);
+            gap_args.to_ = std::to_string(gap.to_ms_);
+
+            AggregateBars fetched = fetch(gap_args);
+            adjusted = adjusted && fetched.adjusted_;
+            is_truncated = is_truncated || fetched.is_truncated_;
+
+            // A truncated response says nothing about the bars past its last one. A complete one vouches for the whole gap,
+            // including stretches without bars such as weekends, but only up to the cutoff past which bars may be forming.
+            if (!fetched.is_truncated_) {
+                const int64_t covered_to_ms = std::min(gap.to_ms_, complete_to_ms);
+                if (covered_to_ms >= gap.from_ms_) {
+                    coverage.push_back(TimeInterval{.from_ms_ = gap.from_ms_, .to_ms_ = covered_to_ms});
+                }
+            }
+
+            merged.insert(merged.end(), std::make_move_iterator(fetched.results_.begin()), std::make_move_iterator(fetched.results_.end()));
+        }
+
+        std::stable_sort(merged.begin(), merged.end(), [](const auto& a, const auto& b) { return a.unix_ts_ns_ < b.unix_ts_ns_; });
+        merged.erase(std::unique(merged.begin(), merged.end(), [](const auto& a, const auto& b) { return a.unix_ts_ns_ == b.unix_ts_ns_; }), merged.end());
+
+        if (!policy_->is_replay_only_ && (!gaps.empty() || absorbed.size() > 1)) {
+            write_coverage(key_path, merge_intervals(std::move(coverage)), absorbed, merged);
+        }
+
+        AggregateBars out{};
+        out.ticker_ = args.symbol_;
+        out.adjusted_ = adjusted;
+        out.is_truncated_ = is_truncated;
+        out.query_count_ = gaps.size();
+
+        const int64_t from_ns = from_ms * constants::NANOSECONDS_PER_MILLISECOND;
+        const int64_t to_ns = requested_to_ms * constants::NANOSECONDS_PER_MILLISECOND;
+
+        for (auto& bar : merged) {
+            if (bar.unix_ts_ns_ >= from_ns && bar.unix_ts_ns_ <= to_ns) {
+                out.results_.emplace_back(std::move(bar));
+            }
+        }
+        out.result_count_ = out.results_.size();
+
+        return out;
+    }
+
+    std::vector<TimeInterval> BarCache::find_gaps(std::vector<TimeInterval> covered, TimeInterval requested) {
+        std::sort(covered.begin(), covered.end(), [](const auto& a, const auto& b) { return a.from_ms_ < b.from_ms_; });
+
+        std::vector<TimeInterval> gaps;
+        int64_t cursor = requested.from_ms_;
+
+        for (const auto& interval : covered) {
+            if (cursor > requested.to_ms_) {
+                break;
+            }
+
+            if (interval.to_ms_ < cursor) {
+                continue;
+            }
+
+            if (interval.from_ms_ > cursor) {
+                gaps.push_back(TimeInterval{.from_ms_ = cursor, .to_ms_ = std::min(interval.from_ms_ - 1, requested.to_ms_)});
+            }
+
+            cursor = std::max(cursor, interval.to_ms_ + 1);
+        }
+
+        if (cursor <= requested.to_ms_) {
+            gaps.push_back(TimeInterval{.from_ms_ = cursor, .to_ms_ = requested.to_ms_});
+        }
+
+        return gaps;
+    }
+
+    std::vector<TimeInterval> BarCache::merge_intervals(std::vector<TimeInterval> intervals) {
+        std::sort(intervals.begin(), intervals.end(), [](const auto& a, const auto& b) { return a.from_ms_ < b.from_ms_; });
+
+        std::vector<TimeInterval> merged;
+        for (const auto& interval : intervals) {
+            if (!merged.empty() && interval.from_ms_ <= merged.back().to_ms_ + 1) {
+                merged.back().to_ms_ = std::max(merged.back().to_ms_, interval.to_ms_);
+            } else {
+                merged.push_back(interval);
+            }
+        }
+
+        return merged;
+    }
+
+    int64_t BarCache::get_bar_duration_ms(const AggregateBarsArgs& args) {
+        using namespace std::chrono;
+
+        // Calendar units take their longest length, so a bar is never taken for complete early.
+        static const std::unordered_map<std::string, milliseconds> unit_durations = {
+            {"second", seconds{1}}, {"minute", minutes{1}}, {"hour", hours{1}},           {"day", days{1}},
+            {"week", weeks{1}},     {"month", days{31}},    {"quarter", days{DAYS_PER_QUARTER}}, {"year", days{DAYS_PER_LEAP_YEAR}},
+        };
+
+        const auto it = unit_durations.find(args.timespan_unit_);
+        if (it == unit_durations.end()) {
+            throw std::runtime_error("Unknown timespan unit: " + args.timespan_unit_);
+        }
+
+        return args.timespan_ * it->second.count();
+    }
+
+    std::shared_ptr<std::mutex> BarCache::get_key_mutex(const std::string& key) {
+        std::lock_guard<std::mutex> lock(key_mutexes_mutex_);
+
+        auto& key_mutex = key_mutexes_[key];
+        if (key_mutex == nullptr) {
+            key_mutex = std::make_shared<std::mutex>();
+        }
+
+        return key_mutex;
+    }
+
+    std::filesystem::path BarCache::create_key_path(const AggregateBarsArgs& args) const {
+        return policy_->root_ / args.symbol_ / (std::to_string(args.timespan_) + "_" + args.timespan_unit_);
+    }
+
+    int64_t BarCache::get_recorded_end_ms(const std::vector<BarSegment>& segments) {
+        if (segments.empty()) {
+            return std::numeric_limits<int64_t>::max();
+        }
+
+        return std::ranges::max(segments, {}, [](const auto& segment) { return segment.interval_.to_ms_; }).interval_.to_ms_;
+    }
+
+    std::vector<BarSegment> BarCache::list_segments(const std::filesystem::path& key_path) {
+        std::vector<BarSegment> segments;
+
+        if (!std::filesystem::is_directory(key_path)) {
+            return segments;
+        }
+
+        for (const auto& entry : std::filesystem::directory_iterator{key_path}) {
+            if (!entry.is_regular_file() || entry.path().extension() != SEGMENT_FILE_EXT) {
+                continue;
+            }
+
+            long long from_ms = 0;
+            long long to_ms = 0;
+
+            // NOLINTNEXTLINE(cert-err34-c)
+            if (std::sscanf(entry.path().stem().string().c_str(), "%lld_%lld", &from_ms, &to_ms) != 2 || from_ms > to_ms) {
+                continue;
+            }
+
+            segments.push_back(BarSegment{.interval_ = TimeInterval{.from_ms_ = from_ms, .to_ms_ = to_ms}, .path_ = entry.path()});
+        }
+
+        return segments;
+    }
+
+    std::vector<AggregateBarResult> BarCache::read_segment(const BarSegment& segment, const std::string& symbol) {
+        std::ifstream in(segment.path_, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("open failed: " + segment.path_.string());
+        }
+
+        std::string bytes;
+        in.seekg(0, std::ios::end);
+        bytes.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0, std::ios::beg);
+        in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+        return bar_codec::decode(bytes, symbol);
+    }
+
+    void BarCache::write_coverage(const std::filesystem::path& key_path, const std::vector<TimeInterval>& coverage, const std::vector<BarSegment>& absorbed,
+                                  const std::vector<AggregateBarResult>& bars) {
+        std::vector<std::filesystem::path> written;
+        written.reserve(coverage.size());
+
+        for (const auto& interval : coverage) {
+            const auto path = create_segment_path(key_path, interval);
+            written.push_back(path);
+            if (std::ranges::any_of(absorbed, [&path](const auto& segment) { return segment.path_ == path; })) {
+                continue;
+            }
+
+            // Bars outside the interval, such as one still forming, stay out of the segment so a later fetch replaces them.
+            const auto first = std::ranges::lower_bound(bars, interval.from_ms_ * constants::NANOSECONDS_PER_MILLISECOND, {}, &AggregateBarResult::unix_ts_ns_);
+            const auto last = std::ranges::upper_bound(bars, interval.to_ms_ * constants::NANOSECONDS_PER_MILLISECOND, {}, &AggregateBarResult::unix_ts_ns_);
+            write_segment(path, std::vector<AggregateBarResult>(first, last));
+        }
+
+        for (const auto& segment : absorbed) {
+            if (std::ranges::find(written, segment.path_) == written.end()) {
+                std::filesystem::remove(segment.path_);
+            }
+        }
+    }
+
+    std::filesystem::path BarCache::create_segment_path(const std::filesystem::path& key_path, TimeInterval interval) {
+        return key_path / (std::to_string(interval.from_ms_) + "_" + std::to_string(interval.to_ms_) + SEGMENT_FILE_EXT);
+    }
+
+    void BarCache::write_segment(const std::filesystem::path& path, const std::vector<AggregateBarResult>& bars) {
+        auto tmp = path;
+        tmp += ".tmp";
+
+        const std::string bytes = bar_codec::encode(bars);
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("open failed: " + tmp.string());
+            }
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            out.flush();
+            if (!out) {
+                throw std::runtime_error("write failed: " + tmp.string());
+            }
+        }
+        std::filesystem::rename(tmp, path);  // atomic on same filesystem
+    }
+}  // namespace http::stock_api
@@ -0,0 +1,84 @@
+#ifndef QUANT_FORGE_BAR_CACHE_HPP
+#define QUANT_FORGE_BAR_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "stock_api.hpp"
+
+namespace http::stock_api {
+
+    struct BarCachePolicy {
+        bool enable_caching_ = true;
+        std::filesystem::path root_ = "cache/bars";
+        // Serve a recorded cache directory as is: nothing is written, and the recording's end stands in for now, so only
+        // requests it never saw reach the fetcher.
+        bool is_replay_only_ = false;
+    };
+
+    // Inclusive on both ends, in unix milliseconds (the unit Polygon accepts for from/to).
+    struct TimeInterval {
+        int64_t from_ms_;
+        int64_t to_ms_;
+    };
+
+    struct BarSegment {
+        TimeInterval interval_;
+        std::filesystem::path path_;
+    };
+
+    // Columnar on-disk encoding of a bar series. Layout (little endian):
+    //   "QFBARS01" | uint64 count | int64 ts_ns[count] | double open/high/low/close/volume/vwap[count] | int32 tx_count[count] | uint8 otc[count]
+    namespace bar_codec {
+        inline constexpr std::string_view MAGIC = "QFBARS01";
+
+        [[nodiscard]] std::string encode(const std::vector<AggregateBarResult>& bars);
+        [[nodiscard]] std::vector<AggregateBarResult> decode(std::string_view bytes, const std::string& symbol);
+    }  // namespace bar_codec
+
+    // Per-symbol, per-timespan cache that remembers which time intervals have been materialized.
+    // A request is answered from the cached segments, and only the missing gaps go to the provider.
+    class BarCache {
+       public:
+        using Fetcher = std::function<AggregateBars(const AggregateBarsArgs&)>;
+
+        explicit BarCache(std::unique_ptr<BarCachePolicy> policy);
+
+        ~BarCache() = default;
+        BarCache(const BarCache&) = delete;
+        BarCache& operator=(const BarCache&) = delete;
+        BarCache(BarCache&&) = delete;
+        BarCache& operator=(BarCache&&) = delete;
+
+        [[nodiscard]] AggregateBars get_or_fetch(const AggregateBarsArgs& args, const Fetcher& fetch);
+
+        [[nodiscard]] static std::vector<TimeInterval> find_gaps(std::vector<TimeInterval> covered, TimeInterval requested);
+
+       private:
+        std::unique_ptr<BarCachePolicy> policy_;
+        std::mutex key_mutexes_mutex_;
+        std::unordered_map<std::string, std::shared_ptr<std::mutex>> key_mutexes_;
+
+        [[nodiscard]] std::shared_ptr<std::mutex> get_key_mutex(const std::string& key);
+        [[nodiscard]] std::filesystem::path create_key_path(const AggregateBarsArgs& args) const;
+
+        [[nodiscard]] static std::vector<TimeInterval> merge_intervals(std::vector<TimeInterval> intervals);
+        [[nodiscard]] static int64_t get_bar_duration_ms(const AggregateBarsArgs& args);
+        [[nodiscard]] static int64_t get_recorded_end_ms(const std::vector<BarSegment>& segments);
+        [[nodiscard]] static std::vector<BarSegment> list_segments(const std::filesystem::path& key_path);
+        [[nodiscard]] static std::vector<AggregateBarResult> read_segment(const BarSegment& segment, const std::string& symbol);
+        [[nodiscard]] static std::filesystem::path create_segment_path(const std::filesystem::path& key_path, TimeInterval interval);
+        static void write_coverage(const std::filesystem::path& key_path, const std::vector<TimeInterval>& coverage, const std::vector<BarSegment>& absorbed,
+                                   const std::vector<AggregateBarResult>& bars);
+        static void write_segment(const std::filesystem::path& path, const std::vector<AggregateBarResult>& bars);
+    };
+}  // namespace http::stock_api
+
+#endif
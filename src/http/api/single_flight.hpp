@@ -0,0 +1,67 @@
+#ifndef QUANT_FORGE_SINGLE_FLIGHT_HPP
+#define QUANT_FORGE_SINGLE_FLIGHT_HPP
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+
+namespace http::stock_api {
+
+    // Coalesces concurrent calls for the same key: the first caller runs the work, later callers block on its
+    // result (or its exception). The key is forgotten once the leader finishes, so this never acts as a cache.
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class SingleFlight {
+       public:
+        SingleFlight() = default;
+
+        ~SingleFlight() = default;
+        SingleFlight(const SingleFlight&) = delete;
+        SingleFlight& operator=(const SingleFlight&) = delete;
+        SingleFlight(SingleFlight&&) = delete;
+        SingleFlight& operator=(SingleFlight&&) = delete;
+
+        template <typename Fn>
+        Value run(const Key& key, Fn&& fn) {
+            std::promise<Value> promise;
+            std::shared_future<Value> future;
+            bool is_leader = false;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = in_flight_.find(key);
+                if (it != in_flight_.end()) {
+                    future = it->second;
+                } else {
+                    future = promise.get_future().share();
+                    in_flight_.emplace(key, future);
+                    is_leader = true;
+                }
+            }
+
+            if (!is_leader) {
+                return future.get();
+            }
+
+            try {
+                promise.set_value(std::forward<Fn>(fn)());
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                in_flight_.erase(key);
+            }
+
+            return future.get();
+        }
+
+       private:
+        std::mutex mutex_;
+        std::unordered_map<Key, std::shared_future<Value>, Hash> in_flight_;
+    };
+}  // namespace http::stock_api
+
+#endif
@@ -6,24 +6,56 @@
 
 #include <string>
 
+#include "../../utils/profiler.hpp"
 #include "../client/curl_easy.hpp"
 #include "../error/http_error.hpp"
 #include "../model/model.hpp"
+#include "bar_cache.hpp"
 
 const long HTTP_SUCCESS_UPPER_BOUNDARY = 300;
 
 namespace http::stock_api {
     StockAPI::StockAPI(const IStockDataProvider* p, std::unique_ptr<http::client::IHttpClient> ce) : provider_(p), http_(std::move(ce)) {}
 
-    AggregateBars StockAPI::custom_aggregate_bars(const AggregateBarsArgs& args) {
+    StockAPI::StockAPI(const IStockDataProvider* p, std::unique_ptr<http::client::IHttpClient> ce, std::shared_ptr<BarCache> bar_cache,
+                       std::shared_ptr<AggregateBarsFlight> aggregate_bars_flight)
+        : provider_(p), http_(std::move(ce)), bar_cache_(std::move(bar_cache)), aggregate_bars_flight_(std::move(aggregate_bars_flight)) {}
+
+    std::shared_ptr<const AggregateBars> StockAPI::custom_aggregate_bars(const AggregateBarsArgs& args) {
+        if (aggregate_bars_flight_ == nullptr) {
+            return std::make_shared<const AggregateBars>(load_custom_aggregate_bars(args));
+        }
+
+        // Identical concurrent requests (e.g. two plugins on the same symbol) share one fetch and one parse.
+        return aggregate_bars_flight_->run(create_flight_key(args),
+                                           [this, &args]() { return std::make_shared<const AggregateBars>(load_custom_aggregate_bars(args)); });
+    }
+
+    AggregateBars StockAPI::load_custom_aggregate_bars(const AggregateBarsArgs& args) {
+        if (bar_cache_ == nullptr) {
+            return fetch_custom_aggregate_bars(args);
+        }
+
+        return bar_cache_->get_or_fetch(args, [this](const AggregateBarsArgs& gap_args) { return fetch_custom_aggregate_bars(gap_args); });
+    }
+
+    AggregateBars StockAPI::fetch_custom_aggregate_bars(const AggregateBarsArgs& args) {
         const http::model::Request req = provider_->build_custom_aggregate_bars(args);
-        const http::model::Response resp = http_->get_with_retries(req);
+        const http::model::Response resp = [&] {
+            PROFILE_SCOPE("http_request");
+            return http_->get_with_retries(req);
+        }();
 
         if (resp.status_ < static_cast<long>(http::client::HttpStatusCode::OK) || resp.status_ >= HTTP_SUCCESS_UPPER_BOUNDARY) {
             throw http::http_error::HttpError(resp.status_, resp.effective_url_, resp.body_.substr(0, http::http_error::ERROR_MESSAGE_LENGTH),
                                               "HTTP request failed with status " + std::to_string(resp.status_));
         }
 
+        PROFILE_SCOPE("parse_bars");
         return provider_->parse_custom_aggregate_bars(resp);
     }
+
+    std::string StockAPI::create_flight_key(const AggregateBarsArgs& args) {
+        return args.symbol_ + "|" + std::to_string(args.timespan_) + "|" + args.timespan_unit_ + "|" + args.from_ + "|" + args.to_;
+    }
 }  // namespace http::stock_api
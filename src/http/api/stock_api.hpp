@@ -7,9 +7,11 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../client/interface.hpp"
 #include "../model/model.hpp"
+#include "single_flight.hpp"
 
 namespace http::stock_api {
 
@@ -38,6 +40,8 @@ namespace http::stock_api {
         bool adjusted_{};
         std::size_t query_count_{};
         std::size_t result_count_{};
+        // The provider stopped short of the requested range, e.g. at its result limit.
+        bool is_truncated_{};
         std::string ticker_{};
         std::vector<AggregateBarResult> results_{};
     };
@@ -55,15 +59,28 @@ namespace http::stock_api {
         [[nodiscard]] virtual http::stock_api::AggregateBars parse_custom_aggregate_bars(const http::model::Response& resp) const = 0;
     };
 
+    class BarCache;
+
+    using AggregateBarsFlight = SingleFlight<std::string, std::shared_ptr<const AggregateBars>>;
+
     class StockAPI {
        public:
         explicit StockAPI(std::unique_ptr<IStockDataProvider> p, std::unique_ptr<http::client::IHttpClient> ce);
         explicit StockAPI(const IStockDataProvider* p, std::unique_ptr<http::client::IHttpClient> ce);
-        AggregateBars custom_aggregate_bars(const AggregateBarsArgs& args);
+        explicit StockAPI(const IStockDataProvider* p, std::unique_ptr<http::client::IHttpClient> ce, std::shared_ptr<BarCache> bar_cache,
+                          std::shared_ptr<AggregateBarsFlight> aggregate_bars_flight = nullptr);
+        // Shared with every concurrent caller of the same request, so the bars are never copied per caller.
+        std::shared_ptr<const AggregateBars> custom_aggregate_bars(const AggregateBarsArgs& args);
 
        private:
         const IStockDataProvider* provider_;
         std::shared_ptr<http::client::IHttpClient> http_;
+        std::shared_ptr<BarCache> bar_cache_;
+        std::shared_ptr<AggregateBarsFlight> aggregate_bars_flight_;
+
+        AggregateBars load_custom_aggregate_bars(const AggregateBarsArgs& args);
+        AggregateBars fetch_custom_aggregate_bars(const AggregateBarsArgs& args);
+        [[nodiscard]] static std::string create_flight_key(const AggregateBarsArgs& args);
     };
 
 }  // namespace http::stock_api
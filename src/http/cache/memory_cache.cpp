@@ -0,0 +1,94 @@
+#include "memory_cache.hpp"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "../model/model.hpp"
+
+namespace http::cache {
+
+    MemoryCache::MemoryCache(std::unique_ptr<MemoryCachePolicy> policy) : policy_(std::move(policy)) {}
+
+    std::shared_ptr<const MemoryCache::Entry> MemoryCache::get(const std::string &key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        lru_.splice(lru_.begin(), lru_, it->second);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second->second;
+    }
+
+    void MemoryCache::put(const std::string &key, http::model::Response response, long unix_ts_s) {
+        auto entry = std::make_shared<const Entry>(Entry{.response_ = std::move(response), .unix_ts_s_ = unix_ts_s});
+        const size_t size = entry_size(key, *entry);
+
+        // A single response larger than the whole budget would only evict everything else.
+        if (size > policy_->max_bytes_) {
+            erase(key);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            bytes_ -= entry_size(key, *it->second->second);
+            it->second->second = std::move(entry);
+            lru_.splice(lru_.begin(), lru_, it->second);
+        } else {
+            lru_.emplace_front(key, std::move(entry));
+            index_.emplace(key, lru_.begin());
+        }
+
+        bytes_ += size;
+        evict_locked();
+    }
+
+    void MemoryCache::erase(const std::string &key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            return;
+        }
+
+        bytes_ -= entry_size(key, *it->second->second);
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    MemoryCacheStats MemoryCache::stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return MemoryCacheStats{
+            .hits_ = hits_.load(std::memory_order_relaxed),
+            .misses_ = misses_.load(std::memory_order_relaxed),
+            .evictions_ = evictions_.load(std::memory_order_relaxed),
+            .bytes_ = bytes_,
+            .entries_ = index_.size(),
+        };
+    }
+
+    size_t MemoryCache::entry_size(const std::string &key, const Entry &entry) {
+        const auto &r = entry.response_;
+        return sizeof(Entry) + key.size() + r.body_.size() + r.effective_url_.size() + r.etag_.size() + r.last_modified_.size() + r.retry_after_.size() +
+               r.cache_control_.size() + r.content_type_.size();
+    }
+
+    void MemoryCache::evict_locked() {
+        while (!lru_.empty() && (bytes_ > policy_->max_bytes_ || index_.size() > policy_->max_entries_)) {
+            const auto &[key, entry] = lru_.back();
+            bytes_ -= entry_size(key, *entry);
+            index_.erase(key);
+            lru_.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}  // namespace http::cache
@@ -0,0 +1,72 @@
+#ifndef QUANT_FORGE_MEMORY_CACHE_HPP
+#define QUANT_FORGE_MEMORY_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "../model/model.hpp"
+
+namespace http::cache {
+    inline constexpr size_t DEFAULT_MEMORY_CACHE_MAX_BYTES = 256UL * 1024UL * 1024UL;
+    inline constexpr size_t DEFAULT_MEMORY_CACHE_MAX_ENTRIES = 4096;
+
+    struct MemoryCachePolicy {
+        size_t max_bytes_ = DEFAULT_MEMORY_CACHE_MAX_BYTES;
+        size_t max_entries_ = DEFAULT_MEMORY_CACHE_MAX_ENTRIES;
+    };
+
+    struct MemoryCacheStats {
+        uint64_t hits_ = 0;
+        uint64_t misses_ = 0;
+        uint64_t evictions_ = 0;
+        size_t bytes_ = 0;
+        size_t entries_ = 0;
+    };
+
+    // Process-wide, size-bounded LRU of responses keyed by request url. Entries are immutable and handed out
+    // as shared pointers, so readers never hold the lock while copying a body.
+    class MemoryCache {
+       public:
+        struct Entry {
+            http::model::Response response_;
+            long unix_ts_s_;
+        };
+
+        explicit MemoryCache(std::unique_ptr<MemoryCachePolicy> policy);
+
+        ~MemoryCache() = default;
+        MemoryCache(const MemoryCache &) = delete;
+        MemoryCache &operator=(const MemoryCache &) = delete;
+        MemoryCache(MemoryCache &&) = delete;
+        MemoryCache &operator=(MemoryCache &&) = delete;
+
+        [[nodiscard]] std::shared_ptr<const Entry> get(const std::string &key);
+        void put(const std::string &key, http::model::Response response, long unix_ts_s);
+        void erase(const std::string &key);
+        [[nodiscard]] MemoryCacheStats stats() const;
+
+       private:
+        using LruList = std::list<std::pair<std::string, std::shared_ptr<const Entry>>>;
+
+        std::unique_ptr<MemoryCachePolicy> policy_;
+        mutable std::mutex mutex_;
+        LruList lru_;
+        std::unordered_map<std::string, LruList::iterator> index_;
+        size_t bytes_ = 0;
+
+        std::atomic<uint64_t> hits_{0};
+        std::atomic<uint64_t> misses_{0};
+        std::atomic<uint64_t> evictions_{0};
+
+        [[nodiscard]] static size_t entry_size(const std::string &key, const Entry &entry);
+        void evict_locked();
+    };
+}  // namespace http::cache
+
+#endif
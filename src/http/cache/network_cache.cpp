@@ -20,7 +20,12 @@ static constexpr const char *META_FILE_EXT = ".meta";
 
 namespace http::cache {
 
-    NetworkCache::NetworkCache(std::unique_ptr<NetworkCachePolicy> policy) : policy_(std::move(policy)) {}
+    NetworkCache::NetworkCache(std::unique_ptr<NetworkCachePolicy> policy, std::shared_ptr<MemoryCache> memory_cache)
+        : policy_(std::move(policy)), memory_cache_(std::move(memory_cache)) {
+        if (policy_->enable_caching_) {
+            std::filesystem::create_directories(policy_->root_);
+        }
+    }
 
     std::optional<NetworkCache::Hit> NetworkCache::probe(const http::model::Request &req) const {
         if (!policy_->enable_caching_) {
@@ -28,6 +33,18 @@ namespace http::cache {
         }
 
         const auto base_path = create_base_path(req);
+
+        if (memory_cache_) {
+            if (auto entry = memory_cache_->get(req.url_)) {
+                return Hit{
+                    .url_ = req.url_,
+                    .base_path_ = base_path,
+                    .meta_ = meta_from_response(entry->response_, entry->unix_ts_s_),
+                    .memory_entry_ = std::move(entry),
+                };
+            }
+        }
+
         const auto body_path = string_utils::append_to_path(base_path, BODY_FILE_EXT);
         const auto meta_path = string_utils::append_to_path(base_path, META_FILE_EXT);
 
@@ -47,6 +64,7 @@ namespace http::cache {
             .url_ = req.url_,
             .base_path_ = base_path,
             .meta_ = meta,
+            .memory_entry_ = nullptr,
         };
     }
 
@@ -85,7 +103,11 @@ namespace http::cache {
         return age <= policy_->ttl_s_;
     }
 
-    http::model::Response NetworkCache::get_cached_response(Hit &&hit) {
+    http::model::Response NetworkCache::get_cached_response(Hit &&hit) const {
+        if (hit.memory_entry_) {
+            return hit.memory_entry_->response_;
+        }
+
         std::string s;
         hit.in_.seekg(0, std::ios::end);
         s.resize(static_cast<size_t>(hit.in_.tellg()));
@@ -103,6 +125,12 @@ namespace http::cache {
         response.rate_limit_reset_ = hit.meta_.rate_limit_reset_;
         response.cache_control_ = hit.meta_.cache_control_;
         response.content_type_ = hit.meta_.content_type_;
+
+        // Promote disk hits so repeated requests in this process skip the filesystem.
+        if (memory_cache_) {
+            memory_cache_->put(response.effective_url_, response, hit.meta_.unix_ts_s_);
+        }
+
         return response;
     }
 
@@ -117,6 +145,23 @@ namespace http::cache {
 
         write_atomic(body_path, resp.body_);
 
+        const long now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        save_meta_atomic(meta_path, meta_from_response(resp, now));
+
+        if (memory_cache_) {
+            memory_cache_->put(req.url_, resp, now);
+        }
+    }
+
+    std::filesystem::path NetworkCache::create_base_path(const http::model::Request &req) const {
+        std::hash<std::string> hash_maker;
+        // IMPROVEMENT (out of scope): Include certain request headers in the url
+        // cache key.
+        size_t hash = hash_maker(req.url_);
+        return policy_->root_ / std::to_string(hash);
+    }
+
+    NetworkCache::Meta NetworkCache::meta_from_response(const http::model::Response &resp, long unix_ts_s) {
         Meta m;
         m.status_ = resp.status_;
         m.etag_ = resp.etag_;
@@ -126,18 +171,8 @@ namespace http::cache {
         m.retry_after_ = resp.retry_after_;
         m.rate_limit_remaining_ = resp.rate_limit_remaining_;
         m.rate_limit_reset_ = resp.rate_limit_reset_;
-        m.unix_ts_s_ = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-
-        save_meta_atomic(meta_path, m);
-    }
-
-    std::filesystem::path NetworkCache::create_base_path(const http::model::Request &req) {
-        std::hash<std::string> hash_maker;
-        // IMPROVEMENT (out of scope): Include certain request headers in the url
-        // cache key.
-        size_t hash = hash_maker(req.url_);
-        std::filesystem::create_directories("cache/http");
-        return {"cache/http/" + std::to_string(hash)};
+        m.unix_ts_s_ = unix_ts_s;
+        return m;
     }
 
     void NetworkCache::save_meta_atomic(const std::filesystem::path &p, const Meta &m) {
@@ -218,10 +253,14 @@ namespace http::cache {
         return true;
     }
 
-    void NetworkCache::refresh_meta_timestamp(const std::filesystem::path &base_path, Meta &meta) {
-        meta.unix_ts_s_ = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-        const auto meta_path = string_utils::append_to_path(base_path, META_FILE_EXT);
-        NetworkCache::save_meta_atomic(meta_path, meta);
+    void NetworkCache::refresh_meta_timestamp(Hit &hit) const {
+        hit.meta_.unix_ts_s_ = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        const auto meta_path = string_utils::append_to_path(hit.base_path_, META_FILE_EXT);
+        NetworkCache::save_meta_atomic(meta_path, hit.meta_);
+
+        if (memory_cache_ && hit.memory_entry_) {
+            memory_cache_->put(hit.url_, hit.memory_entry_->response_, hit.meta_.unix_ts_s_);
+        }
     }
 
     bool NetworkCache::extract_header_value(const char *buffer, size_t bytes, const char *key, std::string &out_property) {
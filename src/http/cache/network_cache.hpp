@@ -7,11 +7,13 @@
 
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <optional>
 #include <string>
 
 #include "../../utils/constants.hpp"
 #include "../model/model.hpp"
+#include "memory_cache.hpp"
 
 namespace http::cache {
     const long BASE_DELAY_MS = 300;
@@ -32,6 +34,7 @@ namespace http::cache {
     struct NetworkCachePolicy {
         bool enable_caching_ = true;
         long ttl_s_ = constants::ONE_DAY_S;
+        std::filesystem::path root_ = "cache/http";
     };
 
     class NetworkCache {
@@ -53,10 +56,11 @@ namespace http::cache {
             std::string url_;
             std::filesystem::path base_path_;
             Meta meta_;
-            explicit operator bool() const { return in_.is_open(); };
+            std::shared_ptr<const MemoryCache::Entry> memory_entry_;
+            explicit operator bool() const { return memory_entry_ != nullptr || in_.is_open(); };
         };
 
-        NetworkCache(std::unique_ptr<NetworkCachePolicy> policy);
+        NetworkCache(std::unique_ptr<NetworkCachePolicy> policy, std::shared_ptr<MemoryCache> memory_cache = nullptr);
 
         ~NetworkCache() = default;
         NetworkCache(const NetworkCache &) = delete;
@@ -65,17 +69,19 @@ namespace http::cache {
         NetworkCache &operator=(NetworkCache &&) = delete;
 
         [[nodiscard]] std::optional<NetworkCache::Hit> probe(const http::model::Request &req) const;
-        static http::model::Response get_cached_response(Hit &&hit);
+        [[nodiscard]] http::model::Response get_cached_response(Hit &&hit) const;
         void cache_response(const http::model::Request &req, const http::model::Response &resp) const;
         [[nodiscard]] bool fresh_enough(const Meta &meta) const;
-        static void refresh_meta_timestamp(const std::filesystem::path &base_path, Meta &meta);
+        void refresh_meta_timestamp(Hit &hit) const;
         static bool extract_header_value(const char *buffer, size_t bytes, const char *key, std::string &out_property);
         static bool extract_header_value(const char *buffer, size_t bytes, const char *key, long &out_property);
 
        private:
         std::unique_ptr<NetworkCachePolicy> policy_;
+        std::shared_ptr<MemoryCache> memory_cache_;
 
-        [[nodiscard]] static std::filesystem::path create_base_path(const http::model::Request &req);
+        [[nodiscard]] std::filesystem::path create_base_path(const http::model::Request &req) const;
+        [[nodiscard]] static Meta meta_from_response(const http::model::Response &resp, long unix_ts_s);
 
         static bool load_meta(const std::filesystem::path &p, Meta &out);
         static void save_meta_atomic(const std::filesystem::path &p, const Meta &m);
@@ -49,7 +49,8 @@ namespace http::client {
         static constexpr const char* CACHE_CONTROL = "cache-control:";
     };
 
-    CurlEasy::CurlEasy(std::unique_ptr<http::cache::NetworkCache> cache_layer) : handle_(curl_easy_init()), cache_layer_(std::move(cache_layer)) {
+    CurlEasy::CurlEasy(std::unique_ptr<http::cache::NetworkCache> cache_layer, std::shared_ptr<RateLimiter> rate_limiter)
+        : handle_(curl_easy_init()), cache_layer_(std::move(cache_layer)), rate_limiter_(std::move(rate_limiter)) {
         if (handle_ == nullptr) {
             throw std::runtime_error("Failed to create CURL easy handle");
         }
@@ -174,12 +175,21 @@ namespace http::client {
             body.reserve(static_cast<size_t>(last_content_length_));
         }
 
+        // Cache hits above never spend quota; only requests that actually go out wait for a slot.
+        if (rate_limiter_) {
+            rate_limiter_->acquire();
+        }
+
         perform_throw();
         http::model::Response r = make_response(body);
 
+        if (rate_limiter_) {
+            rate_limiter_->observe(r.rate_limit_remaining_, r.rate_limit_reset_);
+        }
+
         if (r.status_ == static_cast<long>(HttpStatusCode::NOT_MODIFIED) && hit) {
             // Optionally refresh stored_at in meta:
-            cache_layer_->refresh_meta_timestamp(hit->base_path_, hit->meta_);
+            cache_layer_->refresh_meta_timestamp(*hit);
             return cache_layer_->get_cached_response(std::move(*hit));
         }
 
@@ -197,12 +207,28 @@ namespace http::client {
             try {
                 auto resp = get(req);
 
+                const bool is_rate_limited = resp.status_ == static_cast<long>(HttpStatusCode::TOO_MANY_REQUESTS);
+
+                // With a shared limiter, a 429 pushes back every IO thread at once instead of each handle sleeping on its own.
+                if (is_rate_limited && rate_limiter_ && attempt < p.max_tries_) {
+                    char* end = nullptr;
+                    const long s = resp.retry_after_.empty() ? 0 : std::strtol(resp.retry_after_.c_str(), &end, 10);
+                    if (s > 0) {
+                        rate_limiter_->defer_until(system_clock::now() + seconds{s});
+                        continue;
+                    }
+                    if (resp.rate_limit_remaining_ == 0 && resp.rate_limit_reset_ > 0) {
+                        // observe() in get() has already deferred until the reset.
+                        continue;
+                    }
+                }
+
                 if (is_retryable_http(resp.status_) && attempt < p.max_tries_) {
                     delay = CurlEasy::get_retry_delay(p, delay);
                     continue;
                 }
 
-                if (resp.status_ != static_cast<long>(HttpStatusCode::TOO_MANY_REQUESTS)) {
+                if (!is_rate_limited) {
                     return resp;
                 }
 
@@ -14,6 +14,7 @@
 #include "../cache/network_cache.hpp"
 #include "../model/model.hpp"
 #include "interface.hpp"
+#include "rate_limiter.hpp"
 
 struct curl_slist;
 
@@ -31,7 +32,7 @@ namespace http::client {
 
     class CurlEasy : public IHttpClient {
        public:
-        CurlEasy(std::unique_ptr<http::cache::NetworkCache> cache_layer);
+        CurlEasy(std::unique_ptr<http::cache::NetworkCache> cache_layer, std::shared_ptr<RateLimiter> rate_limiter = nullptr);
 
         ~CurlEasy() override;
         CurlEasy(const CurlEasy&) = delete;
@@ -78,6 +79,7 @@ namespace http::client {
 
         CURL* handle_{};
         std::unique_ptr<http::cache::NetworkCache> cache_layer_;
+        std::shared_ptr<RateLimiter> rate_limiter_;
     };
 }  // namespace http::client
 
@@ -0,0 +1,54 @@
+#include "file_client.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "../model/model.hpp"
+
+static constexpr long FILE_STATUS_OK = 200;
+static constexpr long FILE_STATUS_NOT_FOUND = 404;
+
+namespace http::client {
+
+    http::model::Response FileClient::get(const http::model::Request& req) {
+        http::model::Response response;
+        response.effective_url_ = req.url_;
+
+        const auto path = path_from_url(req.url_);
+        std::ifstream in(path, std::ios::binary);
+
+        if (!in) {
+            response.status_ = FILE_STATUS_NOT_FOUND;
+            response.body_ = "File not found: " + path.string();
+            return response;
+        }
+
+        in.seekg(0, std::ios::end);
+        response.body_.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0, std::ios::beg);
+        in.read(response.body_.data(), static_cast<std::streamsize>(response.body_.size()));
+
+        response.status_ = FILE_STATUS_OK;
+        return response;
+    }
+
+    // Local reads either succeed or fail deterministically, so there is nothing to retry.
+    http::model::Response FileClient::get_with_retries(const http::model::Request& req, const http::cache::RetryPolicy& /*p*/) { return get(req); }
+
+    std::filesystem::path FileClient::path_from_url(const std::string& url) {
+        std::string_view view = url;
+        const std::string_view scheme = FILE_URL_SCHEME;
+
+        if (view.starts_with(scheme)) {
+            view.remove_prefix(scheme.size());
+        }
+
+        const auto query_pos = view.find('?');
+        if (query_pos != std::string_view::npos) {
+            view = view.substr(0, query_pos);
+        }
+
+        return std::filesystem::path{view};
+    }
+}  // namespace http::client
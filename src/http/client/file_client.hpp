@@ -0,0 +1,32 @@
+#ifndef QUANT_FORGE_FILE_CLIENT_HPP
+#define QUANT_FORGE_FILE_CLIENT_HPP
+
+#include <filesystem>
+#include <string>
+
+#include "../model/model.hpp"
+#include "interface.hpp"
+
+namespace http::client {
+    inline constexpr const char* FILE_URL_SCHEME = "file://";
+
+    // Serves "file://<path>[?query]" requests from the local filesystem, so offline providers can keep the
+    // same build/parse flow as the networked ones. The query string is left for the provider to interpret.
+    class FileClient : public IHttpClient {
+       public:
+        FileClient() = default;
+
+        ~FileClient() override = default;
+        FileClient(const FileClient&) = delete;
+        FileClient& operator=(const FileClient&) = delete;
+        FileClient(FileClient&&) = delete;
+        FileClient& operator=(FileClient&&) = delete;
+
+        http::model::Response get(const http::model::Request& req) override;
+        http::model::Response get_with_retries(const http::model::Request& req, const http::cache::RetryPolicy& p = {}) override;
+
+        [[nodiscard]] static std::filesystem::path path_from_url(const std::string& url);
+    };
+}  // namespace http::client
+
+#endif
@@ -0,0 +1,83 @@
+#include "rate_limiter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono;
+
+namespace http::client {
+
+    RateLimiter::RateLimiter(std::unique_ptr<RateLimitPolicy> policy)
+        : policy_(std::move(policy)), base_interval_ns_(0), tolerance_ns_(0), interval_ns_(0) {
+        if (policy_->requests_per_window_ > 0) {
+            const double effective_requests = static_cast<double>(policy_->requests_per_window_) * policy_->headroom_;
+            base_interval_ns_ = static_cast<int64_t>(static_cast<double>(duration_cast<nanoseconds>(policy_->window_).count()) / effective_requests);
+        }
+
+        tolerance_ns_ = base_interval_ns_ * std::max(policy_->burst_ - 1, 0L);
+        interval_ns_.store(base_interval_ns_, std::memory_order_relaxed);
+    }
+
+    void RateLimiter::acquire() {
+        if (!policy_->enable_limiting_) {
+            return;
+        }
+
+        const int64_t now = steady_now_ns();
+        const int64_t interval = interval_ns_.load(std::memory_order_relaxed);
+
+        int64_t tat = tat_ns_.load(std::memory_order_relaxed);
+        int64_t start = 0;
+
+        do {
+            start = std::max(tat, now);
+        } while (!tat_ns_.compare_exchange_weak(tat, start + interval, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        const int64_t allowed_at = start - tolerance_ns_;
+        if (allowed_at > now) {
+            std::this_thread::sleep_for(nanoseconds{allowed_at - now});
+        }
+    }
+
+    void RateLimiter::observe(long remaining, long reset_unix_s) {
+        if (!policy_->enable_limiting_ || remaining < 0 || reset_unix_s <= 0) {
+            return;
+        }
+
+        const auto reset_at = system_clock::time_point{seconds{reset_unix_s}};
+
+        if (remaining == 0) {
+            defer_until(reset_at);
+            return;
+        }
+
+        const int64_t until_reset_ns = to_steady_ns(reset_at) - steady_now_ns();
+        if (until_reset_ns <= 0) {
+            return;
+        }
+
+        // Spread what is left of the window evenly, but never run faster than the plan allows.
+        const auto header_interval = static_cast<int64_t>(static_cast<double>(until_reset_ns) / (static_cast<double>(remaining) * policy_->headroom_));
+        interval_ns_.store(std::max(base_interval_ns_, header_interval), std::memory_order_relaxed);
+    }
+
+    void RateLimiter::defer_until(system_clock::time_point deadline) {
+        if (!policy_->enable_limiting_) {
+            return;
+        }
+
+        const int64_t target = to_steady_ns(deadline) + tolerance_ns_;
+        int64_t tat = tat_ns_.load(std::memory_order_relaxed);
+
+        while (tat < target && !tat_ns_.compare_exchange_weak(tat, target, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        }
+    }
+
+    int64_t RateLimiter::steady_now_ns() { return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count(); }
+
+    int64_t RateLimiter::to_steady_ns(system_clock::time_point tp) {
+        return steady_now_ns() + duration_cast<nanoseconds>(tp - system_clock::now()).count();
+    }
+}  // namespace http::client
@@ -0,0 +1,55 @@
+#ifndef QUANT_FORGE_RATE_LIMITER_HPP
+#define QUANT_FORGE_RATE_LIMITER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace http::client {
+    // Unmetered: without a plan quota only the server's rate limit headers and 429s slow requests down.
+    inline constexpr long DEFAULT_REQUESTS_PER_WINDOW = 0;
+    inline constexpr std::chrono::milliseconds DEFAULT_RATE_LIMIT_WINDOW{60'000};
+    inline constexpr double DEFAULT_RATE_LIMIT_HEADROOM = 0.95;
+
+    struct RateLimitPolicy {
+        bool enable_limiting_ = true;
+        // Plan quota; 0 means unmetered, in which case only the rate limit headers drive the pace.
+        long requests_per_window_ = DEFAULT_REQUESTS_PER_WINDOW;
+        std::chrono::milliseconds window_ = DEFAULT_RATE_LIMIT_WINDOW;
+        long burst_ = 1;
+        // Fraction of the quota we actually spend, so clock skew against the server never trips a 429.
+        double headroom_ = DEFAULT_RATE_LIMIT_HEADROOM;
+    };
+
+    // Process-wide token bucket implemented as GCRA over a single atomic "theoretical arrival time".
+    // Every caller reserves its slot with one CAS and then sleeps outside of any lock until the slot opens.
+    class RateLimiter {
+       public:
+        explicit RateLimiter(std::unique_ptr<RateLimitPolicy> policy);
+
+        ~RateLimiter() = default;
+        RateLimiter(const RateLimiter&) = delete;
+        RateLimiter& operator=(const RateLimiter&) = delete;
+        RateLimiter(RateLimiter&&) = delete;
+        RateLimiter& operator=(RateLimiter&&) = delete;
+
+        void acquire();
+        // Calibrates the pace from X-RateLimit-Remaining and X-RateLimit-Reset (unix seconds). Negative values mean absent.
+        void observe(long remaining, long reset_unix_s);
+        // Holds back every caller until the deadline, e.g. when the server answers 429 with Retry-After.
+        void defer_until(std::chrono::system_clock::time_point deadline);
+
+       private:
+        std::unique_ptr<RateLimitPolicy> policy_;
+        int64_t base_interval_ns_;
+        int64_t tolerance_ns_;
+        std::atomic<int64_t> interval_ns_;
+        std::atomic<int64_t> tat_ns_{0};
+
+        [[nodiscard]] static int64_t steady_now_ns();
+        [[nodiscard]] static int64_t to_steady_ns(std::chrono::system_clock::time_point tp);
+    };
+}  // namespace http::client
+
+#endif
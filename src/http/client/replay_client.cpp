@@ -0,0 +1,30 @@
+#include "replay_client.hpp"
+
+#include <memory>
+#include <optional>
+
+#include "../cache/network_cache.hpp"
+#include "../model/model.hpp"
+
+static constexpr long REPLAY_STATUS_NOT_FOUND = 404;
+
+namespace http::client {
+
+    ReplayClient::ReplayClient(std::unique_ptr<http::cache::NetworkCache> recording) : recording_(std::move(recording)) {}
+
+    http::model::Response ReplayClient::get(const http::model::Request& req) {
+        std::optional<http::cache::NetworkCache::Hit> hit = recording_->probe(req);
+
+        if (!hit) {
+            http::model::Response response;
+            response.status_ = REPLAY_STATUS_NOT_FOUND;
+            response.effective_url_ = req.url_;
+            response.body_ = "Request was not recorded: " + req.url_;
+            return response;
+        }
+
+        return recording_->get_cached_response(std::move(*hit));
+    }
+
+    http::model::Response ReplayClient::get_with_retries(const http::model::Request& req, const http::cache::RetryPolicy& /*p*/) { return get(req); }
+}  // namespace http::client
@@ -0,0 +1,31 @@
+#ifndef QUANT_FORGE_REPLAY_CLIENT_HPP
+#define QUANT_FORGE_REPLAY_CLIENT_HPP
+
+#include <memory>
+
+#include "../cache/network_cache.hpp"
+#include "../model/model.hpp"
+#include "interface.hpp"
+
+namespace http::client {
+    // Answers requests exclusively from a recorded NetworkCache directory, ignoring freshness. Anything that was
+    // not recorded comes back as a 404 instead of going to the network, so replays are fully deterministic.
+    class ReplayClient : public IHttpClient {
+       public:
+        explicit ReplayClient(std::unique_ptr<http::cache::NetworkCache> recording);
+
+        ~ReplayClient() override = default;
+        ReplayClient(const ReplayClient&) = delete;
+        ReplayClient& operator=(const ReplayClient&) = delete;
+        ReplayClient(ReplayClient&&) = delete;
+        ReplayClient& operator=(ReplayClient&&) = delete;
+
+        http::model::Response get(const http::model::Request& req) override;
+        http::model::Response get_with_retries(const http::model::Request& req, const http::cache::RetryPolicy& p = {}) override;
+
+       private:
+        std::unique_ptr<http::cache::NetworkCache> recording_;
+    };
+}  // namespace http::client
+
+#endif
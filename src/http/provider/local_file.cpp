@@ -0,0 +1,291 @@
+#include "local_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <exception>
+#include <filesystem>
+#include <latch>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../utils/constants.hpp"
+#include "../../utils/thread_pool.hpp"
+#include "../../utils/time_utils.hpp"
+#include "../api/bar_cache.hpp"
+#include "../api/stock_api.hpp"
+#include "../client/file_client.hpp"
+#include "../error/http_error.hpp"
+#include "../model/model.hpp"
+
+static constexpr const char* BINARY_FILE_EXT = ".bars";
+static constexpr const char* CSV_FILE_EXT = ".csv";
+static constexpr size_t MAX_CSV_COLUMNS = 32;
+// Below this size, splitting the body costs more than it saves.
+static constexpr size_t MIN_PARALLEL_CSV_BYTES = 1UL << 20U;
+
+namespace http::provider {
+    namespace {
+        struct CsvColumns {
+            int timestamp_ = -1;
+            int open_ = -1;
+            int high_ = -1;
+            int low_ = -1;
+            int close_ = -1;
+            int volume_ = -1;
+            int vwap_ = -1;
+            int tx_count_ = -1;
+            int otc_ = -1;
+        };
+
+        std::string_view strip_line(std::string_view line) {
+            while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) {
+                line.remove_suffix(1);
+            }
+            return line;
+        }
+
+        size_t split_fields(std::string_view line, std::array<std::string_view, MAX_CSV_COLUMNS>& fields) {
+            size_t count = 0;
+            size_t start = 0;
+
+            while (count < MAX_CSV_COLUMNS) {
+                const size_t comma = line.find(',', start);
+                fields.at(count++) = line.substr(start, comma == std::string_view::npos ? std::string_view::npos : comma - start);
+                if (comma == std::string_view::npos) {
+                    break;
+                }
+                start = comma + 1;
+            }
+
+            return count;
+        }
+
+        CsvColumns parse_csv_header(std::string_view header) {
+            std::array<std::string_view, MAX_CSV_COLUMNS> fields{};
+            const size_t count = split_fields(strip_line(header), fields);
+
+            CsvColumns columns;
+            for (size_t i = 0; i < count; ++i) {
+                const std::string_view name = fields.at(i);
+                const int index = static_cast<int>(i);
+
+                if (name == "t" || name == "timestamp") {
+                    columns.timestamp_ = index;
+                } else if (name == "o" || name == "open") {
+                    columns.open_ = index;
+                } else if (name == "h" || name == "high") {
+                    columns.high_ = index;
+                } else if (name == "l" || name == "low") {
+                    columns.low_ = index;
+                } else if (name == "c" || name == "close") {
+                    columns.close_ = index;
+                } else if (name == "v" || name == "volume") {
+                    columns.volume_ = index;
+                } else if (name == "vw" || name == "vwap") {
+                    columns.vwap_ = index;
+                } else if (name == "n" || name == "transactions") {
+                    columns.tx_count_ = index;
+                } else if (name == "otc") {
+                    columns.otc_ = index;
+                }
+            }
+
+            if (columns.timestamp_ < 0 || columns.open_ < 0 || columns.high_ < 0 || columns.low_ < 0 || columns.close_ < 0) {
+                throw std::runtime_error("CSV header must name timestamp, open, high, low and close columns");
+            }
+
+            return columns;
+        }
+
+        template <typename T>
+        T parse_field(const std::array<std::string_view, MAX_CSV_COLUMNS>& fields, size_t count, int column, T fallback) {
+            if (column < 0 || static_cast<size_t>(column) >= count || fields.at(column).empty()) {
+                return fallback;
+            }
+
+            const std::string_view field = fields.at(column);
+            T value{};
+            const auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+
+            if (ec != std::errc{}) {
+                throw std::runtime_error("Invalid CSV value: " + std::string(field));
+            }
+
+            return value;
+        }
+
+        void parse_csv_chunk(std::string_view chunk, const CsvColumns& columns, const std::string& symbol, std::vector<http::stock_api::AggregateBarResult>& out) {
+            std::array<std::string_view, MAX_CSV_COLUMNS> fields{};
+            size_t start = 0;
+
+            while (start < chunk.size()) {
+                size_t end = chunk.find('\n', start);
+                if (end == std::string_view::npos) {
+                    end = chunk.size();
+                }
+
+                const std::string_view line = strip_line(chunk.substr(start, end - start));
+                start = end + 1;
+
+                if (line.empty()) {
+                    continue;
+                }
+
+                const size_t count = split_fields(line, fields);
+
+                http::stock_api::AggregateBarResult bar{};
+                bar.symbol_ = symbol;
+                bar.unix_ts_ns_ = parse_field<long long>(fields, count, columns.timestamp_, 0) * constants::NANOSECONDS_PER_MILLISECOND;
+                bar.open_ = parse_field<double>(fields, count, columns.open_, 0.0);
+                bar.high_ = parse_field<double>(fields, count, columns.high_, 0.0);
+                bar.low_ = parse_field<double>(fields, count, columns.low_, 0.0);
+                bar.close_ = parse_field<double>(fields, count, columns.close_, 0.0);
+                bar.volume_ = parse_field<double>(fields, count, columns.volume_, 0.0);
+                bar.volume_weighted_price_ = parse_field<double>(fields, count, columns.vwap_, 0.0);
+                bar.tx_count_ = parse_field<int>(fields, count, columns.tx_count_, 0);
+                bar.is_otc_ = parse_field<int>(fields, count, columns.otc_, 0) != 0;
+
+                out.emplace_back(std::move(bar));
+            }
+        }
+
+        std::string get_query_value(std::string_view url, std::string_view key) {
+            const auto query_pos = url.find('?');
+            if (query_pos == std::string_view::npos) {
+                return {};
+            }
+
+            std::string_view query = url.substr(query_pos + 1);
+            while (!query.empty()) {
+                const auto amp = query.find('&');
+                const std::string_view pair = query.substr(0, amp);
+                const auto eq = pair.find('=');
+
+                if (eq != std::string_view::npos && pair.substr(0, eq) == key) {
+                    return std::string(pair.substr(eq + 1));
+                }
+
+                if (amp == std::string_view::npos) {
+                    break;
+                }
+                query.remove_prefix(amp + 1);
+            }
+
+            return {};
+        }
+    }  // namespace
+
+    LocalFileProvider::LocalFileProvider(std::filesystem::path root, std::shared_ptr<concurrency::ThreadPool> parse_pool)
+        : root_(std::move(root)), parse_pool_(std::move(parse_pool)) {}
+
+    http::model::Request LocalFileProvider::build_custom_aggregate_bars(const http::stock_api::AggregateBarsArgs& a) const {
+        const auto base_path = root_ / a.symbol_ / (std::to_string(a.timespan_) + "_" + a.timespan_unit_);
+
+        auto path = base_path;
+        path += BINARY_FILE_EXT;
+        if (!std::filesystem::exists(path)) {
+            path = base_path;
+            path += CSV_FILE_EXT;
+        }
+
+        http::model::Request r;
+        r.url_ = std::string(http::client::FILE_URL_SCHEME) + path.string() + "?symbol=" + a.symbol_ + "&from=" + a.from_ + "&to=" + a.to_;
+        r.method_ = "GET";
+        return r;
+    }
+
+    http::stock_api::AggregateBars LocalFileProvider::parse_custom_aggregate_bars(const http::model::Response& resp) const {
+        http::stock_api::AggregateBars out{};
+
+        try {
+            const auto path = http::client::FileClient::path_from_url(resp.effective_url_);
+            const std::string symbol = get_query_value(resp.effective_url_, "symbol");
+            const int64_t from_ns = time_utils::parse_datetime_ms(get_query_value(resp.effective_url_, "from")) * constants::NANOSECONDS_PER_MILLISECOND;
+            const int64_t to_ns = time_utils::parse_datetime_end_ms(get_query_value(resp.effective_url_, "to")) * constants::NANOSECONDS_PER_MILLISECOND;
+
+            auto bars = path.extension() == BINARY_FILE_EXT ? http::stock_api::bar_codec::decode(resp.body_, symbol) : parse_csv(resp.body_, symbol);
+
+            std::erase_if(bars, [from_ns, to_ns](const auto& bar) { return bar.unix_ts_ns_ < from_ns || bar.unix_ts_ns_ > to_ns; });
+            std::stable_sort(bars.begin(), bars.end(), [](const auto& a, const auto& b) { return a.unix_ts_ns_ < b.unix_ts_ns_; });
+
+            out.ticker_ = symbol;
+            out.query_count_ = 1;
+            out.result_count_ = bars.size();
+            out.results_ = std::move(bars);
+        } catch (const std::exception& e) {
+            throw http::http_error::HttpError(resp.status_, resp.effective_url_, resp.body_.substr(0, http::http_error::ERROR_MESSAGE_LENGTH),
+                                              "Failed to parse local bars: " + std::string(e.what()));
+        }
+
+        return out;
+    }
+
+    std::vector<http::stock_api::AggregateBarResult> LocalFileProvider::parse_csv(std::string_view body, const std::string& symbol) const {
+        const size_t header_end = body.find('\n');
+        if (header_end == std::string_view::npos) {
+            return {};
+        }
+
+        const CsvColumns columns = parse_csv_header(body.substr(0, header_end));
+        const std::string_view rows = body.substr(header_end + 1);
+
+        const size_t parse_threads = parse_pool_ != nullptr ? parse_pool_->get_thread_count() : 1;
+        if (parse_threads <= 1 || rows.size() < MIN_PARALLEL_CSV_BYTES) {
+            std::vector<http::stock_api::AggregateBarResult> bars;
+            parse_csv_chunk(rows, columns, symbol, bars);
+            return bars;
+        }
+
+        // Split on line boundaries into one chunk per thread; each chunk parses into its own vector.
+        std::vector<std::string_view> chunks;
+        const size_t target_size = rows.size() / parse_threads;
+        size_t start = 0;
+
+        while (start < rows.size()) {
+            size_t end = std::min(start + target_size, rows.size());
+            end = end < rows.size() ? rows.find('\n', end) : end;
+            end = end == std::string_view::npos ? rows.size() : end + 1;
+            chunks.push_back(rows.substr(start, end - start));
+            start = end;
+        }
+
+        std::vector<std::vector<http::stock_api::AggregateBarResult>> parts(chunks.size());
+        std::vector<std::exception_ptr> errors(chunks.size());
+
+        // The pool is shared with other requests, so this call waits for its own chunks rather than for the pool to drain.
+        std::latch chunks_parsed(static_cast<std::ptrdiff_t>(chunks.size()));
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            parse_pool_->enqueue([&, i]() {
+                try {
+                    parse_csv_chunk(chunks[i], columns, symbol, parts[i]);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+                chunks_parsed.count_down();
+            });
+        }
+        chunks_parsed.wait();
+
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        size_t total = 0;
+        for (const auto& part : parts) {
+            total += part.size();
+        }
+
+        std::vector<http::stock_api::AggregateBarResult> bars;
+        bars.reserve(total);
+        for (auto& part : parts) {
+            bars.insert(bars.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+        }
+
+        return bars;
+    }
+}  // namespace http::provider
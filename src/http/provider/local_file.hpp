@@ -0,0 +1,33 @@
+#ifndef QUANT_FORGE_LOCAL_FILE_HPP
+#define QUANT_FORGE_LOCAL_FILE_HPP
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../utils/thread_pool.hpp"
+#include "../api/stock_api.hpp"
+#include "../model/model.hpp"
+
+namespace http::provider {
+    // Bars live at "<root>/<SYMBOL>/<timespan>_<unit>.bars" (the bar cache columnar format) or ".csv".
+    // CSV files need a header naming the columns, using either Polygon keys (t,o,h,l,c,v,vw,n,otc) or long
+    // names (timestamp,open,high,low,close,volume,vwap,transactions,otc). Timestamps are unix milliseconds.
+    class LocalFileProvider : public http::stock_api::IStockDataProvider {
+       public:
+        // Large CSV bodies are split across parse_pool, shared by every request; without one they parse on the calling thread.
+        explicit LocalFileProvider(std::filesystem::path root, std::shared_ptr<concurrency::ThreadPool> parse_pool = nullptr);
+        [[nodiscard]] http::model::Request build_custom_aggregate_bars(const http::stock_api::AggregateBarsArgs& a) const override;
+        [[nodiscard]] http::stock_api::AggregateBars parse_custom_aggregate_bars(const http::model::Response& resp) const override;
+
+       private:
+        std::filesystem::path root_;
+        std::shared_ptr<concurrency::ThreadPool> parse_pool_;
+
+        [[nodiscard]] std::vector<http::stock_api::AggregateBarResult> parse_csv(std::string_view body, const std::string& symbol) const;
+    };
+}  // namespace http::provider
+
+#endif
@@ -41,8 +41,16 @@ namespace http::provider {
             out.adjusted_ = bool(doc["adjusted"]);
             out.query_count_ = int64_t(doc["queryCount"]);
             out.result_count_ = int64_t(doc["resultsCount"]);
+            // Polygon pages a range past its result limit, linking the rest through "next_url".
+            out.is_truncated_ = doc["next_url"].error() == simdjson::SUCCESS;
 
-            for (auto result : doc["results"]) {
+            // Polygon omits "results" entirely when the range holds no bars.
+            ondemand::array results;
+            if (doc["results"].get_array().get(results) != simdjson::SUCCESS) {
+                return out;
+            }
+
+            for (auto result : results) {
                 http::stock_api::AggregateBarResult bar{};
                 bar.volume_ = double(result["v"]);
                 bar.volume_weighted_price_ = double(result["vw"]);
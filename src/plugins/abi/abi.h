@@ -9,6 +9,15 @@ extern "C" {
 #endif
 
 #define PLUGIN_API_VERSION 1
+// Fixed layout, string free variant of the API; see the "API v2" section below.
+#define PLUGIN_API_VERSION_V2 2
+// v1 exports whose vtable sets vtable_size_. Plugins built before the optional slots existed return PLUGIN_API_VERSION and
+// only fill the vtable up to free_string, so the host reads an optional slot only from an export with this version
+// whose vtable_size_ covers it.
+#define PLUGIN_API_VERSION_V1_SIZED 0x101
+// The same for v2, whose vtable sets vtable_size_ after precompute_signals.
+#define PLUGIN_API_VERSION_V2_SIZED 0x102
+#define INDICATOR_MAX_OUTPUTS 3
 
 typedef enum CExitOrderType {
     EXIT_ORDER_STOP_LOSS = 0,
@@ -104,6 +113,30 @@ typedef struct CEquitySnapshot {
     double conditional_value_at_risk_;
 } CEquitySnapshot;
 
+typedef enum CIndicatorType {
+    INDICATOR_TYPE_SMA = 0,
+    INDICATOR_TYPE_EMA = 1,
+    INDICATOR_TYPE_WMA = 2,
+    INDICATOR_TYPE_STDDEV = 3,
+    INDICATOR_TYPE_RSI = 4,
+    INDICATOR_TYPE_ATR = 5,
+    INDICATOR_TYPE_MACD = 6,
+    INDICATOR_TYPE_BOLLINGER = 7,
+    INDICATOR_TYPE_MIN = 8,
+    INDICATOR_TYPE_MAX = 9,
+    INDICATOR_TYPE_VWAP = 10,
+} CIndicatorType;
+
+// Latest value of one host computed indicator. The handle of an indicator is its index in the manifest's
+// host_params.indicators, which is also its index in CState::indicators_.
+// values_[0] holds the value; MACD fills [macd, signal, histogram] and Bollinger fills [middle, upper, lower].
+typedef struct CIndicatorValue {
+    const char* symbol_;
+    CIndicatorType type_;
+    bool is_ready_;
+    double values_[INDICATOR_MAX_OUTPUTS];
+} CIndicatorValue;
+
 typedef struct CState {
     int64_t cash_;
     const CPosition* positions_;
@@ -114,6 +147,8 @@ typedef struct CState {
     size_t new_fills_count_;
     const CEquitySnapshot* equity_curve_;
     size_t equity_curve_count_;
+    const CIndicatorValue* indicators_;
+    size_t indicators_count_;
 } CState;
 
 typedef struct CBar {
@@ -126,6 +161,32 @@ typedef struct CBar {
     double volume_;
 } Bar;
 
+// Full price history of one symbol as columns, in timestamp order. Owned by the host, valid for the call only.
+typedef struct CSeries {
+    const char* symbol_;
+    const int64_t* unix_ts_ns_;
+    const double* open_;
+    const double* high_;
+    const double* low_;
+    const double* close_;
+    const double* volume_;
+    size_t count_;
+} CSeries;
+
+typedef enum CSignalValue {
+    SIGNAL_VALUE_SELL = -1,
+    SIGNAL_VALUE_NONE = 0,
+    SIGNAL_VALUE_BUY = 1,
+} CSignalValue;
+
+// One signal per bar of the matching CSeries. The host allocates signals_ (zero-filled) and the plugin writes
+// CSignalValue entries into it.
+typedef struct CSignalColumn {
+    const char* symbol_;
+    int8_t* signals_;
+    size_t count_;
+} CSignalColumn;
+
 typedef struct PluginConfigKV {
     const char* key_;
     const char* value_;
@@ -150,6 +211,14 @@ typedef struct PluginResult {
     size_t instructions_count_;
 } PluginResult;
 
+// Host-owned instruction storage, reused across bars. The plugin writes at most capacity_ entries from the start of
+// instructions_ and sets count_; any strings they point at must stay valid until the plugin's next call.
+typedef struct CInstructionBuffer {
+    CInstruction* instructions_;
+    size_t capacity_;
+    size_t count_;
+} CInstructionBuffer;
+
 typedef struct PluginVTable {
     void (*destroy)(void* self);
 
@@ -164,12 +233,30 @@ typedef struct PluginVTable {
     PluginResult (*on_end)(void* self, const char** json_out);
     // The plugin needs to free the string, which can be called after on_end by the host
     void (*free_string)(void* self, const char* json_out_str);
+
+    // sizeof(PluginVTable) as the plugin was built, with api_version_ set to PLUGIN_API_VERSION_V1_SIZED. Slots past
+    // this field are optional and only read when they lie within vtable_size_.
+    size_t vtable_size_;
+
+    // Optional, may be null. For strategies whose signals depend only on price history: called once with every
+    // symbol's full series, and the host then replays the returned signals instead of calling on_bar per bar.
+    PluginResult (*precompute_signals)(void* self, const CSeries* series, CSignalColumn* signals, size_t series_count);
+
+    // Optional, may be null. Preferred over on_bar when set: instructions are written into the host's buffer instead
+    // of plugin-owned memory. Instructions that do not fit may still be returned through the result.
+    PluginResult (*on_bar_into)(void* self, const Bar* bar, const CState* state, CInstructionBuffer* out);
+
+    // Optional, may be null, but a plugin that keeps state between bars needs both for a resumed back test to match an
+    // uninterrupted one. save_state hands out plugin-owned bytes, valid until the plugin's next call. restore_state gets
+    // bytes an earlier save_state handed out, before the first bar of the resumed run.
+    PluginResult (*save_state)(void* self, const uint8_t** data_out, size_t* size_out);
+    PluginResult (*restore_state)(void* self, const uint8_t* data, size_t size);
 } PluginVTable;
 // NOLINTEND(readability-identifier-naming)
 
 // ---- Factory export every plugin must provide
 typedef struct PluginExport {
-    int api_version_;      // must equal PLUGIN_API_VERSION
+    int api_version_;      // PLUGIN_API_VERSION_V1_SIZED, or PLUGIN_API_VERSION for a vtable ending at free_string
     void* instance_;       // opaque pointer to plugin state
     PluginVTable vtable_;  // function pointers
 } PluginExport;
@@ -177,6 +264,143 @@ typedef struct PluginExport {
 #define PLUGIN_CREATE_SYMBOL "create_plugin"
 typedef PluginExport (*CreatePluginFn)(const SimulatorContext* ctx);
 
+// ---- API v2
+// Same lifecycle as v1, but everything crossing the boundary on the hot path is plain data: symbols are ids, actions and
+// order types are enums and every price is int64 microdollars. A symbol's id is its index in the manifest's
+// host_params.symbols, and on_init receives the table mapping ids back to names.
+//
+// The host looks up PLUGIN_CREATE_V2_SYMBOL first and calls it with ctx->api_version_ set to the newest version it
+// supports. A plugin that returns an export whose api_version_ is neither v2 revision, or that does not export
+// the symbol at all, is loaded through the v1 PLUGIN_CREATE_SYMBOL instead.
+
+typedef uint32_t CSymbolId;
+#define SYMBOL_ID_UNKNOWN UINT32_MAX
+
+typedef enum CAction {
+    ACTION_BUY = 0,
+    ACTION_SELL = 1,
+} CAction;
+
+typedef enum COrderType {
+    ORDER_TYPE_MARKET = 0,
+    ORDER_TYPE_LIMIT = 1,
+} COrderType;
+
+typedef struct CSymbolTable {
+    const char* const* symbols_;  // Indexed by CSymbolId
+    size_t count_;
+} CSymbolTable;
+
+typedef struct CBarV2 {
+    int64_t unix_ts_ns_;
+    double open_;
+    double high_;
+    double low_;
+    double close_;
+    double volume_;
+    CSymbolId symbol_id_;
+    uint32_t reserved_;
+} CBarV2;
+
+typedef struct CPositionV2 {
+    CSymbolId symbol_id_;
+    uint32_t reserved_;
+    double quantity_;
+    int64_t average_price_;
+} CPositionV2;
+
+// Fill ids are assigned by the host in the order fills are first reported, and exit orders refer to them.
+typedef struct CFillV2 {
+    uint64_t fill_id_;
+    CSymbolId symbol_id_;
+    CAction action_;
+    double quantity_;
+    int64_t price_;
+    int64_t created_at_ns_;
+} CFillV2;
+
+// trigger_price_ is the stop loss price or the take profit price, depending on type_.
+typedef struct CExitOrderV2 {
+    uint64_t fill_id_;
+    CSymbolId symbol_id_;
+    CExitOrderType type_;
+    double trigger_quantity_;
+    int64_t trigger_price_;
+    int64_t price_;
+    int64_t created_at_ns_;
+    bool is_triggered_;
+} CExitOrderV2;
+
+typedef struct CIndicatorValueV2 {
+    CSymbolId symbol_id_;
+    CIndicatorType type_;
+    double values_[INDICATOR_MAX_OUTPUTS];
+    bool is_ready_;
+} CIndicatorValueV2;
+
+typedef struct CStateV2 {
+    int64_t cash_;
+    const CPositionV2* positions_;
+    size_t positions_count_;
+    const CExitOrderV2* new_exit_orders_;
+    size_t new_exit_orders_count_;
+    const CFillV2* new_fills_;
+    size_t new_fills_count_;
+    const CEquitySnapshot* equity_curve_;
+    size_t equity_curve_count_;
+    const CIndicatorValueV2* indicators_;
+    size_t indicators_count_;
+} CStateV2;
+
+// One cache line. Signals only use type_, symbol_id_ and action_; unused prices are INT64_MIN, as in v1.
+typedef struct CInstructionV2 {
+    CInstructionType type_;
+    CSymbolId symbol_id_;
+    CAction action_;
+    COrderType order_type_;
+    double quantity_;
+    double leverage_;
+    int64_t limit_price_;
+    int64_t stop_loss_price_;
+    int64_t take_profit_price_;
+    uint64_t reserved_;
+} CInstructionV2;
+
+// NOLINTBEGIN(readability-identifier-naming)
+typedef struct PluginResultV2 {
+    int32_t code_;         // 0 == OK
+    const char* message_;  // optional (owned by plugin, valid until next call)
+    const CInstructionV2* instructions_;
+    size_t instructions_count_;
+} PluginResultV2;
+
+typedef struct PluginVTableV2 {
+    void (*destroy)(void* self);
+    PluginResultV2 (*on_init)(void* self, const PluginOptions* opts, const CSymbolTable* symbols);
+    PluginResultV2 (*on_start)(void* self);
+    PluginResultV2 (*on_bar)(void* self, const CBarV2* bar, const CStateV2* state);
+    PluginResultV2 (*on_end)(void* self, const char** json_out);
+    void (*free_string)(void* self, const char* json_out_str);
+    // Optional, may be null. See PluginVTable::precompute_signals.
+    PluginResultV2 (*precompute_signals)(void* self, const CSeries* series, CSignalColumn* signals, size_t series_count);
+    // sizeof(PluginVTableV2) as the plugin was built, with api_version_ set to PLUGIN_API_VERSION_V2_SIZED. Slots past
+    // this field are only read when they lie within vtable_size_.
+    size_t vtable_size_;
+    // Optional, may be null. See PluginVTable::save_state.
+    PluginResultV2 (*save_state)(void* self, const uint8_t** data_out, size_t* size_out);
+    PluginResultV2 (*restore_state)(void* self, const uint8_t* data, size_t size);
+} PluginVTableV2;
+// NOLINTEND(readability-identifier-naming)
+
+typedef struct PluginExportV2 {
+    int api_version_;  // PLUGIN_API_VERSION_V2_SIZED, or PLUGIN_API_VERSION_V2 for a vtable ending at precompute_signals
+    void* instance_;
+    PluginVTableV2 vtable_;
+} PluginExportV2;
+
+#define PLUGIN_CREATE_V2_SYMBOL "create_plugin_v2"
+typedef PluginExportV2 (*CreatePluginV2Fn)(const SimulatorContext* ctx);
+
 #ifdef __cplusplus
 }
 #endif
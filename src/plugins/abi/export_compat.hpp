@@ -0,0 +1,67 @@
+#ifndef QUANT_FORGE_EXPORT_COMPAT_HPP
+#define QUANT_FORGE_EXPORT_COMPAT_HPP
+
+#pragma once
+
+#include <cstddef>
+
+#include "abi.h"
+
+namespace plugins::abi {
+
+    // Brings an export from any v1 revision into the form the host works with: api_version_ is PLUGIN_API_VERSION and
+    // every optional slot the plugin was not built with is null, whatever the export's memory held past its end.
+    // Returns false for an export of no known v1 revision.
+    inline bool normalize_export(PluginExport& exp) {
+        size_t vtable_size = offsetof(PluginVTable, vtable_size_);
+        if (exp.api_version_ == PLUGIN_API_VERSION_V1_SIZED) {
+            vtable_size = exp.vtable_.vtable_size_;
+        } else if (exp.api_version_ != PLUGIN_API_VERSION) {
+            return false;
+        }
+
+        auto& vtable = exp.vtable_;
+        const auto has_slot = [vtable_size](size_t offset, size_t size) { return offset + size <= vtable_size; };
+        if (!has_slot(offsetof(PluginVTable, precompute_signals), sizeof(vtable.precompute_signals))) {
+            vtable.precompute_signals = nullptr;
+        }
+        // on_bar_into is preferred over on_bar whenever it is set, so a stale pointer here would be called on every bar.
+        if (!has_slot(offsetof(PluginVTable, on_bar_into), sizeof(vtable.on_bar_into))) {
+            vtable.on_bar_into = nullptr;
+        }
+        if (!has_slot(offsetof(PluginVTable, save_state), sizeof(vtable.save_state)) ||
+            !has_slot(offsetof(PluginVTable, restore_state), sizeof(vtable.restore_state))) {
+            vtable.save_state = nullptr;
+            vtable.restore_state = nullptr;
+        }
+
+        exp.api_version_ = PLUGIN_API_VERSION;
+        vtable.vtable_size_ = sizeof(PluginVTable);
+        return true;
+    }
+
+    // The v2 counterpart of normalize_export, leaving api_version_ at PLUGIN_API_VERSION_V2.
+    inline bool normalize_export_v2(PluginExportV2& exp) {
+        size_t vtable_size = offsetof(PluginVTableV2, vtable_size_);
+        if (exp.api_version_ == PLUGIN_API_VERSION_V2_SIZED) {
+            vtable_size = exp.vtable_.vtable_size_;
+        } else if (exp.api_version_ != PLUGIN_API_VERSION_V2) {
+            return false;
+        }
+
+        auto& vtable = exp.vtable_;
+        const auto has_slot = [vtable_size](size_t offset, size_t size) { return offset + size <= vtable_size; };
+        if (!has_slot(offsetof(PluginVTableV2, save_state), sizeof(vtable.save_state)) ||
+            !has_slot(offsetof(PluginVTableV2, restore_state), sizeof(vtable.restore_state))) {
+            vtable.save_state = nullptr;
+            vtable.restore_state = nullptr;
+        }
+
+        exp.api_version_ = PLUGIN_API_VERSION_V2;
+        vtable.vtable_size_ = sizeof(PluginVTableV2);
+        return true;
+    }
+
+}  // namespace plugins::abi
+
+#endif
@@ -0,0 +1,369 @@
+#include "ipc_codec.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static constexpr uint32_t NULL_STRING_LENGTH = std::numeric_limits<uint32_t>::max();
+
+namespace plugins::isolation {
+
+    void BufferWriter::put_string(const char* value) {
+        if (value == nullptr) {
+            put<uint32_t>(NULL_STRING_LENGTH);
+            return;
+        }
+
+        const auto length = static_cast<uint32_t>(std::strlen(value));
+        put<uint32_t>(length);
+        bytes_.insert(bytes_.end(), value, value + length);
+    }
+
+    const uint8_t* BufferReader::take(size_t count) {
+        if (offset_ + count > bytes_.size()) {
+            throw std::runtime_error("Truncated plugin IPC message");
+        }
+
+        const uint8_t* data = bytes_.data() + offset_;
+        offset_ += count;
+        return data;
+    }
+
+    const char* BufferReader::get_string(std::deque<std::string>& storage) {
+        const auto length = get<uint32_t>();
+        if (length == NULL_STRING_LENGTH) {
+            return nullptr;
+        }
+
+        const auto* data = take(length);
+        return storage.emplace_back(data, data + length).c_str();
+    }
+
+    void encode_bar(BufferWriter& writer, const CBar& bar) {
+        writer.put_string(bar.symbol_);
+        writer.put(bar.unix_ts_ns_);
+        writer.put(bar.open_);
+        writer.put(bar.high_);
+        writer.put(bar.low_);
+        writer.put(bar.close_);
+        writer.put(bar.volume_);
+    }
+
+    void decode_bar(BufferReader& reader, BarFrame& frame) {
+        frame.strings_.clear();
+        frame.bar_.symbol_ = reader.get_string(frame.strings_);
+        frame.bar_.unix_ts_ns_ = reader.get<int64_t>();
+        frame.bar_.open_ = reader.get<double>();
+        frame.bar_.high_ = reader.get<double>();
+        frame.bar_.low_ = reader.get<double>();
+        frame.bar_.close_ = reader.get<double>();
+        frame.bar_.volume_ = reader.get<double>();
+    }
+
+    void encode_state(BufferWriter& writer, const CState& state, EquitySent& equity_sent) {
+        writer.put(state.cash_);
+
+        writer.put<uint64_t>(state.positions_count_);
+        for (size_t i = 0; i < state.positions_count_; ++i) {
+            writer.put_string(state.positions_[i].symbol_);
+            writer.put(state.positions_[i].quantity_);
+            writer.put(state.positions_[i].average_price_);
+        }
+
+        writer.put<uint64_t>(state.new_fills_count_);
+        for (size_t i = 0; i < state.new_fills_count_; ++i) {
+            const auto& fill = state.new_fills_[i];
+            writer.put(fill.quantity_);
+            writer.put(fill.price_);
+            writer.put(fill.created_at_ns_);
+            writer.put_string(fill.symbol_);
+            writer.put_string(fill.uuid_);
+            writer.put_string(fill.action_);
+        }
+
+        writer.put<uint64_t>(state.new_exit_orders_count_);
+        for (size_t i = 0; i < state.new_exit_orders_count_; ++i) {
+            const auto& exit_order = state.new_exit_orders_[i];
+            writer.put(exit_order.type_);
+            // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+            if (exit_order.type_ == EXIT_ORDER_STOP_LOSS) {
+                const auto& order = exit_order.data_.stop_loss_;
+                writer.put(order.is_triggered_);
+                writer.put(order.trigger_quantity_);
+                writer.put(order.stop_loss_price_);
+                writer.put(order.price_);
+                writer.put(order.created_at_ns_);
+                writer.put_string(order.symbol_);
+                writer.put_string(order.fill_uuid_);
+            } else {
+                const auto& order = exit_order.data_.take_profit_;
+                writer.put(order.is_triggered_);
+                writer.put(order.trigger_quantity_);
+                writer.put(order.take_profit_price_);
+                writer.put(order.price_);
+                writer.put(order.created_at_ns_);
+                writer.put_string(order.symbol_);
+                writer.put_string(order.fill_uuid_);
+            }
+            // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+        }
+
+        const int64_t first_timestamp_ns = state.equity_curve_count_ > 0 ? state.equity_curve_[0].timestamp_ns_ : 0;
+        if (first_timestamp_ns != equity_sent.first_timestamp_ns_) {
+            equity_sent.count_ = 0;
+        }
+        const size_t equity_start = std::min(equity_sent.count_ > 0 ? equity_sent.count_ - 1 : 0, state.equity_curve_count_);
+        writer.put<uint64_t>(equity_start);
+        writer.put_array(state.equity_curve_ + equity_start, state.equity_curve_count_ - equity_start);
+        equity_sent = EquitySent{.count_ = state.equity_curve_count_, .first_timestamp_ns_ = first_timestamp_ns};
+
+        writer.put<uint64_t>(state.indicators_count_);
+        for (size_t i = 0; i < state.indicators_count_; ++i) {
+            const auto& indicator = state.indicators_[i];
+            writer.put_string(indicator.symbol_);
+            writer.put(indicator.type_);
+            writer.put(indicator.is_ready_);
+            for (const double value : indicator.values_) {
+                writer.put(value);
+            }
+        }
+    }
+
+    void decode_state(BufferReader& reader, StateFrame& frame) {
+        frame.strings_.clear();
+        frame.state_.cash_ = reader.get<int64_t>();
+
+        frame.positions_.resize(reader.get<uint64_t>());
+        for (auto& position : frame.positions_) {
+            position.symbol_ = reader.get_string(frame.strings_);
+            position.quantity_ = reader.get<double>();
+            position.average_price_ = reader.get<double>();
+        }
+
+        frame.new_fills_.resize(reader.get<uint64_t>());
+        for (auto& fill : frame.new_fills_) {
+            fill.quantity_ = reader.get<double>();
+            fill.price_ = reader.get<int64_t>();
+            fill.created_at_ns_ = reader.get<int64_t>();
+            fill.symbol_ = reader.get_string(frame.strings_);
+            fill.uuid_ = reader.get_string(frame.strings_);
+            fill.action_ = reader.get_string(frame.strings_);
+        }
+
+        frame.new_exit_orders_.resize(reader.get<uint64_t>());
+        for (auto& exit_order : frame.new_exit_orders_) {
+            exit_order.type_ = reader.get<CExitOrderType>();
+            // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+            if (exit_order.type_ == EXIT_ORDER_STOP_LOSS) {
+                auto& order = exit_order.data_.stop_loss_;
+                order.is_triggered_ = reader.get<bool>();
+                order.trigger_quantity_ = reader.get<double>();
+                order.stop_loss_price_ = reader.get<int64_t>();
+                order.price_ = reader.get<int64_t>();
+                order.created_at_ns_ = reader.get<int64_t>();
+                order.symbol_ = reader.get_string(frame.strings_);
+                order.fill_uuid_ = reader.get_string(frame.strings_);
+            } else {
+                auto& order = exit_order.data_.take_profit_;
+                order.is_triggered_ = reader.get<bool>();
+                order.trigger_quantity_ = reader.get<double>();
+                order.take_profit_price_ = reader.get<int64_t>();
+                order.price_ = reader.get<int64_t>();
+                order.created_at_ns_ = reader.get<int64_t>();
+                order.symbol_ = reader.get_string(frame.strings_);
+                order.fill_uuid_ = reader.get_string(frame.strings_);
+            }
+            // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+        }
+
+        const auto equity_start = reader.get<uint64_t>();
+        std::vector<CEquitySnapshot> equity_delta;
+        reader.get_array(equity_delta);
+        frame.equity_curve_.resize(std::min<size_t>(equity_start, frame.equity_curve_.size()));
+        frame.equity_curve_.insert(frame.equity_curve_.end(), equity_delta.begin(), equity_delta.end());
+
+        frame.indicators_.resize(reader.get<uint64_t>());
+        for (auto& indicator : frame.indicators_) {
+            indicator.symbol_ = reader.get_string(frame.strings_);
+            indicator.type_ = reader.get<CIndicatorType>();
+            indicator.is_ready_ = reader.get<bool>();
+            for (double& value : indicator.values_) {
+                value = reader.get<double>();
+            }
+        }
+
+        frame.state_.positions_ = frame.positions_.data();
+        frame.state_.positions_count_ = frame.positions_.size();
+        frame.state_.new_fills_ = frame.new_fills_.data();
+        frame.state_.new_fills_count_ = frame.new_fills_.size();
+        frame.state_.new_exit_orders_ = frame.new_exit_orders_.data();
+        frame.state_.new_exit_orders_count_ = frame.new_exit_orders_.size();
+        frame.state_.equity_curve_ = frame.equity_curve_.data();
+        frame.state_.equity_curve_count_ = frame.equity_curve_.size();
+        frame.state_.indicators_ = frame.indicators_.data();
+        frame.state_.indicators_count_ = frame.indicators_.size();
+    }
+
+    namespace {
+        void encode_instruction(BufferWriter& writer, const CInstruction& instruction) {
+            writer.put(instruction.type_);
+            // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+            if (instruction.type_ == INSTRUCTION_TYPE_SIGNAL) {
+                writer.put_string(instruction.data_.signal_.symbol_);
+                writer.put_string(instruction.data_.signal_.action_);
+            } else {
+                const auto& order = instruction.data_.order_;
+                writer.put_string(order.symbol_);
+                writer.put_string(order.action_);
+                writer.put(order.quantity_);
+                writer.put(order.leverage_);
+                writer.put(order.limit_price_);
+                writer.put(order.stop_loss_price_);
+                writer.put(order.take_profit_price_);
+                writer.put_string(order.order_type_);
+            }
+            // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+        }
+    }  // namespace
+
+    void encode_result(BufferWriter& writer, const PluginResult& result, const CInstructionBuffer* buffer) {
+        writer.put(result.code_);
+        writer.put_string(result.message_);
+
+        const size_t buffered = buffer != nullptr ? std::min(buffer->count_, buffer->capacity_) : 0;
+        const size_t count = result.instructions_ != nullptr ? result.instructions_count_ : 0;
+        writer.put<uint64_t>(buffered + count);
+        for (size_t i = 0; i < buffered; ++i) {
+            encode_instruction(writer, buffer->instructions_[i]);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            encode_instruction(writer, result.instructions_[i]);
+        }
+    }
+
+    void decode_result(BufferReader& reader, ResultFrame& frame) {
+        frame.strings_.clear();
+        frame.result_.code_ = reader.get<int32_t>();
+        frame.result_.message_ = reader.get_string(frame.strings_);
+
+        frame.instructions_.resize(reader.get<uint64_t>());
+        for (auto& instruction : frame.instructions_) {
+            instruction = CInstruction{};
+            instruction.type_ = reader.get<CInstructionType>();
+            // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+            if (instruction.type_ == INSTRUCTION_TYPE_SIGNAL) {
+                instruction.data_.signal_.symbol_ = reader.get_string(frame.strings_);
+                instruction.data_.signal_.action_ = reader.get_string(frame.strings_);
+            } else {
+                auto& order = instruction.data_.order_;
+                order.symbol_ = reader.get_string(frame.strings_);
+                order.action_ = reader.get_string(frame.strings_);
+                order.quantity_ = reader.get<double>();
+                order.leverage_ = reader.get<double>();
+                order.limit_price_ = reader.get<int64_t>();
+                order.stop_loss_price_ = reader.get<int64_t>();
+                order.take_profit_price_ = reader.get<int64_t>();
+                order.order_type_ = reader.get_string(frame.strings_);
+            }
+            // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+        }
+
+        frame.result_.instructions_ = frame.instructions_.empty() ? nullptr : frame.instructions_.data();
+        frame.result_.instructions_count_ = frame.instructions_.size();
+    }
+
+    void encode_options(BufferWriter& writer, const PluginOptions& options) {
+        writer.put<uint64_t>(options.count_);
+        for (size_t i = 0; i < options.count_; ++i) {
+            writer.put_string(options.items_[i].key_);
+            writer.put_string(options.items_[i].value_);
+        }
+    }
+
+    void decode_options(BufferReader& reader, OptionsFrame& frame) {
+        frame.strings_.clear();
+        frame.items_.resize(reader.get<uint64_t>());
+        for (auto& item : frame.items_) {
+            item.key_ = reader.get_string(frame.strings_);
+            item.value_ = reader.get_string(frame.strings_);
+        }
+
+        frame.options_ = PluginOptions{frame.items_.data(), frame.items_.size()};
+    }
+
+    void encode_series(BufferWriter& writer, const CSeries* series, size_t series_count) {
+        writer.put<uint64_t>(series_count);
+        for (size_t i = 0; i < series_count; ++i) {
+            const auto& s = series[i];
+            writer.put_string(s.symbol_);
+            writer.put_array(s.unix_ts_ns_, s.count_);
+            writer.put_array(s.open_, s.count_);
+            writer.put_array(s.high_, s.count_);
+            writer.put_array(s.low_, s.count_);
+            writer.put_array(s.close_, s.count_);
+            writer.put_array(s.volume_, s.count_);
+        }
+    }
+
+    void decode_series(BufferReader& reader, SeriesFrame& frame) {
+        static constexpr size_t PRICE_COLUMNS = 5;
+
+        const auto series_count = reader.get<uint64_t>();
+        frame.strings_.clear();
+        frame.series_.resize(series_count);
+        frame.signals_.resize(series_count);
+        frame.timestamps_.resize(series_count);
+        frame.columns_.resize(series_count * PRICE_COLUMNS);
+        frame.signal_values_.resize(series_count);
+
+        for (size_t i = 0; i < series_count; ++i) {
+            const char* symbol = reader.get_string(frame.strings_);
+            reader.get_array(frame.timestamps_[i]);
+
+            auto* columns = &frame.columns_[i * PRICE_COLUMNS];
+            for (size_t c = 0; c < PRICE_COLUMNS; ++c) {
+                reader.get_array(columns[c]);
+            }
+
+            const size_t count = frame.timestamps_[i].size();
+            frame.signal_values_[i].assign(count, SIGNAL_VALUE_NONE);
+
+            frame.series_[i] = CSeries{
+                .symbol_ = symbol,
+                .unix_ts_ns_ = frame.timestamps_[i].data(),
+                .open_ = columns[0].data(),
+                .high_ = columns[1].data(),
+                .low_ = columns[2].data(),
+                .close_ = columns[3].data(),
+                .volume_ = columns[4].data(),
+                .count_ = count,
+            };
+            frame.signals_[i] = CSignalColumn{.symbol_ = symbol, .signals_ = frame.signal_values_[i].data(), .count_ = count};
+        }
+    }
+
+    void encode_signals(BufferWriter& writer, const CSignalColumn* signals, size_t series_count) {
+        writer.put<uint64_t>(series_count);
+        for (size_t i = 0; i < series_count; ++i) {
+            writer.put_array(signals[i].signals_, signals[i].count_);
+        }
+    }
+
+    void decode_signals(BufferReader& reader, CSignalColumn* signals, size_t series_count) {
+        if (reader.get<uint64_t>() != series_count) {
+            throw std::runtime_error("Plugin worker returned signals for a different number of series");
+        }
+
+        std::vector<int8_t> values;
+        for (size_t i = 0; i < series_count; ++i) {
+            reader.get_array(values);
+            std::copy_n(values.begin(), std::min(values.size(), signals[i].count_), signals[i].signals_);
+        }
+    }
+
+}  // namespace plugins::isolation
@@ -0,0 +1,141 @@
+#ifndef QUANT_FORGE_PLUGINS_ISOLATION_IPC_CODEC_HPP
+#define QUANT_FORGE_PLUGINS_ISOLATION_IPC_CODEC_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../abi/abi.h"
+
+namespace plugins::isolation {
+
+    // Host byte order and layout, since both ends of a channel are the same binary.
+    class BufferWriter {
+       public:
+        template <typename T>
+        void put(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&value);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            bytes_.insert(bytes_.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T>
+        void put_array(const T* values, size_t count) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            put<uint64_t>(count);
+            const auto* bytes = reinterpret_cast<const uint8_t*>(values);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            bytes_.insert(bytes_.end(), bytes, bytes + (count * sizeof(T)));
+        }
+
+        void put_string(const char* value);
+        void clear() { bytes_.clear(); }
+        [[nodiscard]] std::span<const uint8_t> get_bytes() const { return bytes_; }
+
+       private:
+        std::vector<uint8_t> bytes_;
+    };
+
+    class BufferReader {
+       public:
+        explicit BufferReader(std::span<const uint8_t> bytes) : bytes_(bytes) {}
+
+        template <typename T>
+        T get() {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value{};
+            std::memcpy(&value, take(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void get_array(std::vector<T>& out) {
+            const auto count = get<uint64_t>();
+            out.resize(count);
+            if (count > 0) {
+                std::memcpy(out.data(), take(count * sizeof(T)), count * sizeof(T));
+            }
+        }
+
+        // Strings are copied into storage, which must outlive every pointer handed out.
+        const char* get_string(std::deque<std::string>& storage);
+
+       private:
+        std::span<const uint8_t> bytes_;
+        size_t offset_ = 0;
+
+        const uint8_t* take(size_t count);
+    };
+
+    // Owns everything a decoded CState points into. The worker keeps one for the whole run, so the equity curve is only
+    // sent as a delta.
+    struct StateFrame {
+        CState state_{};
+        std::vector<CPosition> positions_;
+        std::vector<CFill> new_fills_;
+        std::vector<CExitOrder> new_exit_orders_;
+        std::vector<CEquitySnapshot> equity_curve_;
+        std::vector<CIndicatorValue> indicators_;
+        std::deque<std::string> strings_;
+    };
+
+    struct BarFrame {
+        CBar bar_{};
+        std::deque<std::string> strings_;
+    };
+
+    struct ResultFrame {
+        PluginResult result_{};
+        std::vector<CInstruction> instructions_;
+        std::deque<std::string> strings_;
+    };
+
+    struct SeriesFrame {
+        std::vector<CSeries> series_;
+        std::vector<CSignalColumn> signals_;
+        std::vector<std::vector<int64_t>> timestamps_;
+        std::vector<std::vector<double>> columns_;
+        std::vector<std::vector<int8_t>> signal_values_;
+        std::deque<std::string> strings_;
+    };
+
+    struct OptionsFrame {
+        PluginOptions options_{};
+        std::vector<PluginConfigKV> items_;
+        std::deque<std::string> strings_;
+    };
+
+    void encode_bar(BufferWriter& writer, const CBar& bar);
+    void decode_bar(BufferReader& reader, BarFrame& frame);
+
+    // What the receiving side already holds of the equity curve. The last snapshot is resent because the host may still
+    // update it in place, and a curve whose first snapshot changed (trimmed to a window) is resent whole.
+    struct EquitySent {
+        size_t count_ = 0;
+        int64_t first_timestamp_ns_ = 0;
+    };
+
+    void encode_state(BufferWriter& writer, const CState& state, EquitySent& equity_sent);
+    void decode_state(BufferReader& reader, StateFrame& frame);
+
+    // Instructions written into buffer, if any, are sent ahead of those in the result.
+    void encode_result(BufferWriter& writer, const PluginResult& result, const CInstructionBuffer* buffer = nullptr);
+    void decode_result(BufferReader& reader, ResultFrame& frame);
+
+    void encode_options(BufferWriter& writer, const PluginOptions& options);
+    void decode_options(BufferReader& reader, OptionsFrame& frame);
+
+    void encode_series(BufferWriter& writer, const CSeries* series, size_t series_count);
+    void decode_series(BufferReader& reader, SeriesFrame& frame);
+    void encode_signals(BufferWriter& writer, const CSignalColumn* signals, size_t series_count);
+    void decode_signals(BufferReader& reader, CSignalColumn* signals, size_t series_count);
+
+}  // namespace plugins::isolation
+
+#endif
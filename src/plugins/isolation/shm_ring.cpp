@@ -0,0 +1,228 @@
+#include "shm_ring.hpp"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <ctime>
+#endif
+
+static constexpr size_t FRAME_HEADER_BYTES = 8;
+static constexpr size_t FRAME_ALIGNMENT = 8;
+static constexpr uint16_t FRAME_FLAG_MORE = 1;
+static constexpr uint16_t FRAME_FLAG_WRAP = 2;
+// Roughly a few microseconds of polling before falling back to the futex.
+static constexpr int SPIN_ITERATIONS = 4000;
+static constexpr auto FUTEX_TIMEOUT = std::chrono::milliseconds(50);
+
+namespace plugins::isolation {
+    namespace {
+        struct FrameHeader {
+            uint32_t size_;
+            uint16_t type_;
+            uint16_t flags_;
+        };
+
+        static_assert(sizeof(FrameHeader) == FRAME_HEADER_BYTES);
+        static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+                      "Ring counters must be lock free to be shared between processes");
+
+        size_t align_to(size_t bytes, size_t alignment) { return (bytes + alignment - 1) & ~(alignment - 1); }
+
+        size_t align_frame(size_t bytes) { return align_to(bytes, FRAME_ALIGNMENT); }
+
+        void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+
+        // std::atomic::wait uses process private futexes, so the shared rings call the syscall directly.
+        void futex_wait(std::atomic<uint32_t>& word, uint32_t expected) {
+#if defined(__linux__)
+            timespec timeout{.tv_sec = 0, .tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(FUTEX_TIMEOUT).count()};
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-type-vararg)
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else
+            if (word.load() == expected) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+#endif
+        }
+
+        void futex_wake(std::atomic<uint32_t>& word) {
+#if defined(__linux__)
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-type-vararg)
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#else
+            (void)word;
+#endif
+        }
+
+        void notify(std::atomic<uint32_t>& seq, const std::atomic<uint32_t>& waiting) {
+            seq.fetch_add(1);
+            if (waiting.load() != 0) {
+                futex_wake(seq);
+            }
+        }
+
+        // The waiter flag is raised before sampling seq and re-checking, so a publish between the check and the sleep
+        // either changes seq (the futex returns at once) or sees the flag and wakes us.
+        template <typename Predicate>
+        bool wait_until(const Predicate& is_ready, std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiting, const std::function<bool()>& is_peer_alive) {
+            // On a single core the peer cannot make progress while we spin, so go straight to the futex.
+            static const int spin_iterations = std::thread::hardware_concurrency() > 1 ? SPIN_ITERATIONS : 0;
+
+            for (int i = 0; i < spin_iterations; ++i) {
+                if (is_ready()) {
+                    return true;
+                }
+                cpu_relax();
+            }
+
+            while (true) {
+                waiting.store(1);
+                const uint32_t observed = seq.load();
+                if (is_ready()) {
+                    waiting.store(0);
+                    return true;
+                }
+
+                futex_wait(seq, observed);
+                waiting.store(0);
+
+                if (is_ready()) {
+                    return true;
+                }
+                if (!is_peer_alive()) {
+                    return false;
+                }
+            }
+        }
+    }  // namespace
+
+    ShmRing::ShmRing(RingHeader* header, uint8_t* data, size_t capacity) : header_(header), data_(data), capacity_(capacity) {}
+
+    bool ShmRing::write(MessageType type, std::span<const uint8_t> payload, const std::function<bool()>& is_peer_alive) {
+        const size_t max_payload = get_max_frame_payload();
+
+        do {
+            const size_t chunk = std::min(payload.size(), max_payload);
+            const bool has_more = chunk < payload.size();
+
+            if (!write_frame(type, has_more ? FRAME_FLAG_MORE : 0, payload.first(chunk), is_peer_alive)) {
+                return false;
+            }
+
+            payload = payload.subspan(chunk);
+        } while (!payload.empty());
+
+        return true;
+    }
+
+    bool ShmRing::write_frame(MessageType type, uint16_t flags, std::span<const uint8_t> payload, const std::function<bool()>& is_peer_alive) {
+        const uint64_t head = header_->head_.load(std::memory_order_relaxed);
+        const size_t position = head % capacity_;
+        const size_t contiguous = capacity_ - position;
+        const size_t frame_bytes = align_frame(FRAME_HEADER_BYTES + payload.size());
+        // A frame never straddles the end of the buffer; the remainder is skipped with a wrap marker instead.
+        const size_t skip_bytes = contiguous < frame_bytes ? contiguous : 0;
+        const size_t needed = skip_bytes + frame_bytes;
+
+        auto has_space = [this, head, needed]() { return capacity_ - (head - header_->tail_.load(std::memory_order_acquire)) >= needed; };
+
+        if (!wait_until(has_space, header_->space_seq_, header_->producer_waiting_, is_peer_alive)) {
+            return false;
+        }
+
+        if (skip_bytes > 0) {
+            const FrameHeader wrap{.size_ = 0, .type_ = 0, .flags_ = FRAME_FLAG_WRAP};
+            std::memcpy(data_ + position, &wrap, sizeof(wrap));
+        }
+
+        const size_t frame_position = (head + skip_bytes) % capacity_;
+        const FrameHeader frame{.size_ = static_cast<uint32_t>(payload.size()), .type_ = static_cast<uint16_t>(type), .flags_ = flags};
+        std::memcpy(data_ + frame_position, &frame, sizeof(frame));
+        if (!payload.empty()) {
+            std::memcpy(data_ + frame_position + FRAME_HEADER_BYTES, payload.data(), payload.size());
+        }
+
+        header_->head_.store(head + needed, std::memory_order_release);
+        notify(header_->data_seq_, header_->consumer_waiting_);
+        return true;
+    }
+
+    bool ShmRing::read(MessageType& type, std::vector<uint8_t>& payload, const std::function<bool()>& is_peer_alive) {
+        payload.clear();
+
+        while (true) {
+            uint64_t tail = header_->tail_.load(std::memory_order_relaxed);
+            auto has_data = [this, &tail]() { return header_->head_.load(std::memory_order_acquire) != tail; };
+
+            if (!wait_until(has_data, header_->data_seq_, header_->consumer_waiting_, is_peer_alive)) {
+                return false;
+            }
+
+            const size_t position = tail % capacity_;
+            FrameHeader frame{};
+            std::memcpy(&frame, data_ + position, sizeof(frame));
+
+            if ((frame.flags_ & FRAME_FLAG_WRAP) != 0) {
+                header_->tail_.store(tail + (capacity_ - position), std::memory_order_release);
+                notify(header_->space_seq_, header_->producer_waiting_);
+                continue;
+            }
+
+            const uint8_t* frame_payload = data_ + position + FRAME_HEADER_BYTES;
+            payload.insert(payload.end(), frame_payload, frame_payload + frame.size_);
+            type = static_cast<MessageType>(frame.type_);
+
+            tail += align_frame(FRAME_HEADER_BYTES + frame.size_);
+            header_->tail_.store(tail, std::memory_order_release);
+            notify(header_->space_seq_, header_->producer_waiting_);
+
+            if ((frame.flags_ & FRAME_FLAG_MORE) == 0) {
+                return true;
+            }
+        }
+    }
+
+    SharedChannel::SharedChannel(size_t ring_bytes) {
+        const size_t capacity = align_to(ring_bytes, CACHE_LINE_BYTES);
+        const size_t header_bytes = align_to(sizeof(RingHeader), CACHE_LINE_BYTES);
+        mapping_bytes_ = 2 * (header_bytes + capacity);
+
+        mapping_ = mmap(nullptr, mapping_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            throw std::runtime_error("Failed to map shared plugin channel");
+        }
+
+        auto* base = static_cast<uint8_t*>(mapping_);
+        auto create_ring = [&](uint8_t* region) {
+            auto* header = new (region) RingHeader{};
+            return std::make_unique<ShmRing>(header, region + header_bytes, capacity);
+        };
+
+        requests_ = create_ring(base);
+        responses_ = create_ring(base + header_bytes + capacity);
+    }
+
+    SharedChannel::~SharedChannel() {
+        if (mapping_ != nullptr) {
+            munmap(mapping_, mapping_bytes_);
+        }
+    }
+}  // namespace plugins::isolation
@@ -0,0 +1,87 @@
+#ifndef QUANT_FORGE_PLUGINS_ISOLATION_SHM_RING_HPP
+#define QUANT_FORGE_PLUGINS_ISOLATION_SHM_RING_HPP
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace plugins::isolation {
+
+    inline constexpr size_t CACHE_LINE_BYTES = 64;
+    inline constexpr size_t DEFAULT_RING_BYTES = 4UL << 20U;
+
+    enum class MessageType : uint16_t {
+        HELLO = 0,
+        FAILURE = 1,
+        INIT = 2,
+        START = 3,
+        BAR = 4,
+        PRECOMPUTE_SIGNALS = 5,
+        END = 6,
+        SHUTDOWN = 7,
+        RESULT = 8,
+        SAVE_STATE = 9,
+        RESTORE_STATE = 10,
+    };
+
+    // Lives at the start of each ring inside the shared mapping. Producer and consumer fields sit on separate cache lines.
+    struct RingHeader {
+        alignas(CACHE_LINE_BYTES) std::atomic<uint64_t> head_;  // Bytes published by the producer
+        std::atomic<uint32_t> data_seq_;                        // Futex word, bumped on every publish
+        std::atomic<uint32_t> consumer_waiting_;
+        alignas(CACHE_LINE_BYTES) std::atomic<uint64_t> tail_;  // Bytes released by the consumer
+        std::atomic<uint32_t> space_seq_;                       // Futex word, bumped on every release
+        std::atomic<uint32_t> producer_waiting_;
+    };
+
+    // Single producer, single consumer ring of framed messages over memory shared between two processes.
+    // Waiters spin briefly, then sleep on a futex, so a round trip stays in the microseconds while idle peers cost nothing.
+    // Messages larger than a frame are split into continuation frames and reassembled by read.
+    class ShmRing {
+       public:
+        ShmRing(RingHeader* header, uint8_t* data, size_t capacity);
+
+        // Both return false when is_peer_alive reports the other process gone while waiting.
+        bool write(MessageType type, std::span<const uint8_t> payload, const std::function<bool()>& is_peer_alive);
+        bool read(MessageType& type, std::vector<uint8_t>& payload, const std::function<bool()>& is_peer_alive);
+
+       private:
+        RingHeader* header_;
+        uint8_t* data_;
+        size_t capacity_;
+
+        [[nodiscard]] size_t get_max_frame_payload() const { return capacity_ / 4; }
+        bool write_frame(MessageType type, uint16_t flags, std::span<const uint8_t> payload, const std::function<bool()>& is_peer_alive);
+    };
+
+    // Anonymous shared mapping holding a request ring (host to worker) and a response ring (worker to host).
+    // It is created before fork, so both processes map it at the same address.
+    class SharedChannel {
+       public:
+        explicit SharedChannel(size_t ring_bytes = DEFAULT_RING_BYTES);
+        ~SharedChannel();
+
+        SharedChannel(const SharedChannel&) = delete;
+        SharedChannel& operator=(const SharedChannel&) = delete;
+        SharedChannel(SharedChannel&&) = delete;
+        SharedChannel& operator=(SharedChannel&&) = delete;
+
+        [[nodiscard]] ShmRing& get_requests() { return *requests_; }
+        [[nodiscard]] ShmRing& get_responses() { return *responses_; }
+
+       private:
+        void* mapping_ = nullptr;
+        size_t mapping_bytes_ = 0;
+        std::unique_ptr<ShmRing> requests_;
+        std::unique_ptr<ShmRing> responses_;
+    };
+
+}  // namespace plugins::isolation
+
+#endif
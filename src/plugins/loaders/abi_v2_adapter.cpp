@@ -0,0 +1,293 @@
+#include "abi_v2_adapter.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "../../utils/constants.hpp"
+#include "../abi/abi.h"
+#include "../isolation/ipc_codec.hpp"
+#include "../manifest/manifest.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+
+namespace plugins::loaders {
+    namespace {
+        CAction to_c_action(const char* action) { return action != nullptr && std::strcmp(action, constants::SELL) == 0 ? ACTION_SELL : ACTION_BUY; }
+
+        const char* to_action_string(CAction action) { return action == ACTION_SELL ? constants::SELL : constants::BUY; }
+
+        const char* to_order_type_string(COrderType order_type) { return order_type == ORDER_TYPE_LIMIT ? constants::LIMIT : constants::MARKET; }
+
+        ABIV2Adapter& as_adapter(void* self) { return *static_cast<ABIV2Adapter*>(self); }
+    }  // namespace
+
+    ABIV2Adapter::ABIV2Adapter(PluginExportV2 exp, const std::vector<plugins::manifest::Symbol>& symbols) : exp_(exp) {
+        symbols_.reserve(symbols.size());
+        for (const auto& symbol : symbols) {
+            symbols_.push_back(symbol.symbol_);
+        }
+
+        // Filled only once symbols_ is complete, since the keys view its strings.
+        for (size_t i = 0; i < symbols_.size(); ++i) {
+            c_symbols_.push_back(symbols_[i].c_str());
+            symbol_ids_.emplace(symbols_[i], static_cast<CSymbolId>(i));
+        }
+    }
+
+    PluginExport ABIV2Adapter::get_v1_export() {
+        PluginVTable vtable{};
+        vtable.destroy = &ABIV2Adapter::destroy;
+        vtable.on_init = &ABIV2Adapter::on_init;
+        vtable.on_start = &ABIV2Adapter::on_start;
+        vtable.on_bar = &ABIV2Adapter::on_bar;
+        vtable.on_end = &ABIV2Adapter::on_end;
+        vtable.free_string = &ABIV2Adapter::free_string;
+        vtable.vtable_size_ = sizeof(PluginVTable);
+        vtable.precompute_signals = exp_.vtable_.precompute_signals != nullptr ? &ABIV2Adapter::precompute_signals : nullptr;
+        vtable.on_bar_into = &ABIV2Adapter::on_bar_into;
+
+        const bool has_state_hooks = exp_.vtable_.save_state != nullptr && exp_.vtable_.restore_state != nullptr;
+        vtable.save_state = has_state_hooks ? &ABIV2Adapter::save_state : nullptr;
+        vtable.restore_state = has_state_hooks ? &ABIV2Adapter::restore_state : nullptr;
+
+        return PluginExport{PLUGIN_API_VERSION, this, vtable};
+    }
+
+    CSymbolId ABIV2Adapter::get_symbol_id(const char* symbol) const {
+        if (symbol == nullptr) {
+            return SYMBOL_ID_UNKNOWN;
+        }
+
+        const auto it = symbol_ids_.find(std::string_view(symbol));
+        return it != symbol_ids_.end() ? it->second : SYMBOL_ID_UNKNOWN;
+    }
+
+    uint64_t ABIV2Adapter::get_fill_id(const char* uuid) {
+        if (uuid == nullptr) {
+            return 0;
+        }
+
+        return fill_ids_.try_emplace(uuid, fill_ids_.size() + 1).first->second;
+    }
+
+    CStateV2 ABIV2Adapter::to_v2_state(const CState& state) {
+        positions_.clear();
+        for (size_t i = 0; i < state.positions_count_; ++i) {
+            const auto& position = state.positions_[i];
+            positions_.push_back(CPositionV2{
+                .symbol_id_ = get_symbol_id(position.symbol_),
+                .reserved_ = 0,
+                .quantity_ = position.quantity_,
+                .average_price_ = std::llround(position.average_price_ * static_cast<double>(constants::MONEY_SCALED_BASE)),
+            });
+        }
+
+        fills_.clear();
+        for (size_t i = 0; i < state.new_fills_count_; ++i) {
+            const auto& fill = state.new_fills_[i];
+            fills_.push_back(CFillV2{
+                .fill_id_ = get_fill_id(fill.uuid_),
+                .symbol_id_ = get_symbol_id(fill.symbol_),
+                .action_ = to_c_action(fill.action_),
+                .quantity_ = fill.quantity_,
+                .price_ = fill.price_,
+                .created_at_ns_ = fill.created_at_ns_,
+            });
+        }
+
+        exit_orders_.clear();
+        for (size_t i = 0; i < state.new_exit_orders_count_; ++i) {
+            const auto& exit_order = state.new_exit_orders_[i];
+            const bool is_stop_loss = exit_order.type_ == EXIT_ORDER_STOP_LOSS;
+            const auto& stop_loss = exit_order.data_.stop_loss_;
+            const auto& take_profit = exit_order.data_.take_profit_;
+
+            exit_orders_.push_back(CExitOrderV2{
+                .fill_id_ = get_fill_id(is_stop_loss ? stop_loss.fill_uuid_ : take_profit.fill_uuid_),
+                .symbol_id_ = get_symbol_id(is_stop_loss ? stop_loss.symbol_ : take_profit.symbol_),
+                .type_ = exit_order.type_,
+                .trigger_quantity_ = is_stop_loss ? stop_loss.trigger_quantity_ : take_profit.trigger_quantity_,
+                .trigger_price_ = is_stop_loss ? stop_loss.stop_loss_price_ : take_profit.take_profit_price_,
+                .price_ = is_stop_loss ? stop_loss.price_ : take_profit.price_,
+                .created_at_ns_ = is_stop_loss ? stop_loss.created_at_ns_ : take_profit.created_at_ns_,
+                .is_triggered_ = is_stop_loss ? stop_loss.is_triggered_ : take_profit.is_triggered_,
+            });
+        }
+
+        indicators_.resize(state.indicators_count_);
+        for (size_t i = 0; i < state.indicators_count_; ++i) {
+            const auto& indicator = state.indicators_[i];
+            auto& indicator_v2 = indicators_[i];
+            indicator_v2.symbol_id_ = get_symbol_id(indicator.symbol_);
+            indicator_v2.type_ = indicator.type_;
+            indicator_v2.is_ready_ = indicator.is_ready_;
+            std::memcpy(indicator_v2.values_, indicator.values_, sizeof(indicator.values_));
+        }
+
+        // CEquitySnapshot has no strings, so both versions share it.
+        return CStateV2{
+            .cash_ = state.cash_,
+            .positions_ = positions_.data(),
+            .positions_count_ = positions_.size(),
+            .new_exit_orders_ = exit_orders_.data(),
+            .new_exit_orders_count_ = exit_orders_.size(),
+            .new_fills_ = fills_.data(),
+            .new_fills_count_ = fills_.size(),
+            .equity_curve_ = state.equity_curve_,
+            .equity_curve_count_ = state.equity_curve_count_,
+            .indicators_ = indicators_.data(),
+            .indicators_count_ = indicators_.size(),
+        };
+    }
+
+    PluginResult ABIV2Adapter::to_v1_result(const PluginResultV2& result, CInstructionBuffer* out) {
+        instructions_.clear();
+        if (out != nullptr) {
+            out->count_ = 0;
+        }
+
+        const size_t count = result.instructions_ != nullptr ? result.instructions_count_ : 0;
+        for (size_t i = 0; i < count; ++i) {
+            const auto& instruction = result.instructions_[i];
+            if (instruction.symbol_id_ >= c_symbols_.size()) {
+                return PluginResult{1, "Instruction refers to an unknown symbol id", nullptr, 0};
+            }
+
+            const char* symbol = c_symbols_[instruction.symbol_id_];
+            CInstruction& c_instruction = out != nullptr && out->count_ < out->capacity_ ? out->instructions_[out->count_++] : instructions_.emplace_back();
+            c_instruction.type_ = instruction.type_;
+
+            if (instruction.type_ == INSTRUCTION_TYPE_SIGNAL) {
+                c_instruction.data_.signal_ = CSignal{.symbol_ = symbol, .action_ = to_action_string(instruction.action_)};
+            } else {
+                c_instruction.data_.order_ = COrder{
+                    .symbol_ = symbol,
+                    .action_ = to_action_string(instruction.action_),
+                    .quantity_ = instruction.quantity_,
+                    .leverage_ = instruction.leverage_,
+                    .limit_price_ = instruction.limit_price_,
+                    .stop_loss_price_ = instruction.stop_loss_price_,
+                    .take_profit_price_ = instruction.take_profit_price_,
+                    .order_type_ = to_order_type_string(instruction.order_type_),
+                };
+            }
+        }
+
+        return PluginResult{result.code_, result.message_, instructions_.empty() ? nullptr : instructions_.data(), instructions_.size()};
+    }
+
+    void ABIV2Adapter::destroy(void* self) {
+        auto& adapter = as_adapter(self);
+        if (adapter.exp_.instance_ != nullptr && adapter.exp_.vtable_.destroy != nullptr) {
+            adapter.exp_.vtable_.destroy(adapter.exp_.instance_);
+            adapter.exp_.instance_ = nullptr;
+        }
+    }
+
+    PluginResult ABIV2Adapter::on_init(void* self, const PluginOptions* opts) {
+        auto& adapter = as_adapter(self);
+        if (adapter.exp_.vtable_.on_init == nullptr) {
+            return PluginResult{0, nullptr, nullptr, 0};
+        }
+
+        const CSymbolTable symbols{.symbols_ = adapter.c_symbols_.data(), .count_ = adapter.c_symbols_.size()};
+        return adapter.to_v1_result(adapter.exp_.vtable_.on_init(adapter.exp_.instance_, opts, &symbols));
+    }
+
+    PluginResult ABIV2Adapter::on_start(void* self) {
+        auto& adapter = as_adapter(self);
+        if (adapter.exp_.vtable_.on_start == nullptr) {
+            return PluginResult{1, "Undefined Method on_start", nullptr, 0};
+        }
+
+        return adapter.to_v1_result(adapter.exp_.vtable_.on_start(adapter.exp_.instance_));
+    }
+
+    PluginResult ABIV2Adapter::on_bar(void* self, const CBar* bar, const CState* state) { return on_bar_into(self, bar, state, nullptr); }
+
+    PluginResult ABIV2Adapter::on_bar_into(void* self, const CBar* bar, const CState* state, CInstructionBuffer* out) {
+        auto& adapter = as_adapter(self);
+        if (adapter.exp_.vtable_.on_bar == nullptr) {
+            return PluginResult{1, "Undefined Method on_bar", nullptr, 0};
+        }
+
+        adapter.bar_ = CBarV2{
+            .unix_ts_ns_ = bar->unix_ts_ns_,
+            .open_ = bar->open_,
+            .high_ = bar->high_,
+            .low_ = bar->low_,
+            .close_ = bar->close_,
+            .volume_ = bar->volume_,
+            .symbol_id_ = adapter.get_symbol_id(bar->symbol_),
+            .reserved_ = 0,
+        };
+        const CStateV2 state_v2 = adapter.to_v2_state(*state);
+
+        return adapter.to_v1_result(adapter.exp_.vtable_.on_bar(adapter.exp_.instance_, &adapter.bar_, &state_v2), out);
+    }
+
+    PluginResult ABIV2Adapter::on_end(void* self, const char** json_out) {
+        auto& adapter = as_adapter(self);
+        return adapter.to_v1_result(adapter.exp_.vtable_.on_end(adapter.exp_.instance_, json_out));
+    }
+
+    void ABIV2Adapter::free_string(void* self, const char* json_out_str) {
+        auto& adapter = as_adapter(self);
+        if (adapter.exp_.vtable_.free_string != nullptr) {
+            adapter.exp_.vtable_.free_string(adapter.exp_.instance_, json_out_str);
+        }
+    }
+
+    PluginResult ABIV2Adapter::precompute_signals(void* self, const CSeries* series, CSignalColumn* signals, size_t series_count) {
+        auto& adapter = as_adapter(self);
+        return adapter.to_v1_result(adapter.exp_.vtable_.precompute_signals(adapter.exp_.instance_, series, signals, series_count));
+    }
+
+    PluginResult ABIV2Adapter::save_state(void* self, const uint8_t** data_out, size_t* size_out) {
+        auto& adapter = as_adapter(self);
+
+        const uint8_t* plugin_state = nullptr;
+        size_t plugin_state_size = 0;
+        const PluginResultV2 result = adapter.exp_.vtable_.save_state(adapter.exp_.instance_, &plugin_state, &plugin_state_size);
+        if (result.code_ != 0) {
+            return adapter.to_v1_result(result);
+        }
+
+        auto& writer = adapter.saved_state_;
+        writer.clear();
+        writer.put<uint64_t>(adapter.fill_ids_.size());
+        for (const auto& [uuid, fill_id] : adapter.fill_ids_) {
+            writer.put_string(uuid.c_str());
+            writer.put(fill_id);
+        }
+        writer.put_array(plugin_state, plugin_state_size);
+
+        *data_out = writer.get_bytes().data();
+        *size_out = writer.get_bytes().size();
+        return PluginResult{0, nullptr, nullptr, 0};
+    }
+
+    PluginResult ABIV2Adapter::restore_state(void* self, const uint8_t* data, size_t size) {
+        auto& adapter = as_adapter(self);
+        plugins::isolation::BufferReader reader({data, size});
+        std::deque<std::string> uuids;
+
+        adapter.fill_ids_.clear();
+        const auto fill_count = reader.get<uint64_t>();
+        for (uint64_t i = 0; i < fill_count; ++i) {
+            const char* uuid = reader.get_string(uuids);
+            adapter.fill_ids_.emplace(uuid, reader.get<uint64_t>());
+        }
+
+        std::vector<uint8_t> plugin_state;
+        reader.get_array(plugin_state);
+
+        return adapter.to_v1_result(adapter.exp_.vtable_.restore_state(adapter.exp_.instance_, plugin_state.data(), plugin_state.size()));
+    }
+
+}  // namespace plugins::loaders
+
+// NOLINTEND(cppcoreguidelines-pro-type-union-access)
@@ -0,0 +1,67 @@
+#ifndef QUANT_FORGE_PLUGINS_LOADERS_ABI_V2_ADAPTER_HPP
+#define QUANT_FORGE_PLUGINS_LOADERS_ABI_V2_ADAPTER_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../abi/abi.h"
+#include "../isolation/ipc_codec.hpp"
+#include "../manifest/manifest.hpp"
+
+namespace plugins::loaders {
+
+    // Presents a v2 plugin through a v1 PluginExport, so loaders and the process worker only deal with one vtable.
+    // State goes in by replacing strings with symbol and fill ids; instructions come back by pointing at the symbol
+    // table and the action/order type constants, so neither direction allocates once the buffers are warm.
+    class ABIV2Adapter {
+       public:
+        ABIV2Adapter(PluginExportV2 exp, const std::vector<plugins::manifest::Symbol>& symbols);
+        ~ABIV2Adapter() = default;
+
+        ABIV2Adapter(const ABIV2Adapter&) = delete;
+        ABIV2Adapter& operator=(const ABIV2Adapter&) = delete;
+        ABIV2Adapter(ABIV2Adapter&&) = delete;
+        ABIV2Adapter& operator=(ABIV2Adapter&&) = delete;
+
+        // The v1 export whose instance_ is this adapter.
+        [[nodiscard]] PluginExport get_v1_export();
+
+       private:
+        PluginExportV2 exp_;
+        std::vector<std::string> symbols_;
+        std::vector<const char*> c_symbols_;
+        std::unordered_map<std::string_view, CSymbolId> symbol_ids_;
+        std::unordered_map<std::string, uint64_t> fill_ids_;
+
+        CBarV2 bar_{};
+        std::vector<CPositionV2> positions_;
+        std::vector<CFillV2> fills_;
+        std::vector<CExitOrderV2> exit_orders_;
+        std::vector<CIndicatorValueV2> indicators_;
+        std::vector<CInstruction> instructions_;
+        // Fill ids are part of what the plugin remembers, so they are saved ahead of its own state.
+        plugins::isolation::BufferWriter saved_state_;
+
+        [[nodiscard]] CSymbolId get_symbol_id(const char* symbol) const;
+        [[nodiscard]] uint64_t get_fill_id(const char* uuid);
+        [[nodiscard]] CStateV2 to_v2_state(const CState& state);
+        [[nodiscard]] PluginResult to_v1_result(const PluginResultV2& result, CInstructionBuffer* out = nullptr);
+
+        static void destroy(void* self);
+        static PluginResult on_init(void* self, const PluginOptions* opts);
+        static PluginResult on_start(void* self);
+        static PluginResult on_bar(void* self, const CBar* bar, const CState* state);
+        static PluginResult on_bar_into(void* self, const CBar* bar, const CState* state, CInstructionBuffer* out);
+        static PluginResult on_end(void* self, const char** json_out);
+        static void free_string(void* self, const char* json_out_str);
+        static PluginResult precompute_signals(void* self, const CSeries* series, CSignalColumn* signals, size_t series_count);
+        static PluginResult save_state(void* self, const uint8_t** data_out, size_t* size_out);
+        static PluginResult restore_state(void* self, const uint8_t* data, size_t size);
+    };
+
+}  // namespace plugins::loaders
+
+#endif
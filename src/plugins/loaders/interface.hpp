@@ -1,7 +1,12 @@
 #ifndef QUANT_FORGE_PLUGINS_LOADERS_INTERFACE_HPP
 #define QUANT_FORGE_PLUGINS_LOADERS_INTERFACE_HPP
 
+#include <algorithm>
+#include <deque>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "../../http/api/stock_api.hpp"
 #include "../../simulators/back_test/state.hpp"
@@ -34,6 +39,46 @@ namespace plugins::loaders {
         };
     }
 
+    // Identity and option overrides of one plugin instance. Instances created from the same loader share its library and
+    // manifest; each gets its own create_plugin call and its own name in the data and report stores.
+    struct PluginInstanceOptions {
+        std::string instance_name_;
+        std::vector<std::pair<std::string, std::string>> option_overrides_;
+    };
+
+    // Manifest options with per-instance overrides applied. Owns the strings the returned PluginOptions points at.
+    class PluginOptionsOverlay {
+       public:
+        PluginOptions apply(const PluginOptions& base, const std::vector<std::pair<std::string, std::string>>& overrides) {
+            strings_.clear();
+            items_.clear();
+
+            auto add_kv = [this](const std::string& key, const std::string& value) {
+                const char* key_ptr = strings_.emplace_back(key).c_str();
+                const char* value_ptr = strings_.emplace_back(value).c_str();
+                items_.push_back(PluginConfigKV{key_ptr, value_ptr});
+            };
+
+            for (size_t i = 0; i < base.count_; ++i) {
+                const std::string key = base.items_[i].key_;
+                const auto it = std::ranges::find_if(overrides, [&key](const auto& kv) { return kv.first == key; });
+                add_kv(key, it != overrides.end() ? it->second : std::string(base.items_[i].value_));
+            }
+
+            for (const auto& [key, value] : overrides) {
+                if (std::ranges::none_of(items_, [&key](const PluginConfigKV& kv) { return key == kv.key_; })) {
+                    add_kv(key, value);
+                }
+            }
+
+            return PluginOptions{items_.data(), items_.size()};
+        }
+
+       private:
+        std::deque<std::string> strings_;
+        std::vector<PluginConfigKV> items_;
+    };
+
     class IPluginLoader {
        public:
         IPluginLoader() = default;
@@ -42,13 +87,25 @@ namespace plugins::loaders {
         virtual void load_plugin(const SimulatorContext& ctx) = 0;
         virtual void on_init() const = 0;
         [[nodiscard]] virtual PluginResult on_start() const = 0;
-        [[nodiscard]] virtual PluginResult on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state) const = 0;
+        // Instructions come back in the caller's buffer (count_ set) and, for plugins without on_bar_into or past its
+        // capacity, in the result.
+        [[nodiscard]] virtual PluginResult on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state,
+                                                  CInstructionBuffer& instructions) const = 0;
+        [[nodiscard]] virtual bool has_precompute_signals() const = 0;
+        [[nodiscard]] virtual PluginResult precompute_signals(const CSeries* series, CSignalColumn* signals, size_t series_count) const = 0;
+        // Whether the plugin can save and restore its own state, so a back test resumed from a checkpoint carries on as
+        // if uninterrupted. Saved bytes belong to the plugin and stay valid until its next call.
+        [[nodiscard]] virtual bool has_state_hooks() const = 0;
+        [[nodiscard]] virtual PluginResult save_state(const uint8_t** data_out, size_t* size_out) const = 0;
+        [[nodiscard]] virtual PluginResult restore_state(const uint8_t* data, size_t size) const = 0;
         [[nodiscard]] virtual PluginResult on_end(const char** json_out) const = 0;
         virtual void free_string(const char* str) const = 0;
         [[nodiscard]] virtual std::string get_plugin_name() const = 0;
         virtual void unload_plugin() = 0;
         [[nodiscard]] virtual PluginExport* get_plugin_export() const = 0;
         [[nodiscard]] virtual plugins::manifest::HostParams get_host_params() const = 0;
+        // Creates and loads another instance of the same plugin; the caller runs its on_init.
+        [[nodiscard]] virtual std::unique_ptr<IPluginLoader> create_instance(const SimulatorContext& ctx, const PluginInstanceOptions& instance_options) const = 0;
     };
 
 }  // namespace plugins::loaders
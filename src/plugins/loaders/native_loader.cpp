@@ -3,63 +3,113 @@
 #include <pybind11/embed.h>
 #include <pybind11/pybind11.h>
 
+#include <dlfcn.h>
+
+#include <filesystem>
+
 #include "../../http/api/stock_api.hpp"
 #include "../../simulators/back_test/state.hpp"
 #include "../abi/abi.h"
+#include "../abi/export_compat.hpp"
 #include "../abi/lib_handler.hpp"
 #include "../manifest/manifest.hpp"
+#include "abi_v2_adapter.hpp"
 #include "simulators/back_test/abi_converter.hpp"
 
 namespace py = pybind11;
 
 namespace plugins::loaders {
-    struct NativePlugin {
-        LibHandler lib_;
-        PluginExport exp_{};
-    };
-
-    NativeLoader::NativeLoader(std::unique_ptr<plugins::manifest::PluginManifest> plugin_manifest) : plugin_manifest_(std::move(plugin_manifest)) {}
+    NativeLoader::NativeLoader(std::shared_ptr<plugins::manifest::PluginManifest> plugin_manifest, PluginInstanceOptions instance_options)
+        : plugin_manifest_(std::move(plugin_manifest)), instance_options_(std::move(instance_options)) {}
 
     void NativeLoader::load_plugin(const SimulatorContext& ctx) {
         std::string err;
 
-        lib_ = LibHandler::open(plugin_manifest_->get_entry(), err);
+        LibHandler lib = LibHandler::open(plugin_manifest_->get_entry(), err);
 
-        if (lib_.handle_ == nullptr) {
+        if (lib.handle_ == nullptr) {
             throw std::runtime_error(err);
         }
 
-        auto create = lib_.sym<CreatePluginFn>(PLUGIN_CREATE_SYMBOL, err);
-        if (create == nullptr) {
-            lib_.close();
+        lib_ = std::shared_ptr<LibHandler>(new LibHandler(lib), [](LibHandler* handler) {
+            handler->close();
+            delete handler;
+        });
+
+        auto create_v2 = lib_->sym<CreatePluginV2Fn>(PLUGIN_CREATE_V2_SYMBOL, err);
+        auto create = lib_->sym<CreatePluginFn>(PLUGIN_CREATE_SYMBOL, err);
+        if (create == nullptr && create_v2 == nullptr) {
+            lib_.reset();
             throw std::runtime_error("Failed to load plugin");
-            return;
         }
 
-        exp_ = create(&ctx);
+        create_plugin(ctx, create, create_v2);
+    }
+
+    // Prefers v2 and falls back to v1 when the plugin has no v2 entry point or declines the version.
+    void NativeLoader::create_plugin(const SimulatorContext& ctx, CreatePluginFn create, CreatePluginV2Fn create_v2) {
+        create_ = create;
+        create_v2_ = create_v2;
+        v2_adapter_.reset();
+
+        if (create_v2_ != nullptr) {
+            const SimulatorContext ctx_v2{.api_version_ = PLUGIN_API_VERSION_V2};
+            PluginExportV2 exp_v2 = create_v2_(&ctx_v2);
+
+            if (plugins::abi::normalize_export_v2(exp_v2) && exp_v2.instance_ != nullptr) {
+                if (exp_v2.vtable_.destroy == nullptr || exp_v2.vtable_.on_end == nullptr) {
+                    lib_.reset();
+                    throw std::runtime_error("Required vtable methods missing");
+                }
+
+                v2_adapter_ = std::make_unique<ABIV2Adapter>(exp_v2, plugin_manifest_->get_host_params().symbols_);
+                exp_ = v2_adapter_->get_v1_export();
+                return;
+            }
+
+            if (exp_v2.instance_ != nullptr && exp_v2.vtable_.destroy != nullptr) {
+                exp_v2.vtable_.destroy(exp_v2.instance_);
+            }
+        }
+
+        if (create_ == nullptr) {
+            lib_.reset();
+            throw std::runtime_error("Plugin declined API v2 and has no v1 entry point");
+        }
+
+        exp_ = create_(&ctx);
 
-        if (exp_.api_version_ != PLUGIN_API_VERSION || exp_.instance_ == nullptr) {
-            err = "API mismatch or null instance";
-            lib_.close();
+        if (!plugins::abi::normalize_export(exp_) || exp_.instance_ == nullptr) {
+            lib_.reset();
             exp_ = {};
-            throw std::runtime_error(err);
+            throw std::runtime_error("API mismatch or null instance");
         }
 
         if (exp_.vtable_.destroy == nullptr || exp_.vtable_.on_end == nullptr) {
-            err = "Required vtable methods missing";
-            lib_.close();
+            lib_.reset();
             exp_ = {};
-            throw std::runtime_error(err);
+            throw std::runtime_error("Required vtable methods missing");
         }
     }
 
+    std::unique_ptr<IPluginLoader> NativeLoader::create_instance(const SimulatorContext& ctx, const PluginInstanceOptions& instance_options) const {
+        if (lib_ == nullptr || (create_ == nullptr && create_v2_ == nullptr)) {
+            throw std::runtime_error("Cannot create an instance of a plugin that is not loaded");
+        }
+
+        auto instance = std::make_unique<NativeLoader>(plugin_manifest_, instance_options);
+        instance->lib_ = lib_;
+        instance->create_plugin(ctx, create_, create_v2_);
+        return instance;
+    }
+
     void NativeLoader::on_init() const {
         if (exp_.api_version_ != PLUGIN_API_VERSION) {
             return;
         }
 
         if (exp_.vtable_.on_init != nullptr) {
-            auto options = plugin_manifest_->get_options();
+            auto options = options_overlay_.apply(plugin_manifest_->get_options(), instance_options_.option_overrides_);
             exp_.vtable_.on_init(exp_.instance_, &options);
         }
     }
@@ -76,20 +126,71 @@ namespace plugins::loaders {
         return exp_.vtable_.on_start(exp_.instance_);
     }
 
-    PluginResult NativeLoader::on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state) const {
+    PluginResult NativeLoader::on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state, CInstructionBuffer& instructions) const {
+        instructions.count_ = 0;
+
         if (exp_.api_version_ != PLUGIN_API_VERSION) {
             return PluginResult{1, "Invalid API Version", .instructions_count_ = 0, .instructions_ = nullptr};
         }
 
-        if (exp_.vtable_.on_bar == nullptr) {
+        if (exp_.vtable_.on_bar == nullptr && exp_.vtable_.on_bar_into == nullptr) {
             return PluginResult{1, "Undefined Method on_bar", .instructions_count_ = 0, .instructions_ = nullptr};
         }
 
         CBar plugin_bar = plugins::loaders::to_plugin_bar(bar);
-        CState c_state = simulators::ABIConverter().to_c_state(state);  // TODO This should be a static method
+        CState c_state = abi_converter_.to_c_state(state);
+
+        if (exp_.vtable_.on_bar_into != nullptr) {
+            return exp_.vtable_.on_bar_into(exp_.instance_, &plugin_bar, &c_state, &instructions);
+        }
+
         return exp_.vtable_.on_bar(exp_.instance_, &plugin_bar, &c_state);
     }
 
+    bool NativeLoader::has_precompute_signals() const {
+        return exp_.api_version_ == PLUGIN_API_VERSION && exp_.vtable_.precompute_signals != nullptr;
+    }
+
+    PluginResult NativeLoader::precompute_signals(const CSeries* series, CSignalColumn* signals, size_t series_count) const {
+        if (exp_.api_version_ != PLUGIN_API_VERSION) {
+            return PluginResult{1, "Invalid API Version", .instructions_count_ = 0, .instructions_ = nullptr};
+        }
+
+        if (exp_.vtable_.precompute_signals == nullptr) {
+            return PluginResult{1, "Undefined Method precompute_signals", .instructions_count_ = 0, .instructions_ = nullptr};
+        }
+
+        return exp_.vtable_.precompute_signals(exp_.instance_, series, signals, series_count);
+    }
+
+    bool NativeLoader::has_state_hooks() const {
+        return exp_.api_version_ == PLUGIN_API_VERSION && exp_.vtable_.save_state != nullptr && exp_.vtable_.restore_state != nullptr;
+    }
+
+    PluginResult NativeLoader::save_state(const uint8_t** data_out, size_t* size_out) const {
+        if (exp_.api_version_ != PLUGIN_API_VERSION) {
+            return PluginResult{1, "Invalid API Version", .instructions_count_ = 0, .instructions_ = nullptr};
+        }
+
+        if (exp_.vtable_.save_state == nullptr) {
+            return PluginResult{1, "Undefined Method save_state", .instructions_count_ = 0, .instructions_ = nullptr};
+        }
+
+        return exp_.vtable_.save_state(exp_.instance_, data_out, size_out);
+    }
+
+    PluginResult NativeLoader::restore_state(const uint8_t* data, size_t size) const {
+        if (exp_.api_version_ != PLUGIN_API_VERSION) {
+            return PluginResult{1, "Invalid API Version", .instructions_count_ = 0, .instructions_ = nullptr};
+        }
+
+        if (exp_.vtable_.restore_state == nullptr) {
+            return PluginResult{1, "Undefined Method restore_state", .instructions_count_ = 0, .instructions_ = nullptr};
+        }
+
+        return exp_.vtable_.restore_state(exp_.instance_, data, size);
+    }
+
     PluginResult NativeLoader::on_end(const char** json_out) const {
         if (exp_.api_version_ != PLUGIN_API_VERSION) {
             return PluginResult{1, "Invalid API Version", .instructions_count_ = 0, .instructions_ = nullptr};
@@ -114,7 +215,9 @@ namespace plugins::loaders {
         return exp_.vtable_.free_string(exp_.instance_, str);
     }
 
-    std::string NativeLoader::get_plugin_name() const { return plugin_manifest_->get_name(); }
+    std::string NativeLoader::get_plugin_name() const {
+        return instance_options_.instance_name_.empty() ? plugin_manifest_->get_name() : instance_options_.instance_name_;
+    }
 
     void NativeLoader::unload_plugin() {
         if (exp_.api_version_ != PLUGIN_API_VERSION) {
@@ -125,12 +228,24 @@ namespace plugins::loaders {
             exp_.vtable_.destroy(exp_.instance_);
             exp_.instance_ = nullptr;
         }
-        lib_.close();
+        v2_adapter_.reset();
+        lib_.reset();
         exp_ = {};
     }
 
     PluginExport* NativeLoader::get_plugin_export() const { return &exp_; }
 
+    std::filesystem::path NativeLoader::get_library_path() const {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const void* symbol = create_v2_ != nullptr ? reinterpret_cast<const void*>(create_v2_) : reinterpret_cast<const void*>(create_);
+        Dl_info info{};
+        if (lib_ == nullptr || symbol == nullptr || dladdr(symbol, &info) == 0 || info.dli_fname == nullptr) {
+            return {};
+        }
+
+        return info.dli_fname;
+    }
+
     plugins::manifest::HostParams NativeLoader::get_host_params() const { return plugin_manifest_->get_host_params(); }
 
 }  // namespace plugins::loaders
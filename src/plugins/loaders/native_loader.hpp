@@ -1,20 +1,24 @@
 #ifndef QUANT_FORGE_PLUGINS_LOADERS_NATIVE_LOADER_HPP
 #define QUANT_FORGE_PLUGINS_LOADERS_NATIVE_LOADER_HPP
 
+#include <filesystem>
+#include <memory>
 #include <string>
 
 #include "../../http/api/stock_api.hpp"
+#include "../../simulators/back_test/abi_converter.hpp"
 #include "../../simulators/back_test/state.hpp"
 #include "../abi/abi.h"
 #include "../abi/lib_handler.hpp"
 #include "../manifest/manifest.hpp"
+#include "abi_v2_adapter.hpp"
 #include "interface.hpp"
 
 namespace plugins::loaders {
 
     class NativeLoader : public IPluginLoader {
        public:
-        explicit NativeLoader(std::unique_ptr<plugins::manifest::PluginManifest> plugin_manifest);
+        explicit NativeLoader(std::shared_ptr<plugins::manifest::PluginManifest> plugin_manifest, PluginInstanceOptions instance_options = {});
         ~NativeLoader() override = default;
 
         NativeLoader(const NativeLoader&) = delete;
@@ -25,18 +29,37 @@ namespace plugins::loaders {
         void load_plugin(const SimulatorContext& ctx) override;
         void on_init() const override;
         [[nodiscard]] PluginResult on_start() const override;
-        [[nodiscard]] PluginResult on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state) const override;
+        [[nodiscard]] PluginResult on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state,
+                                          CInstructionBuffer& instructions) const override;
+        [[nodiscard]] bool has_precompute_signals() const override;
+        [[nodiscard]] PluginResult precompute_signals(const CSeries* series, CSignalColumn* signals, size_t series_count) const override;
+        [[nodiscard]] bool has_state_hooks() const override;
+        [[nodiscard]] PluginResult save_state(const uint8_t** data_out, size_t* size_out) const override;
+        [[nodiscard]] PluginResult restore_state(const uint8_t* data, size_t size) const override;
         [[nodiscard]] PluginResult on_end(const char** json_out) const override;
         void free_string(const char* str) const override;
         [[nodiscard]] std::string get_plugin_name() const override;
         void unload_plugin() override;
         [[nodiscard]] PluginExport* get_plugin_export() const override;
         [[nodiscard]] plugins::manifest::HostParams get_host_params() const override;
+        [[nodiscard]] std::unique_ptr<IPluginLoader> create_instance(const SimulatorContext& ctx, const PluginInstanceOptions& instance_options) const override;
+        // Where the dynamic loader actually found the entry, which the manifest may only name. Empty when not loaded.
+        [[nodiscard]] std::filesystem::path get_library_path() const;
 
        private:
-        std::unique_ptr<plugins::manifest::PluginManifest> plugin_manifest_;
+        void create_plugin(const SimulatorContext& ctx, CreatePluginFn create, CreatePluginV2Fn create_v2);
+
+        std::shared_ptr<plugins::manifest::PluginManifest> plugin_manifest_;
+        PluginInstanceOptions instance_options_;
+        mutable PluginOptionsOverlay options_overlay_;
         mutable PluginExport exp_{};
-        mutable LibHandler lib_;
+        mutable simulators::ABIConverter abi_converter_;
+        // Shared by every instance created from this loader; the library is closed when the last one unloads.
+        std::shared_ptr<LibHandler> lib_;
+        CreatePluginFn create_ = nullptr;
+        CreatePluginV2Fn create_v2_ = nullptr;
+        // Set for v2 plugins; exp_ then is the adapter's v1 view of the plugin.
+        std::unique_ptr<ABIV2Adapter> v2_adapter_;
     };
 }  // namespace plugins::loaders
 
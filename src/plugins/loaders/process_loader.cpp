@@ -0,0 +1,409 @@
+#include "process_loader.hpp"
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../http/api/stock_api.hpp"
+#include "../../simulators/back_test/state.hpp"
+#include "../../utils/constants.hpp"
+#include "../abi/abi.h"
+#include "../isolation/ipc_codec.hpp"
+#include "../isolation/shm_ring.hpp"
+#include "../manifest/manifest.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-owning-memory)
+
+static constexpr auto WORKER_SHUTDOWN_TIMEOUT = std::chrono::seconds(2);
+static constexpr auto WORKER_SHUTDOWN_POLL = std::chrono::milliseconds(5);
+
+namespace plugins::loaders {
+    namespace {
+        using plugins::isolation::BufferReader;
+        using plugins::isolation::BufferWriter;
+        using plugins::isolation::MessageType;
+        using plugins::isolation::SharedChannel;
+
+        PluginResult missing_method(const char* message) { return PluginResult{1, message, nullptr, 0}; }
+
+        std::string describe_exit(int status) {
+            if (WIFSIGNALED(status)) {
+                const char* signal_name = strsignal(WTERMSIG(status));
+                return "Plugin worker process killed by signal " + std::to_string(WTERMSIG(status)) + " (" + (signal_name != nullptr ? signal_name : "unknown") +
+                       ")";
+            }
+            return "Plugin worker process exited with status " + std::to_string(WEXITSTATUS(status));
+        }
+
+        // Everything the worker needs lives on its own stack; it never returns into the host's code.
+        class Worker {
+           public:
+            Worker(SharedChannel& channel, pid_t host_pid) : channel_(channel), host_pid_(host_pid) {}
+
+            [[noreturn]] void run(const LoaderFactory& factory, const SimulatorContext& ctx) {
+                std::unique_ptr<IPluginLoader> loader;
+
+                try {
+                    loader = factory();
+                    loader->load_plugin(ctx);
+                    exp_ = loader->get_plugin_export();
+
+                    if (exp_ == nullptr || exp_->api_version_ != PLUGIN_API_VERSION || exp_->instance_ == nullptr) {
+                        throw std::runtime_error("API mismatch or null instance");
+                    }
+                } catch (const std::exception& e) {
+                    response_.put_string(e.what());
+                    send(MessageType::FAILURE);
+                    _exit(1);
+                }
+
+                response_.put(exp_->vtable_.precompute_signals != nullptr);
+                response_.put(exp_->vtable_.save_state != nullptr && exp_->vtable_.restore_state != nullptr);
+                send(MessageType::HELLO);
+
+                MessageType type{};
+                while (channel_.get_requests().read(type, request_, [this]() { return is_host_alive(); })) {
+                    if (type == MessageType::SHUTDOWN) {
+                        loader->unload_plugin();
+                        _exit(0);
+                    }
+
+                    response_.clear();
+                    try {
+                        BufferReader reader(request_);
+                        handle(type, reader);
+                    } catch (const std::exception& e) {
+                        response_.clear();
+                        plugins::isolation::encode_result(response_, PluginResult{1, e.what(), nullptr, 0});
+                    }
+
+                    send(MessageType::RESULT);
+                }
+
+                // The host is gone; nobody is left to read a result.
+                _exit(1);
+            }
+
+           private:
+            SharedChannel& channel_;
+            pid_t host_pid_;
+            PluginExport* exp_ = nullptr;
+
+            std::vector<uint8_t> request_;
+            BufferWriter response_;
+            plugins::isolation::OptionsFrame options_frame_;
+            plugins::isolation::BarFrame bar_frame_;
+            plugins::isolation::StateFrame state_frame_;
+            plugins::isolation::SeriesFrame series_frame_;
+            std::vector<CInstruction> instructions_ = std::vector<CInstruction>(constants::INSTRUCTION_BUFFER_CAPACITY);
+            std::vector<uint8_t> plugin_state_;
+
+            [[nodiscard]] bool is_host_alive() const { return getppid() == host_pid_; }
+
+            void send(MessageType type) {
+                if (!channel_.get_responses().write(type, response_.get_bytes(), [this]() { return is_host_alive(); })) {
+                    _exit(1);
+                }
+                response_.clear();
+            }
+
+            void handle(MessageType type, BufferReader& reader) {
+                const auto& vtable = exp_->vtable_;
+
+                switch (type) {
+                    case MessageType::INIT: {
+                        plugins::isolation::decode_options(reader, options_frame_);
+                        const auto result = vtable.on_init != nullptr ? vtable.on_init(exp_->instance_, &options_frame_.options_) : PluginResult{};
+                        plugins::isolation::encode_result(response_, result);
+                        break;
+                    }
+                    case MessageType::START: {
+                        const auto result = vtable.on_start != nullptr ? vtable.on_start(exp_->instance_) : missing_method("Undefined Method on_start");
+                        plugins::isolation::encode_result(response_, result);
+                        break;
+                    }
+                    case MessageType::BAR: {
+                        plugins::isolation::decode_bar(reader, bar_frame_);
+                        plugins::isolation::decode_state(reader, state_frame_);
+                        CInstructionBuffer buffer{.instructions_ = instructions_.data(), .capacity_ = instructions_.size(), .count_ = 0};
+                        if (vtable.on_bar_into != nullptr) {
+                            const auto result = vtable.on_bar_into(exp_->instance_, &bar_frame_.bar_, &state_frame_.state_, &buffer);
+                            plugins::isolation::encode_result(response_, result, &buffer);
+                            break;
+                        }
+                        const auto result = vtable.on_bar != nullptr ? vtable.on_bar(exp_->instance_, &bar_frame_.bar_, &state_frame_.state_)
+                                                                     : missing_method("Undefined Method on_bar");
+                        plugins::isolation::encode_result(response_, result);
+                        break;
+                    }
+                    case MessageType::PRECOMPUTE_SIGNALS: {
+                        plugins::isolation::decode_series(reader, series_frame_);
+                        const auto result = vtable.precompute_signals != nullptr
+                                                ? vtable.precompute_signals(exp_->instance_, series_frame_.series_.data(), series_frame_.signals_.data(),
+                                                                            series_frame_.series_.size())
+                                                : missing_method("Undefined Method precompute_signals");
+                        plugins::isolation::encode_result(response_, result);
+                        plugins::isolation::encode_signals(response_, series_frame_.signals_.data(), series_frame_.signals_.size());
+                        break;
+                    }
+                    case MessageType::SAVE_STATE: {
+                        const uint8_t* data = nullptr;
+                        size_t size = 0;
+                        const auto result =
+                            vtable.save_state != nullptr ? vtable.save_state(exp_->instance_, &data, &size) : missing_method("Undefined Method save_state");
+                        plugins::isolation::encode_result(response_, result);
+                        response_.put_array(data, result.code_ == 0 ? size : 0);
+                        break;
+                    }
+                    case MessageType::RESTORE_STATE: {
+                        reader.get_array(plugin_state_);
+                        const auto result = vtable.restore_state != nullptr ? vtable.restore_state(exp_->instance_, plugin_state_.data(), plugin_state_.size())
+                                                                            : missing_method("Undefined Method restore_state");
+                        plugins::isolation::encode_result(response_, result);
+                        break;
+                    }
+                    case MessageType::END: {
+                        const char* json = nullptr;
+                        const auto result = vtable.on_end(exp_->instance_, &json);
+                        plugins::isolation::encode_result(response_, result);
+                        response_.put_string(json);
+                        if (json != nullptr && vtable.free_string != nullptr) {
+                            vtable.free_string(exp_->instance_, json);
+                        }
+                        break;
+                    }
+                    default:
+                        throw std::runtime_error("Unexpected plugin worker request");
+                }
+            }
+        };
+    }  // namespace
+
+    ProcessLoader::ProcessLoader(std::shared_ptr<plugins::manifest::PluginManifest> plugin_manifest, LoaderFactory inner_factory,
+                                 PluginInstanceOptions instance_options)
+        : plugin_manifest_(std::move(plugin_manifest)), inner_factory_(std::move(inner_factory)), instance_options_(std::move(instance_options)) {}
+
+    ProcessLoader::~ProcessLoader() { unload_plugin(); }
+
+    void ProcessLoader::load_plugin(const SimulatorContext& ctx) {
+        channel_ = std::make_unique<SharedChannel>();
+        const pid_t host_pid = getpid();
+
+        worker_pid_ = fork();
+        if (worker_pid_ < 0) {
+            channel_.reset();
+            throw std::runtime_error("Failed to fork plugin worker: " + std::string(std::strerror(errno)));
+        }
+
+        if (worker_pid_ == 0) {
+            Worker(*channel_, host_pid).run(inner_factory_, ctx);
+        }
+
+        is_worker_exited_ = false;
+        exit_message_ = "Plugin worker process exited";
+        MessageType type{};
+        if (!channel_->get_responses().read(type, response_, [this]() { return is_worker_alive(); })) {
+            const std::string error = "Failed to load " + plugin_manifest_->get_name() + ": " + exit_message_;
+            unload_plugin();
+            throw std::runtime_error(error);
+        }
+
+        BufferReader reader(response_);
+        if (type == MessageType::FAILURE) {
+            std::deque<std::string> strings;
+            const char* message = reader.get_string(strings);
+            const std::string error = message != nullptr ? message : "Failed to load plugin";
+            unload_plugin();
+            throw std::runtime_error(error);
+        }
+
+        has_precompute_signals_ = reader.get<bool>();
+        has_state_hooks_ = reader.get<bool>();
+        exp_ = PluginExport{PLUGIN_API_VERSION, nullptr, {}};
+        equity_sent_ = {};
+    }
+
+    std::unique_ptr<IPluginLoader> ProcessLoader::create_instance(const SimulatorContext& ctx, const PluginInstanceOptions& instance_options) const {
+        auto instance = std::make_unique<ProcessLoader>(plugin_manifest_, inner_factory_, instance_options);
+        instance->load_plugin(ctx);
+        return instance;
+    }
+
+    bool ProcessLoader::is_worker_alive() const {
+        if (is_worker_exited_ || worker_pid_ <= 0) {
+            return false;
+        }
+
+        int status = 0;
+        if (waitpid(worker_pid_, &status, WNOHANG) == worker_pid_) {
+            is_worker_exited_ = true;
+            exit_message_ = describe_exit(status);
+        }
+        return !is_worker_exited_;
+    }
+
+    bool ProcessLoader::exchange(MessageType type, std::vector<uint8_t>& response) const {
+        if (!is_worker_alive()) {
+            return false;
+        }
+
+        auto is_alive = [this]() { return is_worker_alive(); };
+        MessageType response_type{};
+
+        const bool ok = channel_->get_requests().write(type, request_.get_bytes(), is_alive) && channel_->get_responses().read(response_type, response, is_alive);
+        request_.clear();
+        return ok && response_type == MessageType::RESULT;
+    }
+
+    PluginResult ProcessLoader::decode_result(BufferReader& reader) const {
+        plugins::isolation::decode_result(reader, result_frame_);
+        return result_frame_.result_;
+    }
+
+    void ProcessLoader::on_init() const {
+        auto options = options_overlay_.apply(plugin_manifest_->get_options(), instance_options_.option_overrides_);
+        plugins::isolation::encode_options(request_, options);
+        (void)exchange(MessageType::INIT, response_);
+    }
+
+    PluginResult ProcessLoader::on_start() const {
+        if (!exchange(MessageType::START, response_)) {
+            return PluginResult{1, exit_message_.c_str(), nullptr, 0};
+        }
+
+        BufferReader reader(response_);
+        return decode_result(reader);
+    }
+
+    // The worker fills its own arena and sends everything back in one result, so the host's buffer is left empty.
+    PluginResult ProcessLoader::on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state, CInstructionBuffer& instructions) const {
+        instructions.count_ = 0;
+
+        const CBar c_bar = plugins::loaders::to_plugin_bar(bar);
+        const CState c_state = abi_converter_.to_c_state(state);
+
+        plugins::isolation::encode_bar(request_, c_bar);
+        plugins::isolation::encode_state(request_, c_state, equity_sent_);
+
+        if (!exchange(MessageType::BAR, response_)) {
+            return PluginResult{1, exit_message_.c_str(), nullptr, 0};
+        }
+
+        BufferReader reader(response_);
+        return decode_result(reader);
+    }
+
+    bool ProcessLoader::has_precompute_signals() const { return has_precompute_signals_; }
+
+    PluginResult ProcessLoader::precompute_signals(const CSeries* series, CSignalColumn* signals, size_t series_count) const {
+        plugins::isolation::encode_series(request_, series, series_count);
+
+        if (!exchange(MessageType::PRECOMPUTE_SIGNALS, response_)) {
+            return PluginResult{1, exit_message_.c_str(), nullptr, 0};
+        }
+
+        BufferReader reader(response_);
+        const PluginResult result = decode_result(reader);
+        plugins::isolation::decode_signals(reader, signals, series_count);
+        return result;
+    }
+
+    bool ProcessLoader::has_state_hooks() const { return has_state_hooks_; }
+
+    // The bytes are copied out of the worker, so they stay valid until the next save_state rather than the next call.
+    PluginResult ProcessLoader::save_state(const uint8_t** data_out, size_t* size_out) const {
+        if (!exchange(MessageType::SAVE_STATE, response_)) {
+            return PluginResult{1, exit_message_.c_str(), nullptr, 0};
+        }
+
+        BufferReader reader(response_);
+        const PluginResult result = decode_result(reader);
+        reader.get_array(saved_state_);
+
+        *data_out = saved_state_.data();
+        *size_out = saved_state_.size();
+        return result;
+    }
+
+    PluginResult ProcessLoader::restore_state(const uint8_t* data, size_t size) const {
+        request_.put_array(data, size);
+
+        if (!exchange(MessageType::RESTORE_STATE, response_)) {
+            return PluginResult{1, exit_message_.c_str(), nullptr, 0};
+        }
+
+        BufferReader reader(response_);
+        return decode_result(reader);
+    }
+
+    PluginResult ProcessLoader::on_end(const char** json_out) const {
+        if (!exchange(MessageType::END, response_)) {
+            return PluginResult{1, exit_message_.c_str(), nullptr, 0};
+        }
+
+        BufferReader reader(response_);
+        const PluginResult result = decode_result(reader);
+
+        std::deque<std::string> strings;
+        const char* json = reader.get_string(strings);
+        if (json != nullptr) {
+            const size_t length = std::strlen(json);
+            char* heap = new char[length + 1];
+            std::memcpy(heap, json, length + 1);
+            *json_out = heap;
+        }
+
+        return result;
+    }
+
+    void ProcessLoader::free_string(const char* str) const { delete[] str; }
+
+    std::string ProcessLoader::get_plugin_name() const {
+        return instance_options_.instance_name_.empty() ? plugin_manifest_->get_name() : instance_options_.instance_name_;
+    }
+
+    // Asks the worker to destroy its plugin and exit, and kills it if it does not within the timeout.
+    void ProcessLoader::unload_plugin() {
+        if (worker_pid_ <= 0) {
+            return;
+        }
+
+        if (is_worker_alive()) {
+            request_.clear();
+            (void)channel_->get_requests().write(MessageType::SHUTDOWN, request_.get_bytes(), [this]() { return is_worker_alive(); });
+
+            const auto deadline = std::chrono::steady_clock::now() + WORKER_SHUTDOWN_TIMEOUT;
+            while (is_worker_alive() && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(WORKER_SHUTDOWN_POLL);
+            }
+
+            if (!is_worker_exited_) {
+                kill(worker_pid_, SIGKILL);
+                waitpid(worker_pid_, nullptr, 0);
+            }
+        }
+
+        worker_pid_ = -1;
+        is_worker_exited_ = true;
+        channel_.reset();
+        exp_ = {};
+    }
+
+    // The plugin instance lives in the worker, so the export only carries the API version.
+    PluginExport* ProcessLoader::get_plugin_export() const { return &exp_; }
+
+    plugins::manifest::HostParams ProcessLoader::get_host_params() const { return plugin_manifest_->get_host_params(); }
+
+}  // namespace plugins::loaders
+
+// NOLINTEND(cppcoreguidelines-owning-memory)
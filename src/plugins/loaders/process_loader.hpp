@@ -0,0 +1,87 @@
+#ifndef QUANT_FORGE_PLUGINS_LOADERS_PROCESS_LOADER_HPP
+#define QUANT_FORGE_PLUGINS_LOADERS_PROCESS_LOADER_HPP
+
+#include <sys/types.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../http/api/stock_api.hpp"
+#include "../../simulators/back_test/abi_converter.hpp"
+#include "../../simulators/back_test/state.hpp"
+#include "../abi/abi.h"
+#include "../isolation/ipc_codec.hpp"
+#include "../isolation/shm_ring.hpp"
+#include "../manifest/manifest.hpp"
+#include "interface.hpp"
+
+namespace plugins::loaders {
+
+    // Builds the loader that runs inside the worker process. It is only ever called in the child.
+    using LoaderFactory = std::function<std::unique_ptr<IPluginLoader>()>;
+
+    // Runs a plugin in a forked worker process, so its calls no longer share the host's interpreter lock or address
+    // space. Requests and responses travel over a SharedChannel; the plugin side still sees the unchanged PluginVTable.
+    // A worker that crashes only fails its own plugin: every later call returns an error result naming the signal.
+    class ProcessLoader : public IPluginLoader {
+       public:
+        ProcessLoader(std::shared_ptr<plugins::manifest::PluginManifest> plugin_manifest, LoaderFactory inner_factory,
+                      PluginInstanceOptions instance_options = {});
+        ~ProcessLoader() override;
+
+        ProcessLoader(const ProcessLoader&) = delete;
+        ProcessLoader& operator=(const ProcessLoader&) = delete;
+        ProcessLoader(ProcessLoader&&) = delete;
+        ProcessLoader& operator=(ProcessLoader&&) = delete;
+
+        void load_plugin(const SimulatorContext& ctx) override;
+        void on_init() const override;
+        [[nodiscard]] PluginResult on_start() const override;
+        [[nodiscard]] PluginResult on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state,
+                                          CInstructionBuffer& instructions) const override;
+        [[nodiscard]] bool has_precompute_signals() const override;
+        [[nodiscard]] PluginResult precompute_signals(const CSeries* series, CSignalColumn* signals, size_t series_count) const override;
+        [[nodiscard]] bool has_state_hooks() const override;
+        [[nodiscard]] PluginResult save_state(const uint8_t** data_out, size_t* size_out) const override;
+        [[nodiscard]] PluginResult restore_state(const uint8_t* data, size_t size) const override;
+        [[nodiscard]] PluginResult on_end(const char** json_out) const override;
+        void free_string(const char* str) const override;
+        [[nodiscard]] std::string get_plugin_name() const override;
+        void unload_plugin() override;
+        [[nodiscard]] PluginExport* get_plugin_export() const override;
+        [[nodiscard]] plugins::manifest::HostParams get_host_params() const override;
+        [[nodiscard]] std::unique_ptr<IPluginLoader> create_instance(const SimulatorContext& ctx, const PluginInstanceOptions& instance_options) const override;
+
+       private:
+        // Sends one request and waits for its response. Returns false, and marks the worker dead, if it exited.
+        bool exchange(plugins::isolation::MessageType type, std::vector<uint8_t>& response) const;
+        [[nodiscard]] bool is_worker_alive() const;
+        [[nodiscard]] PluginResult decode_result(plugins::isolation::BufferReader& reader) const;
+
+        std::shared_ptr<plugins::manifest::PluginManifest> plugin_manifest_;
+        LoaderFactory inner_factory_;
+        PluginInstanceOptions instance_options_;
+        mutable PluginOptionsOverlay options_overlay_;
+        mutable PluginExport exp_{};
+        mutable simulators::ABIConverter abi_converter_;
+
+        std::unique_ptr<plugins::isolation::SharedChannel> channel_;
+        pid_t worker_pid_ = -1;
+        mutable bool is_worker_exited_ = false;
+        // Why the worker went away; returned as the message of every call made after that.
+        mutable std::string exit_message_;
+        bool has_precompute_signals_ = false;
+        bool has_state_hooks_ = false;
+
+        mutable plugins::isolation::BufferWriter request_;
+        mutable std::vector<uint8_t> response_;
+        mutable plugins::isolation::ResultFrame result_frame_;
+        mutable std::vector<uint8_t> saved_state_;
+        // What the worker already holds of the equity curve, see encode_state.
+        mutable plugins::isolation::EquitySent equity_sent_;
+    };
+}  // namespace plugins::loaders
+
+#endif
@@ -1,13 +1,25 @@
 #include "python_loader.hpp"
 
 #include <pybind11/embed.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include <pthread.h>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "../../http/api/stock_api.hpp"
 #include "../../simulators/back_test/abi_converter.hpp"
 #include "../../simulators/back_test/models.hpp"
 #include "../../simulators/back_test/state.hpp"
 #include "../abi/abi.h"
+#include "../isolation/ipc_codec.hpp"
 #include "../manifest/manifest.hpp"
 
 // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access, cppcoreguidelines-owning-memory)
@@ -15,16 +27,193 @@
 namespace py = pybind11;
 
 namespace plugins::loaders {
+    namespace {
+        // Isolated plugins run in workers forked from the host (see process_loader.hpp), which then keep using the
+        // interpreter they inherited. CPython has to be told about a fork it did not make itself, with the GIL held, and
+        // the forking thread is usually a pool thread that does not hold it yet.
+        void register_fork_handlers() {
+            static thread_local PyGILState_STATE fork_gil_state{};
+
+            pthread_atfork(
+                []() {
+                    fork_gil_state = PyGILState_Ensure();
+                    PyOS_BeforeFork();
+                },
+                []() {
+                    PyOS_AfterFork_Parent();
+                    PyGILState_Release(fork_gil_state);
+                },
+                []() {
+                    PyOS_AfterFork_Child();
+                    PyGILState_Release(fork_gil_state);
+                });
+        }
+
+        // Started once per process. The starting thread gives the GIL back, so plugins can be loaded and run from any
+        // pool thread; every call into Python takes the GIL for itself.
+        void ensure_interpreter() {
+            static std::once_flag started;
+            std::call_once(started, []() {
+                py::initialize_interpreter();
+                register_fork_handlers();
+                PyEval_SaveThread();
+            });
+        }
 
-    PythonLoader::PythonLoader(std::unique_ptr<plugins::manifest::PluginManifest> plugin_manifest) : plugin_manifest_(std::move(plugin_manifest)) {}
+        // Equity snapshots are handed to numpy plugins as one structured array, field names without the trailing
+        // underscore. Registration imports numpy, so it only happens once a plugin actually asks for numpy mode.
+        void register_numpy_dtypes() {
+            static std::once_flag registered;
+            std::call_once(registered, []() {
+                PYBIND11_NUMPY_DTYPE_EX(CEquitySnapshot, timestamp_ns_, "timestamp_ns", equity_, "equity", return_, "return", max_drawdown_, "max_drawdown",
+                                        sharpe_ratio_, "sharpe_ratio", sortino_ratio_, "sortino_ratio", calmar_ratio_, "calmar_ratio", tail_ratio_,
+                                        "tail_ratio", value_at_risk_, "value_at_risk", conditional_value_at_risk_, "conditional_value_at_risk");
+            });
+        }
 
-    void PythonLoader::load_plugin(const SimulatorContext& ctx) {
-        static bool py_up = false;
+        // Wraps host memory without copying. The no-op capsule stops numpy from taking a copy, and the view is marked
+        // read-only; the memory stays owned by the host and is only valid for the duration of the call.
+        template <typename T>
+        py::array_t<T> make_readonly_view(const T* data, size_t count) {
+            if (data == nullptr || count == 0) {
+                return py::array_t<T>(0);
+            }
 
-        if (!py_up) {
-            py::initialize_interpreter();
-            py_up = true;
+            py::array_t<T> view({count}, {sizeof(T)}, data, py::capsule(data, [](void*) {}));
+            py::detail::array_proxy(view.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+            return view;
+        }
+
+        template <typename T>
+        py::array_t<T> make_window_view(const std::vector<T>& column, size_t window_size) {
+            const size_t count = window_size == 0 ? column.size() : std::min(window_size, column.size());
+            return make_readonly_view(column.data() + (column.size() - count), count);
+        }
+
+        template <typename T>
+        void trim_front(std::vector<T>& column, size_t count) {
+            column.erase(column.begin(), column.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+
+        // The numpy windows live in the host, so they are saved with the plugin's own state to refill identically on resume.
+        void encode_bar_history(plugins::isolation::BufferWriter& writer, const std::unordered_map<std::string, PyBarHistory>& bar_history) {
+            writer.put<uint64_t>(bar_history.size());
+            for (const auto& [symbol, history] : bar_history) {
+                writer.put_string(symbol.c_str());
+                writer.put_array(history.unix_ts_ns_.data(), history.unix_ts_ns_.size());
+                writer.put_array(history.open_.data(), history.open_.size());
+                writer.put_array(history.high_.data(), history.high_.size());
+                writer.put_array(history.low_.data(), history.low_.size());
+                writer.put_array(history.close_.data(), history.close_.size());
+                writer.put_array(history.volume_.data(), history.volume_.size());
+            }
+        }
+
+        void decode_bar_history(plugins::isolation::BufferReader& reader, std::unordered_map<std::string, PyBarHistory>& bar_history) {
+            bar_history.clear();
+            std::deque<std::string> symbols;
+
+            const auto symbol_count = reader.get<uint64_t>();
+            for (uint64_t i = 0; i < symbol_count; ++i) {
+                auto& history = bar_history[reader.get_string(symbols)];
+                reader.get_array(history.unix_ts_ns_);
+                reader.get_array(history.open_);
+                reader.get_array(history.high_);
+                reader.get_array(history.low_);
+                reader.get_array(history.close_);
+                reader.get_array(history.volume_);
+            }
+        }
+
+        py::dict to_py_state(const CState* state) {
+            py::dict state_dict;
+            state_dict["cash"] = state->cash_;
+
+            py::list positions_list;
+            for (size_t i = 0; i < state->positions_count_; ++i) {
+                py::dict pos;
+                pos["symbol"] = state->positions_[i].symbol_;
+                pos["quantity"] = state->positions_[i].quantity_;
+                pos["average_price"] = state->positions_[i].average_price_;
+                positions_list.append(pos);
+            }
+            state_dict["positions"] = positions_list;
+
+            py::list fills_list;
+            for (size_t i = 0; i < state->new_fills_count_; ++i) {
+                py::dict fill;
+                fill["symbol"] = state->new_fills_[i].symbol_;
+                fill["quantity"] = state->new_fills_[i].quantity_;
+                fill["price"] = state->new_fills_[i].price_;
+                fill["created_at_ns"] = state->new_fills_[i].created_at_ns_;
+                fill["uuid"] = state->new_fills_[i].uuid_;
+                fill["action"] = state->new_fills_[i].action_;
+                fills_list.append(fill);
+            }
+            state_dict["new_fills"] = fills_list;
+
+            py::list exit_orders_list;
+            for (size_t i = 0; i < state->new_exit_orders_count_; ++i) {
+                py::dict exit_order;
+                const auto& order = state->new_exit_orders_[i];
+                exit_order["type"] = order.type_;
+                if (order.type_ == EXIT_ORDER_STOP_LOSS) {
+                    exit_order["symbol"] = order.data_.stop_loss_.symbol_;
+                    exit_order["trigger_quantity"] = order.data_.stop_loss_.trigger_quantity_;
+                    exit_order["stop_loss_price"] = order.data_.stop_loss_.stop_loss_price_;
+                    exit_order["fill_uuid"] = order.data_.stop_loss_.fill_uuid_;
+                } else if (order.type_ == EXIT_ORDER_TAKE_PROFIT) {
+                    exit_order["symbol"] = order.data_.take_profit_.symbol_;
+                    exit_order["trigger_quantity"] = order.data_.take_profit_.trigger_quantity_;
+                    exit_order["take_profit_price"] = order.data_.take_profit_.take_profit_price_;
+                    exit_order["fill_uuid"] = order.data_.take_profit_.fill_uuid_;
+                }
+                exit_orders_list.append(exit_order);
+            }
+            state_dict["new_exit_orders"] = exit_orders_list;
+
+            // Indexed by handle, the position of the indicator in the manifest's host_params.indicators.
+            py::list indicators_list;
+            for (size_t i = 0; i < state->indicators_count_; ++i) {
+                const auto& indicator = state->indicators_[i];
+                py::dict indicator_dict;
+                indicator_dict["symbol"] = indicator.symbol_;
+                indicator_dict["type"] = static_cast<int>(indicator.type_);
+                indicator_dict["is_ready"] = indicator.is_ready_;
+                indicator_dict["value"] = indicator.values_[0];
+                indicator_dict["values"] = py::make_tuple(indicator.values_[0], indicator.values_[1], indicator.values_[2]);
+                indicators_list.append(indicator_dict);
+            }
+            state_dict["indicators"] = indicators_list;
+
+            return state_dict;
+        }
+
+        py::list to_py_equity_curve(const CState* state) {
+            py::list equity_curve_list;
+            for (size_t i = 0; i < state->equity_curve_count_; ++i) {
+                py::dict equity;
+                equity["timestamp_ns"] = state->equity_curve_[i].timestamp_ns_;
+                equity["equity"] = state->equity_curve_[i].equity_;
+                equity["return"] = state->equity_curve_[i].return_;
+                equity["max_drawdown"] = state->equity_curve_[i].max_drawdown_;
+                equity["sharpe_ratio"] = state->equity_curve_[i].sharpe_ratio_;
+                equity["sortino_ratio"] = state->equity_curve_[i].sortino_ratio_;
+                equity["calmar_ratio"] = state->equity_curve_[i].calmar_ratio_;
+                equity["tail_ratio"] = state->equity_curve_[i].tail_ratio_;
+                equity["value_at_risk"] = state->equity_curve_[i].value_at_risk_;
+                equity["conditional_value_at_risk"] = state->equity_curve_[i].conditional_value_at_risk_;
+                equity_curve_list.append(equity);
+            }
+            return equity_curve_list;
         }
+    }  // namespace
+
+    PythonLoader::PythonLoader(std::shared_ptr<plugins::manifest::PluginManifest> plugin_manifest, PluginInstanceOptions instance_options)
+        : plugin_manifest_(std::move(plugin_manifest)), instance_options_(std::move(instance_options)) {}
+
+    void PythonLoader::load_plugin(const SimulatorContext& ctx) {
+        ensure_interpreter();
 
         try {
             py::gil_scoped_acquire gil;
@@ -33,11 +222,20 @@ namespace plugins::loaders {
             py::capsule ctx_capsule((void*)&ctx, "SimulatorContext", [](void*) {});
             py::object plugin_instance = create_plugin_fn(ctx_capsule);
 
-            auto* pp = new PyPlugin{plugin_instance, {}, {}, {}};
+            auto* pp = new PyPlugin{.obj_ = plugin_instance};
+
+            pp->use_numpy_ = py::hasattr(plugin_instance, "on_bar_numpy");
+            if (pp->use_numpy_) {
+                register_numpy_dtypes();
+            }
 
-            pp->vtable_.destroy = [](void* self) { delete static_cast<PyPlugin*>(self); };
+            pp->vtable_.destroy = [](void* self) {
+                py::gil_scoped_acquire gil;
+                delete static_cast<PyPlugin*>(self);
+            };
 
             pp->vtable_.on_init = [](void* self, const PluginOptions* opts) -> PluginResult {
+                py::gil_scoped_acquire gil;
                 auto& python_plugin = *static_cast<PyPlugin*>(self);
                 py::dict plugin_options_dict = py::dict{};
                 if (opts != nullptr) {
@@ -47,96 +245,119 @@ namespace plugins::loaders {
                 }
                 auto py_result = python_plugin.obj_.attr("on_init")(plugin_options_dict);
 
+                // Read after on_init, since plugins usually size the window from their options.
+                if (python_plugin.use_numpy_ && py::hasattr(python_plugin.obj_, "window_size")) {
+                    python_plugin.window_size_ = python_plugin.obj_.attr("window_size").cast<size_t>();
+                }
+
                 return PythonLoader::to_plugin_result(python_plugin, py_result);
             };
 
             pp->vtable_.on_start = [](void* self) -> PluginResult {
+                py::gil_scoped_acquire gil;
                 auto& python_plugin = *static_cast<PyPlugin*>(self);
                 auto py_result = python_plugin.obj_.attr("on_start")();
                 return PythonLoader::to_plugin_result(python_plugin, py_result);
             };
 
             pp->vtable_.on_bar = [](void* self, const CBar* bar, const CState* state) -> PluginResult {
+                py::gil_scoped_acquire gil;
                 auto& python_plugin = *static_cast<PyPlugin*>(self);
+                auto py_result = PythonLoader::call_on_bar(python_plugin, bar, state);
+                return PythonLoader::to_plugin_result(python_plugin, py_result);
+            };
 
-                py::dict state_dict;
-                state_dict["cash"] = state->cash_;
+            pp->vtable_.on_bar_into = [](void* self, const CBar* bar, const CState* state, CInstructionBuffer* out) -> PluginResult {
+                py::gil_scoped_acquire gil;
+                auto& python_plugin = *static_cast<PyPlugin*>(self);
+                auto py_result = PythonLoader::call_on_bar(python_plugin, bar, state);
+                return PythonLoader::to_plugin_result(python_plugin, py_result, out);
+            };
 
-                py::list positions_list;
-                for (size_t i = 0; i < state->positions_count_; ++i) {
-                    py::dict pos;
-                    pos["symbol"] = state->positions_[i].symbol_;
-                    pos["quantity"] = state->positions_[i].quantity_;
-                    pos["average_price"] = state->positions_[i].average_price_;
-                    positions_list.append(pos);
-                }
-                state_dict["positions"] = positions_list;
-
-                py::list fills_list;
-                for (size_t i = 0; i < state->new_fills_count_; ++i) {
-                    py::dict fill;
-                    fill["symbol"] = state->new_fills_[i].symbol_;
-                    fill["quantity"] = state->new_fills_[i].quantity_;
-                    fill["price"] = state->new_fills_[i].price_;
-                    fill["created_at_ns"] = state->new_fills_[i].created_at_ns_;
-                    fill["uuid"] = state->new_fills_[i].uuid_;
-                    fill["action"] = state->new_fills_[i].action_;
-                    fills_list.append(fill);
-                }
-                state_dict["new_fills"] = fills_list;
-
-                py::list exit_orders_list;
-                for (size_t i = 0; i < state->new_exit_orders_count_; ++i) {
-                    py::dict exit_order;
-                    const auto& order = state->new_exit_orders_[i];
-                    exit_order["type"] = order.type_;
-                    if (order.type_ == EXIT_ORDER_STOP_LOSS) {
-                        exit_order["symbol"] = order.data_.stop_loss_.symbol_;
-                        exit_order["trigger_quantity"] = order.data_.stop_loss_.trigger_quantity_;
-                        exit_order["stop_loss_price"] = order.data_.stop_loss_.stop_loss_price_;
-                        exit_order["fill_uuid"] = order.data_.stop_loss_.fill_uuid_;
-                    } else if (order.type_ == EXIT_ORDER_TAKE_PROFIT) {
-                        exit_order["symbol"] = order.data_.take_profit_.symbol_;
-                        exit_order["trigger_quantity"] = order.data_.take_profit_.trigger_quantity_;
-                        exit_order["take_profit_price"] = order.data_.take_profit_.take_profit_price_;
-                        exit_order["fill_uuid"] = order.data_.take_profit_.fill_uuid_;
+            // precompute_signals(series) gets {symbol: {column: read-only numpy view}} and returns {symbol: signals},
+            // where signals is any array-like of -1/0/1 with one entry per bar.
+            if (py::hasattr(plugin_instance, "precompute_signals")) {
+                register_numpy_dtypes();
+
+                pp->vtable_.precompute_signals = [](void* self, const CSeries* series, CSignalColumn* signals, size_t series_count) -> PluginResult {
+                    py::gil_scoped_acquire gil;
+                    auto& python_plugin = *static_cast<PyPlugin*>(self);
+
+                    py::dict series_dict;
+                    for (size_t i = 0; i < series_count; ++i) {
+                        const CSeries& s = series[i];
+                        py::dict columns;
+                        columns["unix_ts_ns"] = make_readonly_view(s.unix_ts_ns_, s.count_);
+                        columns["open"] = make_readonly_view(s.open_, s.count_);
+                        columns["high"] = make_readonly_view(s.high_, s.count_);
+                        columns["low"] = make_readonly_view(s.low_, s.count_);
+                        columns["close"] = make_readonly_view(s.close_, s.count_);
+                        columns["volume"] = make_readonly_view(s.volume_, s.count_);
+                        series_dict[s.symbol_] = columns;
                     }
-                    exit_orders_list.append(exit_order);
-                }
-                state_dict["new_exit_orders"] = exit_orders_list;
-
-                py::list equity_curve_list;
-                for (size_t i = 0; i < state->equity_curve_count_; ++i) {
-                    py::dict equity;
-                    equity["timestamp_ns"] = state->equity_curve_[i].timestamp_ns_;
-                    equity["equity"] = state->equity_curve_[i].equity_;
-                    equity["return"] = state->equity_curve_[i].return_;
-                    equity["max_drawdown"] = state->equity_curve_[i].max_drawdown_;
-                    equity["sharpe_ratio"] = state->equity_curve_[i].sharpe_ratio_;
-                    equity["sortino_ratio"] = state->equity_curve_[i].sortino_ratio_;
-                    equity["calmar_ratio"] = state->equity_curve_[i].calmar_ratio_;
-                    equity["tail_ratio"] = state->equity_curve_[i].tail_ratio_;
-                    equity["value_at_risk"] = state->equity_curve_[i].value_at_risk_;
-                    equity["conditional_value_at_risk"] = state->equity_curve_[i].conditional_value_at_risk_;
-                    equity_curve_list.append(equity);
-                }
-                state_dict["equity_curve"] = equity_curve_list;
 
-                py::dict bar_dict;
-                bar_dict["symbol"] = bar->symbol_;
-                bar_dict["unix_ts_ns"] = bar->unix_ts_ns_;
-                bar_dict["open"] = bar->open_;
-                bar_dict["high"] = bar->high_;
-                bar_dict["low"] = bar->low_;
-                bar_dict["close"] = bar->close_;
-                bar_dict["volume"] = bar->volume_;
+                    auto signals_dict = python_plugin.obj_.attr("precompute_signals")(series_dict).cast<py::dict>();
 
-                auto py_result = python_plugin.obj_.attr("on_bar")(bar_dict, state_dict);
+                    for (size_t i = 0; i < series_count; ++i) {
+                        CSignalColumn& column = signals[i];
+                        if (!signals_dict.contains(column.symbol_)) {
+                            continue;
+                        }
 
-                return PythonLoader::to_plugin_result(python_plugin, py_result);
-            };
+                        auto values = py::array_t<int8_t, py::array::c_style | py::array::forcecast>::ensure(signals_dict[column.symbol_]);
+                        if (!values) {
+                            return PluginResult{1, "precompute_signals returned a non numeric column", nullptr, 0};
+                        }
+
+                        const size_t count = std::min(column.count_, static_cast<size_t>(values.size()));
+                        std::copy_n(values.data(), count, column.signals_);
+                    }
+
+                    return PluginResult{0, nullptr, nullptr, 0};
+                };
+            }
+
+            // save_state() returns bytes and restore_state(data) gets them back. Numpy plugins get the hooks either way,
+            // since their windows are host state.
+            if ((py::hasattr(plugin_instance, "save_state") && py::hasattr(plugin_instance, "restore_state")) || pp->use_numpy_) {
+                pp->vtable_.save_state = [](void* self, const uint8_t** data_out, size_t* size_out) -> PluginResult {
+                    py::gil_scoped_acquire gil;
+                    auto& python_plugin = *static_cast<PyPlugin*>(self);
+                    auto& writer = python_plugin.saved_state_;
+
+                    writer.clear();
+                    encode_bar_history(writer, python_plugin.bar_history_);
+
+                    std::string plugin_state;
+                    if (py::hasattr(python_plugin.obj_, "save_state")) {
+                        plugin_state = python_plugin.obj_.attr("save_state")().cast<std::string>();
+                    }
+                    writer.put_array(plugin_state.data(), plugin_state.size());
+
+                    *data_out = writer.get_bytes().data();
+                    *size_out = writer.get_bytes().size();
+                    return PluginResult{0, nullptr, nullptr, 0};
+                };
+
+                pp->vtable_.restore_state = [](void* self, const uint8_t* data, size_t size) -> PluginResult {
+                    py::gil_scoped_acquire gil;
+                    auto& python_plugin = *static_cast<PyPlugin*>(self);
+
+                    plugins::isolation::BufferReader reader({data, size});
+                    decode_bar_history(reader, python_plugin.bar_history_);
+
+                    std::vector<char> plugin_state;
+                    reader.get_array(plugin_state);
+                    if (py::hasattr(python_plugin.obj_, "restore_state")) {
+                        python_plugin.obj_.attr("restore_state")(py::bytes(plugin_state.data(), plugin_state.size()));
+                    }
+
+                    return PluginResult{0, nullptr, nullptr, 0};
+                };
+            }
 
             pp->vtable_.on_end = [](void* self, const char** json_out) -> PluginResult {
+                py::gil_scoped_acquire gil;
                 auto& python_plugin = *static_cast<PyPlugin*>(self);
                 auto out = python_plugin.obj_.attr("on_end")().cast<std::string>();
                 char* heap = new char[out.size() + 1];
@@ -147,6 +368,7 @@ namespace plugins::loaders {
 
             pp->vtable_.free_string = [](void*, const char* p) { delete[] p; };
 
+            pp->vtable_.vtable_size_ = sizeof(PluginVTable);
             exp_ = PluginExport{PLUGIN_API_VERSION, pp, pp->vtable_};
         } catch (const py::error_already_set& e) {
             exp_ = PluginExport{0, nullptr, {}};
@@ -164,7 +386,7 @@ namespace plugins::loaders {
             return;
         }
 
-        auto options = plugin_manifest_->get_options();
+        auto options = options_overlay_.apply(plugin_manifest_->get_options(), instance_options_.option_overrides_);
         exp_.vtable_.on_init(exp_.instance_, &options);
     }
 
@@ -180,7 +402,9 @@ namespace plugins::loaders {
         return exp_.vtable_.on_start(exp_.instance_);
     }
 
-    PluginResult PythonLoader::on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state) const {
+    PluginResult PythonLoader::on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state, CInstructionBuffer& instructions) const {
+        instructions.count_ = 0;
+
         if (exp_.api_version_ != PLUGIN_API_VERSION) {
             return PluginResult{1, "Invalid API Version", nullptr, 0};
         }
@@ -199,9 +423,57 @@ namespace plugins::loaders {
 
         CState c_state = abi_converter_.to_c_state(state);
 
+        if (exp_.vtable_.on_bar_into != nullptr) {
+            return exp_.vtable_.on_bar_into(exp_.instance_, &c_bar, &c_state, &instructions);
+        }
+
         return exp_.vtable_.on_bar(exp_.instance_, &c_bar, &c_state);
     }
 
+    bool PythonLoader::has_precompute_signals() const {
+        return exp_.api_version_ == PLUGIN_API_VERSION && exp_.vtable_.precompute_signals != nullptr;
+    }
+
+    PluginResult PythonLoader::precompute_signals(const CSeries* series, CSignalColumn* signals, size_t series_count) const {
+        if (exp_.api_version_ != PLUGIN_API_VERSION) {
+            return PluginResult{1, "Invalid API Version", nullptr, 0};
+        }
+
+        if (exp_.vtable_.precompute_signals == nullptr) {
+            return PluginResult{1, "Undefined Method precompute_signals", nullptr, 0};
+        }
+
+        return exp_.vtable_.precompute_signals(exp_.instance_, series, signals, series_count);
+    }
+
+    bool PythonLoader::has_state_hooks() const {
+        return exp_.api_version_ == PLUGIN_API_VERSION && exp_.vtable_.save_state != nullptr && exp_.vtable_.restore_state != nullptr;
+    }
+
+    PluginResult PythonLoader::save_state(const uint8_t** data_out, size_t* size_out) const {
+        if (exp_.api_version_ != PLUGIN_API_VERSION) {
+            return PluginResult{1, "Invalid API Version", nullptr, 0};
+        }
+
+        if (exp_.vtable_.save_state == nullptr) {
+            return PluginResult{1, "Undefined Method save_state", nullptr, 0};
+        }
+
+        return exp_.vtable_.save_state(exp_.instance_, data_out, size_out);
+    }
+
+    PluginResult PythonLoader::restore_state(const uint8_t* data, size_t size) const {
+        if (exp_.api_version_ != PLUGIN_API_VERSION) {
+            return PluginResult{1, "Invalid API Version", nullptr, 0};
+        }
+
+        if (exp_.vtable_.restore_state == nullptr) {
+            return PluginResult{1, "Undefined Method restore_state", nullptr, 0};
+        }
+
+        return exp_.vtable_.restore_state(exp_.instance_, data, size);
+    }
+
     PluginResult PythonLoader::on_end(const char** json_out) const {
         if (exp_.api_version_ != PLUGIN_API_VERSION) {
             return PluginResult{1, "Invalid API Version", nullptr, 0};
@@ -239,13 +511,89 @@ namespace plugins::loaders {
 
     PluginExport* PythonLoader::get_plugin_export() const { return &exp_; }
 
-    std::string PythonLoader::get_plugin_name() const { return plugin_manifest_->get_name(); }
+    std::string PythonLoader::get_plugin_name() const {
+        return instance_options_.instance_name_.empty() ? plugin_manifest_->get_name() : instance_options_.instance_name_;
+    }
 
     plugins::manifest::HostParams PythonLoader::get_host_params() const { return plugin_manifest_->get_host_params(); }
 
-    PluginResult PythonLoader::to_plugin_result(PyPlugin& python_plugin, py::object& py_result) {
+    // The module is already imported, so a new instance only costs another create_plugin call.
+    std::unique_ptr<IPluginLoader> PythonLoader::create_instance(const SimulatorContext& ctx, const PluginInstanceOptions& instance_options) const {
+        auto instance = std::make_unique<PythonLoader>(plugin_manifest_, instance_options);
+        instance->load_plugin(ctx);
+        return instance;
+    }
+
+    py::object PythonLoader::call_on_bar(PyPlugin& python_plugin, const CBar* bar, const CState* state) {
+        if (python_plugin.use_numpy_) {
+            return PythonLoader::on_bar_numpy(python_plugin, bar, state);
+        }
+
+        py::dict state_dict = to_py_state(state);
+        state_dict["equity_curve"] = to_py_equity_curve(state);
+
+        py::dict bar_dict;
+        bar_dict["symbol"] = bar->symbol_;
+        bar_dict["unix_ts_ns"] = bar->unix_ts_ns_;
+        bar_dict["open"] = bar->open_;
+        bar_dict["high"] = bar->high_;
+        bar_dict["low"] = bar->low_;
+        bar_dict["close"] = bar->close_;
+        bar_dict["volume"] = bar->volume_;
+
+        return python_plugin.obj_.attr("on_bar")(bar_dict, state_dict);
+    }
+
+    // Numpy mode: the plugin receives on_bar_numpy(symbol, window, state). Window is a dict of read-only column views
+    // (unix_ts_ns, open, high, low, close, volume) over the symbol's last window_size bars, the current bar last.
+    // state["equity_curve"] is a structured array view. Views alias host memory and must be copied to be kept.
+    py::object PythonLoader::on_bar_numpy(PyPlugin& python_plugin, const CBar* bar, const CState* state) {
+        auto& history = python_plugin.bar_history_[bar->symbol_];
+
+        // Keep at most two windows resident, so trimming is amortized and the window stays contiguous.
+        if (python_plugin.window_size_ > 0 && history.close_.size() >= 2 * python_plugin.window_size_) {
+            const size_t excess = history.close_.size() - python_plugin.window_size_ + 1;
+            trim_front(history.unix_ts_ns_, excess);
+            trim_front(history.open_, excess);
+            trim_front(history.high_, excess);
+            trim_front(history.low_, excess);
+            trim_front(history.close_, excess);
+            trim_front(history.volume_, excess);
+        }
+
+        history.unix_ts_ns_.push_back(bar->unix_ts_ns_);
+        history.open_.push_back(bar->open_);
+        history.high_.push_back(bar->high_);
+        history.low_.push_back(bar->low_);
+        history.close_.push_back(bar->close_);
+        history.volume_.push_back(bar->volume_);
+
+        const size_t window_size = python_plugin.window_size_;
+
+        py::dict window;
+        window["unix_ts_ns"] = make_window_view(history.unix_ts_ns_, window_size);
+        window["open"] = make_window_view(history.open_, window_size);
+        window["high"] = make_window_view(history.high_, window_size);
+        window["low"] = make_window_view(history.low_, window_size);
+        window["close"] = make_window_view(history.close_, window_size);
+        window["volume"] = make_window_view(history.volume_, window_size);
+
+        py::dict state_dict = to_py_state(state);
+        state_dict["equity_curve"] = make_readonly_view(state->equity_curve_, state->equity_curve_count_);
+
+        return python_plugin.obj_.attr("on_bar_numpy")(bar->symbol_, window, state_dict);
+    }
+
+    // Symbols, actions and order types come from a small set, so they are interned once per plugin instead of being copied on every call.
+    const char* PythonLoader::intern(PyPlugin& python_plugin, std::string value) {
+        return python_plugin.interned_strings_.insert(std::move(value)).first->c_str();
+    }
+
+    PluginResult PythonLoader::to_plugin_result(PyPlugin& python_plugin, py::object& py_result, CInstructionBuffer* out) {
         python_plugin.current_instructions_.clear();
-        python_plugin.instruction_strings_.clear();
+        if (out != nullptr) {
+            out->count_ = 0;
+        }
 
         int status_code = 0;
         py::list instructions_list;
@@ -261,18 +609,14 @@ namespace plugins::loaders {
         for (auto item : instructions_list) {
             auto inst_dict = item.cast<py::dict>();
 
-            python_plugin.instruction_strings_.push_back(inst_dict["symbol"].cast<std::string>());
-            const char* symbol = python_plugin.instruction_strings_.back().c_str();
-
-            python_plugin.instruction_strings_.push_back(inst_dict["action"].cast<std::string>());
-            const char* action = python_plugin.instruction_strings_.back().c_str();
+            const char* symbol = intern(python_plugin, inst_dict["symbol"].cast<std::string>());
+            const char* action = intern(python_plugin, inst_dict["action"].cast<std::string>());
 
             CInstruction c_inst;
             if (inst_dict.contains("quantity")) {
                 c_inst.type_ = INSTRUCTION_TYPE_ORDER;
 
-                python_plugin.instruction_strings_.push_back(inst_dict.contains("order_type") ? inst_dict["order_type"].cast<std::string>() : "market");
-                const char* order_type = python_plugin.instruction_strings_.back().c_str();
+                const char* order_type = intern(python_plugin, inst_dict.contains("order_type") ? inst_dict["order_type"].cast<std::string>() : "market");
 
                 c_inst.data_.order_.symbol_ = symbol;
                 c_inst.data_.order_.action_ = action;
@@ -291,7 +635,11 @@ namespace plugins::loaders {
                 c_inst.data_.signal_.action_ = action;
             }
 
-            python_plugin.current_instructions_.push_back(c_inst);
+            if (out != nullptr && out->count_ < out->capacity_) {
+                out->instructions_[out->count_++] = c_inst;
+            } else {
+                python_plugin.current_instructions_.push_back(c_inst);
+            }
         }
 
         return PluginResult{status_code, status_code == 0 ? nullptr : "on_bar failed",
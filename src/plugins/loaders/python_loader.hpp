@@ -5,28 +5,49 @@
 #include <pybind11/pybind11.h>
 
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "../../http/api/stock_api.hpp"
 #include "../../simulators/back_test/abi_converter.hpp"
 #include "../../simulators/back_test/state.hpp"
 #include "../abi/abi.h"
+#include "../isolation/ipc_codec.hpp"
 #include "../manifest/manifest.hpp"
 #include "interface.hpp"
 
 namespace py = pybind11;
 
 namespace plugins::loaders {
+    // Per-symbol bar history kept as structure-of-arrays, so numpy views over it need no copying.
+    struct PyBarHistory {
+        std::vector<int64_t> unix_ts_ns_;
+        std::vector<double> open_;
+        std::vector<double> high_;
+        std::vector<double> low_;
+        std::vector<double> close_;
+        std::vector<double> volume_;
+    };
+
     struct PyPlugin {
         py::object obj_;
-        PluginVTable vtable_;
+        PluginVTable vtable_{};
         std::vector<CInstruction> current_instructions_;
-        std::vector<std::string> instruction_strings_;
+        std::unordered_set<std::string> interned_strings_;
+
+        // Set when the plugin defines on_bar_numpy(symbol, window, state); see python_loader.cpp.
+        bool use_numpy_ = false;
+        size_t window_size_ = 0;
+        std::unordered_map<std::string, PyBarHistory> bar_history_;
+
+        // Bytes handed out by the last save_state call.
+        plugins::isolation::BufferWriter saved_state_;
     };
 
     class PythonLoader : public IPluginLoader {
        public:
-        explicit PythonLoader(std::unique_ptr<plugins::manifest::PluginManifest> plugin_manifest);
+        explicit PythonLoader(std::shared_ptr<plugins::manifest::PluginManifest> plugin_manifest, PluginInstanceOptions instance_options = {});
         ~PythonLoader() override = default;
 
         PythonLoader(const PythonLoader&) = delete;
@@ -37,18 +58,30 @@ namespace plugins::loaders {
         void load_plugin(const SimulatorContext& ctx) override;
         void on_init() const override;
         [[nodiscard]] PluginResult on_start() const override;
-        [[nodiscard]] PluginResult on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state) const override;  // Changed
+        [[nodiscard]] PluginResult on_bar(const http::stock_api::AggregateBarResult& bar, simulators::State& state,
+                                          CInstructionBuffer& instructions) const override;
+        [[nodiscard]] bool has_precompute_signals() const override;
+        [[nodiscard]] PluginResult precompute_signals(const CSeries* series, CSignalColumn* signals, size_t series_count) const override;
+        [[nodiscard]] bool has_state_hooks() const override;
+        [[nodiscard]] PluginResult save_state(const uint8_t** data_out, size_t* size_out) const override;
+        [[nodiscard]] PluginResult restore_state(const uint8_t* data, size_t size) const override;
         [[nodiscard]] PluginResult on_end(const char** json_out) const override;
         void free_string(const char* str) const override;
         [[nodiscard]] std::string get_plugin_name() const override;
         void unload_plugin() override;
         [[nodiscard]] PluginExport* get_plugin_export() const override;
         [[nodiscard]] plugins::manifest::HostParams get_host_params() const override;
+        [[nodiscard]] std::unique_ptr<IPluginLoader> create_instance(const SimulatorContext& ctx, const PluginInstanceOptions& instance_options) const override;
 
        private:
-        [[nodiscard]] static PluginResult to_plugin_result(PyPlugin& python_plugin, py::object& py_result);
+        [[nodiscard]] static const char* intern(PyPlugin& python_plugin, std::string value);
+        [[nodiscard]] static PluginResult to_plugin_result(PyPlugin& python_plugin, py::object& py_result, CInstructionBuffer* out = nullptr);
+        [[nodiscard]] static py::object call_on_bar(PyPlugin& python_plugin, const CBar* bar, const CState* state);
+        [[nodiscard]] static py::object on_bar_numpy(PyPlugin& python_plugin, const CBar* bar, const CState* state);
 
-        std::unique_ptr<plugins::manifest::PluginManifest> plugin_manifest_;
+        std::shared_ptr<plugins::manifest::PluginManifest> plugin_manifest_;
+        PluginInstanceOptions instance_options_;
+        mutable PluginOptionsOverlay options_overlay_;
         mutable PluginExport exp_{};
         mutable simulators::ABIConverter abi_converter_;  // Add this for state conversion
     };
@@ -1,58 +1,278 @@
 #include "plugin_manager.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include "../loaders/interface.hpp"
 #include "../loaders/native_loader.hpp"
+#include "../loaders/process_loader.hpp"
 #include "../loaders/python_loader.hpp"
 #include "../manifest/manifest.hpp"
+#include "../manifest/manifest_index.hpp"
+#include "plugin_watcher.hpp"
+
+// 64-bit FNV-1a, spelled out so fingerprints stay the same across builds of the host.
+static constexpr uint64_t FINGERPRINT_OFFSET_BASIS = 14695981039346656037ULL;
+static constexpr uint64_t FINGERPRINT_PRIME = 1099511628211ULL;
+static constexpr size_t FINGERPRINT_READ_SIZE = 64 * 1024;
 
 namespace plugins::manager {
+    namespace {
+        void hash_bytes(uint64_t& hash, std::string_view bytes) {
+            for (const char byte : bytes) {
+                hash ^= static_cast<uint8_t>(byte);
+                hash *= FINGERPRINT_PRIME;
+            }
+        }
+
+        // Terminated, so consecutive strings cannot run into each other.
+        void hash_text(uint64_t& hash, std::string_view text) {
+            hash_bytes(hash, text);
+            hash_bytes(hash, std::string_view("\0", 1));
+        }
+
+        void hash_file(uint64_t& hash, const std::filesystem::path& path) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) {
+                throw std::runtime_error("Failed to read plugin file: " + path.string());
+            }
+
+            std::array<char, FINGERPRINT_READ_SIZE> buffer{};
+            while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0) {
+                hash_bytes(hash, std::string_view(buffer.data(), static_cast<size_t>(in.gcount())));
+            }
+        }
+    }  // namespace
+
     PluginManager::PluginManager(const std::vector<std::string>& plugin_names) : plugin_names_(plugin_names) { ctx_.api_version_ = PLUGIN_API_VERSION; }
 
-    void PluginManager::load_plugins_from_dir(const std::filesystem::path& root) {
+    // Names are filtered first, from the manifest index where possible, so manifests of plugins that were not asked for
+    // are never fully parsed. The selected plugins are then parsed, loaded and initialized concurrently on the pool;
+    // Python imports still take turns on the GIL but overlap with native loads.
+    void PluginManager::load_plugins_from_dir(const std::filesystem::path& root, concurrency::ThreadPool& pool) {
         if (plugin_names_.empty()) {
             throw std::runtime_error("No plugin names provided to load");
         }
 
+        plugins::manifest::ManifestIndex manifest_index(root / plugins::manifest::MANIFEST_INDEX_FILE);
+        std::vector<std::filesystem::path> plugin_dirs;
+
         for (const auto& dir : std::filesystem::directory_iterator{root}) {
             if (!dir.is_directory()) {
                 continue;
             }
 
-            std::unique_ptr<plugins::manifest::PluginManifest> plugin_manifest = std::make_unique<plugins::manifest::PluginManifest>();
+            if (std::ranges::find(plugin_names_, manifest_index.get_plugin_name(dir.path())) != plugin_names_.end()) {
+                plugin_dirs.push_back(dir.path());
+            }
+        }
 
-            auto document = plugin_manifest->load_from_file(dir.path());
+        manifest_index.save();
 
-            plugin_manifest->parse_json(document);
+        std::mutex plugins_mutex;
+        std::exception_ptr first_error;
 
-            if (!plugin_manifest->is_one_of(plugin_names_)) {
-                continue;
-            }
+        for (const auto& plugin_dir : plugin_dirs) {
+            pool.enqueue([this, plugin_dir, &plugins_mutex, &first_error]() {
+                try {
+                    PluginSource source{.dir_ = plugin_dir, .watch_files_ = {}, .instances_ = {}};
+                    auto loader = load_plugin_from_dir(plugin_dir, source.watch_files_);
 
-            auto loader = [&]() -> std::unique_ptr<plugins::loaders::IPluginLoader> {
-                if (plugin_manifest->is_python()) {
-                    return std::make_unique<plugins::loaders::PythonLoader>(std::move(plugin_manifest));
+                    std::lock_guard<std::mutex> lock(plugins_mutex);
+                    plugin_sources_by_name_.emplace(loader->get_plugin_name(), std::move(source));
+                    plugin_map_by_name_.emplace(loader->get_plugin_name(), std::move(loader));
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(plugins_mutex);
+                    if (first_error == nullptr) {
+                        first_error = std::current_exception();
+                    }
                 }
+            });
+        }
 
-                if (plugin_manifest->is_native()) {
-                    return std::make_unique<plugins::loaders::NativeLoader>(std::move(plugin_manifest));
-                }
+        pool.wait_all();
 
-                throw std::runtime_error("Unknown plugin kind in manifest");
-            }();
+        if (first_error != nullptr) {
+            std::rethrow_exception(first_error);
+        }
+    }
 
-            loader->load_plugin(ctx_);
+    // In-process Python plugins get no watch files: their module stays imported in the interpreter, so reloading them
+    // would run the old code.
+    std::unique_ptr<plugins::loaders::IPluginLoader> PluginManager::load_plugin_from_dir(const std::filesystem::path& plugin_dir,
+                                                                                         std::vector<std::filesystem::path>& watch_files) const {
+        std::shared_ptr<plugins::manifest::PluginManifest> plugin_manifest = std::make_shared<plugins::manifest::PluginManifest>();
+
+        auto document = plugin_manifest->load_from_file(plugin_dir);
+
+        plugin_manifest->parse_json(document);
+
+        if (plugin_manifest->is_native() || plugin_manifest->is_process_isolated()) {
+            watch_files.push_back(plugin_dir / "manifest.json");
+        }
+
+        // An isolated native library is only opened in the worker, so its path is only known if the manifest spells it out.
+        if (plugin_manifest->is_native() && plugin_manifest->is_process_isolated() && plugin_manifest->get_entry().find('/') != std::string::npos) {
+            watch_files.emplace_back(plugin_manifest->get_entry());
+        }
+
+        auto loader = [&]() -> std::unique_ptr<plugins::loaders::IPluginLoader> {
+            // The inner loader is only built in the worker, so a native library is never mapped into the host.
+            if (plugin_manifest->is_process_isolated()) {
+                auto inner_factory = [plugin_manifest]() -> std::unique_ptr<plugins::loaders::IPluginLoader> {
+                    if (plugin_manifest->is_native()) {
+                        return std::make_unique<plugins::loaders::NativeLoader>(plugin_manifest);
+                    }
+                    return std::make_unique<plugins::loaders::PythonLoader>(plugin_manifest);
+                };
+                return std::make_unique<plugins::loaders::ProcessLoader>(plugin_manifest, std::move(inner_factory));
+            }
+
+            if (plugin_manifest->is_python()) {
+                return std::make_unique<plugins::loaders::PythonLoader>(plugin_manifest);
+            }
+
+            if (plugin_manifest->is_native()) {
+                return std::make_unique<plugins::loaders::NativeLoader>(plugin_manifest);
+            }
+
+            throw std::runtime_error("Unknown plugin kind in manifest");
+        }();
+
+        loader->load_plugin(ctx_);
+
+        if (const auto* native_loader = dynamic_cast<const plugins::loaders::NativeLoader*>(loader.get()); native_loader != nullptr) {
+            if (auto library_path = native_loader->get_library_path(); !library_path.empty()) {
+                watch_files.push_back(std::move(library_path));
+            }
+        }
+
+        loader->on_init();
+
+        return loader;
+    }
+
+    void PluginManager::create_plugin_instances(const std::string& plugin_name, const std::vector<plugins::loaders::PluginInstanceOptions>& instances) {
+        auto it = plugin_map_by_name_.find(plugin_name);
+        if (it == plugin_map_by_name_.end()) {
+            throw std::runtime_error("Cannot create instances of unloaded plugin: " + plugin_name);
+        }
+
+        const auto* base_loader = it->second.get();
+
+        for (const auto& instance_options : instances) {
+            if (instance_options.instance_name_.empty() || plugin_map_by_name_.contains(instance_options.instance_name_)) {
+                throw std::runtime_error("Plugin instance names must be unique and non empty: " + instance_options.instance_name_);
+            }
+
+            auto loader = base_loader->create_instance(ctx_, instance_options);
 
             loader->on_init();
 
             plugin_map_by_name_.emplace(loader->get_plugin_name(), std::move(loader));
+            plugin_sources_by_name_.at(plugin_name).instances_.push_back(instance_options);
+        }
+    }
+
+    plugins::loaders::IPluginLoader* PluginManager::get_plugin(const std::string& plugin_name) const {
+        const auto it = plugin_map_by_name_.find(plugin_name);
+        return it != plugin_map_by_name_.end() ? it->second.get() : nullptr;
+    }
+
+    uint64_t PluginManager::get_plugin_fingerprint(const std::string& plugin_name) const {
+        const PluginSource* source = nullptr;
+        const plugins::loaders::PluginInstanceOptions* instance_options = nullptr;
+        for (const auto& [base_name, candidate] : plugin_sources_by_name_) {
+            const auto it = std::ranges::find_if(candidate.instances_, [&plugin_name](const auto& options) { return options.instance_name_ == plugin_name; });
+            if (base_name == plugin_name || it != candidate.instances_.end()) {
+                source = &candidate;
+                instance_options = it != candidate.instances_.end() ? &*it : nullptr;
+                break;
+            }
+        }
+        if (source == nullptr) {
+            throw std::runtime_error("Cannot fingerprint a plugin that was not loaded from a directory: " + plugin_name);
+        }
+
+        uint64_t hash = FINGERPRINT_OFFSET_BASIS;
+        const auto manifest_path = source->dir_ / "manifest.json";
+        hash_file(hash, manifest_path);
+        for (const auto& file : source->watch_files_) {
+            if (file != manifest_path) {
+                hash_file(hash, file);
+            }
+        }
+
+        if (instance_options != nullptr) {
+            for (const auto& [key, value] : instance_options->option_overrides_) {
+                hash_text(hash, key);
+                hash_text(hash, value);
+            }
+        }
+        return hash;
+    }
+
+    void PluginManager::watch_plugins(PluginWatcher& watcher) const {
+        for (const auto& [plugin_name, source] : plugin_sources_by_name_) {
+            for (const auto& file : source.watch_files_) {
+                watcher.watch(plugin_name, file);
+            }
         }
     }
 
+    std::vector<std::string> PluginManager::reload_plugin(const std::string& plugin_name) {
+        const auto source_it = plugin_sources_by_name_.find(plugin_name);
+        if (source_it == plugin_sources_by_name_.end()) {
+            throw std::runtime_error("Cannot reload a plugin that was not loaded from a directory: " + plugin_name);
+        }
+        const auto& source = source_it->second;
+
+        auto unload = [this](const std::string& name) {
+            if (auto it = plugin_map_by_name_.find(name); it != plugin_map_by_name_.end()) {
+                it->second->unload_plugin();
+                plugin_map_by_name_.erase(it);
+            }
+        };
+
+        // Instances share the base plugin's library, so every one of them has to let go of it before it can be opened
+        // again; otherwise dlopen hands back the library that is still mapped.
+        for (const auto& instance_options : source.instances_) {
+            unload(instance_options.instance_name_);
+        }
+        unload(plugin_name);
+
+        std::vector<std::filesystem::path> watch_files;
+        auto loader = load_plugin_from_dir(source.dir_, watch_files);
+        if (loader->get_plugin_name() != plugin_name) {
+            loader->unload_plugin();
+            throw std::runtime_error("Plugin was renamed while being watched, restart to pick it up: " + plugin_name);
+        }
+
+        std::vector<std::string> reloaded_names = {plugin_name};
+        const auto* base_loader = loader.get();
+        plugin_map_by_name_.emplace(plugin_name, std::move(loader));
+
+        for (const auto& instance_options : source.instances_) {
+            auto instance = base_loader->create_instance(ctx_, instance_options);
+            instance->on_init();
+            reloaded_names.push_back(instance->get_plugin_name());
+            plugin_map_by_name_.emplace(instance->get_plugin_name(), std::move(instance));
+        }
+
+        return reloaded_names;
+    }
+
     PluginManager::~PluginManager() {
         for (auto& [plugin_name, loader] : plugin_map_by_name_) {
             loader->unload_plugin();
@@ -2,19 +2,46 @@
 #define QUANT_FORGE_PLUGIN_MANAGER_HPP
 
 #pragma once
+#include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "../../utils/thread_pool.hpp"
 #include "../abi/abi.h"
 #include "../loaders/interface.hpp"
 
 namespace plugins::manager {
 
+    class PluginWatcher;
+
+    // Where a plugin was loaded from, kept so it can be reloaded in place.
+    struct PluginSource {
+        std::filesystem::path dir_;
+        // Rewriting any of these triggers a reload: the manifest and, when known, the native library.
+        std::vector<std::filesystem::path> watch_files_;
+        std::vector<plugins::loaders::PluginInstanceOptions> instances_;
+    };
+
     class PluginManager {
        public:
         PluginManager(const std::vector<std::string>& plugin_names);
 
-        void load_plugins_from_dir(const std::filesystem::path& root);
+        void load_plugins_from_dir(const std::filesystem::path& root, concurrency::ThreadPool& pool);
+        // Adds instances of an already loaded plugin, e.g. one per parameter set of a sweep. Native instances share the
+        // loaded library, so a sweep needs a single dlopen however many instances it runs.
+        void create_plugin_instances(const std::string& plugin_name, const std::vector<plugins::loaders::PluginInstanceOptions>& instances);
+        [[nodiscard]] plugins::loaders::IPluginLoader* get_plugin(const std::string& plugin_name) const;
+        // A hash of what decides the plugin's back test: its manifest, its native library when the path is known and, for
+        // an instance, its option overrides. Python sources are not covered, as their module is only named by the manifest.
+        [[nodiscard]] uint64_t get_plugin_fingerprint(const std::string& plugin_name) const;
+
+        void watch_plugins(PluginWatcher& watcher) const;
+        // Unloads the plugin and its instances, loads it again from its directory and recreates the instances.
+        // Returns the names of every loader that was replaced.
+        std::vector<std::string> reload_plugin(const std::string& plugin_name);
 
         ~PluginManager();
         PluginManager(const PluginManager&) = delete;
@@ -32,7 +59,11 @@ namespace plugins::manager {
        private:
         SimulatorContext ctx_{};
         std::unordered_map<std::string, std::unique_ptr<plugins::loaders::IPluginLoader>> plugin_map_by_name_;
+        std::unordered_map<std::string, PluginSource> plugin_sources_by_name_;
         std::vector<std::string> plugin_names_;
+
+        [[nodiscard]] std::unique_ptr<plugins::loaders::IPluginLoader> load_plugin_from_dir(const std::filesystem::path& plugin_dir,
+                                                                                          std::vector<std::filesystem::path>& watch_files) const;
     };
 
 }  // namespace plugins::manager
@@ -0,0 +1,119 @@
+#include "plugin_watcher.hpp"
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+static constexpr int SETTLE_TIMEOUT_MS = 200;
+static constexpr size_t EVENT_BUFFER_SIZE = 16 * 1024;
+#endif
+
+namespace plugins::manager {
+
+#if defined(__linux__)
+
+    PluginWatcher::PluginWatcher() : inotify_fd_(inotify_init1(IN_CLOEXEC)) {
+        if (inotify_fd_ < 0) {
+            throw std::runtime_error("Failed to start plugin watcher: " + std::string(std::strerror(errno)));
+        }
+    }
+
+    PluginWatcher::~PluginWatcher() {
+        if (inotify_fd_ >= 0) {
+            close(inotify_fd_);
+        }
+    }
+
+    void PluginWatcher::watch(const std::string& plugin_name, const std::filesystem::path& file) {
+        const auto absolute_file = std::filesystem::absolute(file).lexically_normal();
+        const auto dir = absolute_file.parent_path();
+
+        // Linkers usually write a new file and rename it into place, so the directory is watched rather than the file.
+        const int watch = inotify_add_watch(inotify_fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (watch < 0) {
+            throw std::runtime_error("Failed to watch " + dir.string() + ": " + std::string(std::strerror(errno)));
+        }
+
+        dirs_by_watch_[watch] = dir;
+
+        auto& plugin_names = plugins_by_file_[absolute_file.string()];
+        if (std::ranges::find(plugin_names, plugin_name) == plugin_names.end()) {
+            plugin_names.push_back(plugin_name);
+        }
+    }
+
+    std::vector<std::string> PluginWatcher::wait_for_changes() {
+        std::unordered_set<std::string> changed;
+
+        while (changed.empty()) {
+            read_events(-1, changed);
+        }
+
+        while (read_events(SETTLE_TIMEOUT_MS, changed)) {
+        }
+
+        return {changed.begin(), changed.end()};
+    }
+
+    bool PluginWatcher::read_events(int timeout_ms, std::unordered_set<std::string>& changed) {
+        pollfd poll_fd{.fd = inotify_fd_, .events = POLLIN, .revents = 0};
+
+        const int ready = poll(&poll_fd, 1, timeout_ms);
+        if (ready < 0 && errno != EINTR) {
+            throw std::runtime_error("Plugin watcher poll failed: " + std::string(std::strerror(errno)));
+        }
+        if (ready <= 0) {
+            return false;
+        }
+
+        alignas(inotify_event) std::array<char, EVENT_BUFFER_SIZE> buffer{};
+        const ssize_t length = read(inotify_fd_, buffer.data(), buffer.size());
+        if (length <= 0) {
+            return false;
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            const auto dir = dirs_by_watch_.find(event->wd);
+            if (dir == dirs_by_watch_.end() || event->len == 0) {
+                continue;
+            }
+
+            const auto it = plugins_by_file_.find((dir->second / event->name).string());
+            if (it != plugins_by_file_.end()) {
+                changed.insert(it->second.begin(), it->second.end());
+            }
+        }
+
+        return true;
+    }
+
+#else
+    PluginWatcher::PluginWatcher() { throw std::runtime_error("Watch mode is unsupported on this platform: it needs inotify, which is Linux only"); }
+
+    PluginWatcher::~PluginWatcher() = default;
+
+    void PluginWatcher::watch(const std::string& /*plugin_name*/, const std::filesystem::path& /*file*/) {}
+
+    std::vector<std::string> PluginWatcher::wait_for_changes() { return {}; }
+
+    bool PluginWatcher::read_events(int /*timeout_ms*/, std::unordered_set<std::string>& /*changed*/) { return false; }
+#endif
+
+}  // namespace plugins::manager
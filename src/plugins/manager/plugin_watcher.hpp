@@ -0,0 +1,42 @@
+#ifndef QUANT_FORGE_PLUGINS_MANAGER_PLUGIN_WATCHER_HPP
+#define QUANT_FORGE_PLUGINS_MANAGER_PLUGIN_WATCHER_HPP
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace plugins::manager {
+
+    // Reports which plugins had one of their files rewritten, using inotify on the files' directories. A rebuild writes
+    // several files in quick succession, so changes are only returned once the directories have been quiet for a moment.
+    // Elsewhere than Linux the constructor throws, as there is nothing to watch with.
+    class PluginWatcher {
+       public:
+        PluginWatcher();
+
+        ~PluginWatcher();
+        PluginWatcher(const PluginWatcher&) = delete;
+        PluginWatcher& operator=(const PluginWatcher&) = delete;
+        PluginWatcher(PluginWatcher&&) = delete;
+        PluginWatcher& operator=(PluginWatcher&&) = delete;
+
+        void watch(const std::string& plugin_name, const std::filesystem::path& file);
+        // Blocks until at least one watched file changed; each affected plugin is listed once.
+        [[nodiscard]] std::vector<std::string> wait_for_changes();
+
+       private:
+        int inotify_fd_ = -1;
+        std::unordered_map<int, std::filesystem::path> dirs_by_watch_;
+        std::unordered_map<std::string, std::vector<std::string>> plugins_by_file_;
+
+        // Returns false when nothing arrived within timeout_ms.
+        bool read_events(int timeout_ms, std::unordered_set<std::string>& changed);
+    };
+
+}  // namespace plugins::manager
+
+#endif
@@ -29,30 +29,76 @@ namespace plugins::manifest {
             return T(value);
         }
 
+        // For fields that may be left out of the manifest entirely: a missing field yields the fallback value.
+        template <typename T>
+        static T parse_value_or_fallback(simdjson::simdjson_result<T> result, const ParserOptions<T>& options) {
+            if (!options.is_required_ && result.error() == simdjson::error_code::NO_SUCH_FIELD) {
+                return options.fallback_value_;
+            }
+
+            return parse_value(std::move(result), options);
+        }
+
+        // For fields whose absence means the feature is off: a missing field yields no value.
+        template <typename T>
+        static std::optional<T> parse_optional_value(simdjson::simdjson_result<T> result, const ParserOptions<T>& options) {
+            if (!options.is_required_ && result.error() == simdjson::error_code::NO_SUCH_FIELD) {
+                return std::nullopt;
+            }
+
+            return parse_value(std::move(result), options);
+        }
+
     }  // namespace parser
 
     bool PluginManifest::is_python() const { return kind_ == "python"; };
 
     bool PluginManifest::is_native() const { return kind_ == "native"; };
 
+    bool PluginManifest::is_process_isolated() const { return isolation_ == "process"; };
+
     bool PluginManifest::is_one_of(const std::vector<std::string>& plugin_names) const {
         return std::ranges::any_of(plugin_names, [this](const std::string& plugin_name) { return plugin_name == name_; });
     };
 
-    simdjson::ondemand::document PluginManifest::load_from_file(const std::filesystem::path& path) {
-        std::filesystem::path manifest_json_file = path / "manifest.json";
+    namespace {
+        simdjson::padded_string load_manifest_json(const std::filesystem::path& path) {
+            std::filesystem::path manifest_json_file = path / "manifest.json";
+
+            if (!std::filesystem::exists(manifest_json_file) || !std::filesystem::is_regular_file(manifest_json_file)) {
+                throw std::runtime_error("Manifest file not found");
+            }
 
-        if (!std::filesystem::exists(manifest_json_file) || !std::filesystem::is_regular_file(manifest_json_file)) {
-            throw std::runtime_error("Manifest file not found");
+            auto manifest_json = simdjson::padded_string::load(manifest_json_file.string());
+            if (manifest_json.error() != simdjson::error_code::SUCCESS) {
+                throw std::runtime_error("Manifest file could not be read");
+            }
+
+            return std::move(manifest_json).value();
         }
 
-        simdjson::ondemand::parser parser;
-        simdjson::padded_string manifest_json = simdjson::padded_string::load(manifest_json_file.string());
-        simdjson::ondemand::document manifest_document = parser.iterate(manifest_json);
+        // Manifests are loaded concurrently, so each thread reuses its own parser rather than allocating one per file.
+        simdjson::ondemand::parser& get_thread_parser() {
+            static thread_local simdjson::ondemand::parser parser;
+            return parser;
+        }
+    }  // namespace
+
+    simdjson::ondemand::document PluginManifest::load_from_file(const std::filesystem::path& path) {
+        json_ = load_manifest_json(path);
+
+        simdjson::ondemand::document manifest_document = get_thread_parser().iterate(json_);
 
         return manifest_document;
     };
 
+    std::string PluginManifest::read_name(const std::filesystem::path& path) {
+        const simdjson::padded_string manifest_json = load_manifest_json(path);
+        simdjson::ondemand::document doc = get_thread_parser().iterate(manifest_json);
+
+        return std::string(parser::parse_value(doc["name"].get_string(), NAME_PARSER_OPTIONS));
+    };
+
     std::string PluginManifest::get_name() const { return name_; };
 
     int PluginManifest::get_api_version() const { return api_version_; };
@@ -71,6 +117,7 @@ namespace plugins::manifest {
         author_ = parser::parse_value(doc["author"].get_string(), AUTHOR_PARSER_OPTIONS);
         version_ = parser::parse_value(doc["version"].get_string(), VERSION_PARSER_OPTIONS);
         api_version_ = int(parser::parse_value(doc["api_version"].get_int64(), API_VERSION_PARSER_OPTIONS));
+        isolation_ = parser::parse_value_or_fallback(doc["isolation"].get_string(), ISOLATION_PARSER_OPTIONS);
 
         std::vector<Symbol> parsed_symbols;
         auto raw_symbols = doc["host_params"]["symbols"].get_array();
@@ -91,6 +138,30 @@ namespace plugins::manifest {
                                         std::string(parser::parse_value(obj["timespan_unit"].get_string(), TIMESPAN_UNIT_PARSER_OPTIONS)));
         }
 
+        std::vector<IndicatorSpec> parsed_indicators;
+        auto raw_indicators = doc["host_params"]["indicators"].get_array();
+        if (raw_indicators.error() == simdjson::error_code::SUCCESS) {
+            for (auto raw_indicator : raw_indicators.value()) {
+                auto raw_indicator_object = raw_indicator.get_object();
+                if (raw_indicator_object.error() != simdjson::error_code::SUCCESS) {
+                    throw std::runtime_error("Invalid indicator object");
+                }
+
+                auto obj = raw_indicator_object.value();
+                parsed_indicators.push_back(IndicatorSpec{
+                    .name_ = std::string(parser::parse_value(obj["name"].get_string(), INDICATOR_NAME_PARSER_OPTIONS)),
+                    .symbol_ = std::string(parser::parse_value(obj["symbol"].get_string(), SYMBOL_PARSER_OPTIONS)),
+                    .period_ = int(parser::parse_value_or_fallback(obj["period"].get_int64(), INDICATOR_PERIOD_PARSER_OPTIONS)),
+                    .fast_period_ = int(parser::parse_value_or_fallback(obj["fast_period"].get_int64(), INDICATOR_PERIOD_PARSER_OPTIONS)),
+                    .slow_period_ = int(parser::parse_value_or_fallback(obj["slow_period"].get_int64(), INDICATOR_PERIOD_PARSER_OPTIONS)),
+                    .signal_period_ = int(parser::parse_value_or_fallback(obj["signal_period"].get_int64(), INDICATOR_PERIOD_PARSER_OPTIONS)),
+                    .multiplier_ = parser::parse_value_or_fallback(obj["multiplier"].get_double(), INDICATOR_MULTIPLIER_PARSER_OPTIONS),
+                });
+            }
+        } else if (raw_indicators.error() != simdjson::error_code::NO_SUCH_FIELD) {
+            throw std::runtime_error("Invalid indicators");
+        }
+
         host_params_ = HostParams{
             .market_hours_only_ = parser::parse_value<bool>(doc["host_params"]["market_hours_only"].get_bool(), MARKET_HOURS_ONLY_PARSER_OPTIONS),
             .allow_fractional_shares_ =
@@ -126,14 +197,19 @@ namespace plugins::manifest {
             .use_take_profit_ = std::optional<bool>(parser::parse_value(doc["host_params"]["use_take_profit"].get_bool(), USE_TAKE_PROFIT_PARSER_OPTIONS)),
             .take_profit_pct_ = std::optional<double>(parser::parse_value(doc["host_params"]["take_profit_pct"].get_double(), TAKE_PROFIT_PCT_PARSER_OPTIONS)),
             .fill_max_pct_of_volume_ =
-                std::optional<double>(parser::parse_value(doc["host_params"]["fill_max_pct_of_volume"].get_double(), FILL_MAX_PCT_OF_VOLUME_PARSER_OPTIONS)),
+                parser::parse_optional_value(doc["host_params"]["fill_max_pct_of_volume"].get_double(), FILL_MAX_PCT_OF_VOLUME_PARSER_OPTIONS),
             .risk_free_rate_ = std::optional<double>(parser::parse_value(doc["host_params"]["risk_free_rate"].get_double(), RISK_FREE_RATE_PARSER_OPTIONS)),
             .allow_short_selling_ =
                 std::optional<bool>(parser::parse_value(doc["host_params"]["allow_short_selling"].get_bool(), ALLOW_SHORT_SELLING_PARSER_OPTIONS)),
+            .allow_limit_orders_ =
+                std::optional<bool>(parser::parse_value_or_fallback(doc["host_params"]["allow_limit_orders"].get_bool(), ALLOW_LIMIT_ORDERS_PARSER_OPTIONS)),
+            .allow_exit_orders_ =
+                std::optional<bool>(parser::parse_value_or_fallback(doc["host_params"]["allow_exit_orders"].get_bool(), ALLOW_EXIT_ORDERS_PARSER_OPTIONS)),
             .initial_margin_pct_ =
                 std::optional<double>(parser::parse_value(doc["host_params"]["initial_margin_pct"].get_double(), INITIAL_MARGIN_PCT_PARSER_OPTIONS)),
             .max_leverage_ = std::optional<double>(parser::parse_value(doc["host_params"]["max_leverage"].get_double(), MAX_LEVERAGE_PARSER_OPTIONS)),
             .symbols_ = parsed_symbols,
+            .indicators_ = parsed_indicators,
         };
 
         auto result = simdjson::to_json_string(doc["strategy_params"]);
@@ -186,6 +262,8 @@ namespace plugins::manifest {
         add_optional("fill_max_pct_of_volume", host_params_.fill_max_pct_of_volume_);
         add_optional("risk_free_rate", host_params_.risk_free_rate_);
         add_optional("allow_short_selling", host_params_.allow_short_selling_);
+        add_optional("allow_limit_orders", host_params_.allow_limit_orders_);
+        add_optional("allow_exit_orders", host_params_.allow_exit_orders_);
         add_optional("initial_margin_pct", host_params_.initial_margin_pct_);
         add_optional("max_leverage", host_params_.max_leverage_);
 
@@ -31,6 +31,18 @@ namespace plugins::manifest {
             : primary_(primary), timespan_(timespan), symbol_(std::move(symbol)), timespan_unit_(std::move(timespan_unit)) {}
     };
 
+    // See: manifest.schema.json for more details.
+    // Unused parameters stay at 0 and are ignored by the indicator they don't apply to.
+    struct IndicatorSpec {
+        std::string name_;
+        std::string symbol_;
+        int period_ = 0;
+        int fast_period_ = 0;
+        int slow_period_ = 0;
+        int signal_period_ = 0;
+        double multiplier_ = 0.0;
+    };
+
     // See: manifest.schema.json for more details.
     struct HostParams {
         std::optional<bool> market_hours_only_;
@@ -48,6 +60,7 @@ namespace plugins::manifest {
         std::string backtest_start_datetime_;
         std::string backtest_end_datetime_;
         std::vector<Symbol> symbols_;
+        std::vector<IndicatorSpec> indicators_;
 
         std::optional<std::string> position_sizing_method_;
         std::optional<double> position_size_value_;
@@ -59,6 +72,8 @@ namespace plugins::manifest {
         std::optional<double> fill_max_pct_of_volume_;
         std::optional<double> risk_free_rate_;
         std::optional<bool> allow_short_selling_;   // Default: true
+        std::optional<bool> allow_limit_orders_;    // Default: true
+        std::optional<bool> allow_exit_orders_;     // Default: true
         std::optional<double> initial_margin_pct_;  // Default: 1.0 (100% - fully collateralized)
         std::optional<double> max_leverage_;        // Default: 1.0 (no leverage)
     };
@@ -74,9 +89,11 @@ namespace plugins::manifest {
     const ParserOptions<std::string_view> AUTHOR_PARSER_OPTIONS = {
         .is_required_ = false, .allowed_values_ = {}, .fallback_value_ = "", .error_message_ = "Invalid author"};
     const ParserOptions<long long> API_VERSION_PARSER_OPTIONS = {
-        .is_required_ = true, .allowed_values_ = {PLUGIN_API_VERSION}, .fallback_value_ = 0, .error_message_ = "Invalid api version"};
+        .is_required_ = true, .allowed_values_ = {PLUGIN_API_VERSION, PLUGIN_API_VERSION_V2}, .fallback_value_ = 0, .error_message_ = "Invalid api version"};
     const ParserOptions<std::string_view> VERSION_PARSER_OPTIONS = {
         .is_required_ = true, .allowed_values_ = {}, .fallback_value_ = "", .error_message_ = "Invalid version"};
+    const ParserOptions<std::string_view> ISOLATION_PARSER_OPTIONS = {
+        .is_required_ = false, .allowed_values_ = {"none", "process"}, .fallback_value_ = "none", .error_message_ = "Invalid isolation"};
     const ParserOptions<std::string_view> STRATEGY_PARAMS_PARSER_OPTIONS = {
         .is_required_ = true, .allowed_values_ = {}, .fallback_value_ = "", .error_message_ = "Invalid strategy params"};
     const ParserOptions<bool> PRIMARY_PARSER_OPTIONS = {
@@ -89,6 +106,15 @@ namespace plugins::manifest {
                                                                           .allowed_values_ = {"second", "minute", "hour", "day", "week", "month", "year"},
                                                                           .fallback_value_ = "",
                                                                           .error_message_ = "Invalid timespan unit"};
+    const ParserOptions<std::string_view> INDICATOR_NAME_PARSER_OPTIONS = {
+        .is_required_ = true,
+        .allowed_values_ = {"sma", "ema", "wma", "stddev", "rsi", "atr", "macd", "bollinger", "min", "max", "vwap"},
+        .fallback_value_ = "",
+        .error_message_ = "Invalid indicator name"};
+    const ParserOptions<long long> INDICATOR_PERIOD_PARSER_OPTIONS = {
+        .is_required_ = false, .allowed_values_ = {}, .fallback_value_ = 0, .error_message_ = "Invalid indicator period"};
+    const ParserOptions<double> INDICATOR_MULTIPLIER_PARSER_OPTIONS = {
+        .is_required_ = false, .allowed_values_ = {}, .fallback_value_ = 2.0, .error_message_ = "Invalid indicator multiplier"};
     const ParserOptions<bool> MARKET_HOURS_ONLY_PARSER_OPTIONS = {
         .is_required_ = true, .allowed_values_ = {true, false}, .fallback_value_ = false, .error_message_ = "Invalid market hours only"};
     const ParserOptions<bool> ALLOW_FRACTIONAL_SHARES_PARSER_OPTIONS = {
@@ -145,6 +171,10 @@ namespace plugins::manifest {
         .is_required_ = false, .allowed_values_ = {}, .fallback_value_ = 0.02, .error_message_ = "Invalid risk free rate"};
     const ParserOptions<bool> ALLOW_SHORT_SELLING_PARSER_OPTIONS = {
         .is_required_ = false, .allowed_values_ = {true, false}, .fallback_value_ = true, .error_message_ = "Invalid allow short selling"};
+    const ParserOptions<bool> ALLOW_LIMIT_ORDERS_PARSER_OPTIONS = {
+        .is_required_ = false, .allowed_values_ = {true, false}, .fallback_value_ = true, .error_message_ = "Invalid allow limit orders"};
+    const ParserOptions<bool> ALLOW_EXIT_ORDERS_PARSER_OPTIONS = {
+        .is_required_ = false, .allowed_values_ = {true, false}, .fallback_value_ = true, .error_message_ = "Invalid allow exit orders"};
     const ParserOptions<double> INITIAL_MARGIN_PCT_PARSER_OPTIONS = {
         .is_required_ = false, .allowed_values_ = {}, .fallback_value_ = 1.0, .error_message_ = "Invalid initial margin pct"};
     const ParserOptions<double> MAX_LEVERAGE_PARSER_OPTIONS = {
@@ -163,12 +193,17 @@ namespace plugins::manifest {
 
         [[nodiscard]] bool is_python() const;
         [[nodiscard]] bool is_native() const;
+        [[nodiscard]] bool is_process_isolated() const;
         [[nodiscard]] bool is_one_of(const std::vector<std::string>& plugin_names) const;
 
         // Load from dir is the initial manifest loading option.
         // In the future there may be other ways to load the manifest.
-        [[nodiscard]] static simdjson::ondemand::document load_from_file(const std::filesystem::path& path);
+        // The document reads from this manifest's copy of the file through the calling thread's parser, so it has to be
+        // parsed on the same thread before that thread loads another manifest.
+        [[nodiscard]] simdjson::ondemand::document load_from_file(const std::filesystem::path& path);
         void parse_json(simdjson::ondemand::document& doc);
+        // Reads only the name field, for filtering plugins before anything else is parsed.
+        [[nodiscard]] static std::string read_name(const std::filesystem::path& path);
 
         [[nodiscard]] std::string get_name() const;
         [[nodiscard]] int get_api_version() const;
@@ -185,9 +220,12 @@ namespace plugins::manifest {
         std::optional<std::string> description_;
         std::optional<std::string> author_;
         std::string version_;
+        std::string isolation_;
         HostParams host_params_;
         std::string strategy_params_;
 
+        simdjson::padded_string json_;
+
         mutable std::vector<PluginConfigKV> cached_options_;
         mutable std::vector<std::string> cached_option_strings_;
     };
@@ -0,0 +1,105 @@
+#include "manifest_index.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "manifest.hpp"
+
+namespace plugins::manifest {
+    namespace {
+        std::optional<int64_t> get_manifest_mtime_ns(const std::filesystem::path& plugin_dir) {
+            std::error_code error;
+            const auto mtime = std::filesystem::last_write_time(plugin_dir / "manifest.json", error);
+            if (error) {
+                return std::nullopt;
+            }
+
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count();
+        }
+    }  // namespace
+
+    ManifestIndex::ManifestIndex(std::filesystem::path index_path) : index_path_(std::move(index_path)) { load(); }
+
+    std::string ManifestIndex::get_plugin_name(const std::filesystem::path& plugin_dir) {
+        const std::string dir_name = plugin_dir.filename().string();
+        const auto mtime_ns = get_manifest_mtime_ns(plugin_dir);
+
+        auto it = entries_.find(dir_name);
+        if (it != entries_.end() && mtime_ns.has_value() && it->second.mtime_ns_ == mtime_ns.value()) {
+            it->second.is_seen_ = true;
+            return it->second.name_;
+        }
+
+        std::string name = PluginManifest::read_name(plugin_dir);
+        if (mtime_ns.has_value()) {
+            entries_.insert_or_assign(dir_name, Entry{.mtime_ns_ = mtime_ns.value(), .name_ = name, .is_seen_ = true});
+            is_dirty_ = true;
+        }
+
+        return name;
+    }
+
+    void ManifestIndex::load() {
+        std::ifstream in(index_path_);
+        if (!in) {
+            return;
+        }
+
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::string dir_name;
+            std::string mtime_ns;
+            std::string name;
+
+            if (!std::getline(fields, dir_name, '\t') || !std::getline(fields, mtime_ns, '\t') || !std::getline(fields, name)) {
+                continue;
+            }
+
+            try {
+                entries_.insert_or_assign(dir_name, Entry{.mtime_ns_ = std::stoll(mtime_ns), .name_ = name});
+            } catch (const std::exception&) {
+                continue;
+            }
+        }
+    }
+
+    void ManifestIndex::save() const {
+        const bool has_stale_entries = std::ranges::any_of(entries_, [](const auto& entry) { return !entry.second.is_seen_; });
+        if (!is_dirty_ && !has_stale_entries) {
+            return;
+        }
+
+        auto tmp = index_path_;
+        tmp += ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::trunc);
+            if (!out) {
+                return;
+            }
+
+            for (const auto& [dir_name, entry] : entries_) {
+                if (entry.is_seen_) {
+                    out << dir_name << '\t' << entry.mtime_ns_ << '\t' << entry.name_ << '\n';
+                }
+            }
+
+            out.flush();
+            if (!out) {
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tmp, index_path_, error);  // atomic on same filesystem
+    }
+
+}  // namespace plugins::manifest
@@ -0,0 +1,48 @@
+#ifndef QUANT_FORGE_PLUGINS_MANIFEST_MANIFEST_INDEX_HPP
+#define QUANT_FORGE_PLUGINS_MANIFEST_MANIFEST_INDEX_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+namespace plugins::manifest {
+
+    inline constexpr const char* MANIFEST_INDEX_FILE = ".manifest_index";
+
+    // Plugin names by plugin directory, persisted next to the plugin directories and keyed by each manifest's mtime, so a
+    // startup only opens the manifests that changed since the last one. Layout, one line per directory:
+    //   <directory name>\t<manifest mtime ns>\t<plugin name>
+    class ManifestIndex {
+       public:
+        explicit ManifestIndex(std::filesystem::path index_path);
+
+        ~ManifestIndex() = default;
+        ManifestIndex(const ManifestIndex&) = delete;
+        ManifestIndex& operator=(const ManifestIndex&) = delete;
+        ManifestIndex(ManifestIndex&&) = delete;
+        ManifestIndex& operator=(ManifestIndex&&) = delete;
+
+        // From the index when the manifest is unchanged, otherwise read from the manifest and remembered.
+        [[nodiscard]] std::string get_plugin_name(const std::filesystem::path& plugin_dir);
+        // Writes the index back if anything changed, dropping directories that were not looked up. A plugin directory that
+        // cannot be written to only costs the cache.
+        void save() const;
+
+       private:
+        struct Entry {
+            int64_t mtime_ns_;
+            std::string name_;
+            bool is_seen_ = false;
+        };
+
+        std::filesystem::path index_path_;
+        std::unordered_map<std::string, Entry> entries_;
+        bool is_dirty_ = false;
+
+        void load();
+    };
+
+}  // namespace plugins::manifest
+
+#endif
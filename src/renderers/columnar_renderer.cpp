@@ -0,0 +1,120 @@
+#include "columnar_renderer.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../simulators/back_test/back_test_engine.hpp"
+#include "../simulators/monte_carlo/monte_carlo_engine.hpp"
+#include "columnar_writer.hpp"
+
+namespace renderers {
+    ColumnarRenderer::ColumnarRenderer(std::filesystem::path dir) : dir_(std::move(dir)) { std::filesystem::create_directories(dir_); }
+
+    ColumnarRenderer::~ColumnarRenderer() = default;
+
+    void ColumnarRenderer::render_back_test_report(const simulators::BackTestReport& report) {
+        write_equity_curve(report);
+        write_fills(report);
+        write_symbol_pnls(report);
+        write_rejections(report);
+        write_metrics(report);
+    }
+
+    void ColumnarRenderer::render_monte_carlo_report(const simulators::MonteCarloReport& report) {
+        ColumnarWriter writer(get_table_path(report.plugin_name_, "monte_carlo"), report.final_returns_.size());
+        writer.write_column<double>("final_return", [&](uint64_t row) { return report.final_returns_[row]; });
+        writer.write_column<double>("max_drawdown", [&](uint64_t row) { return report.max_drawdowns_[row]; });
+        writer.finish();
+    }
+
+    void ColumnarRenderer::render_plugin_failures(const std::vector<std::pair<std::string, std::string>>& failures) {
+        if (failures.empty()) {
+            return;
+        }
+
+        ColumnarWriter writer(dir_ / "failures.qfc", failures.size());
+        writer.write_string_column("plugin_name", [&](uint64_t row) -> std::string_view { return failures[row].first; });
+        writer.write_string_column("message", [&](uint64_t row) -> std::string_view { return failures[row].second; });
+        writer.finish();
+    }
+
+    std::filesystem::path ColumnarRenderer::get_table_path(const std::string& plugin_name, const std::string& table) const {
+        return dir_ / (plugin_name + "." + table + ".qfc");
+    }
+
+    void ColumnarRenderer::write_equity_curve(const simulators::BackTestReport& report) const {
+        const auto& curve = report.equity_curve_;
+
+        ColumnarWriter writer(get_table_path(report.plugin_name_, "equity"), curve.size());
+        writer.write_column<int64_t>("timestamp_ns", [&](uint64_t row) { return curve[row].timestamp_ns_; });
+        writer.write_column<double>("equity", [&](uint64_t row) { return curve[row].equity_.to_dollars(); });
+        writer.write_column<double>("return", [&](uint64_t row) { return curve[row].return_; });
+        writer.write_column<double>("max_drawdown", [&](uint64_t row) { return curve[row].max_drawdown_; });
+        writer.finish();
+    }
+
+    void ColumnarRenderer::write_fills(const simulators::BackTestReport& report) const {
+        const auto& fills = report.fills_;
+
+        ColumnarWriter writer(get_table_path(report.plugin_name_, "fills"), fills.size());
+        writer.write_column<int64_t>("created_at_ns", [&](uint64_t row) { return fills[row].created_at_ns_; });
+        writer.write_string_column("symbol", [&](uint64_t row) { return fills[row].get_symbol(); });
+        writer.write_column<bool>("is_buy", [&](uint64_t row) { return fills[row].is_buy_; });
+        writer.write_column<double>("quantity", [&](uint64_t row) { return fills[row].quantity_; });
+        writer.write_column<double>("price", [&](uint64_t row) { return fills[row].price_.to_dollars(); });
+        writer.write_column<double>("leverage", [&](uint64_t row) { return fills[row].leverage_; });
+        writer.write_column<double>("margin_used", [&](uint64_t row) { return fills[row].margin_used_.to_dollars(); });
+        writer.write_string_column("uuid", [&](uint64_t row) { return fills[row].get_uuid(); });
+        writer.finish();
+    }
+
+    void ColumnarRenderer::write_symbol_pnls(const simulators::BackTestReport& report) const {
+        const auto& pnls = report.symbol_pnls_;
+
+        ColumnarWriter writer(get_table_path(report.plugin_name_, "symbols"), pnls.size());
+        writer.write_string_column("symbol", [&](uint64_t row) -> std::string_view { return pnls[row].symbol_; });
+        writer.write_column<int64_t>("fill_count", [&](uint64_t row) { return static_cast<int64_t>(pnls[row].fill_count_); });
+        writer.write_column<double>("bought_quantity", [&](uint64_t row) { return pnls[row].bought_quantity_; });
+        writer.write_column<double>("sold_quantity", [&](uint64_t row) { return pnls[row].sold_quantity_; });
+        writer.write_column<double>("pnl", [&](uint64_t row) { return pnls[row].pnl_.to_dollars(); });
+        writer.finish();
+    }
+
+    void ColumnarRenderer::write_rejections(const simulators::BackTestReport& report) const {
+        const auto& rejections = report.rejections_;
+
+        ColumnarWriter writer(get_table_path(report.plugin_name_, "rejections"), rejections.size());
+        writer.write_string_column("reason", [&](uint64_t row) -> std::string_view { return rejections[row].reason_; });
+        writer.write_column<int64_t>("count", [&](uint64_t row) { return static_cast<int64_t>(rejections[row].count_); });
+        writer.finish();
+    }
+
+    // One row per metric, so a new metric is a new row rather than a new schema.
+    void ColumnarRenderer::write_metrics(const simulators::BackTestReport& report) const {
+        const auto& metrics = report.metrics_;
+        const std::vector<std::pair<std::string_view, double>> rows = {
+            {"initial_capital", metrics.initial_capital_.to_dollars()},
+            {"final_equity", metrics.final_equity_.to_dollars()},
+            {"total_return", metrics.total_return_},
+            {"annualized_return", metrics.annualized_return_},
+            {"annualized_volatility", metrics.annualized_volatility_},
+            {"sharpe_ratio", metrics.sharpe_ratio_},
+            {"sortino_ratio", metrics.sortino_ratio_},
+            {"calmar_ratio", metrics.calmar_ratio_},
+            {"max_drawdown", metrics.max_drawdown_},
+            {"tail_ratio", metrics.tail_ratio_},
+            {"value_at_risk", metrics.value_at_risk_},
+            {"conditional_value_at_risk", metrics.conditional_value_at_risk_},
+            {"fill_count", static_cast<double>(metrics.fill_count_)},
+            {"snapshot_count", static_cast<double>(metrics.snapshot_count_)},
+        };
+
+        ColumnarWriter writer(get_table_path(report.plugin_name_, "metrics"), rows.size());
+        writer.write_string_column("metric", [&](uint64_t row) { return rows[row].first; });
+        writer.write_column<double>("value", [&](uint64_t row) { return rows[row].second; });
+        writer.finish();
+    }
+}  // namespace renderers
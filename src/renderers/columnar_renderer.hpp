@@ -0,0 +1,47 @@
+#ifndef QUANT_FORGE_COLUMNAR_RENDERER_HPP
+#define QUANT_FORGE_COLUMNAR_RENDERER_HPP
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../simulators/back_test/back_test_engine.hpp"
+#include "../simulators/monte_carlo/monte_carlo_engine.hpp"
+#include "interface.hpp"
+
+namespace renderers {
+
+    // Writes each report as tables under dir_, one file per table, for dataframe tools to load:
+    // <plugin>.equity.qfc, <plugin>.fills.qfc, <plugin>.symbols.qfc, <plugin>.rejections.qfc, <plugin>.metrics.qfc,
+    // <plugin>.monte_carlo.qfc and failures.qfc. See ColumnarWriter for the format.
+    class ColumnarRenderer : public IRenderer {
+       public:
+        explicit ColumnarRenderer(std::filesystem::path dir);
+
+        ~ColumnarRenderer() override;
+
+        ColumnarRenderer(const ColumnarRenderer&) = delete;
+        ColumnarRenderer& operator=(const ColumnarRenderer&) = delete;
+        ColumnarRenderer(ColumnarRenderer&&) = delete;
+        ColumnarRenderer& operator=(ColumnarRenderer&&) = delete;
+
+        void render_back_test_report(const simulators::BackTestReport& report) override;
+        void render_monte_carlo_report(const simulators::MonteCarloReport& report) override;
+        void render_plugin_failures(const std::vector<std::pair<std::string, std::string>>& failures) override;
+
+       private:
+        std::filesystem::path dir_;
+
+        [[nodiscard]] std::filesystem::path get_table_path(const std::string& plugin_name, const std::string& table) const;
+        void write_equity_curve(const simulators::BackTestReport& report) const;
+        void write_fills(const simulators::BackTestReport& report) const;
+        void write_symbol_pnls(const simulators::BackTestReport& report) const;
+        void write_rejections(const simulators::BackTestReport& report) const;
+        void write_metrics(const simulators::BackTestReport& report) const;
+    };
+}  // namespace renderers
+
+#endif
@@ -0,0 +1,98 @@
+#include "columnar_writer.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+static constexpr std::array<char, 4> COLUMNAR_MAGIC = {'Q', 'F', 'C', 'T'};
+
+namespace renderers {
+
+    ColumnarWriter::ColumnarWriter(std::filesystem::path path, uint64_t row_count) : path_(std::move(path)), row_count_(row_count) {
+        tmp_path_ = path_;
+        tmp_path_ += ".tmp";
+
+        out_.open(tmp_path_, std::ios::binary | std::ios::trunc);
+        if (!out_) {
+            throw std::runtime_error("Failed to open " + tmp_path_.string() + " for writing");
+        }
+        write_bytes(COLUMNAR_MAGIC.data(), COLUMNAR_MAGIC.size());
+    }
+
+    void ColumnarWriter::write_string_column(const std::string& name, const std::function<std::string_view(uint64_t)>& value_of) {
+        begin_column(name, ColumnType::STRING);
+
+        std::vector<uint64_t> offsets;
+        offsets.reserve(row_count_ + 1);
+        offsets.push_back(0);
+        for (uint64_t row = 0; row < row_count_; ++row) {
+            offsets.push_back(offsets.back() + value_of(row).size());
+        }
+        write_bytes(offsets.data(), offsets.size() * sizeof(uint64_t));
+
+        std::string batch;
+        for (uint64_t row = 0; row < row_count_; ++row) {
+            batch += value_of(row);
+            if (batch.size() >= COLUMNAR_WRITE_BATCH) {
+                write_bytes(batch.data(), batch.size());
+                batch.clear();
+            }
+        }
+        write_bytes(batch.data(), batch.size());
+    }
+
+    void ColumnarWriter::finish() {
+        if (!columns_.empty()) {
+            column_sizes_.push_back(position_ - columns_.back().offset_);
+        }
+
+        const uint64_t footer_start = position_;
+        const auto column_count = static_cast<uint32_t>(columns_.size());
+        write_bytes(&COLUMNAR_VERSION, sizeof(COLUMNAR_VERSION));
+        write_bytes(&row_count_, sizeof(row_count_));
+        write_bytes(&column_count, sizeof(column_count));
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            const auto& column = columns_[i];
+            const auto name_size = static_cast<uint32_t>(column.name_.size());
+            write_bytes(&column.type_, sizeof(column.type_));
+            write_bytes(&name_size, sizeof(name_size));
+            write_bytes(column.name_.data(), column.name_.size());
+            write_bytes(&column.offset_, sizeof(column.offset_));
+            write_bytes(&column_sizes_[i], sizeof(uint64_t));
+        }
+        const uint64_t footer_size = position_ - footer_start;
+        write_bytes(&footer_size, sizeof(footer_size));
+        write_bytes(COLUMNAR_MAGIC.data(), COLUMNAR_MAGIC.size());
+
+        out_.close();
+        if (!out_) {
+            throw std::runtime_error("Failed to write " + tmp_path_.string());
+        }
+        std::filesystem::rename(tmp_path_, path_);
+    }
+
+    void ColumnarWriter::begin_column(const std::string& name, ColumnType type) {
+        if (!columns_.empty()) {
+            column_sizes_.push_back(position_ - columns_.back().offset_);
+        }
+
+        static constexpr std::array<char, COLUMNAR_ALIGNMENT> PADDING{};
+        write_bytes(PADDING.data(), (COLUMNAR_ALIGNMENT - (position_ % COLUMNAR_ALIGNMENT)) % COLUMNAR_ALIGNMENT);
+        columns_.push_back(Column{.name_ = name, .type_ = type, .offset_ = position_});
+    }
+
+    void ColumnarWriter::write_bytes(const void* data, size_t size) {
+        if (size == 0) {
+            return;
+        }
+
+        out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!out_) {
+            throw std::runtime_error("Failed to write " + tmp_path_.string());
+        }
+        position_ += size;
+    }
+
+}  // namespace renderers
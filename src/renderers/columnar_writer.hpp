@@ -0,0 +1,92 @@
+#ifndef QUANT_FORGE_COLUMNAR_WRITER_HPP
+#define QUANT_FORGE_COLUMNAR_WRITER_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+static constexpr uint32_t COLUMNAR_VERSION = 1;
+static constexpr size_t COLUMNAR_ALIGNMENT = 64;
+static constexpr size_t COLUMNAR_WRITE_BATCH = 4096;
+
+namespace renderers {
+
+    enum class ColumnType : uint8_t {
+        INT64,
+        DOUBLE,
+        // One byte per row.
+        BOOL,
+        // uint64 offsets, one per row plus one, then the bytes they point into.
+        STRING,
+    };
+
+    // One table per file, laid out like Parquet: "QFCT", column chunks each starting at a COLUMNAR_ALIGNMENT offset,
+    // then a footer of version (u32), row count (u64), column count (u32) and per column type (u8), name length (u32),
+    // name, offset (u64) and size (u64), closed by the footer's size (u64) and "QFCT". A reader maps a column straight
+    // into an array. Columns are written as they are gathered, so a table never has to fit in memory twice. Files use
+    // the host byte order.
+    class ColumnarWriter {
+       public:
+        ColumnarWriter(std::filesystem::path path, uint64_t row_count);
+        ~ColumnarWriter() = default;
+
+        ColumnarWriter(const ColumnarWriter&) = delete;
+        ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+        ColumnarWriter(ColumnarWriter&&) = delete;
+        ColumnarWriter& operator=(ColumnarWriter&&) = delete;
+
+        // value_of(row) gives each row's value, as int64_t, double or bool.
+        template <typename T, typename ValueFn>
+        void write_column(const std::string& name, ValueFn&& value_of) {
+            static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, double> || std::is_same_v<T, bool>);
+            begin_column(name, std::is_same_v<T, int64_t> ? ColumnType::INT64 : std::is_same_v<T, double> ? ColumnType::DOUBLE : ColumnType::BOOL);
+
+            // vector<bool> packs its bits, so bools are stored a byte each.
+            using Stored = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+            std::vector<Stored> batch;
+            batch.reserve(COLUMNAR_WRITE_BATCH);
+            for (uint64_t row = 0; row < row_count_; ++row) {
+                batch.push_back(static_cast<Stored>(value_of(row)));
+                if (batch.size() == COLUMNAR_WRITE_BATCH) {
+                    write_bytes(batch.data(), batch.size() * sizeof(Stored));
+                    batch.clear();
+                }
+            }
+            write_bytes(batch.data(), batch.size() * sizeof(Stored));
+        }
+
+        void write_string_column(const std::string& name, const std::function<std::string_view(uint64_t)>& value_of);
+
+        // Writes the footer and moves the table into place. Until then the file under path is the previous table, if any.
+        void finish();
+
+       private:
+        struct Column {
+            std::string name_;
+            ColumnType type_;
+            uint64_t offset_;
+        };
+
+        std::filesystem::path path_;
+        std::filesystem::path tmp_path_;
+        std::ofstream out_;
+        uint64_t row_count_;
+        uint64_t position_ = 0;
+        std::vector<Column> columns_;
+        std::vector<uint64_t> column_sizes_;
+
+        void begin_column(const std::string& name, ColumnType type);
+        void write_bytes(const void* data, size_t size);
+    };
+
+}  // namespace renderers
+
+#endif
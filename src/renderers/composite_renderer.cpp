@@ -0,0 +1,30 @@
+#include "composite_renderer.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace renderers {
+    CompositeRenderer::CompositeRenderer(std::vector<std::unique_ptr<IRenderer>> renderers) : renderers_(std::move(renderers)) {}
+
+    CompositeRenderer::~CompositeRenderer() = default;
+
+    void CompositeRenderer::render_back_test_report(const simulators::BackTestReport& report) {
+        for (const auto& renderer : renderers_) {
+            renderer->render_back_test_report(report);
+        }
+    }
+
+    void CompositeRenderer::render_monte_carlo_report(const simulators::MonteCarloReport& report) {
+        for (const auto& renderer : renderers_) {
+            renderer->render_monte_carlo_report(report);
+        }
+    }
+
+    void CompositeRenderer::render_plugin_failures(const std::vector<std::pair<std::string, std::string>>& failures) {
+        for (const auto& renderer : renderers_) {
+            renderer->render_plugin_failures(failures);
+        }
+    }
+}  // namespace renderers
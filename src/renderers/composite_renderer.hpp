@@ -0,0 +1,38 @@
+#ifndef QUANT_FORGE_COMPOSITE_RENDERER_HPP
+#define QUANT_FORGE_COMPOSITE_RENDERER_HPP
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../simulators/back_test/back_test_engine.hpp"
+#include "../simulators/monte_carlo/monte_carlo_engine.hpp"
+#include "interface.hpp"
+
+namespace renderers {
+
+    // Hands every report to each renderer in turn, in the order they were given.
+    class CompositeRenderer : public IRenderer {
+       public:
+        explicit CompositeRenderer(std::vector<std::unique_ptr<IRenderer>> renderers);
+
+        ~CompositeRenderer() override;
+
+        CompositeRenderer(const CompositeRenderer&) = delete;
+        CompositeRenderer& operator=(const CompositeRenderer&) = delete;
+        CompositeRenderer(CompositeRenderer&&) = delete;
+        CompositeRenderer& operator=(CompositeRenderer&&) = delete;
+
+        void render_back_test_report(const simulators::BackTestReport& report) override;
+        void render_monte_carlo_report(const simulators::MonteCarloReport& report) override;
+        void render_plugin_failures(const std::vector<std::pair<std::string, std::string>>& failures) override;
+
+       private:
+        std::vector<std::unique_ptr<IRenderer>> renderers_;
+    };
+}  // namespace renderers
+
+#endif
@@ -1,5 +1,6 @@
 #include "console_renderer.hpp"
 
+#include <iomanip>
 #include <iostream>
 #include <vector>
 
@@ -9,19 +10,43 @@
 namespace renderers {
     ConsoleRenderer::~ConsoleRenderer() = default;
 
-    void ConsoleRenderer::render_back_test_report(const std::vector<simulators::BackTestReport>& reports) {
-        std::cout << "----- Back Test Reports ----- " << std::endl;
+    void ConsoleRenderer::render_back_test_report(const simulators::BackTestReport& report) {
+        const auto& metrics = report.metrics_;
+        std::cout << "----- Back Test Report: " << report.plugin_name_ << " ----- " << std::endl
+                  << std::fixed << std::setprecision(2)
+                  << "  final equity   " << std::setw(16) << metrics.final_equity_.to_dollars() << std::endl
+                  << "  total return   " << std::setw(15) << metrics.total_return_ * 100 << "%" << std::endl
+                  << "  max drawdown   " << std::setw(15) << metrics.max_drawdown_ * 100 << "%" << std::endl
+                  << "  sharpe         " << std::setw(16) << metrics.sharpe_ratio_ << std::endl
+                  << "  sortino        " << std::setw(16) << metrics.sortino_ratio_ << std::endl
+                  << "  calmar         " << std::setw(16) << metrics.calmar_ratio_ << std::endl
+                  << "  fills          " << std::setw(16) << metrics.fill_count_ << std::endl;
 
-        for (const auto& report : reports) {  // NOLINT
-            std::cout << "TODO: Render back test report" << std::endl;
+        for (const auto& rejection : report.rejections_) {
+            std::cout << "  rejected       " << std::setw(16) << rejection.count_ << "  " << rejection.reason_ << std::endl;
         }
     }
 
-    void ConsoleRenderer::render_monte_carlo_report(const std::vector<simulators::MonteCarloReport>& reports) {
-        std::cout << "----- Monte Carlo Reports ----- " << std::endl;
+    void ConsoleRenderer::render_monte_carlo_report(const simulators::MonteCarloReport& report) {
+        const auto& summary = report.summary_;
+        std::cout << "----- Monte Carlo Report: " << report.plugin_name_ << " (" << report.final_returns_.size() << " paths) ----- " << std::endl
+                  << std::fixed << std::setprecision(2)
+                  << "  return p5/p50/p95    " << std::setw(9) << summary.final_return_p5_ * 100 << "% " << std::setw(9) << summary.final_return_p50_ * 100
+                  << "% " << std::setw(9) << summary.final_return_p95_ * 100 << "%" << std::endl
+                  << "  drawdown p50/p95     " << std::setw(9) << summary.max_drawdown_p50_ * 100 << "% " << std::setw(9) << summary.max_drawdown_p95_ * 100
+                  << "%" << std::endl
+                  << "  probability of loss  " << std::setw(9) << summary.probability_of_loss_ * 100 << "%" << std::endl;
+    }
+
+    void ConsoleRenderer::render_plugin_failures(const std::vector<std::pair<std::string, std::string>>& failures) {
+        if (failures.empty()) {
+            return;
+        }
+
+        std::cout << "----- Failed Plugins ----- " << std::endl;
 
-        for (const auto& report : reports) {  // NOLINT
-            std::cout << "TODO: Render monte carlo report" << std::endl;
+        for (const auto& [plugin_name, message] : failures) {
+            std::cout << plugin_name << ": " << message << std::endl;
         }
     }
 }  // namespace renderers
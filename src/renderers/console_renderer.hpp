@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "../simulators/back_test/back_test_engine.hpp"
@@ -22,8 +24,9 @@ namespace renderers {
         ConsoleRenderer(ConsoleRenderer&&) = delete;
         ConsoleRenderer& operator=(ConsoleRenderer&&) = delete;
 
-        void render_back_test_report(const std::vector<simulators::BackTestReport>& reports) override;
-        void render_monte_carlo_report(const std::vector<simulators::MonteCarloReport>& reports) override;
+        void render_back_test_report(const simulators::BackTestReport& report) override;
+        void render_monte_carlo_report(const simulators::MonteCarloReport& report) override;
+        void render_plugin_failures(const std::vector<std::pair<std::string, std::string>>& failures) override;
     };
 }  // namespace renderers
 
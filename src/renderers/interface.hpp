@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "../simulators/back_test/back_test_engine.hpp"
@@ -19,8 +21,11 @@ namespace renderers {
         IRenderer(IRenderer&&) = delete;
         IRenderer& operator=(IRenderer&&) = delete;
 
-        virtual void render_back_test_report(const std::vector<simulators::BackTestReport>& reports) = 0;
-        virtual void render_monte_carlo_report(const std::vector<simulators::MonteCarloReport>& reports) = 0;
+        // Called once per report, as each plugin's run produces it.
+        virtual void render_back_test_report(const simulators::BackTestReport& report) = 0;
+        virtual void render_monte_carlo_report(const simulators::MonteCarloReport& report) = 0;
+        // Pairs of plugin name and failure message, once every plugin of a run has finished.
+        virtual void render_plugin_failures(const std::vector<std::pair<std::string, std::string>>& failures) = 0;
     };
 }  // namespace renderers
 
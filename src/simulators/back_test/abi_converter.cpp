@@ -1,14 +1,21 @@
 
 #include "./abi_converter.hpp"
 
+#include "../../utils/profiler.hpp"
 #include "./models.hpp"
 #include "./state.hpp"
 
 namespace simulators {
     CState ABIConverter::to_c_state(const simulators::State& state) {
+        PROFILE_SCOPE("to_c_state");
+
         c_positions_cache_ = to_c_positions(state.positions_);
         c_fills_cache_ = to_c_fills(state.new_fills_);
-        c_equity_cache_ = to_c_equity_snapshots(state.equity_curve_);
+        if (state.equity_snapshots_dropped_ != equity_snapshots_dropped_) {
+            c_equity_cache_.clear();
+            equity_snapshots_dropped_ = state.equity_snapshots_dropped_;
+        }
+        append_c_equity_snapshots(state.equity_curve_);
         c_exit_orders_cache_ = to_c_exit_orders(state.new_exit_orders_);
 
         return CState{.cash_ = state.cash_.to_abi_int64(),
@@ -19,7 +26,9 @@ namespace simulators {
                       .new_fills_ = c_fills_cache_.data(),
                       .new_fills_count_ = c_fills_cache_.size(),
                       .equity_curve_ = c_equity_cache_.data(),
-                      .equity_curve_count_ = c_equity_cache_.size()};
+                      .equity_curve_count_ = c_equity_cache_.size(),
+                      .indicators_ = state.indicators_.get_c_values().data(),
+                      .indicators_count_ = state.indicators_.get_c_values().size()};
     }
 
     std::vector<CFill> ABIConverter::to_c_fills(const std::vector<models::Fill>& fills) {
@@ -51,11 +60,21 @@ namespace simulators {
         return c_positions;
     }
 
-    std::vector<CEquitySnapshot> ABIConverter::to_c_equity_snapshots(const std::vector<models::EquitySnapshot>& equity_snapshots) {
-        std::vector<CEquitySnapshot> c_equity_snapshots;
-        c_equity_snapshots.reserve(equity_snapshots.size());
-        for (const auto& equity_snapshot : equity_snapshots) {
-            c_equity_snapshots.emplace_back(CEquitySnapshot{
+    // The equity curve only grows at the tail, and only its last snapshot is ever updated in place (several symbols
+    // sharing a timestamp), so only that tail is converted. Rebuilding it every bar made runs quadratic in bar count.
+    // In streaming mode the front is trimmed too, and to_c_state clears the cache when it is.
+    void ABIConverter::append_c_equity_snapshots(const std::vector<models::EquitySnapshot>& equity_snapshots) {
+        if (c_equity_cache_.size() > equity_snapshots.size()) {
+            c_equity_cache_.clear();
+        }
+
+        if (!c_equity_cache_.empty()) {
+            c_equity_cache_.pop_back();
+        }
+
+        for (size_t i = c_equity_cache_.size(); i < equity_snapshots.size(); ++i) {
+            const auto& equity_snapshot = equity_snapshots[i];
+            c_equity_cache_.emplace_back(CEquitySnapshot{
                 .timestamp_ns_ = equity_snapshot.timestamp_ns_,
                 .equity_ = equity_snapshot.equity_.to_abi_int64(),
                 .return_ = equity_snapshot.return_,
@@ -68,7 +87,6 @@ namespace simulators {
                 .conditional_value_at_risk_ = equity_snapshot.conditional_value_at_risk_,
             });
         }
-        return c_equity_snapshots;
     }
 
     CStopLossExitOrder ABIConverter::to_c_stop_loss_exit_order(const models::StopLossExitOrder& stop_loss) {
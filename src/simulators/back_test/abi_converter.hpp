@@ -25,10 +25,11 @@ namespace simulators {
         mutable std::vector<CFill> c_fills_cache_;
         mutable std::vector<CEquitySnapshot> c_equity_cache_;
         mutable std::vector<CExitOrder> c_exit_orders_cache_;
+        uint64_t equity_snapshots_dropped_ = 0;
 
         [[nodiscard]] static std::vector<CFill> to_c_fills(const std::vector<models::Fill>& fills);
         [[nodiscard]] static std::vector<CPosition> to_c_positions(const std::map<std::string, models::Position>& positions);
-        [[nodiscard]] static std::vector<CEquitySnapshot> to_c_equity_snapshots(const std::vector<models::EquitySnapshot>& equity_snapshots);
+        void append_c_equity_snapshots(const std::vector<models::EquitySnapshot>& equity_snapshots);
         [[nodiscard]] static std::vector<CExitOrder> to_c_exit_orders(const std::vector<models::ExitOrder>& exit_orders);
         [[nodiscard]] static CStopLossExitOrder to_c_stop_loss_exit_order(const models::StopLossExitOrder& stop_loss);
         [[nodiscard]] static CTakeProfitExitOrder to_c_take_profit_exit_order(const models::TakeProfitExitOrder& take_profit);
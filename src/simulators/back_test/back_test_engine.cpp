@@ -1,15 +1,26 @@
 #include "back_test_engine.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "../../forge/stores/data_store.hpp"
 #include "../../plugins/loaders/interface.hpp"
+#include "../../utils/constants.hpp"
+#include "../../utils/profiler.hpp"
 #include "./abi_converter.hpp"
+#include "./checkpoint.hpp"
+#include "./event_log.hpp"
 #include "./exchange.hpp"
 #include "./executor.hpp"
+#include "./journal.hpp"
 #include "./models.hpp"
 #include "./position_calculator.hpp"
+#include "./report.hpp"
 #include "./state.hpp"
 
 using namespace money_utils;
@@ -17,55 +28,324 @@ using namespace money_utils;
 namespace simulators {
 
     BackTestEngine::BackTestEngine(const plugins::loaders::IPluginLoader* plugin, const forge::DataStore* data_store)
-        : plugin_(plugin), data_store_(data_store) {}
+        : plugin_(plugin), data_store_(data_store), instruction_buffer_(constants::INSTRUCTION_BUFFER_CAPACITY) {}
 
     void BackTestEngine::run() {
+        const ExecutionPolicy policy = ExecutionPolicy::compile(plugin_->get_host_params());
+        with_features(policy, [&]<typename FeaturesT>() { run_with_features<FeaturesT>(); });
+    }
+
+    template <typename FeaturesT>
+    void BackTestEngine::run_with_features() {
         const auto& host_params = plugin_->get_host_params();
+        const ExecutionPolicy policy = ExecutionPolicy::compile(host_params);
+
+        if (!covers_policy<FeaturesT>(policy)) {
+            throw std::runtime_error("Back test variant leaves out a feature the manifest allows: " + plugin_->get_plugin_name());
+        }
 
         state_.prepare_initial_state(host_params);
 
         const auto iterable_plugin_data = data_store_->get_iterable_plugin_data(plugin_->get_plugin_name());
 
-        std::for_each(iterable_plugin_data.begin(), iterable_plugin_data.end(), [&, host_params](const auto& bar) {
-            if (!exchange::is_within_market_hour_restrictions(bar.unix_ts_ns_, host_params)) {
-                return;
+        const bool use_precomputed_signals = plugin_->has_precompute_signals();
+
+        if (use_precomputed_signals) {
+            precompute_signals(iterable_plugin_data);
+        }
+
+        replay<FeaturesT>(iterable_plugin_data, policy, host_params, use_precomputed_signals);
+        state_.close_journals();
+
+        const char* json_out = nullptr;
+        PluginResult result = plugin_->on_end(&json_out);
+
+        if (result.code_ != 0) {
+            throw std::runtime_error("Plugin on_end failed: " + std::string(result.message_));
+        }
+
+        plugin_->free_string(json_out);
+
+        if (checkpoint_options_.interval_bars_ > 0) {
+            std::filesystem::remove(checkpoint_options_.path_);
+        }
+
+        report_ = build_report(Money(host_params.initial_capital_));
+    }
+
+    void BackTestEngine::set_event_log(EventLog* event_log) { event_log_ = event_log; }
+
+    void BackTestEngine::set_checkpoint_options(CheckpointOptions checkpoint_options) { checkpoint_options_ = std::move(checkpoint_options); }
+
+    void BackTestEngine::set_streaming_options(StreamingOptions streaming_options) {
+        if (!streaming_options.fill_journal_path_.empty() && (streaming_options.equity_window_ == 0 || streaming_options.equity_stride_ == 0)) {
+            throw std::runtime_error("Streaming needs an equity window and stride of at least 1");
+        }
+        streaming_.options_ = std::move(streaming_options);
+    }
+
+    void BackTestEngine::open_journals(const StreamingCursor& cursor) {
+        if (!streaming_.is_enabled()) {
+            return;
+        }
+        streaming_.open(cursor);
+        state_.streaming_ = &streaming_;
+    }
+
+    bool BackTestEngine::is_resumable(bool use_precomputed_signals) const {
+        return checkpoint_options_.interval_bars_ > 0 && event_log_ == nullptr && (use_precomputed_signals || plugin_->has_state_hooks());
+    }
+
+    bool BackTestEngine::is_checkpoint_due(size_t next_bar, size_t bar_count) const {
+        return checkpoint_options_.interval_bars_ > 0 && next_bar < bar_count && next_bar % checkpoint_options_.interval_bars_ == 0;
+    }
+
+    void BackTestEngine::save_checkpoint(const std::vector<http::stock_api::AggregateBarResult>& bars, size_t next_bar) const {
+        PROFILE_SCOPE("save_checkpoint");
+
+        plugins::isolation::BufferWriter writer;
+        const CheckpointCursor cursor{.next_bar_ = next_bar, .bar_count_ = bars.size(), .last_bar_unix_ts_ns_ = bars[next_bar - 1].unix_ts_ns_};
+        checkpoint::encode_cursor(writer, cursor);
+        checkpoint::encode_state(writer, state_);
+        checkpoint::encode_scheduled_orders(writer, order_book_.get_data());
+        checkpoint::encode_limit_orders(writer, limit_order_book_.get_orders());
+        checkpoint::encode_exit_orders(writer, exit_order_book_.get_orders());
+        checkpoint::encode_rejection_counts(writer, rejection_counts_);
+        writer.put(streaming_.is_enabled());
+        writer.put(streaming_.get_cursor());
+
+        const uint8_t* plugin_state = nullptr;
+        size_t plugin_state_size = 0;
+        if (plugin_->has_state_hooks()) {
+            const PluginResult result = plugin_->save_state(&plugin_state, &plugin_state_size);
+            if (result.code_ != 0) {
+                throw std::runtime_error("Plugin save_state failed: " + std::string(result.message_));
             }
+        }
+        writer.put_array(plugin_state, plugin_state_size);
 
-            state_.prepare_next_bar_state(bar);
+        checkpoint::write_file(checkpoint_options_.path_, checkpoint_options_.fingerprint_, writer.get_bytes());
+    }
 
-            execute_order_book(bar, host_params);
-            execute_limit_orders(host_params);
-            execute_exit_orders(host_params);
+    size_t BackTestEngine::resume_from_checkpoint(const std::vector<http::stock_api::AggregateBarResult>& bars, const ExecutionPolicy& policy,
+                                                  bool use_precomputed_signals) {
+        const auto payload =
+            is_resumable(use_precomputed_signals) ? checkpoint::read_file(checkpoint_options_.path_, checkpoint_options_.fingerprint_) : std::nullopt;
+        if (!payload.has_value()) {
+            open_journals(StreamingCursor{});
+            return 0;
+        }
 
-            const PluginResult result = plugin_->on_bar(bar, state_);
+        plugins::isolation::BufferReader reader(payload.value());
+        const CheckpointCursor cursor = checkpoint::decode_cursor(reader);
 
+        if (cursor.bar_count_ != bars.size() || cursor.next_bar_ == 0 || cursor.next_bar_ > bars.size() ||
+            bars[cursor.next_bar_ - 1].unix_ts_ns_ != cursor.last_bar_unix_ts_ns_) {
+            throw std::runtime_error("Checkpoint does not match the plugin's data: " + checkpoint_options_.path_.string());
+        }
+
+        // The indicators, current bar prices and signal cursors end up exactly where the interrupted run left them.
+        for (size_t i = 0; i < cursor.next_bar_; ++i) {
+            const auto& bar = bars[i];
+            if (use_precomputed_signals) {
+                precomputed_signals_[bar.symbol_].cursor_++;
+            }
+            if (exchange::is_within_market_hour_restrictions(bar.unix_ts_ns_, policy)) {
+                state_.prepare_next_bar_state(bar);
+            }
+        }
+
+        checkpoint::decode_state(reader, state_);
+        for (const auto& order : checkpoint::decode_scheduled_orders(reader)) {
+            order_book_.push(order);
+        }
+        for (const auto& order : checkpoint::decode_limit_orders(reader)) {
+            limit_order_book_.add_limit_order(order);
+        }
+        for (const auto& order : checkpoint::decode_exit_orders(reader)) {
+            exit_order_book_.add_exit_order(order);
+        }
+        rejection_counts_ = checkpoint::decode_rejection_counts(reader);
+
+        // The journals are cut back to the checkpoint, dropping whatever the interrupted run wrote after it.
+        if (reader.get<bool>() != streaming_.is_enabled()) {
+            throw std::runtime_error("Checkpoint was taken with streaming turned the other way: " + checkpoint_options_.path_.string());
+        }
+        open_journals(reader.get<StreamingCursor>());
+
+        std::vector<uint8_t> plugin_state;
+        reader.get_array(plugin_state);
+        if (plugin_->has_state_hooks()) {
+            const PluginResult result = plugin_->restore_state(plugin_state.data(), plugin_state.size());
             if (result.code_ != 0) {
-                throw std::runtime_error("Plugin on_bar failed: " + std::string(result.message_));
+                throw std::runtime_error("Plugin restore_state failed: " + std::string(result.message_));
             }
+        }
 
-            schedule_plugin_instructions(result, host_params);
+        return cursor.next_bar_;
+    }
 
-            state_.record_bar_equity_snapshot(host_params);
+    void BackTestEngine::run_from_event_log(const EventLog& event_log, const plugins::manifest::HostParams& host_params) {
+        const ExecutionPolicy policy = ExecutionPolicy::compile(host_params);
 
-            state_.clear_previous_bar_state();
-        });
+        state_.prepare_initial_state(host_params);
 
-        const char* json_out = nullptr;
-        PluginResult result = plugin_->on_end(&json_out);
+        open_journals(StreamingCursor{});
+        with_features(policy, [&]<typename FeaturesT>() { replay_event_log<FeaturesT>(event_log, policy, host_params); });
+        state_.close_journals();
 
-        if (result.code_ != 0) {
-            throw std::runtime_error("Plugin on_end failed: " + std::string(result.message_));
+        report_ = build_report(Money(host_params.initial_capital_));
+    }
+
+    BackTestReport BackTestEngine::build_report(Money initial_capital) const {
+        PROFILE_SCOPE("build_report");
+
+        BackTestReport report{.plugin_name_ = plugin_ != nullptr ? plugin_->get_plugin_name() : std::string()};
+
+        if (streaming_.is_enabled()) {
+            const JournalReader fills(streaming_.options_.fill_journal_path_, FILL_JOURNAL_MAGIC, sizeof(FillRecord));
+            const JournalReader equity_curve(streaming_.options_.equity_journal_path_, EQUITY_JOURNAL_MAGIC, sizeof(models::EquitySnapshot));
+            const auto fill_records = fills.get_records<FillRecord>();
+            const auto equity_snapshots = equity_curve.get_records<models::EquitySnapshot>();
+            report.fills_.assign(fill_records.begin(), fill_records.end());
+            report.equity_curve_.assign(equity_snapshots.begin(), equity_snapshots.end());
+        } else {
+            report.fills_.reserve(state_.fills_.size());
+            for (const auto& fill : state_.fills_) {
+                report.fills_.push_back(FillRecord::from_fill(fill));
+            }
+            report.equity_curve_ = state_.equity_curve_;
         }
 
-        plugin_->free_string(json_out);
+        report.metrics_ = report::calculate_metrics(report.equity_curve_, initial_capital, state_.max_drawdown_, report.fills_.size());
+        report.symbol_pnls_ = report::calculate_symbol_pnls(report.fills_, state_);
+        report.rejections_.reserve(rejection_counts_.size());
+        for (const auto& [reason, count] : rejection_counts_) {
+            report.rejections_.push_back(RejectionCount{.reason_ = reason, .count_ = count});
+        }
+        return report;
+    }
+
+    template <typename FeaturesT>
+    void BackTestEngine::replay(const std::vector<http::stock_api::AggregateBarResult>& bars, const ExecutionPolicy& policy,
+                                const plugins::manifest::HostParams& host_params, bool use_precomputed_signals) {
+        const auto replay_bar = [&](const auto& bar) {
+            // The cursor advances on every bar, including those skipped below, to stay aligned with the series.
+            int8_t signal = SIGNAL_VALUE_NONE;
+            if (use_precomputed_signals) {
+                auto& symbol_signals = precomputed_signals_[bar.symbol_];
+                signal = symbol_signals.signals_[symbol_signals.cursor_++];
+            }
+
+            // Recorded ahead of the market hours check, so a replay under other market hours still sees every bar.
+            if (event_log_ != nullptr) {
+                event_log_->record_bar(bar);
+            }
+
+            if (!exchange::is_within_market_hour_restrictions(bar.unix_ts_ns_, policy)) {
+                return;
+            }
+
+            process_bar<FeaturesT>(bar, policy, host_params, [&] {
+                if (use_precomputed_signals) {
+                    schedule_precomputed_signal<FeaturesT>(bar.symbol_, signal, policy);
+                    return;
+                }
+
+                CInstructionBuffer instructions{.instructions_ = instruction_buffer_.data(), .capacity_ = instruction_buffer_.size(), .count_ = 0};
+                const PluginResult result = [&] {
+                    PROFILE_SCOPE("on_bar");
+                    return plugin_->on_bar(bar, state_, instructions);
+                }();
 
-        report_ = {
-            .some_value_ = "some_value",
-            .another_value_ = "another_value",
+                if (result.code_ != 0) {
+                    throw std::runtime_error("Plugin on_bar failed: " + std::string(result.message_));
+                }
+
+                // Buffered instructions were written first, so they are scheduled ahead of any overflow in the result.
+                const size_t buffered_count = std::min(instructions.count_, instructions.capacity_);
+                for (size_t i = 0; i < buffered_count; ++i) {
+                    schedule_plugin_instruction<FeaturesT>(instruction_buffer_[i], policy);
+                }
+                schedule_plugin_instructions<FeaturesT>(result, policy);
+            });
         };
+
+        const bool is_checkpointing = is_resumable(use_precomputed_signals);
+        for (size_t i = resume_from_checkpoint(bars, policy, use_precomputed_signals); i < bars.size(); ++i) {
+            replay_bar(bars[i]);
+
+            if (is_checkpointing && is_checkpoint_due(i + 1, bars.size())) {
+                save_checkpoint(bars, i + 1);
+            }
+        }
+    }
+
+    // Each bar is followed in the log by the instructions the plugin answered it with, which stand in for on_bar here.
+    template <typename FeaturesT>
+    void BackTestEngine::replay_event_log(const EventLog& event_log, const ExecutionPolicy& policy, const plugins::manifest::HostParams& host_params) {
+        const auto& events = event_log.get_events();
+        http::stock_api::AggregateBarResult bar;
+
+        size_t i = 0;
+        while (i < events.size()) {
+            if (events[i].type_ != EventType::BAR) {
+                ++i;
+                continue;
+            }
+
+            const size_t bar_index = i++;
+            while (i < events.size() && events[i].type_ != EventType::BAR) {
+                ++i;
+            }
+
+            event_log.to_bar(events[bar_index], bar);
+
+            if (event_log_ != nullptr) {
+                event_log_->record_bar(bar);
+            }
+
+            if (!exchange::is_within_market_hour_restrictions(bar.unix_ts_ns_, policy)) {
+                continue;
+            }
+
+            process_bar<FeaturesT>(bar, policy, host_params, [&] {
+                for (size_t j = bar_index + 1; j < i; ++j) {
+                    if (events[j].type_ == EventType::INSTRUCTION) {
+                        schedule_plugin_instruction<FeaturesT>(event_log.to_c_instruction(events[j]), policy);
+                    }
+                }
+            });
+        }
+    }
+
+    template <typename FeaturesT, typename ScheduleFn>
+    void BackTestEngine::process_bar(const http::stock_api::AggregateBarResult& bar, const ExecutionPolicy& policy,
+                                     const plugins::manifest::HostParams& host_params, ScheduleFn&& schedule_instructions) {
+        state_.prepare_next_bar_state(bar);
+
+        execute_order_book<FeaturesT>(bar, policy);
+        if constexpr (FeaturesT::LIMIT_ORDERS) {
+            execute_limit_orders<FeaturesT>(policy);
+        }
+        if constexpr (FeaturesT::EXIT_ORDERS) {
+            execute_exit_orders<FeaturesT>(policy);
+        }
+
+        std::forward<ScheduleFn>(schedule_instructions)();
+
+        {
+            PROFILE_SCOPE("record_bar_equity_snapshot");
+            state_.record_bar_equity_snapshot(host_params);
+        }
+
+        state_.clear_previous_bar_state();
     }
 
-    void BackTestEngine::execute_order_book(const http::stock_api::AggregateBarResult& bar, const plugins::manifest::HostParams& host_params) {
+    template <typename FeaturesT>
+    void BackTestEngine::execute_order_book(const http::stock_api::AggregateBarResult& bar, const ExecutionPolicy& policy) {
+        PROFILE_SCOPE("execute_order_book");
+
         while (!order_book_.empty()) {
             const auto top_order_optional = order_book_.top();
 
@@ -81,45 +361,67 @@ namespace simulators {
 
             order_book_.pop();
 
-            const models::ExecutionResult execution_result = executor::execute_order(scheduled_order.order_, host_params, state_);
+            submit_order<FeaturesT>(scheduled_order.order_, policy);
+        }
+    }
+
+    template <typename FeaturesT>
+    void BackTestEngine::submit_order(const models::Order& order, const ExecutionPolicy& policy) {
+        if (event_log_ != nullptr) {
+            event_log_->record_order(order, state_.current_timestamp_ns_);
+        }
+
+        const models::ExecutionResult execution_result = executor::execute_order<FeaturesT>(order, policy, state_);
 
-            handle_execution_result(execution_result, host_params);
+        if (event_log_ != nullptr) {
+            event_log_->record_execution_result(execution_result, state_.current_timestamp_ns_);
         }
+
+        handle_execution_result<FeaturesT>(execution_result, policy);
     }
 
-    void BackTestEngine::handle_execution_result(const models::ExecutionResult& execution_result, const plugins::manifest::HostParams& host_params) {
+    template <typename FeaturesT>
+    void BackTestEngine::handle_execution_result(const models::ExecutionResult& execution_result, const ExecutionPolicy& policy) {
         std::visit(
             [&](auto arg) {
                 using T = std::decay_t<decltype(arg)>;
 
                 if constexpr (std::is_same_v<T, models::ExecutionResultError>) {
-                    // When we have logger, log the failure
+                    PROFILE_COUNT("order_rejected");
+                    rejection_counts_[arg.message_]++;
                     return;
                 }
 
                 if constexpr (std::is_same_v<T, models::ExecutionResultSuccess>) {
-                    if (arg.fill_.is_sell()) {
-                        const auto closed_fills = position_calc::find_buy_fill_uuids_closed_by_sell(arg.fill_, state_);
-                        exit_order_book_.reduce_exit_orders_by_fills(closed_fills);
-                    }
+                    PROFILE_COUNT("order_filled");
 
-                    if (arg.fill_.is_buy()) {
-                        const auto closed_fills = position_calc::find_sell_fill_uuids_closed_by_buy(arg.fill_, state_);
-                        exit_order_book_.reduce_exit_orders_by_fills(closed_fills);
-                    }
+                    // The closed-fill scans walk every fill so far and only serve the exit order book.
+                    if constexpr (FeaturesT::EXIT_ORDERS) {
+                        if (arg.fill_.is_sell()) {
+                            const auto closed_fills = position_calc::find_buy_fill_uuids_closed_by_sell(arg.fill_, state_);
+                            exit_order_book_.reduce_exit_orders_by_fills(closed_fills);
+                        }
+
+                        if (FeaturesT::SHORTING && arg.fill_.is_buy()) {
+                            const auto closed_fills = position_calc::find_sell_fill_uuids_closed_by_buy(arg.fill_, state_);
+                            exit_order_book_.reduce_exit_orders_by_fills(closed_fills);
+                        }
 
-                    if (arg.has_exit_strategy()) {
-                        for (const auto& exit_order : arg.exit_orders_) {
-                            exit_order_book_.add_exit_order(exit_order);
+                        if (arg.has_exit_strategy()) {
+                            for (const auto& exit_order : arg.exit_orders_) {
+                                exit_order_book_.add_exit_order(exit_order);
+                            }
                         }
                     }
 
-                    if (arg.is_partial_fill()) {
-                        const auto& partial_order = arg.partial_order_.value();
-                        if (partial_order.is_limit_order()) {
-                            limit_order_book_.add_limit_order(create_scheduled_limit_order(partial_order));
-                        } else {
-                            order_book_.push(create_scheduled_order(partial_order, host_params, state_));
+                    if constexpr (FeaturesT::PARTIAL_FILLS) {
+                        if (arg.is_partial_fill()) {
+                            const auto& partial_order = arg.partial_order_.value();
+                            if (FeaturesT::LIMIT_ORDERS && partial_order.is_limit_order()) {
+                                limit_order_book_.add_limit_order(create_scheduled_limit_order(partial_order));
+                            } else {
+                                order_book_.push(create_scheduled_order(partial_order, policy, state_));
+                            }
                         }
                     }
 
@@ -129,57 +431,159 @@ namespace simulators {
             execution_result);
     }
 
-    void BackTestEngine::schedule_plugin_instructions(const PluginResult& result, const plugins::manifest::HostParams& host_params) {
-        ABIConverter::iterate_c_instructions(result, [&, host_params](const auto& c_intruction) {
-            const models::Instruction instruction = ABIConverter::to_instruction(c_intruction);
+    template <typename FeaturesT>
+    void BackTestEngine::schedule_plugin_instructions(const PluginResult& result, const ExecutionPolicy& policy) {
+        ABIConverter::iterate_c_instructions(result, [&](const auto& c_intruction) { schedule_plugin_instruction<FeaturesT>(c_intruction, policy); });
+    }
 
-            models::Order order = std::visit(
-                [&](auto&& arg) {
-                    using T = std::decay_t<decltype(arg)>;
-                    if constexpr (std::is_same_v<T, models::Signal>) {
-                        return executor::signal_to_order(arg, host_params, state_);
-                    }
-                    if constexpr (std::is_same_v<T, models::Order>) {
-                        return arg;
-                    }
-                    throw std::runtime_error("Invalid instruction type");
-                },
-                instruction);
+    template <typename FeaturesT>
+    void BackTestEngine::schedule_plugin_instruction(const CInstruction& c_instruction, const ExecutionPolicy& policy) {
+        if (event_log_ != nullptr) {
+            event_log_->record_instruction(c_instruction);
+        }
 
-            if (order.is_limit_order()) {
-                limit_order_book_.add_limit_order(create_scheduled_limit_order(order));
-            } else {
-                order_book_.push(create_scheduled_order(order, host_params, state_));
-            }
-        });
+        const models::Instruction instruction = ABIConverter::to_instruction(c_instruction);
+
+        models::Order order = std::visit(
+            [&](auto&& arg) {
+                using T = std::decay_t<decltype(arg)>;
+                if constexpr (std::is_same_v<T, models::Signal>) {
+                    return executor::signal_to_order(arg, policy, state_);
+                }
+                if constexpr (std::is_same_v<T, models::Order>) {
+                    return arg;
+                }
+                throw std::runtime_error("Invalid instruction type");
+            },
+            instruction);
+
+        // Orders needing a feature the manifest turned off are rejected here, whichever variant is running.
+        if (order.is_limit_order() && !policy.allow_limit_orders_) {
+            rejection_counts_["Limit orders disabled"]++;
+            return;
+        }
+        if ((order.stop_loss_price_.has_value() || order.take_profit_price_.has_value()) && !policy.allow_exit_orders_) {
+            rejection_counts_["Exit orders disabled"]++;
+            return;
+        }
+
+        if (FeaturesT::LIMIT_ORDERS && order.is_limit_order()) {
+            limit_order_book_.add_limit_order(create_scheduled_limit_order(order));
+        } else {
+            order_book_.push(create_scheduled_order(order, policy, state_));
+        }
     }
 
-    void BackTestEngine::execute_limit_orders(const plugins::manifest::HostParams& host_params) {
-        limit_order_book_.process_buy_limits(state_, [&, host_params](const models::Order& order) {
-            const models::ExecutionResult execution_result = executor::execute_order(order, host_params, state_);
-            handle_execution_result(execution_result, host_params);
-        });
+    template <typename FeaturesT>
+    void BackTestEngine::execute_limit_orders(const ExecutionPolicy& policy) {
+        PROFILE_SCOPE("execute_limit_orders");
 
-        limit_order_book_.process_sell_limits(state_, [&, host_params](const models::Order& order) {
-            const models::ExecutionResult execution_result = executor::execute_order(order, host_params, state_);
-            handle_execution_result(execution_result, host_params);
-        });
+        limit_order_book_.process_buy_limits(state_, [&](const models::Order& order) { submit_order<FeaturesT>(order, policy); });
+
+        limit_order_book_.process_sell_limits(state_, [&](const models::Order& order) { submit_order<FeaturesT>(order, policy); });
     }
 
-    void BackTestEngine::execute_exit_orders(const plugins::manifest::HostParams& host_params) {
-        exit_order_book_.process_stop_loss_heap(state_, [&, host_params](const models::StopLossExitOrder& exit_order) {
-            const models::Order close_order = exit_order.to_close_instruction();
-            const models::ExecutionResult execution_result = executor::execute_order(close_order, host_params, state_);
-            handle_execution_result(execution_result, host_params);
+    template <typename FeaturesT>
+    void BackTestEngine::execute_exit_orders(const ExecutionPolicy& policy) {
+        PROFILE_SCOPE("execute_exit_orders");
+
+        exit_order_book_.process_stop_loss_heap(state_, [&](const models::StopLossExitOrder& exit_order) {
+            if (event_log_ != nullptr) {
+                event_log_->record_exit_trigger(exit_order, state_.current_timestamp_ns_);
+            }
+            submit_order<FeaturesT>(exit_order.to_close_instruction(), policy);
         });
 
-        exit_order_book_.process_take_profit_heap(state_, [&, host_params](const models::TakeProfitExitOrder& exit_order) {
-            const models::Order close_order = exit_order.to_close_instruction();
-            const models::ExecutionResult execution_result = executor::execute_order(close_order, host_params, state_);
-            handle_execution_result(execution_result, host_params);
+        exit_order_book_.process_take_profit_heap(state_, [&](const models::TakeProfitExitOrder& exit_order) {
+            if (event_log_ != nullptr) {
+                event_log_->record_exit_trigger(exit_order, state_.current_timestamp_ns_);
+            }
+            submit_order<FeaturesT>(exit_order.to_close_instruction(), policy);
         });
     }
 
+    void BackTestEngine::precompute_signals(const std::vector<http::stock_api::AggregateBarResult>& bars) {
+        struct SeriesColumns {
+            std::vector<int64_t> unix_ts_ns_;
+            std::vector<double> open_;
+            std::vector<double> high_;
+            std::vector<double> low_;
+            std::vector<double> close_;
+            std::vector<double> volume_;
+        };
+
+        std::vector<std::string> symbols;
+        std::unordered_map<std::string, SeriesColumns> columns_by_symbol;
+
+        for (const auto& bar : bars) {
+            auto [it, inserted] = columns_by_symbol.try_emplace(bar.symbol_);
+            if (inserted) {
+                symbols.push_back(bar.symbol_);
+            }
+
+            auto& columns = it->second;
+            columns.unix_ts_ns_.push_back(bar.unix_ts_ns_);
+            columns.open_.push_back(bar.open_);
+            columns.high_.push_back(bar.high_);
+            columns.low_.push_back(bar.low_);
+            columns.close_.push_back(bar.close_);
+            columns.volume_.push_back(bar.volume_);
+        }
+
+        std::vector<CSeries> series;
+        std::vector<CSignalColumn> signal_columns;
+        series.reserve(symbols.size());
+        signal_columns.reserve(symbols.size());
+        precomputed_signals_.clear();
+
+        for (const auto& symbol : symbols) {
+            const auto& columns = columns_by_symbol.at(symbol);
+            auto& symbol_signals = precomputed_signals_[symbol];
+            symbol_signals.signals_.assign(columns.close_.size(), SIGNAL_VALUE_NONE);
+
+            series.push_back(CSeries{
+                .symbol_ = symbol.c_str(),
+                .unix_ts_ns_ = columns.unix_ts_ns_.data(),
+                .open_ = columns.open_.data(),
+                .high_ = columns.high_.data(),
+                .low_ = columns.low_.data(),
+                .close_ = columns.close_.data(),
+                .volume_ = columns.volume_.data(),
+                .count_ = columns.close_.size(),
+            });
+
+            signal_columns.push_back(CSignalColumn{
+                .symbol_ = symbol.c_str(),
+                .signals_ = symbol_signals.signals_.data(),
+                .count_ = symbol_signals.signals_.size(),
+            });
+        }
+
+        const PluginResult result = plugin_->precompute_signals(series.data(), signal_columns.data(), series.size());
+
+        if (result.code_ != 0) {
+            throw std::runtime_error("Plugin precompute_signals failed: " + std::string(result.message_ != nullptr ? result.message_ : ""));
+        }
+    }
+
+    template <typename FeaturesT>
+    void BackTestEngine::schedule_precomputed_signal(const std::string& symbol, int8_t signal, const ExecutionPolicy& policy) {
+        if (signal == SIGNAL_VALUE_NONE) {
+            return;
+        }
+
+        CInstruction c_instruction{};
+        c_instruction.type_ = INSTRUCTION_TYPE_SIGNAL;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+        c_instruction.data_.signal_ = CSignal{.symbol_ = symbol.c_str(), .action_ = signal > 0 ? constants::BUY : constants::SELL};
+
+        schedule_plugin_instructions<FeaturesT>(PluginResult{0, nullptr, &c_instruction, 1}, policy);
+    }
+
     const BackTestReport& BackTestEngine::get_report() { return report_; }
 
+    // run() reaches every variant through with_features; these two are also run directly, to be compared.
+    template void BackTestEngine::run_with_features<AllFeatures>();
+    template void BackTestEngine::run_with_features<MinimalFeatures>();
+
 }  // namespace simulators
@@ -6,14 +6,21 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "../../forge/stores/data_store.hpp"
 #include "../../plugins/loaders/interface.hpp"
 #include "../../utils/min_heap.hpp"
+#include "./checkpoint.hpp"
+#include "./event_log.hpp"
+#include "./execution_policy.hpp"
+#include "./features.hpp"
 #include "./exit_order_book.hpp"
+#include "./journal.hpp"
 #include "./limit_order_book.hpp"
 #include "./models.hpp"
+#include "./report.hpp"
 #include "./slippage_calculator.hpp"
 #include "./state.hpp"
 
@@ -21,25 +28,40 @@ using namespace money_utils;
 
 namespace simulators {
 
-    struct BackTestReport {
-        std::string some_value_;
-        std::string another_value_;
+    // Signals returned by a plugin's precompute_signals hook for one symbol, consumed bar by bar during replay.
+    struct PrecomputedSignals {
+        std::vector<int8_t> signals_;
+        size_t cursor_ = 0;
     };
 
     class BackTestEngine {
        public:
         BackTestEngine(const plugins::loaders::IPluginLoader* plugin, const forge::DataStore* data_store);
         void run();
-        void execute_order_book(const http::stock_api::AggregateBarResult& bar, const plugins::manifest::HostParams& host_params);
-        void execute_limit_orders(const plugins::manifest::HostParams& host_params);
-        void handle_execution_result(const models::ExecutionResult& execution_result, const plugins::manifest::HostParams& host_params);
-        void schedule_plugin_instructions(const PluginResult& result, const plugins::manifest::HostParams& host_params);
-        void execute_exit_orders(const plugins::manifest::HostParams& host_params);
+        // run() on the given variant rather than the narrowest one, e.g. to check that variants agree. Throws when the
+        // manifest allows a feature FeaturesT leaves out. Instantiated for AllFeatures and MinimalFeatures.
+        template <typename FeaturesT>
+        void run_with_features();
+        // Records every bar, instruction, order, fill and exit trigger of the following runs. The log must outlive them.
+        void set_event_log(EventLog* event_log);
+        // Saves a checkpoint every interval_bars_ bars of the following runs and resumes them from an existing one. A run
+        // that records an event log starts over instead, so the log covers it from the first bar, and so does one whose
+        // plugin answers on_bar without state hooks, since whatever it keeps between bars would be lost.
+        void set_checkpoint_options(CheckpointOptions checkpoint_options);
+        // Streams the fills and equity curve of the following runs to journals, see StreamingOptions. Throws on an empty
+        // equity window or stride.
+        void set_streaming_options(StreamingOptions streaming_options);
+        // Re-drives a recorded back test without the data store or the plugin. Under the host params it was recorded
+        // with the outcome is identical; under others, the same decisions are re-priced.
+        void run_from_event_log(const EventLog& event_log, const plugins::manifest::HostParams& host_params);
         [[nodiscard]] const BackTestReport& get_report();
 
        private:
         const plugins::loaders::IPluginLoader* plugin_;
         const forge::DataStore* data_store_;
+        EventLog* event_log_ = nullptr;
+        CheckpointOptions checkpoint_options_;
+        StreamingJournals streaming_;
         BackTestReport report_;
         simulators::State state_ = {
             .cash_ = Money(0),
@@ -61,11 +83,55 @@ namespace simulators {
         data_structures::MinHeap<models::ScheduledOrder> order_book_;
         ExitOrderBook exit_order_book_;
         LimitOrderBook limit_order_book_;
+        std::unordered_map<std::string, PrecomputedSignals> precomputed_signals_;
+        // Rejected orders by the executor's reason; ordered, so the report and checkpoints list them the same way every run.
+        std::map<std::string, uint64_t> rejection_counts_;
+        // Handed to the plugin on every on_bar and consumed before the next, so one arena serves the whole run.
+        std::vector<CInstruction> instruction_buffer_;
+
+        // The replay and order handling below are instantiated per Features; run() picks the variant from the manifest.
+        template <typename FeaturesT>
+        void replay(const std::vector<http::stock_api::AggregateBarResult>& bars, const ExecutionPolicy& policy,
+                    const plugins::manifest::HostParams& host_params, bool use_precomputed_signals);
+        template <typename FeaturesT>
+        void replay_event_log(const EventLog& event_log, const ExecutionPolicy& policy, const plugins::manifest::HostParams& host_params);
+        template <typename FeaturesT, typename ScheduleFn>
+        void process_bar(const http::stock_api::AggregateBarResult& bar, const ExecutionPolicy& policy, const plugins::manifest::HostParams& host_params,
+                         ScheduleFn&& schedule_instructions);
+        template <typename FeaturesT>
+        void execute_order_book(const http::stock_api::AggregateBarResult& bar, const ExecutionPolicy& policy);
+        template <typename FeaturesT>
+        void execute_limit_orders(const ExecutionPolicy& policy);
+        template <typename FeaturesT>
+        void submit_order(const models::Order& order, const ExecutionPolicy& policy);
+        template <typename FeaturesT>
+        void handle_execution_result(const models::ExecutionResult& execution_result, const ExecutionPolicy& policy);
+        template <typename FeaturesT>
+        void schedule_plugin_instructions(const PluginResult& result, const ExecutionPolicy& policy);
+        template <typename FeaturesT>
+        void schedule_plugin_instruction(const CInstruction& c_instruction, const ExecutionPolicy& policy);
+        template <typename FeaturesT>
+        void execute_exit_orders(const ExecutionPolicy& policy);
+        void precompute_signals(const std::vector<http::stock_api::AggregateBarResult>& bars);
+        template <typename FeaturesT>
+        void schedule_precomputed_signal(const std::string& symbol, int8_t signal, const ExecutionPolicy& policy);
+
+        // Whether checkpoints are taken and resumed: the plugin's state either lives in the engine, as with precomputed
+        // signals, or comes back through its state hooks.
+        [[nodiscard]] bool is_resumable(bool use_precomputed_signals) const;
+        [[nodiscard]] bool is_checkpoint_due(size_t next_bar, size_t bar_count) const;
+        void save_checkpoint(const std::vector<http::stock_api::AggregateBarResult>& bars, size_t next_bar) const;
+        // Index of the first bar still to run: 0, or the one after the checkpoint's last.
+        [[nodiscard]] size_t resume_from_checkpoint(const std::vector<http::stock_api::AggregateBarResult>& bars, const ExecutionPolicy& policy,
+                                                    bool use_precomputed_signals);
+        void open_journals(const StreamingCursor& cursor);
+        // From the journals in streaming mode, otherwise from the state.
+        [[nodiscard]] BackTestReport build_report(Money initial_capital) const;
     };
 
-    [[nodiscard]] inline models::ScheduledOrder create_scheduled_order(const models::Order& order, const plugins::manifest::HostParams& host_params,
+    [[nodiscard]] inline models::ScheduledOrder create_scheduled_order(const models::Order& order, const ExecutionPolicy& policy,
                                                                        const simulators::State& state) {
-        return {order, slippage_calc::calculate_slippage_time_ns(order, host_params, state)};
+        return {order, slippage_calc::calculate_slippage_time_ns(order, policy, state)};
     }
 
     [[nodiscard]] inline models::ScheduledLimitOrder create_scheduled_limit_order(const models::Order& order) {
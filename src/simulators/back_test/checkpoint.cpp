@@ -0,0 +1,472 @@
+#include "checkpoint.hpp"
+
+#include <array>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "./report.hpp"
+
+static constexpr std::array<char, 4> CHECKPOINT_MAGIC = {'Q', 'F', 'C', 'K'};
+static constexpr std::array<char, 4> REPORT_MAGIC = {'Q', 'F', 'R', 'P'};
+
+namespace simulators::checkpoint {
+    namespace {
+        using plugins::isolation::BufferReader;
+        using plugins::isolation::BufferWriter;
+
+        struct FileHeader {
+            std::array<char, 4> magic_;
+            uint32_t version_;
+            uint64_t fingerprint_;
+            uint64_t payload_size_;
+        };
+
+        enum class LimitSide : uint8_t { BUY, SELL };
+        enum class ExitKind : uint8_t { STOP_LOSS, TAKE_PROFIT };
+
+        void put_text(BufferWriter& writer, const std::string& value) { writer.put_string(value.c_str()); }
+
+        std::string get_text(BufferReader& reader) {
+            std::deque<std::string> storage;
+            const char* value = reader.get_string(storage);
+            return value != nullptr ? std::move(storage.back()) : std::string();
+        }
+
+        template <typename T>
+        void put_optional(BufferWriter& writer, const std::optional<T>& value) {
+            writer.put(value.has_value());
+            if (value.has_value()) {
+                writer.put(value.value());
+            }
+        }
+
+        template <typename T>
+        std::optional<T> get_optional(BufferReader& reader) {
+            if (!reader.get<bool>()) {
+                return std::nullopt;
+            }
+            return reader.get<T>();
+        }
+
+        template <typename T>
+        void put_map(BufferWriter& writer, const std::map<std::string, T>& values) {
+            writer.put<uint64_t>(values.size());
+            for (const auto& [key, value] : values) {
+                put_text(writer, key);
+                writer.put(value);
+            }
+        }
+
+        template <typename T>
+        void get_map(BufferReader& reader, std::map<std::string, T>& values) {
+            values.clear();
+            const auto count = reader.get<uint64_t>();
+            for (uint64_t i = 0; i < count; ++i) {
+                std::string key = get_text(reader);
+                values.emplace(std::move(key), reader.get<T>());
+            }
+        }
+
+        void encode_order(BufferWriter& writer, const models::Order& order) {
+            writer.put(order.is_exit_order_);
+            writer.put(order.quantity_);
+            writer.put(order.created_at_ns_);
+            put_text(writer, order.symbol_);
+            put_text(writer, order.action_);
+            put_text(writer, order.order_type_);
+            writer.put(order.source_fill_uuid_.has_value());
+            if (order.source_fill_uuid_.has_value()) {
+                put_text(writer, order.source_fill_uuid_.value());
+            }
+            put_optional(writer, order.limit_price_);
+            put_optional(writer, order.stop_loss_price_);
+            put_optional(writer, order.take_profit_price_);
+            put_optional(writer, order.leverage_);
+        }
+
+        models::Order decode_order(BufferReader& reader) {
+            const auto is_exit_order = reader.get<bool>();
+            const auto quantity = reader.get<double>();
+            const auto created_at_ns = reader.get<int64_t>();
+            std::string symbol = get_text(reader);
+            std::string action = get_text(reader);
+            std::string order_type = get_text(reader);
+            std::optional<std::string> source_fill_uuid = reader.get<bool>() ? std::make_optional(get_text(reader)) : std::nullopt;
+            const auto limit_price = get_optional<Money>(reader);
+            const auto stop_loss_price = get_optional<Money>(reader);
+            const auto take_profit_price = get_optional<Money>(reader);
+
+            models::Order order(quantity, created_at_ns, std::move(symbol), std::move(action), std::move(order_type), limit_price, stop_loss_price,
+                                take_profit_price);
+            order.is_exit_order_ = is_exit_order;
+            order.source_fill_uuid_ = std::move(source_fill_uuid);
+            order.leverage_ = get_optional<double>(reader);
+            return order;
+        }
+
+        void encode_fill(BufferWriter& writer, const models::Fill& fill) {
+            put_text(writer, fill.symbol_);
+            put_text(writer, fill.action_);
+            put_text(writer, fill.uuid_);
+            writer.put(fill.quantity_);
+            writer.put(fill.price_);
+            writer.put(fill.created_at_ns_);
+            writer.put(fill.leverage_);
+            writer.put(fill.margin_used_);
+        }
+
+        models::Fill decode_fill(BufferReader& reader) {
+            std::string symbol = get_text(reader);
+            std::string action = get_text(reader);
+            std::string uuid = get_text(reader);
+            const auto quantity = reader.get<double>();
+            const auto price = reader.get<Money>();
+            const auto created_at_ns = reader.get<int64_t>();
+            const auto leverage = reader.get<double>();
+            const auto margin_used = reader.get<Money>();
+
+            models::Fill fill(std::move(symbol), std::move(action), quantity, price, created_at_ns, leverage, margin_used);
+            fill.uuid_ = std::move(uuid);
+            return fill;
+        }
+
+        template <typename T>
+        void encode_exit_order_fields(BufferWriter& writer, const T& exit_order, Money trigger_price) {
+            put_text(writer, exit_order.symbol_);
+            put_text(writer, exit_order.fill_uuid_);
+            writer.put(exit_order.trigger_quantity_);
+            writer.put(trigger_price);
+            writer.put(exit_order.price_);
+            writer.put(exit_order.created_at_ns_);
+            writer.put(exit_order.is_short_position_);
+            writer.put(exit_order.is_triggered_);
+        }
+
+        template <typename T>
+        T decode_exit_order_fields(BufferReader& reader) {
+            std::string symbol = get_text(reader);
+            std::string fill_uuid = get_text(reader);
+            const auto quantity = reader.get<double>();
+            const auto trigger_price = reader.get<Money>();
+            const auto price = reader.get<Money>();
+            const auto created_at_ns = reader.get<int64_t>();
+            const auto is_short_position = reader.get<bool>();
+
+            T exit_order(std::move(symbol), quantity, trigger_price, price, created_at_ns, std::move(fill_uuid), is_short_position);
+            exit_order.is_triggered_ = reader.get<bool>();
+            return exit_order;
+        }
+
+        void write_framed(const std::filesystem::path& path, const std::array<char, 4>& magic, uint64_t fingerprint, std::span<const uint8_t> payload) {
+            std::filesystem::path tmp_path = path;
+            tmp_path += ".tmp";
+
+            {
+                std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+                if (!out) {
+                    throw std::runtime_error("Failed to open checkpoint for writing: " + tmp_path.string());
+                }
+
+                const FileHeader header{.magic_ = magic, .version_ = CHECKPOINT_VERSION, .fingerprint_ = fingerprint, .payload_size_ = payload.size()};
+                out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+
+                if (!out.flush()) {
+                    throw std::runtime_error("Failed to write checkpoint: " + tmp_path.string());
+                }
+            }
+
+            std::filesystem::rename(tmp_path, path);
+        }
+
+        FileHeader read_header(std::ifstream& in, const std::filesystem::path& path) {
+            FileHeader header{};
+            in.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+            if (!in) {
+                throw std::runtime_error("Not a checkpoint: " + path.string());
+            }
+            return header;
+        }
+
+        std::optional<std::vector<uint8_t>> read_framed(const std::filesystem::path& path, const std::array<char, 4>& magic,
+                                                        std::optional<uint64_t> fingerprint) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) {
+                return std::nullopt;
+            }
+
+            const FileHeader header = read_header(in, path);
+            if (header.magic_ != magic) {
+                throw std::runtime_error("Not a checkpoint: " + path.string());
+            }
+            if (header.version_ != CHECKPOINT_VERSION) {
+                throw std::runtime_error("Unsupported checkpoint version " + std::to_string(header.version_) + ": " + path.string());
+            }
+            if (fingerprint.has_value() && header.fingerprint_ != fingerprint.value()) {
+                return std::nullopt;
+            }
+
+            std::vector<uint8_t> payload(header.payload_size_);
+            in.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+
+            if (!in) {
+                throw std::runtime_error("Truncated checkpoint: " + path.string());
+            }
+
+            return payload;
+        }
+    }  // namespace
+
+    void encode_cursor(BufferWriter& writer, const CheckpointCursor& cursor) {
+        writer.put(cursor.next_bar_);
+        writer.put(cursor.bar_count_);
+        writer.put(cursor.last_bar_unix_ts_ns_);
+    }
+
+    CheckpointCursor decode_cursor(BufferReader& reader) {
+        CheckpointCursor cursor;
+        cursor.next_bar_ = reader.get<uint64_t>();
+        cursor.bar_count_ = reader.get<uint64_t>();
+        cursor.last_bar_unix_ts_ns_ = reader.get<int64_t>();
+        return cursor;
+    }
+
+    void encode_state(BufferWriter& writer, const State& state) {
+        writer.put(state.cash_);
+        writer.put(state.margin_in_use_);
+        writer.put(state.peak_equity_);
+        writer.put(state.max_drawdown_);
+
+        writer.put<uint64_t>(state.positions_.size());
+        for (const auto& [symbol, position] : state.positions_) {
+            put_text(writer, symbol);
+            writer.put(position.quantity_);
+            writer.put(position.average_price_);
+        }
+
+        writer.put<uint64_t>(state.fills_.size());
+        for (const auto& fill : state.fills_) {
+            encode_fill(writer, fill);
+        }
+
+        encode_exit_orders(writer, state.exit_orders_);
+        writer.put_array(state.equity_curve_.data(), state.equity_curve_.size());
+
+        put_map(writer, state.active_buy_fills_);
+        put_map(writer, state.active_sell_fills_);
+        put_map(writer, state.active_margin_for_fills_);
+        put_map(writer, state.active_leverage_for_fills_);
+    }
+
+    void decode_state(BufferReader& reader, State& state) {
+        state.cash_ = reader.get<Money>();
+        state.margin_in_use_ = reader.get<Money>();
+        state.peak_equity_ = reader.get<Money>();
+        state.max_drawdown_ = reader.get<double>();
+
+        state.positions_.clear();
+        const auto position_count = reader.get<uint64_t>();
+        for (uint64_t i = 0; i < position_count; ++i) {
+            std::string symbol = get_text(reader);
+            const auto quantity = reader.get<double>();
+            const auto average_price = reader.get<Money>();
+            state.positions_.insert_or_assign(symbol, models::Position(symbol, quantity, average_price));
+        }
+
+        state.fills_.clear();
+        const auto fill_count = reader.get<uint64_t>();
+        state.fills_.reserve(fill_count);
+        for (uint64_t i = 0; i < fill_count; ++i) {
+            state.fills_.push_back(decode_fill(reader));
+        }
+
+        state.exit_orders_ = decode_exit_orders(reader);
+        reader.get_array(state.equity_curve_);
+
+        get_map(reader, state.active_buy_fills_);
+        get_map(reader, state.active_sell_fills_);
+        get_map(reader, state.active_margin_for_fills_);
+        get_map(reader, state.active_leverage_for_fills_);
+
+        state.new_fills_.clear();
+        state.new_exit_orders_.clear();
+    }
+
+    void encode_scheduled_orders(BufferWriter& writer, const std::vector<models::ScheduledOrder>& orders) {
+        writer.put<uint64_t>(orders.size());
+        for (const auto& scheduled_order : orders) {
+            writer.put(scheduled_order.scheduled_fill_at_ns_);
+            encode_order(writer, scheduled_order.order_);
+        }
+    }
+
+    std::vector<models::ScheduledOrder> decode_scheduled_orders(BufferReader& reader) {
+        std::vector<models::ScheduledOrder> orders;
+        const auto count = reader.get<uint64_t>();
+        orders.reserve(count);
+
+        for (uint64_t i = 0; i < count; ++i) {
+            const auto scheduled_fill_at_ns = reader.get<int64_t>();
+            orders.emplace_back(decode_order(reader), scheduled_fill_at_ns);
+        }
+
+        return orders;
+    }
+
+    void encode_limit_orders(BufferWriter& writer, const std::vector<models::ScheduledLimitOrder>& orders) {
+        writer.put<uint64_t>(orders.size());
+        for (const auto& limit_order : orders) {
+            std::visit(
+                [&](const auto& arg) {
+                    using T = std::decay_t<decltype(arg)>;
+                    writer.put(std::is_same_v<T, models::LimitBuyOrder> ? LimitSide::BUY : LimitSide::SELL);
+                    writer.put(arg.limit_price_);
+                    encode_order(writer, arg.order_);
+                },
+                limit_order);
+        }
+    }
+
+    std::vector<models::ScheduledLimitOrder> decode_limit_orders(BufferReader& reader) {
+        std::vector<models::ScheduledLimitOrder> orders;
+        const auto count = reader.get<uint64_t>();
+        orders.reserve(count);
+
+        for (uint64_t i = 0; i < count; ++i) {
+            const auto side = reader.get<LimitSide>();
+            const auto limit_price = reader.get<Money>();
+
+            if (side == LimitSide::BUY) {
+                orders.emplace_back(models::LimitBuyOrder(decode_order(reader), limit_price));
+            } else {
+                orders.emplace_back(models::LimitSellOrder(decode_order(reader), limit_price));
+            }
+        }
+
+        return orders;
+    }
+
+    void encode_exit_orders(BufferWriter& writer, const std::vector<models::ExitOrder>& orders) {
+        writer.put<uint64_t>(orders.size());
+        for (const auto& exit_order : orders) {
+            std::visit(
+                [&](const auto& arg) {
+                    using T = std::decay_t<decltype(arg)>;
+                    if constexpr (std::is_same_v<T, models::StopLossExitOrder>) {
+                        writer.put(ExitKind::STOP_LOSS);
+                        encode_exit_order_fields(writer, arg, arg.stop_loss_price_);
+                    } else {
+                        writer.put(ExitKind::TAKE_PROFIT);
+                        encode_exit_order_fields(writer, arg, arg.take_profit_price_);
+                    }
+                },
+                exit_order);
+        }
+    }
+
+    std::vector<models::ExitOrder> decode_exit_orders(BufferReader& reader) {
+        std::vector<models::ExitOrder> orders;
+        const auto count = reader.get<uint64_t>();
+        orders.reserve(count);
+
+        for (uint64_t i = 0; i < count; ++i) {
+            if (reader.get<ExitKind>() == ExitKind::STOP_LOSS) {
+                orders.emplace_back(decode_exit_order_fields<models::StopLossExitOrder>(reader));
+            } else {
+                orders.emplace_back(decode_exit_order_fields<models::TakeProfitExitOrder>(reader));
+            }
+        }
+
+        return orders;
+    }
+
+    void encode_rejection_counts(BufferWriter& writer, const std::map<std::string, uint64_t>& rejection_counts) { put_map(writer, rejection_counts); }
+
+    std::map<std::string, uint64_t> decode_rejection_counts(BufferReader& reader) {
+        std::map<std::string, uint64_t> rejection_counts;
+        get_map(reader, rejection_counts);
+        return rejection_counts;
+    }
+
+    void write_file(const std::filesystem::path& path, uint64_t fingerprint, std::span<const uint8_t> payload) {
+        write_framed(path, CHECKPOINT_MAGIC, fingerprint, payload);
+    }
+
+    std::optional<std::vector<uint8_t>> read_file(const std::filesystem::path& path, uint64_t fingerprint) {
+        return read_framed(path, CHECKPOINT_MAGIC, fingerprint);
+    }
+
+    void save_report(const std::filesystem::path& path, uint64_t fingerprint, const BackTestReport& report) {
+        BufferWriter writer;
+        put_text(writer, report.plugin_name_);
+        writer.put(report.metrics_);
+        writer.put_array(report.equity_curve_.data(), report.equity_curve_.size());
+        writer.put_array(report.fills_.data(), report.fills_.size());
+        writer.put<uint64_t>(report.symbol_pnls_.size());
+        for (const auto& symbol_pnl : report.symbol_pnls_) {
+            put_text(writer, symbol_pnl.symbol_);
+            writer.put(symbol_pnl.fill_count_);
+            writer.put(symbol_pnl.bought_quantity_);
+            writer.put(symbol_pnl.sold_quantity_);
+            writer.put(symbol_pnl.pnl_);
+        }
+        writer.put<uint64_t>(report.rejections_.size());
+        for (const auto& rejection : report.rejections_) {
+            put_text(writer, rejection.reason_);
+            writer.put(rejection.count_);
+        }
+        write_framed(path, REPORT_MAGIC, fingerprint, writer.get_bytes());
+    }
+
+    BackTestReport load_report(const std::filesystem::path& path) {
+        const auto payload = read_framed(path, REPORT_MAGIC, std::nullopt);
+        if (!payload.has_value()) {
+            throw std::runtime_error("Failed to open report: " + path.string());
+        }
+
+        BufferReader reader(payload.value());
+        BackTestReport report;
+        report.plugin_name_ = get_text(reader);
+        report.metrics_ = reader.get<BackTestMetrics>();
+        reader.get_array(report.equity_curve_);
+        reader.get_array(report.fills_);
+        report.symbol_pnls_.resize(reader.get<uint64_t>());
+        for (auto& symbol_pnl : report.symbol_pnls_) {
+            symbol_pnl.symbol_ = get_text(reader);
+            symbol_pnl.fill_count_ = reader.get<uint64_t>();
+            symbol_pnl.bought_quantity_ = reader.get<double>();
+            symbol_pnl.sold_quantity_ = reader.get<double>();
+            symbol_pnl.pnl_ = reader.get<Money>();
+        }
+        report.rejections_.resize(reader.get<uint64_t>());
+        for (auto& rejection : report.rejections_) {
+            rejection.reason_ = get_text(reader);
+            rejection.count_ = reader.get<uint64_t>();
+        }
+        return report;
+    }
+
+    std::optional<uint64_t> read_fingerprint(const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return std::nullopt;
+        }
+
+        const FileHeader header = read_header(in, path);
+        if (header.magic_ != CHECKPOINT_MAGIC && header.magic_ != REPORT_MAGIC) {
+            throw std::runtime_error("Not a checkpoint: " + path.string());
+        }
+        if (header.version_ != CHECKPOINT_VERSION) {
+            return std::nullopt;
+        }
+        return header.fingerprint_;
+    }
+
+}  // namespace simulators::checkpoint
@@ -0,0 +1,81 @@
+#ifndef QUANT_SIMULATORS_BACK_TEST_CHECKPOINT_HPP
+#define QUANT_SIMULATORS_BACK_TEST_CHECKPOINT_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../../plugins/isolation/ipc_codec.hpp"
+#include "./models.hpp"
+#include "./state.hpp"
+
+static constexpr uint32_t CHECKPOINT_VERSION = 3;
+
+namespace simulators {
+
+    struct BackTestReport;
+
+    // A back test saves a checkpoint to path_ after every interval_bars_ bars and resumes from it when it exists. An
+    // interval of 0 turns checkpoints off. fingerprint_ identifies the plugin build and configuration; a checkpoint
+    // saved under another one is ignored and overwritten.
+    struct CheckpointOptions {
+        std::filesystem::path path_;
+        size_t interval_bars_ = 0;
+        uint64_t fingerprint_ = 0;
+    };
+
+    // Where in the bar series a checkpoint was taken. The count and the timestamp of the last consumed bar catch a
+    // checkpoint being resumed against other data.
+    struct CheckpointCursor {
+        uint64_t next_bar_ = 0;
+        uint64_t bar_count_ = 0;
+        int64_t last_bar_unix_ts_ns_ = 0;
+    };
+
+    // Checkpoints are taken between bars, when the previous bar's new fills and exit orders are already cleared.
+    // Indicators and the current bar's prices are not saved; they are rebuilt by streaming the consumed bars again,
+    // which is cheap next to running the plugin on them. Files use the host byte order, like the event log.
+    namespace checkpoint {
+
+        void encode_cursor(plugins::isolation::BufferWriter& writer, const CheckpointCursor& cursor);
+        [[nodiscard]] CheckpointCursor decode_cursor(plugins::isolation::BufferReader& reader);
+
+        void encode_state(plugins::isolation::BufferWriter& writer, const State& state);
+        void decode_state(plugins::isolation::BufferReader& reader, State& state);
+
+        // Orders come back in the sequence they were written, so writing a heap's data rebuilds the same heap.
+        void encode_scheduled_orders(plugins::isolation::BufferWriter& writer, const std::vector<models::ScheduledOrder>& orders);
+        [[nodiscard]] std::vector<models::ScheduledOrder> decode_scheduled_orders(plugins::isolation::BufferReader& reader);
+        void encode_limit_orders(plugins::isolation::BufferWriter& writer, const std::vector<models::ScheduledLimitOrder>& orders);
+        [[nodiscard]] std::vector<models::ScheduledLimitOrder> decode_limit_orders(plugins::isolation::BufferReader& reader);
+        void encode_exit_orders(plugins::isolation::BufferWriter& writer, const std::vector<models::ExitOrder>& orders);
+        [[nodiscard]] std::vector<models::ExitOrder> decode_exit_orders(plugins::isolation::BufferReader& reader);
+        void encode_rejection_counts(plugins::isolation::BufferWriter& writer, const std::map<std::string, uint64_t>& rejection_counts);
+        [[nodiscard]] std::map<std::string, uint64_t> decode_rejection_counts(plugins::isolation::BufferReader& reader);
+
+        // Written to a temporary file and renamed over path, so a run killed mid-write leaves the previous checkpoint.
+        void write_file(const std::filesystem::path& path, uint64_t fingerprint, std::span<const uint8_t> payload);
+        // The payload, or nullopt when there is no file or it was written under another fingerprint. Throws when it is
+        // not a checkpoint of this version.
+        [[nodiscard]] std::optional<std::vector<uint8_t>> read_file(const std::filesystem::path& path, uint64_t fingerprint);
+
+        // Marks a completed run, so a resumed sweep skips it and takes the report as it was.
+        void save_report(const std::filesystem::path& path, uint64_t fingerprint, const BackTestReport& report);
+        [[nodiscard]] BackTestReport load_report(const std::filesystem::path& path);
+
+        // The fingerprint a checkpoint or report was written under, read from its header alone. nullopt when there is no
+        // file or it is of another version, neither of which can be taken up.
+        [[nodiscard]] std::optional<uint64_t> read_fingerprint(const std::filesystem::path& path);
+
+    }  // namespace checkpoint
+
+}  // namespace simulators
+
+#endif
@@ -0,0 +1,341 @@
+#include "event_log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+#include "../../utils/constants.hpp"
+
+static constexpr std::array<char, 4> EVENT_LOG_MAGIC = {'Q', 'F', 'E', 'L'};
+
+namespace simulators {
+    namespace {
+        struct EventLogHeader {
+            std::array<char, 4> magic_;
+            uint32_t version_;
+            uint64_t symbol_count_;
+            uint64_t event_count_;
+        };
+
+        bool is_buy_action(const char* action) { return action != nullptr && std::strcmp(action, constants::BUY) == 0; }
+
+        bool is_limit_order_type(const char* order_type) { return order_type != nullptr && std::strcmp(order_type, constants::LIMIT) == 0; }
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+        bool is_same_payload(const Event& a, const Event& b) {
+            switch (a.type_) {
+                case EventType::BAR: {
+                    const BarEvent& x = a.data_.bar_;
+                    const BarEvent& y = b.data_.bar_;
+                    return x.unix_ts_ns_ == y.unix_ts_ns_ && x.open_ == y.open_ && x.high_ == y.high_ && x.low_ == y.low_ && x.close_ == y.close_ &&
+                           x.volume_ == y.volume_;
+                }
+                case EventType::INSTRUCTION: {
+                    const InstructionEvent& x = a.data_.instruction_;
+                    const InstructionEvent& y = b.data_.instruction_;
+                    return x.type_ == y.type_ && x.is_buy_ == y.is_buy_ && x.is_limit_ == y.is_limit_ && x.quantity_ == y.quantity_ &&
+                           x.leverage_ == y.leverage_ && x.limit_price_ == y.limit_price_ && x.stop_loss_price_ == y.stop_loss_price_ &&
+                           x.take_profit_price_ == y.take_profit_price_;
+                }
+                case EventType::ORDER: {
+                    const OrderEvent& x = a.data_.order_;
+                    const OrderEvent& y = b.data_.order_;
+                    return x.unix_ts_ns_ == y.unix_ts_ns_ && x.quantity_ == y.quantity_ && x.limit_price_ == y.limit_price_ && x.is_buy_ == y.is_buy_ &&
+                           x.is_limit_ == y.is_limit_ && x.is_exit_order_ == y.is_exit_order_;
+                }
+                case EventType::FILL: {
+                    const FillEvent& x = a.data_.fill_;
+                    const FillEvent& y = b.data_.fill_;
+                    return x.unix_ts_ns_ == y.unix_ts_ns_ && x.quantity_ == y.quantity_ && x.price_ == y.price_ && x.cash_delta_ == y.cash_delta_ &&
+                           x.margin_used_ == y.margin_used_ && x.is_buy_ == y.is_buy_;
+                }
+                case EventType::REJECTION:
+                    return a.data_.rejection_.unix_ts_ns_ == b.data_.rejection_.unix_ts_ns_;
+                case EventType::EXIT_TRIGGER: {
+                    const ExitTriggerEvent& x = a.data_.exit_trigger_;
+                    const ExitTriggerEvent& y = b.data_.exit_trigger_;
+                    return x.unix_ts_ns_ == y.unix_ts_ns_ && x.quantity_ == y.quantity_ && x.trigger_price_ == y.trigger_price_ &&
+                           x.is_take_profit_ == y.is_take_profit_;
+                }
+            }
+
+            return false;
+        }
+        // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+    }  // namespace
+
+    uint32_t EventLog::intern_symbol(const std::string& symbol) {
+        auto [it, inserted] = symbol_ids_.try_emplace(symbol, static_cast<uint32_t>(symbols_.size()));
+        if (inserted) {
+            symbols_.push_back(symbol);
+        }
+        return it->second;
+    }
+
+    void EventLog::record_bar(const http::stock_api::AggregateBarResult& bar) {
+        Event& event = events_.emplace_back(Event{});
+        event.type_ = EventType::BAR;
+        event.symbol_id_ = intern_symbol(bar.symbol_);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+        event.data_.bar_ = BarEvent{
+            .unix_ts_ns_ = bar.unix_ts_ns_,
+            .open_ = bar.open_,
+            .high_ = bar.high_,
+            .low_ = bar.low_,
+            .close_ = bar.close_,
+            .volume_ = bar.volume_,
+        };
+    }
+
+    void EventLog::record_instruction(const CInstruction& c_instruction) {
+        Event& event = events_.emplace_back(Event{});
+        event.type_ = EventType::INSTRUCTION;
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+        if (c_instruction.type_ == INSTRUCTION_TYPE_SIGNAL) {
+            const CSignal& signal = c_instruction.data_.signal_;
+            event.symbol_id_ = intern_symbol(signal.symbol_);
+            event.data_.instruction_ = InstructionEvent{
+                .type_ = INSTRUCTION_TYPE_SIGNAL,
+                .is_buy_ = is_buy_action(signal.action_),
+                .is_limit_ = false,
+                .quantity_ = 0.0,
+                .leverage_ = 0.0,
+                .limit_price_ = models::NULL_MARKET_TRIGGER_PRICE,
+                .stop_loss_price_ = models::NULL_MARKET_TRIGGER_PRICE,
+                .take_profit_price_ = models::NULL_MARKET_TRIGGER_PRICE,
+            };
+            return;
+        }
+
+        const COrder& order = c_instruction.data_.order_;
+        event.symbol_id_ = intern_symbol(order.symbol_);
+        event.data_.instruction_ = InstructionEvent{
+            .type_ = c_instruction.type_,
+            .is_buy_ = is_buy_action(order.action_),
+            .is_limit_ = is_limit_order_type(order.order_type_),
+            .quantity_ = order.quantity_,
+            .leverage_ = order.leverage_,
+            .limit_price_ = order.limit_price_,
+            .stop_loss_price_ = order.stop_loss_price_,
+            .take_profit_price_ = order.take_profit_price_,
+        };
+        // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+    }
+
+    void EventLog::record_order(const models::Order& order, int64_t unix_ts_ns) {
+        Event& event = events_.emplace_back(Event{});
+        event.type_ = EventType::ORDER;
+        event.symbol_id_ = intern_symbol(order.symbol_);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+        event.data_.order_ = OrderEvent{
+            .unix_ts_ns_ = unix_ts_ns,
+            .quantity_ = order.quantity_,
+            .limit_price_ = order.limit_price_.has_value() ? order.limit_price_->to_abi_int64() : models::NULL_MARKET_TRIGGER_PRICE,
+            .is_buy_ = order.is_buy(),
+            .is_limit_ = order.is_limit_order(),
+            .is_exit_order_ = order.is_exit_order_,
+        };
+    }
+
+    void EventLog::record_execution_result(const models::ExecutionResult& execution_result, int64_t unix_ts_ns) {
+        Event& event = events_.emplace_back(Event{});
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+        if (const auto* success = std::get_if<models::ExecutionResultSuccess>(&execution_result)) {
+            event.type_ = EventType::FILL;
+            event.symbol_id_ = intern_symbol(success->fill_.symbol_);
+            event.data_.fill_ = FillEvent{
+                .unix_ts_ns_ = unix_ts_ns,
+                .quantity_ = success->fill_.quantity_,
+                .price_ = success->fill_.price_.to_abi_int64(),
+                .cash_delta_ = success->cash_delta_.to_abi_int64(),
+                .margin_used_ = success->margin_used_.to_abi_int64(),
+                .is_buy_ = success->fill_.is_buy(),
+            };
+            return;
+        }
+
+        event.type_ = EventType::REJECTION;
+        event.symbol_id_ = EVENT_LOG_NO_SYMBOL;
+        event.data_.rejection_ = RejectionEvent{.unix_ts_ns_ = unix_ts_ns};
+        // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+    }
+
+    void EventLog::record_exit_trigger(const models::ExitOrder& exit_order, int64_t unix_ts_ns) {
+        Event& event = events_.emplace_back(Event{});
+        event.type_ = EventType::EXIT_TRIGGER;
+
+        std::visit(
+            [&](const auto& arg) {
+                using T = std::decay_t<decltype(arg)>;
+                constexpr bool IS_TAKE_PROFIT = std::is_same_v<T, models::TakeProfitExitOrder>;
+
+                Money trigger_price;
+                if constexpr (IS_TAKE_PROFIT) {
+                    trigger_price = arg.take_profit_price_;
+                } else {
+                    trigger_price = arg.stop_loss_price_;
+                }
+
+                event.symbol_id_ = intern_symbol(arg.symbol_);
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+                event.data_.exit_trigger_ = ExitTriggerEvent{
+                    .unix_ts_ns_ = unix_ts_ns,
+                    .quantity_ = arg.trigger_quantity_,
+                    .trigger_price_ = trigger_price.to_abi_int64(),
+                    .is_take_profit_ = IS_TAKE_PROFIT,
+                };
+            },
+            exit_order);
+    }
+
+    void EventLog::to_bar(const Event& event, http::stock_api::AggregateBarResult& bar) const {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+        const BarEvent& bar_event = event.data_.bar_;
+        bar.symbol_ = get_symbol(event.symbol_id_);
+        bar.unix_ts_ns_ = bar_event.unix_ts_ns_;
+        bar.open_ = bar_event.open_;
+        bar.high_ = bar_event.high_;
+        bar.low_ = bar_event.low_;
+        bar.close_ = bar_event.close_;
+        bar.volume_ = bar_event.volume_;
+    }
+
+    CInstruction EventLog::to_c_instruction(const Event& event) const {
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+        const InstructionEvent& instruction = event.data_.instruction_;
+        const char* symbol = get_symbol(event.symbol_id_).c_str();
+        const char* action = instruction.is_buy_ ? constants::BUY : constants::SELL;
+
+        CInstruction c_instruction{};
+        c_instruction.type_ = instruction.type_;
+
+        if (instruction.type_ == INSTRUCTION_TYPE_SIGNAL) {
+            c_instruction.data_.signal_ = CSignal{.symbol_ = symbol, .action_ = action};
+            return c_instruction;
+        }
+
+        c_instruction.data_.order_ = COrder{
+            .symbol_ = symbol,
+            .action_ = action,
+            .quantity_ = instruction.quantity_,
+            .leverage_ = instruction.leverage_,
+            .limit_price_ = instruction.limit_price_,
+            .stop_loss_price_ = instruction.stop_loss_price_,
+            .take_profit_price_ = instruction.take_profit_price_,
+            .order_type_ = instruction.is_limit_ ? constants::LIMIT : constants::MARKET,
+        };
+        // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+
+        return c_instruction;
+    }
+
+    const std::vector<Event>& EventLog::get_events() const { return events_; }
+
+    const std::string& EventLog::get_symbol(uint32_t symbol_id) const {
+        if (symbol_id >= symbols_.size()) {
+            throw std::runtime_error("Event log symbol id out of range: " + std::to_string(symbol_id));
+        }
+        return symbols_[symbol_id];
+    }
+
+    void EventLog::save(const std::filesystem::path& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Failed to open event log for writing: " + path.string());
+        }
+
+        const EventLogHeader header{
+            .magic_ = EVENT_LOG_MAGIC,
+            .version_ = EVENT_LOG_VERSION,
+            .symbol_count_ = symbols_.size(),
+            .event_count_ = events_.size(),
+        };
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const auto& symbol : symbols_) {
+            const auto length = static_cast<uint32_t>(symbol.size());
+            out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            out.write(symbol.data(), static_cast<std::streamsize>(length));
+        }
+
+        out.write(reinterpret_cast<const char*>(events_.data()), static_cast<std::streamsize>(events_.size() * sizeof(Event)));
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        if (!out) {
+            throw std::runtime_error("Failed to write event log: " + path.string());
+        }
+    }
+
+    EventLog EventLog::load(const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Failed to open event log: " + path.string());
+        }
+
+        EventLogHeader header{};
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in || header.magic_ != EVENT_LOG_MAGIC) {
+            throw std::runtime_error("Not an event log: " + path.string());
+        }
+        if (header.version_ != EVENT_LOG_VERSION) {
+            throw std::runtime_error("Unsupported event log version " + std::to_string(header.version_) + ": " + path.string());
+        }
+
+        EventLog event_log;
+        event_log.symbols_.reserve(header.symbol_count_);
+
+        for (uint64_t i = 0; i < header.symbol_count_; ++i) {
+            uint32_t length = 0;
+            in.read(reinterpret_cast<char*>(&length), sizeof(length));
+            std::string symbol(length, '\0');
+            in.read(symbol.data(), static_cast<std::streamsize>(length));
+            event_log.intern_symbol(symbol);
+        }
+
+        event_log.events_.resize(header.event_count_);
+        in.read(reinterpret_cast<char*>(event_log.events_.data()), static_cast<std::streamsize>(header.event_count_ * sizeof(Event)));
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        if (!in) {
+            throw std::runtime_error("Truncated event log: " + path.string());
+        }
+
+        return event_log;
+    }
+
+    std::optional<size_t> find_first_divergence(const EventLog& expected, const EventLog& actual) {
+        const auto& expected_events = expected.get_events();
+        const auto& actual_events = actual.get_events();
+        const size_t count = std::min(expected_events.size(), actual_events.size());
+
+        for (size_t i = 0; i < count; ++i) {
+            const Event& a = expected_events[i];
+            const Event& b = actual_events[i];
+
+            if (a.type_ != b.type_ || !is_same_payload(a, b)) {
+                return i;
+            }
+
+            const bool has_symbol = a.symbol_id_ != EVENT_LOG_NO_SYMBOL;
+            if (has_symbol != (b.symbol_id_ != EVENT_LOG_NO_SYMBOL) || (has_symbol && expected.get_symbol(a.symbol_id_) != actual.get_symbol(b.symbol_id_))) {
+                return i;
+            }
+        }
+
+        if (expected_events.size() != actual_events.size()) {
+            return count;
+        }
+
+        return std::nullopt;
+    }
+
+}  // namespace simulators
@@ -0,0 +1,142 @@
+#ifndef QUANT_SIMULATORS_BACK_TEST_EVENT_LOG_HPP
+#define QUANT_SIMULATORS_BACK_TEST_EVENT_LOG_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../http/api/stock_api.hpp"
+#include "../../plugins/abi/abi.h"
+#include "./models.hpp"
+
+static constexpr uint32_t EVENT_LOG_VERSION = 1;
+static constexpr uint32_t EVENT_LOG_NO_SYMBOL = UINT32_MAX;
+
+namespace simulators {
+
+    // Bars and instructions are the inputs of a back test; orders, fills, rejections and exit triggers are its outputs,
+    // kept so a replay can be checked against the run it came from.
+    enum class EventType : uint8_t {
+        BAR,
+        INSTRUCTION,
+        ORDER,
+        FILL,
+        REJECTION,
+        EXIT_TRIGGER,
+    };
+
+    struct BarEvent {
+        int64_t unix_ts_ns_;
+        double open_;
+        double high_;
+        double low_;
+        double close_;
+        double volume_;
+    };
+
+    // A CInstruction as the plugin returned it. Prices keep the ABI's INT64_MIN for "unset".
+    struct InstructionEvent {
+        CInstructionType type_;
+        bool is_buy_;
+        bool is_limit_;
+        double quantity_;
+        double leverage_;
+        int64_t limit_price_;
+        int64_t stop_loss_price_;
+        int64_t take_profit_price_;
+    };
+
+    struct OrderEvent {
+        int64_t unix_ts_ns_;
+        double quantity_;
+        int64_t limit_price_;
+        bool is_buy_;
+        bool is_limit_;
+        bool is_exit_order_;
+    };
+
+    struct FillEvent {
+        int64_t unix_ts_ns_;
+        double quantity_;
+        int64_t price_;
+        int64_t cash_delta_;
+        int64_t margin_used_;
+        bool is_buy_;
+    };
+
+    struct RejectionEvent {
+        int64_t unix_ts_ns_;
+    };
+
+    struct ExitTriggerEvent {
+        int64_t unix_ts_ns_;
+        double quantity_;
+        int64_t trigger_price_;
+        bool is_take_profit_;
+    };
+
+    // Fixed size, so a log is written and read back as one block. Symbols are ids into the log's symbol table.
+    struct Event {
+        EventType type_;
+        uint32_t symbol_id_;
+        union {
+            BarEvent bar_;
+            InstructionEvent instruction_;
+            OrderEvent order_;
+            FillEvent fill_;
+            RejectionEvent rejection_;
+            ExitTriggerEvent exit_trigger_;
+        } data_;
+    };
+
+    // The events of one back test in the order the engine saw them. Files are in native byte order and only meant to be
+    // read by the build that wrote them.
+    class EventLog {
+       public:
+        EventLog() = default;
+
+        ~EventLog() = default;
+        EventLog(const EventLog&) = delete;
+        EventLog& operator=(const EventLog&) = delete;
+        EventLog(EventLog&&) = default;
+        EventLog& operator=(EventLog&&) = default;
+
+        void record_bar(const http::stock_api::AggregateBarResult& bar);
+        void record_instruction(const CInstruction& c_instruction);
+        void record_order(const models::Order& order, int64_t unix_ts_ns);
+        // A rejection carries no symbol; it belongs to the order recorded just before it.
+        void record_execution_result(const models::ExecutionResult& execution_result, int64_t unix_ts_ns);
+        void record_exit_trigger(const models::ExitOrder& exit_order, int64_t unix_ts_ns);
+
+        // Overwrites bar in place, so a replay reuses one bar and its symbol's storage throughout.
+        void to_bar(const Event& event, http::stock_api::AggregateBarResult& bar) const;
+        // Strings point into the symbol table and the action and order type constants, so they outlive the replay.
+        [[nodiscard]] CInstruction to_c_instruction(const Event& event) const;
+
+        [[nodiscard]] const std::vector<Event>& get_events() const;
+        [[nodiscard]] const std::string& get_symbol(uint32_t symbol_id) const;
+
+        void save(const std::filesystem::path& path) const;
+        [[nodiscard]] static EventLog load(const std::filesystem::path& path);
+
+       private:
+        std::vector<Event> events_;
+        std::vector<std::string> symbols_;
+        std::unordered_map<std::string, uint32_t> symbol_ids_;
+
+        uint32_t intern_symbol(const std::string& symbol);
+    };
+
+    // Index of the first event on which two logs disagree, or nullopt when they match. A log that is a prefix of the
+    // other disagrees at the shorter one's end.
+    [[nodiscard]] std::optional<size_t> find_first_divergence(const EventLog& expected, const EventLog& actual);
+
+}  // namespace simulators
+
+#endif
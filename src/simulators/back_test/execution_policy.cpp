@@ -0,0 +1,95 @@
+#include "./execution_policy.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "../../utils/constants.hpp"
+
+namespace simulators {
+    namespace {
+        CommissionType compile_commission_type(const plugins::manifest::HostParams& host_params) {
+            if (!host_params.commission_type_.has_value() || host_params.commission_.value_or(0.0) == 0.0) {
+                return CommissionType::NONE;
+            }
+
+            const std::string& commission_type = host_params.commission_type_.value();
+            if (commission_type == "per_share") {
+                return CommissionType::PER_SHARE;
+            }
+            if (commission_type == "percentage") {
+                return CommissionType::PERCENTAGE;
+            }
+            if (commission_type == "flat") {
+                return CommissionType::FLAT;
+            }
+
+            throw std::runtime_error("Unknown commission type: " + commission_type);
+        }
+
+        SlippageModel compile_slippage_model(const plugins::manifest::HostParams& host_params) {
+            if (!host_params.slippage_model_.has_value()) {
+                return SlippageModel::NONE;
+            }
+
+            const std::string& slippage_model = host_params.slippage_model_.value();
+            if (slippage_model == "none") {
+                return SlippageModel::NONE;
+            }
+            if (slippage_model == "time_based") {
+                return SlippageModel::TIME_BASED;
+            }
+            if (slippage_model == "time_volume_based") {
+                return SlippageModel::TIME_VOLUME_BASED;
+            }
+
+            throw std::runtime_error("Unknown slippage model: " + slippage_model);
+        }
+
+        PositionSizingMethod compile_position_sizing_method(const plugins::manifest::HostParams& host_params) {
+            const std::string sizing_method = host_params.position_sizing_method_.value_or("fixed_percentage");
+            if (sizing_method == "fixed_percentage") {
+                return PositionSizingMethod::FIXED_PERCENTAGE;
+            }
+            if (sizing_method == "fixed_dollar") {
+                return PositionSizingMethod::FIXED_DOLLAR;
+            }
+            if (sizing_method == "equal_weight") {
+                return PositionSizingMethod::EQUAL_WEIGHT;
+            }
+
+            throw std::runtime_error("Unknown position sizing method: " + sizing_method);
+        }
+    }  // namespace
+
+    ExecutionPolicy ExecutionPolicy::compile(const plugins::manifest::HostParams& host_params) {
+        const SlippageModel slippage_model = compile_slippage_model(host_params);
+        const bool allow_exit_orders = host_params.allow_exit_orders_.value_or(true);
+
+        if (!allow_exit_orders && (host_params.use_stop_loss_.value_or(false) || host_params.use_take_profit_.value_or(false))) {
+            throw std::runtime_error("use_stop_loss and use_take_profit require allow_exit_orders");
+        }
+
+        return ExecutionPolicy{
+            .market_hours_only_ = host_params.market_hours_only_ == true,
+            .allow_fractional_shares_ = host_params.allow_fractional_shares_.value_or(false),
+            .allow_short_selling_ = host_params.allow_short_selling_.value_or(true),
+            .allow_limit_orders_ = host_params.allow_limit_orders_.value_or(true),
+            .allow_exit_orders_ = allow_exit_orders,
+            .commission_type_ = compile_commission_type(host_params),
+            .commission_ = host_params.commission_.value_or(0.0),
+            .slippage_model_ = slippage_model,
+            // Time-volume slippage scales with order size, so it defaults to one second per full bar of volume.
+            .slippage_ = host_params.slippage_.value_or(slippage_model == SlippageModel::TIME_VOLUME_BASED ? 1.0 : 0.0),
+            .position_sizing_method_ = compile_position_sizing_method(host_params),
+            .position_size_value_ = host_params.position_size_value_.value_or(constants::DEFAULT_POSITION_SIZE_VALUE),
+            .max_position_size_ = host_params.max_position_size_,
+            .symbol_count_ = host_params.symbols_.size(),
+            .stop_loss_pct_ = host_params.use_stop_loss_.value_or(false) ? host_params.stop_loss_pct_ : std::nullopt,
+            .take_profit_pct_ = host_params.use_take_profit_.value_or(false) ? host_params.take_profit_pct_ : std::nullopt,
+            .fill_max_pct_of_volume_ = host_params.fill_max_pct_of_volume_,
+            .initial_margin_pct_ = host_params.initial_margin_pct_.value_or(1.0),
+            .max_leverage_ = host_params.max_leverage_.value_or(1.0),
+        };
+    }
+
+}  // namespace simulators
@@ -0,0 +1,53 @@
+#ifndef QUANT_SIMULATORS_BACK_TEST_EXECUTION_POLICY_HPP
+#define QUANT_SIMULATORS_BACK_TEST_EXECUTION_POLICY_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "../../plugins/manifest/manifest.hpp"
+
+namespace simulators {
+
+    enum class CommissionType : uint8_t { NONE, PER_SHARE, PERCENTAGE, FLAT };
+
+    enum class SlippageModel : uint8_t { NONE, TIME_BASED, TIME_VOLUME_BASED };
+
+    enum class PositionSizingMethod : uint8_t { FIXED_PERCENTAGE, FIXED_DOLLAR, EQUAL_WEIGHT };
+
+    // The host params an order touches, resolved once per run: string choices become enums and absent values take their
+    // defaults, so nothing on the per-bar path parses or copies a string.
+    struct ExecutionPolicy {
+        bool market_hours_only_ = false;
+        bool allow_fractional_shares_ = false;
+        bool allow_short_selling_ = true;
+        bool allow_limit_orders_ = true;
+        bool allow_exit_orders_ = true;
+
+        CommissionType commission_type_ = CommissionType::NONE;
+        double commission_ = 0.0;
+
+        SlippageModel slippage_model_ = SlippageModel::NONE;
+        double slippage_ = 0.0;
+
+        PositionSizingMethod position_sizing_method_ = PositionSizingMethod::FIXED_PERCENTAGE;
+        double position_size_value_ = 0.0;
+        std::optional<double> max_position_size_;
+        size_t symbol_count_ = 0;
+
+        // Only set when the matching use_* flag is on.
+        std::optional<double> stop_loss_pct_;
+        std::optional<double> take_profit_pct_;
+
+        std::optional<double> fill_max_pct_of_volume_;
+        double initial_margin_pct_ = 1.0;
+        double max_leverage_ = 1.0;
+
+        [[nodiscard]] static ExecutionPolicy compile(const plugins::manifest::HostParams& host_params);
+    };
+
+}  // namespace simulators
+
+#endif
@@ -7,11 +7,10 @@
 #include "./state.hpp"
 
 namespace simulators::executor {
-    std::pair<double, double> get_fillable_and_remaining_quantities(const models::Order& order, const plugins::manifest::HostParams& host_params,
-                                                                    const simulators::State& state) {
-        if (host_params.fill_max_pct_of_volume_.has_value()) {
+    std::pair<double, double> get_fillable_and_remaining_quantities(const models::Order& order, const ExecutionPolicy& policy, const simulators::State& state) {
+        if (policy.fill_max_pct_of_volume_.has_value()) {
             const auto bar_volume = static_cast<double>(state.get_symbol_volume(order.symbol_));
-            const double max_fill_quantity = bar_volume * host_params.fill_max_pct_of_volume_.value();
+            const double max_fill_quantity = bar_volume * policy.fill_max_pct_of_volume_.value();
 
             if (order.quantity_ > max_fill_quantity) {
                 const double remaining_quantity = order.quantity_ - max_fill_quantity;
@@ -22,78 +21,6 @@ namespace simulators::executor {
         return {order.quantity_, 0};
     }
 
-    models::ExecutionResult execute_order(const models::Order& order, const plugins::manifest::HostParams& host_params, const simulators::State& state) {
-        if (order.quantity_ <= 0) {
-            return models::ExecutionResultError("Order quantity must be positive");
-        }
-
-        if (!state.has_symbol_prices(order.symbol_)) {
-            return models::ExecutionResultError("No price data for symbol: " + order.symbol_);
-        }
-
-        if (!state.has_symbol_volume(order.symbol_)) {
-            return models::ExecutionResultError("No volume data for symbol: " + order.symbol_);
-        }
-
-        if (order.is_exit_order_ && order.source_fill_uuid_.has_value()) {
-            const auto& uuid = order.source_fill_uuid_.value();
-            const bool fill_still_active = state.active_buy_fills_.contains(uuid) || state.active_sell_fills_.contains(uuid);
-
-            if (!fill_still_active) {
-                return models::ExecutionResultError("Exit order source fill no longer active - skipping");
-            }
-        }
-
-        auto [fillable_quantity, remaining_quantity] = get_fillable_and_remaining_quantities(order, host_params, state);
-
-        if (!host_params.allow_fractional_shares_.value_or(false)) {
-            fillable_quantity = std::floor(fillable_quantity);
-            if (fillable_quantity <= 0) {
-                return models::ExecutionResultError("Order quantity is too small to execute");
-            }
-        }
-
-        const Money fill_price = calculate_fill_price(order, state);
-
-        const models::Position symbol_position = state.get_symbol_position_or(order.symbol_, models::Position(order.symbol_, 0.0, Money(0)));
-        const double current_position_quantity = state.has_symbol_position(order.symbol_) ? symbol_position.quantity_ : 0.0;
-        const double new_position_quantity = current_position_quantity + (order.is_buy() ? fillable_quantity : -fillable_quantity);
-
-        const double position_opening_quantity =
-            calculate_position_opening_quantity(order, fillable_quantity, current_position_quantity, new_position_quantity);
-
-        const Money commission =
-            exchange::calculate_commision(models::Fill(order.symbol_, order.action_, fillable_quantity, fill_price, state.current_timestamp_ns_), host_params);
-
-        const double leverage = order.leverage_.value_or(1.0);
-
-        const Money margin_required =
-            position_opening_quantity > constants::EPSILON ? calculate_margin_required(host_params, fill_price, position_opening_quantity, leverage) : Money(0);
-
-        const auto validation_error = validate_margin(order, fill_price, commission, host_params, state, position_opening_quantity, new_position_quantity,
-                                                      margin_required, fillable_quantity);
-        if (validation_error.has_value()) {
-            return models::ExecutionResultError(validation_error.value());
-        }
-
-        const Money cash_delta = calculate_cash_delta(order, fill_price, fillable_quantity, commission, position_opening_quantity, margin_required, state);
-
-        const models::Fill fill(order.symbol_, order.action_, fillable_quantity, fill_price, state.current_timestamp_ns_, leverage, margin_required);
-
-        const auto exit_orders = create_exit_orders(order, fill, state, position_opening_quantity, new_position_quantity);
-
-        const models::Position position = position_calc::calculate_position(order, fillable_quantity, fill_price, state);
-
-        if (remaining_quantity > 0) {
-            models::Order partial_order = order;
-            partial_order.quantity_ = remaining_quantity;
-            partial_order.created_at_ns_ = state.current_timestamp_ns_;
-            return models::ExecutionResultSuccess(cash_delta, margin_required, leverage, std::make_optional(partial_order), position, fill, exit_orders);
-        }
-
-        return models::ExecutionResultSuccess(cash_delta, margin_required, leverage, std::nullopt, position, fill, exit_orders);
-    }
-
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
     double calculate_position_opening_quantity(const models::Order& order, double fillable_quantity, double current_position_quantity,
                                                double new_position_quantity) {
@@ -164,17 +91,17 @@ namespace simulators::executor {
         return current_bar_close;
     }
 
-    models::Order signal_to_order(const models::Signal& signal, const plugins::manifest::HostParams& host_params, const simulators::State& state) {
-        const std::optional<Money> stop_loss_price = position_calc::calculate_signal_stop_loss_price(signal, host_params, state);
-        const std::optional<Money> take_profit_price = position_calc::calculate_signal_take_profit_price(signal, host_params, state);
-        const double quantity = position_calc::calculate_signal_position_size(signal, host_params, state);
+    models::Order signal_to_order(const models::Signal& signal, const ExecutionPolicy& policy, const simulators::State& state) {
+        const std::optional<Money> stop_loss_price = position_calc::calculate_signal_stop_loss_price(signal, policy, state);
+        const std::optional<Money> take_profit_price = position_calc::calculate_signal_take_profit_price(signal, policy, state);
+        const double quantity = position_calc::calculate_signal_position_size(signal, policy, state);
 
         return {quantity, state.current_timestamp_ns_, signal.symbol_, signal.action_, constants::MARKET, std::nullopt, stop_loss_price, take_profit_price};
     }
 
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    Money calculate_margin_required(const plugins::manifest::HostParams& host_params, Money fill_price, double position_opening_quantity, double leverage) {
-        const double initial_margin_pct = host_params.initial_margin_pct_.value_or(1.0);
+    Money calculate_margin_required(const ExecutionPolicy& policy, Money fill_price, double position_opening_quantity, double leverage) {
+        const double initial_margin_pct = policy.initial_margin_pct_;
         const double opening_value_dollars = fill_price.to_dollars() * position_opening_quantity;
         const double margin_from_leverage = opening_value_dollars / leverage;
         const double margin_from_initial = opening_value_dollars * initial_margin_pct;
@@ -183,19 +110,19 @@ namespace simulators::executor {
     }
 
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    std::optional<std::string> validate_margin(const models::Order& order, Money fill_price, Money commission, const plugins::manifest::HostParams& host_params,
+    std::optional<std::string> validate_margin(const models::Order& order, Money fill_price, Money commission, const ExecutionPolicy& policy,
                                                const simulators::State& state,
                                                // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
                                                double position_opening_quantity, double new_position_quantity, Money margin_required,
                                                double fillable_quantity) {
-        if (order.is_sell() && !host_params.allow_short_selling_.value_or(true)) {
+        if (order.is_sell() && !policy.allow_short_selling_) {
             if (new_position_quantity < 0) {
                 return "Short selling is not allowed";
             }
         }
 
         const double leverage = order.leverage_.value_or(1.0);
-        const double max_leverage = host_params.max_leverage_.value_or(1.0);
+        const double max_leverage = policy.max_leverage_;
 
         if (leverage < 1.0) {
             return "Leverage must be >= 1.0";
@@ -3,8 +3,15 @@
 
 #pragma once
 
-#include "../../plugins/manifest/manifest.hpp"
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "../../utils/constants.hpp"
+#include "./exchange.hpp"
+#include "./execution_policy.hpp"
 #include "./models.hpp"
+#include "./position_calculator.hpp"
 #include "./state.hpp"
 
 namespace simulators::executor {
@@ -14,12 +21,9 @@ namespace simulators::executor {
         Money realized_pnl_;
     };
 
-    [[nodiscard]] models::ExecutionResult execute_order(const models::Order& order, const plugins::manifest::HostParams& host_params,
-                                                        const simulators::State& state);
-    [[nodiscard]] models::Order signal_to_order(const models::Signal& signal, const plugins::manifest::HostParams& host_params, const simulators::State& state);
-    [[nodiscard]] models::ExecutionResult execute_sell(const models::Order& order, const plugins::manifest::HostParams& host_params,
-                                                       const simulators::State& state);
-    [[nodiscard]] std::pair<double, double> get_fillable_and_remaining_quantities(const models::Order& order, const plugins::manifest::HostParams& host_params,
+    [[nodiscard]] models::Order signal_to_order(const models::Signal& signal, const ExecutionPolicy& policy, const simulators::State& state);
+    [[nodiscard]] models::ExecutionResult execute_sell(const models::Order& order, const ExecutionPolicy& policy, const simulators::State& state);
+    [[nodiscard]] std::pair<double, double> get_fillable_and_remaining_quantities(const models::Order& order, const ExecutionPolicy& policy,
                                                                                   const simulators::State& state);
 
     [[nodiscard]] std::vector<models::ExitOrder> create_exit_orders(const models::Order& order, const models::Fill& fill, const simulators::State& state,
@@ -30,19 +34,104 @@ namespace simulators::executor {
     [[nodiscard]] Money calculate_fill_price(const models::Order& order, const simulators::State& state);
 
     [[nodiscard]] std::optional<std::string> validate_margin(const models::Order& order, Money fill_price, Money commission,
-                                                             const plugins::manifest::HostParams& host_params, const simulators::State& state,
+                                                             const ExecutionPolicy& policy, const simulators::State& state,
                                                              double position_opening_quantity, double new_position_quantity, Money margin_required,
                                                              double fillable_quantity);
 
     [[nodiscard]] double calculate_position_opening_quantity(const models::Order& order, double fillable_quantity, double current_position_quantity,
                                                              double new_position_quantity);
 
-    [[nodiscard]] Money calculate_margin_required(const plugins::manifest::HostParams& host_params, Money fill_price, double position_opening_quantity,
-                                                  double leverage);
+    [[nodiscard]] Money calculate_margin_required(const ExecutionPolicy& policy, Money fill_price, double position_opening_quantity, double leverage);
 
     [[nodiscard]] ClosingMarginInfo calculate_closing_margin_info(const models::Order& order, Money fill_price, double position_closing_quantity,
                                                                   const simulators::State& state);
 
+    // Orders reaching a FeaturesT variant never need its disabled features (see with_features), so their steps are left out.
+    template <typename FeaturesT>
+    [[nodiscard]] models::ExecutionResult execute_order(const models::Order& order, const ExecutionPolicy& policy, const simulators::State& state) {
+        if (order.quantity_ <= 0) {
+            return models::ExecutionResultError("Order quantity must be positive");
+        }
+
+        if (!state.has_symbol_prices(order.symbol_)) {
+            return models::ExecutionResultError("No price data for symbol: " + order.symbol_);
+        }
+
+        if (!state.has_symbol_volume(order.symbol_)) {
+            return models::ExecutionResultError("No volume data for symbol: " + order.symbol_);
+        }
+
+        if constexpr (FeaturesT::EXIT_ORDERS) {
+            if (order.is_exit_order_ && order.source_fill_uuid_.has_value()) {
+                const auto& uuid = order.source_fill_uuid_.value();
+                const bool fill_still_active = state.active_buy_fills_.contains(uuid) || state.active_sell_fills_.contains(uuid);
+
+                if (!fill_still_active) {
+                    return models::ExecutionResultError("Exit order source fill no longer active - skipping");
+                }
+            }
+        }
+
+        auto [fillable_quantity, remaining_quantity] = FeaturesT::PARTIAL_FILLS ? get_fillable_and_remaining_quantities(order, policy, state)
+                                                                                : std::pair<double, double>{order.quantity_, 0};
+
+        if (!policy.allow_fractional_shares_) {
+            fillable_quantity = std::floor(fillable_quantity);
+            if (fillable_quantity <= 0) {
+                return models::ExecutionResultError("Order quantity is too small to execute");
+            }
+        }
+
+        const Money fill_price = FeaturesT::LIMIT_ORDERS ? calculate_fill_price(order, state) : state.get_symbol_close(order.symbol_);
+
+        const models::Position symbol_position = state.get_symbol_position_or(order.symbol_, models::Position(order.symbol_, 0.0, Money(0)));
+        const double current_position_quantity = state.has_symbol_position(order.symbol_) ? symbol_position.quantity_ : 0.0;
+        const double new_position_quantity = current_position_quantity + (order.is_buy() ? fillable_quantity : -fillable_quantity);
+
+        const double position_opening_quantity =
+            calculate_position_opening_quantity(order, fillable_quantity, current_position_quantity, new_position_quantity);
+
+        const Money commission =
+            exchange::calculate_commision(models::Fill(order.symbol_, order.action_, fillable_quantity, fill_price, state.current_timestamp_ns_), policy);
+
+        const double leverage = order.leverage_.value_or(1.0);
+
+        // Without leverage every opened position is fully collateralized; an order asking for leverage fails validation anyway.
+        Money margin_required(0);
+        if (position_opening_quantity > constants::EPSILON) {
+            margin_required = FeaturesT::LEVERAGE ? calculate_margin_required(policy, fill_price, position_opening_quantity, leverage)
+                                                  : Money::from_dollars(fill_price.to_dollars() * position_opening_quantity);
+        }
+
+        const auto validation_error = validate_margin(order, fill_price, commission, policy, state, position_opening_quantity, new_position_quantity,
+                                                      margin_required, fillable_quantity);
+        if (validation_error.has_value()) {
+            return models::ExecutionResultError(validation_error.value());
+        }
+
+        const Money cash_delta = calculate_cash_delta(order, fill_price, fillable_quantity, commission, position_opening_quantity, margin_required, state);
+
+        const models::Fill fill(order.symbol_, order.action_, fillable_quantity, fill_price, state.current_timestamp_ns_, leverage, margin_required);
+
+        std::vector<models::ExitOrder> exit_orders;
+        if constexpr (FeaturesT::EXIT_ORDERS) {
+            exit_orders = create_exit_orders(order, fill, state, position_opening_quantity, new_position_quantity);
+        }
+
+        const models::Position position = position_calc::calculate_position(order, fillable_quantity, fill_price, state);
+
+        if constexpr (FeaturesT::PARTIAL_FILLS) {
+            if (remaining_quantity > 0) {
+                models::Order partial_order = order;
+                partial_order.quantity_ = remaining_quantity;
+                partial_order.created_at_ns_ = state.current_timestamp_ns_;
+                return models::ExecutionResultSuccess(cash_delta, margin_required, leverage, std::make_optional(partial_order), position, fill, exit_orders);
+            }
+        }
+
+        return models::ExecutionResultSuccess(cash_delta, margin_required, leverage, std::nullopt, position, fill, exit_orders);
+    }
+
 }  // namespace simulators::executor
 
 #endif
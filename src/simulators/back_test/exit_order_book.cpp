@@ -1,6 +1,7 @@
 #include "exit_order_book.hpp"
 
 #include <string>
+#include <vector>
 
 #include "./models.hpp"
 #include "./state.hpp"
@@ -175,4 +176,14 @@ namespace simulators {
         }
     }
 
+    std::vector<models::ExitOrder> ExitOrderBook::get_orders() const {
+        std::vector<models::ExitOrder> orders;
+        orders.reserve(stop_loss_heap_.size() + take_profit_heap_.size());
+
+        orders.insert(orders.end(), stop_loss_heap_.get_data().begin(), stop_loss_heap_.get_data().end());
+        orders.insert(orders.end(), take_profit_heap_.get_data().begin(), take_profit_heap_.get_data().end());
+
+        return orders;
+    }
+
 }  // namespace simulators
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 
 #include "../../utils/max_heap.hpp"
 #include "../../utils/min_heap.hpp"
@@ -23,6 +24,9 @@ namespace simulators {
         void process_take_profit_heap(const simulators::State& state, const std::function<void(const models::TakeProfitExitOrder&)>& callback);
         void reduce_exit_orders_by_fill_uuid(const std::string& fill_uuid, double quantity_sold);
         void reduce_exit_orders_by_fills(const std::vector<std::pair<std::string, double>>& closed_fills);
+
+        // Every pending exit order, in an order add_exit_order rebuilds the book from.
+        [[nodiscard]] std::vector<models::ExitOrder> get_orders() const;
     };
 
 }  // namespace simulators
@@ -0,0 +1,77 @@
+#ifndef QUANT_SIMULATORS_BACK_TEST_FEATURES_HPP
+#define QUANT_SIMULATORS_BACK_TEST_FEATURES_HPP
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "./execution_policy.hpp"
+
+static constexpr size_t FEATURE_COUNT = 5;
+
+namespace simulators {
+
+    // The optional order handling compiled into a back test. A disabled feature's bookkeeping is left out rather than
+    // skipped at runtime, so a variant is only ever picked for a policy that rules the feature out.
+    template <bool Leverage, bool Shorting, bool PartialFills, bool LimitOrders, bool ExitOrders>
+    struct Features {
+        static constexpr bool LEVERAGE = Leverage;
+        static constexpr bool SHORTING = Shorting;
+        static constexpr bool PARTIAL_FILLS = PartialFills;
+        static constexpr bool LIMIT_ORDERS = LimitOrders;
+        static constexpr bool EXIT_ORDERS = ExitOrders;
+    };
+
+    using AllFeatures = Features<true, true, true, true, true>;
+    // Cash-only, long-only, market orders that always fill in full.
+    using MinimalFeatures = Features<false, false, false, false, false>;
+
+    namespace detail {
+        // Which features the policy may use, in Features' parameter order.
+        inline std::array<bool, FEATURE_COUNT> get_feature_flags(const ExecutionPolicy& policy) {
+            return {
+                policy.max_leverage_ > 1.0 || policy.initial_margin_pct_ != 1.0,
+                policy.allow_short_selling_,
+                policy.fill_max_pct_of_volume_.has_value(),
+                policy.allow_limit_orders_,
+                policy.allow_exit_orders_,
+            };
+        }
+
+        template <bool... Enabled, typename Fn>
+        void dispatch_features(const std::array<bool, FEATURE_COUNT>& flags, Fn& fn) {
+            if constexpr (sizeof...(Enabled) == FEATURE_COUNT) {
+                fn.template operator()<Features<Enabled...>>();
+            } else if (flags[sizeof...(Enabled)]) {
+                dispatch_features<Enabled..., true>(flags, fn);
+            } else {
+                dispatch_features<Enabled..., false>(flags, fn);
+            }
+        }
+    }  // namespace detail
+
+    // Calls fn.template operator()<FeaturesT>() with the narrowest Features the policy allows.
+    template <typename Fn>
+    void with_features(const ExecutionPolicy& policy, Fn&& fn) {
+        detail::dispatch_features<>(detail::get_feature_flags(policy), fn);
+    }
+
+    // Whether FeaturesT keeps every feature the policy may use, so it runs the policy exactly as the narrowest variant does.
+    template <typename FeaturesT>
+    bool covers_policy(const ExecutionPolicy& policy) {
+        const std::array<bool, FEATURE_COUNT> enabled = {
+            FeaturesT::LEVERAGE, FeaturesT::SHORTING, FeaturesT::PARTIAL_FILLS, FeaturesT::LIMIT_ORDERS, FeaturesT::EXIT_ORDERS,
+        };
+        const auto flags = detail::get_feature_flags(policy);
+        for (size_t i = 0; i < FEATURE_COUNT; ++i) {
+            if (flags[i] && !enabled[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}  // namespace simulators
+
+#endif
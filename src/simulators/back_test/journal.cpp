@@ -0,0 +1,213 @@
+#include "./journal.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+static constexpr size_t JOURNAL_INITIAL_RECORDS = 4096;
+
+namespace simulators {
+    namespace {
+        struct JournalHeader {
+            std::array<char, 4> magic_;
+            uint32_t version_;
+            uint64_t record_size_;
+            uint64_t count_;
+        };
+
+        template <size_t N>
+        void copy_padded(std::array<char, N>& out, const std::string& value, const char* field) {
+            if (value.size() > N) {
+                throw std::runtime_error(std::string("Fill ") + field + " too long for the fill journal: " + value);
+            }
+            out.fill('\0');
+            std::copy(value.begin(), value.end(), out.begin());
+        }
+
+        template <size_t N>
+        std::string_view view_padded(const std::array<char, N>& value) {
+            const auto* end = std::find(value.begin(), value.end(), '\0');
+            return {value.data(), static_cast<size_t>(end - value.begin())};
+        }
+
+        JournalHeader* get_header(void* mapping) { return static_cast<JournalHeader*>(mapping); }
+
+        const JournalHeader* get_header(const void* mapping) { return static_cast<const JournalHeader*>(mapping); }
+
+        std::string describe_errno() { return std::strerror(errno); }
+    }  // namespace
+
+    FillRecord FillRecord::from_fill(const models::Fill& fill) {
+        FillRecord record{
+            .created_at_ns_ = fill.created_at_ns_,
+            .quantity_ = fill.quantity_,
+            .leverage_ = fill.leverage_,
+            .price_ = fill.price_,
+            .margin_used_ = fill.margin_used_,
+            .is_buy_ = fill.is_buy(),
+            .symbol_ = {},
+            .uuid_ = {},
+        };
+        copy_padded(record.symbol_, fill.symbol_, "symbol");
+        copy_padded(record.uuid_, fill.uuid_, "uuid");
+        return record;
+    }
+
+    std::string_view FillRecord::get_symbol() const { return view_padded(symbol_); }
+
+    std::string_view FillRecord::get_uuid() const { return view_padded(uuid_); }
+
+    // An unclosed journal keeps its slack past the last record; readers go by the count in the header.
+    JournalWriter::~JournalWriter() {
+        if (mapping_ != nullptr) {
+            munmap(mapping_, mapping_bytes_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    void JournalWriter::open(const std::filesystem::path& path, const std::array<char, 4>& magic, size_t record_size, uint64_t keep_count) {
+        close();
+
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);  // NOLINT(cppcoreguidelines-pro-type-vararg)
+        if (fd_ < 0) {
+            throw std::runtime_error("Failed to open journal " + path.string() + ": " + describe_errno());
+        }
+        path_ = path;
+        record_size_ = record_size;
+
+        if (keep_count > 0) {
+            JournalHeader existing{};
+            const bool is_readable = pread(fd_, &existing, sizeof(existing), 0) == static_cast<ssize_t>(sizeof(existing));
+            if (!is_readable || existing.magic_ != magic || existing.version_ != JOURNAL_VERSION || existing.record_size_ != record_size ||
+                existing.count_ < keep_count) {
+                ::close(fd_);
+                fd_ = -1;
+                throw std::runtime_error("Journal does not match the checkpoint: " + path.string());
+            }
+        }
+
+        map(sizeof(JournalHeader) + (std::max<uint64_t>(keep_count, JOURNAL_INITIAL_RECORDS) * record_size));
+        *get_header(mapping_) = JournalHeader{.magic_ = magic, .version_ = JOURNAL_VERSION, .record_size_ = record_size, .count_ = keep_count};
+    }
+
+    void JournalWriter::close() {
+        if (fd_ < 0) {
+            return;
+        }
+
+        const uint64_t count = get_count();
+        munmap(mapping_, mapping_bytes_);
+        mapping_ = nullptr;
+        mapping_bytes_ = 0;
+
+        const bool is_trimmed = ftruncate(fd_, static_cast<off_t>(sizeof(JournalHeader) + (count * record_size_))) == 0;
+        ::close(fd_);
+        fd_ = -1;
+
+        if (!is_trimmed) {
+            throw std::runtime_error("Failed to trim journal " + path_.string() + ": " + describe_errno());
+        }
+    }
+
+    uint64_t JournalWriter::get_count() const { return mapping_ != nullptr ? get_header(static_cast<const void*>(mapping_))->count_ : 0; }
+
+    void JournalWriter::append_bytes(const void* record, size_t size) {
+        if (mapping_ == nullptr || size != record_size_) {
+            throw std::runtime_error("Record does not fit journal " + path_.string());
+        }
+
+        const size_t offset = sizeof(JournalHeader) + (get_header(mapping_)->count_ * record_size_);
+        if (offset + size > mapping_bytes_) {
+            map(mapping_bytes_ * 2);
+        }
+
+        std::memcpy(mapping_ + offset, record, size);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        get_header(mapping_)->count_++;
+    }
+
+    void JournalWriter::map(size_t mapping_bytes) {
+        if (mapping_ != nullptr) {
+            munmap(mapping_, mapping_bytes_);
+            mapping_ = nullptr;
+        }
+
+        if (ftruncate(fd_, static_cast<off_t>(mapping_bytes)) != 0) {
+            throw std::runtime_error("Failed to grow journal " + path_.string() + ": " + describe_errno());
+        }
+
+        void* mapping = mmap(nullptr, mapping_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Failed to map journal " + path_.string() + ": " + describe_errno());
+        }
+        mapping_ = static_cast<uint8_t*>(mapping);
+        mapping_bytes_ = mapping_bytes;
+    }
+
+    JournalReader::JournalReader(const std::filesystem::path& path, const std::array<char, 4>& magic, size_t record_size) {
+        const int fd = ::open(path.c_str(), O_RDONLY);  // NOLINT(cppcoreguidelines-pro-type-vararg)
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open journal " + path.string() + ": " + describe_errno());
+        }
+
+        struct stat file_stat{};
+        if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(JournalHeader)) {
+            ::close(fd);
+            throw std::runtime_error("Not a journal: " + path.string());
+        }
+
+        mapping_bytes_ = static_cast<size_t>(file_stat.st_size);
+        mapping_ = mmap(nullptr, mapping_bytes_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            throw std::runtime_error("Failed to map journal " + path.string() + ": " + describe_errno());
+        }
+
+        const JournalHeader* header = get_header(static_cast<const void*>(mapping_));
+        if (header->magic_ != magic || header->version_ != JOURNAL_VERSION || header->record_size_ != record_size ||
+            mapping_bytes_ < sizeof(JournalHeader) + (header->count_ * record_size)) {
+            munmap(mapping_, mapping_bytes_);
+            mapping_ = nullptr;
+            throw std::runtime_error("Not a journal of this version: " + path.string());
+        }
+        count_ = header->count_;
+    }
+
+    JournalReader::~JournalReader() {
+        if (mapping_ != nullptr) {
+            munmap(mapping_, mapping_bytes_);
+        }
+    }
+
+    const void* JournalReader::get_record_data() const {
+        return static_cast<const uint8_t*>(mapping_) + sizeof(JournalHeader);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    void StreamingJournals::open(const StreamingCursor& cursor) {
+        fills_.open(options_.fill_journal_path_, FILL_JOURNAL_MAGIC, sizeof(FillRecord), cursor.fill_count_);
+        equity_curve_.open(options_.equity_journal_path_, EQUITY_JOURNAL_MAGIC, sizeof(models::EquitySnapshot), cursor.equity_count_);
+        equity_snapshots_finished_ = cursor.equity_snapshots_finished_;
+    }
+
+    void StreamingJournals::close() {
+        fills_.close();
+        equity_curve_.close();
+    }
+
+    StreamingCursor StreamingJournals::get_cursor() const {
+        return StreamingCursor{
+            .fill_count_ = fills_.get_count(),
+            .equity_count_ = equity_curve_.get_count(),
+            .equity_snapshots_finished_ = equity_snapshots_finished_,
+        };
+    }
+}  // namespace simulators
@@ -0,0 +1,142 @@
+#ifndef QUANT_SIMULATORS_BACK_TEST_JOURNAL_HPP
+#define QUANT_SIMULATORS_BACK_TEST_JOURNAL_HPP
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "../../utils/money_utils.hpp"
+#include "./models.hpp"
+
+using namespace money_utils;
+
+static constexpr uint32_t JOURNAL_VERSION = 1;
+static constexpr std::array<char, 4> FILL_JOURNAL_MAGIC = {'Q', 'F', 'F', 'J'};
+static constexpr std::array<char, 4> EQUITY_JOURNAL_MAGIC = {'Q', 'F', 'E', 'J'};
+static constexpr size_t FILL_RECORD_SYMBOL_CAPACITY = 32;
+static constexpr size_t FILL_RECORD_UUID_CAPACITY = 40;
+
+namespace simulators {
+
+    // A fill as it was made. Fixed size, so a fill journal is a flat array of records; strings are NUL padded.
+    struct FillRecord {
+        int64_t created_at_ns_;
+        double quantity_;
+        double leverage_;
+        Money price_;
+        Money margin_used_;
+        bool is_buy_;
+        std::array<char, FILL_RECORD_SYMBOL_CAPACITY> symbol_;
+        std::array<char, FILL_RECORD_UUID_CAPACITY> uuid_;
+
+        // Throws when the symbol or uuid does not fit.
+        [[nodiscard]] static FillRecord from_fill(const models::Fill& fill);
+        [[nodiscard]] std::string_view get_symbol() const;
+        [[nodiscard]] std::string_view get_uuid() const;
+    };
+
+    static_assert(std::is_trivially_copyable_v<FillRecord>);
+    static_assert(std::is_trivially_copyable_v<models::EquitySnapshot>);
+
+    // An append-only file of fixed size records, mapped into memory and grown by doubling, so an append is a copy into
+    // the page cache. The record count in the header is bumped after each record, so a killed run leaves a journal of
+    // everything appended before it. Files use the host byte order, like the event log.
+    class JournalWriter {
+       public:
+        JournalWriter() = default;
+        ~JournalWriter();
+
+        JournalWriter(const JournalWriter&) = delete;
+        JournalWriter& operator=(const JournalWriter&) = delete;
+        JournalWriter(JournalWriter&&) = delete;
+        JournalWriter& operator=(JournalWriter&&) = delete;
+
+        // Keeps the first keep_count records of an existing journal and drops the rest; 0 starts a new one.
+        void open(const std::filesystem::path& path, const std::array<char, 4>& magic, size_t record_size, uint64_t keep_count);
+        // Unmaps the journal and trims the file to its records.
+        void close();
+
+        template <typename T>
+        void append(const T& record) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            append_bytes(&record, sizeof(T));
+        }
+
+        [[nodiscard]] bool is_open() const { return fd_ >= 0; }
+        [[nodiscard]] uint64_t get_count() const;
+
+       private:
+        int fd_ = -1;
+        uint8_t* mapping_ = nullptr;
+        size_t mapping_bytes_ = 0;
+        size_t record_size_ = 0;
+        std::filesystem::path path_;
+
+        void append_bytes(const void* record, size_t size);
+        void map(size_t mapping_bytes);
+    };
+
+    // A closed journal mapped read only, so millions of records are read in place.
+    class JournalReader {
+       public:
+        JournalReader(const std::filesystem::path& path, const std::array<char, 4>& magic, size_t record_size);
+        ~JournalReader();
+
+        JournalReader(const JournalReader&) = delete;
+        JournalReader& operator=(const JournalReader&) = delete;
+        JournalReader(JournalReader&&) = delete;
+        JournalReader& operator=(JournalReader&&) = delete;
+
+        template <typename T>
+        [[nodiscard]] std::span<const T> get_records() const {
+            static_assert(std::is_trivially_copyable_v<T>);
+            return {static_cast<const T*>(get_record_data()), count_};
+        }
+
+       private:
+        void* mapping_ = nullptr;
+        size_t mapping_bytes_ = 0;
+        size_t count_ = 0;
+
+        [[nodiscard]] const void* get_record_data() const;
+    };
+
+    // A back test in streaming mode journals every fill and a sample of its equity curve, and keeps only the open fills
+    // and the last equity_window_ snapshots in memory. Plugins see that window as the equity curve.
+    struct StreamingOptions {
+        std::filesystem::path fill_journal_path_;
+        std::filesystem::path equity_journal_path_;
+        size_t equity_window_ = 0;
+        // Every equity_stride_-th snapshot is journaled, and the last one always.
+        size_t equity_stride_ = 1;
+    };
+
+    // How far a streaming back test is through its journals, saved with its checkpoints.
+    struct StreamingCursor {
+        uint64_t fill_count_ = 0;
+        uint64_t equity_count_ = 0;
+        uint64_t equity_snapshots_finished_ = 0;
+    };
+
+    struct StreamingJournals {
+        StreamingOptions options_;
+        JournalWriter fills_;
+        JournalWriter equity_curve_;
+        // Snapshots whose timestamp has passed, journaled or not; the stride counts these.
+        uint64_t equity_snapshots_finished_ = 0;
+
+        [[nodiscard]] bool is_enabled() const { return !options_.fill_journal_path_.empty(); }
+        void open(const StreamingCursor& cursor);
+        void close();
+        [[nodiscard]] StreamingCursor get_cursor() const;
+    };
+
+}  // namespace simulators
+
+#endif
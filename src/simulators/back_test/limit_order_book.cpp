@@ -2,6 +2,7 @@
 
 #include <ranges>
 #include <string>
+#include <vector>
 
 #include "./models.hpp"
 #include "./state.hpp"
@@ -86,4 +87,17 @@ namespace simulators {
                std::ranges::all_of(sell_limits_, [](const auto& pair) { return pair.second.empty(); });
     }
 
+    std::vector<models::ScheduledLimitOrder> LimitOrderBook::get_orders() const {
+        std::vector<models::ScheduledLimitOrder> orders;
+
+        for (const auto& [symbol, heap] : buy_limits_) {
+            orders.insert(orders.end(), heap.get_data().begin(), heap.get_data().end());
+        }
+        for (const auto& [symbol, heap] : sell_limits_) {
+            orders.insert(orders.end(), heap.get_data().begin(), heap.get_data().end());
+        }
+
+        return orders;
+    }
+
 }  // namespace simulators
@@ -6,6 +6,7 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "../../utils/max_heap.hpp"
 #include "../../utils/min_heap.hpp"
@@ -29,6 +30,9 @@ namespace simulators {
         void cancel_orders_for_symbol(const std::string& symbol);
 
         [[nodiscard]] bool empty() const;
+
+        // Every open limit order, in an order add_limit_order rebuilds the book from.
+        [[nodiscard]] std::vector<models::ScheduledLimitOrder> get_orders() const;
     };
 
 }  // namespace simulators
@@ -4,88 +4,76 @@
 #include "./state.hpp"
 
 namespace simulators::position_calc {
-    double calculate_signal_position_size(const models::Signal& signal, const plugins::manifest::HostParams& host_params, const simulators::State& state) {
+    double calculate_signal_position_size(const models::Signal& signal, const ExecutionPolicy& policy, const simulators::State& state) {
         const Money current_price = state.get_symbol_close(signal.symbol_);
         const Money equity = equity_calc::calculate_equity(state);
 
-        const std::string sizing_method = host_params.position_sizing_method_.value_or("fixed_percentage");
-        const double position_size_value = host_params.position_size_value_.value_or(constants::DEFAULT_POSITION_SIZE_VALUE);
-
         double quantity = 0;
 
-        if (sizing_method == "fixed_percentage") {
-            const Money dollar_amount = equity * position_size_value;
-            quantity = dollar_amount.to_dollars() / current_price.to_dollars();
-        }
-
-        if (sizing_method == "fixed_dollar") {
-            quantity = position_size_value / current_price.to_dollars();
-        }
-
-        if (sizing_method == "equal_weight") {
-            const size_t symbol_count = host_params.symbols_.size();
-            if (symbol_count == 0) {
-                return 0.0;
+        switch (policy.position_sizing_method_) {
+            case PositionSizingMethod::FIXED_PERCENTAGE: {
+                const Money dollar_amount = equity * policy.position_size_value_;
+                quantity = dollar_amount.to_dollars() / current_price.to_dollars();
+                break;
+            }
+            case PositionSizingMethod::FIXED_DOLLAR:
+                quantity = policy.position_size_value_ / current_price.to_dollars();
+                break;
+            case PositionSizingMethod::EQUAL_WEIGHT: {
+                if (policy.symbol_count_ == 0) {
+                    return 0.0;
+                }
+                const Money dollar_per_symbol = equity / static_cast<double>(policy.symbol_count_);
+                quantity = dollar_per_symbol.to_dollars() / current_price.to_dollars();
+                break;
             }
-            const Money dollar_per_symbol = equity / static_cast<double>(symbol_count);
-            quantity = dollar_per_symbol.to_dollars() / current_price.to_dollars();
         }
 
-        if (host_params.max_position_size_.has_value() && quantity > host_params.max_position_size_.value()) {
-            quantity = host_params.max_position_size_.value();
+        if (policy.max_position_size_.has_value() && quantity > policy.max_position_size_.value()) {
+            quantity = policy.max_position_size_.value();
         }
 
         return quantity;
     }
 
-    std::optional<Money> calculate_signal_stop_loss_price(const models::Signal& signal, const plugins::manifest::HostParams& host_params,
-                                                          const simulators::State& state) {
-        if (!host_params.use_stop_loss_.value_or(false)) {
+    std::optional<Money> calculate_signal_stop_loss_price(const models::Signal& signal, const ExecutionPolicy& policy, const simulators::State& state) {
+        if (!policy.stop_loss_pct_.has_value()) {
             return std::nullopt;
         }
 
         const Money current_price = state.get_symbol_close(signal.symbol_);
 
-        if (host_params.stop_loss_pct_ == std::nullopt) {
-            return std::nullopt;
-        }
-
         if (signal.is_buy()) {
-            return current_price * (1.0 - host_params.stop_loss_pct_.value());
+            return current_price * (1.0 - policy.stop_loss_pct_.value());
         }
 
         if (signal.is_sell()) {
-            return current_price * (1.0 + host_params.stop_loss_pct_.value());
+            return current_price * (1.0 + policy.stop_loss_pct_.value());
         }
 
         return std::nullopt;
     }
 
-    std::optional<Money> calculate_signal_take_profit_price(const models::Signal& signal, const plugins::manifest::HostParams& host_params,
-                                                            const simulators::State& state) {
-        if (!host_params.use_take_profit_.value_or(false)) {
+    std::optional<Money> calculate_signal_take_profit_price(const models::Signal& signal, const ExecutionPolicy& policy, const simulators::State& state) {
+        if (!policy.take_profit_pct_.has_value()) {
             return std::nullopt;
         }
 
         const Money current_price = state.get_symbol_close(signal.symbol_);
 
-        if (host_params.take_profit_pct_ == std::nullopt) {
-            return std::nullopt;
-        }
-
         if (signal.is_buy()) {
-            return current_price * (1.0 + host_params.take_profit_pct_.value());
+            return current_price * (1.0 + policy.take_profit_pct_.value());
         }
 
         if (signal.is_sell()) {
-            return current_price * (1.0 - host_params.take_profit_pct_.value());
+            return current_price * (1.0 - policy.take_profit_pct_.value());
         }
 
         return std::nullopt;
     }
 
     models::Position calculate_position(const models::Order& order, double fillable_quantity, Money fill_price, const simulators::State& state) {
-        models::Position position = [&, state]() -> models::Position {
+        models::Position position = [&]() -> models::Position {
             const auto it = state.positions_.find(order.symbol_);
             if (it != state.positions_.end()) {
                 return it->second;
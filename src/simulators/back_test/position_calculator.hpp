@@ -5,8 +5,8 @@
 
 #include <optional>
 
-#include "../../plugins/manifest/manifest.hpp"
 #include "../../utils/money_utils.hpp"
+#include "./execution_policy.hpp"
 #include "./models.hpp"
 #include "./state.hpp"
 
@@ -14,11 +14,10 @@ using namespace money_utils;
 
 namespace simulators::position_calc {
 
-    [[nodiscard]] double calculate_signal_position_size(const models::Signal& signal, const plugins::manifest::HostParams& host_params,
-                                                        const simulators::State& state);
-    [[nodiscard]] std::optional<Money> calculate_signal_stop_loss_price(const models::Signal& signal, const plugins::manifest::HostParams& host_params,
+    [[nodiscard]] double calculate_signal_position_size(const models::Signal& signal, const ExecutionPolicy& policy, const simulators::State& state);
+    [[nodiscard]] std::optional<Money> calculate_signal_stop_loss_price(const models::Signal& signal, const ExecutionPolicy& policy,
                                                                         const simulators::State& state);
-    [[nodiscard]] std::optional<Money> calculate_signal_take_profit_price(const models::Signal& signal, const plugins::manifest::HostParams& host_params,
+    [[nodiscard]] std::optional<Money> calculate_signal_take_profit_price(const models::Signal& signal, const ExecutionPolicy& policy,
                                                                           const simulators::State& state);
 
     [[nodiscard]] models::Position calculate_position(const models::Order& order, double fillable_quantity, Money fill_price, const simulators::State& state);
@@ -0,0 +1,130 @@
+#include "./report.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../../utils/constants.hpp"
+
+namespace simulators::report {
+
+    BackTestMetrics calculate_metrics(std::span<const models::EquitySnapshot> equity_curve, Money initial_capital, double max_drawdown, uint64_t fill_count) {
+        BackTestMetrics metrics{
+            .initial_capital_ = initial_capital,
+            .final_equity_ = equity_curve.empty() ? initial_capital : equity_curve.back().equity_,
+            .max_drawdown_ = max_drawdown,
+            .fill_count_ = fill_count,
+            .snapshot_count_ = equity_curve.size(),
+        };
+
+        if (initial_capital.to_dollars() > constants::EPSILON) {
+            metrics.total_return_ = (metrics.final_equity_ - initial_capital).to_dollars() / initial_capital.to_dollars();
+        }
+
+        auto returns = calculate_period_returns(equity_curve);
+        if (returns.size() < 2) {
+            return metrics;
+        }
+
+        const auto count = static_cast<double>(returns.size());
+        const double mean = std::reduce(returns.begin(), returns.end()) / count;
+        double squared_deviations = 0;
+        double squared_downside = 0;
+        for (const double period_return : returns) {
+            squared_deviations += (period_return - mean) * (period_return - mean);
+            squared_downside += std::min(period_return, 0.0) * std::min(period_return, 0.0);
+        }
+        const double deviation = std::sqrt(squared_deviations / (count - 1));
+        const double downside_deviation = std::sqrt(squared_downside / count);
+
+        const auto span_ns = static_cast<double>(equity_curve.back().timestamp_ns_ - equity_curve.front().timestamp_ns_);
+        const double periods_per_year = span_ns > 0 ? NANOSECONDS_PER_YEAR / (span_ns / count) : 0;
+        const double annualizer = std::sqrt(periods_per_year);
+
+        metrics.annualized_return_ = mean * periods_per_year;
+        metrics.annualized_volatility_ = deviation * annualizer;
+        metrics.sharpe_ratio_ = metrics.annualized_volatility_ > 0 ? metrics.annualized_return_ / metrics.annualized_volatility_ : 0;
+        metrics.sortino_ratio_ = downside_deviation > 0 ? metrics.annualized_return_ / (downside_deviation * annualizer) : 0;
+        metrics.calmar_ratio_ = max_drawdown > 0 ? metrics.annualized_return_ / max_drawdown : 0;
+
+        const double upper_tail = calculate_quantile(returns, 1.0 - REPORT_TAIL_QUANTILE);
+        const double lower_tail = calculate_quantile(returns, REPORT_TAIL_QUANTILE);
+        metrics.tail_ratio_ = lower_tail != 0 ? std::abs(upper_tail / lower_tail) : 0;
+        metrics.value_at_risk_ = -lower_tail;
+
+        double tail_sum = 0;
+        size_t tail_count = 0;
+        for (const double period_return : returns) {
+            if (period_return <= lower_tail) {
+                tail_sum += period_return;
+                tail_count++;
+            }
+        }
+        metrics.conditional_value_at_risk_ = -tail_sum / static_cast<double>(tail_count);
+
+        return metrics;
+    }
+
+    std::vector<SymbolPnl> calculate_symbol_pnls(std::span<const FillRecord> fills, const State& state) {
+        std::map<std::string, SymbolPnl, std::less<>> pnls;
+
+        for (const auto& fill : fills) {
+            auto it = pnls.find(fill.get_symbol());
+            if (it == pnls.end()) {
+                it = pnls.emplace(std::string(fill.get_symbol()), SymbolPnl{.symbol_ = std::string(fill.get_symbol())}).first;
+            }
+
+            auto& pnl = it->second;
+            pnl.fill_count_++;
+            if (fill.is_buy_) {
+                pnl.bought_quantity_ += fill.quantity_;
+                pnl.pnl_ -= fill.price_ * fill.quantity_;
+            } else {
+                pnl.sold_quantity_ += fill.quantity_;
+                pnl.pnl_ += fill.price_ * fill.quantity_;
+            }
+        }
+
+        for (const auto& [symbol, position] : state.positions_) {
+            const auto it = pnls.find(symbol);
+            if (it != pnls.end() && state.has_symbol_prices(symbol)) {
+                it->second.pnl_ += state.get_symbol_close(symbol) * position.quantity_;
+            }
+        }
+
+        std::vector<SymbolPnl> symbol_pnls;
+        symbol_pnls.reserve(pnls.size());
+        for (auto& [symbol, pnl] : pnls) {
+            symbol_pnls.push_back(std::move(pnl));
+        }
+        return symbol_pnls;
+    }
+
+    std::vector<double> calculate_period_returns(std::span<const models::EquitySnapshot> equity_curve) {
+        std::vector<double> returns;
+        returns.reserve(equity_curve.empty() ? 0 : equity_curve.size() - 1);
+
+        for (size_t i = 1; i < equity_curve.size(); ++i) {
+            const double previous = equity_curve[i - 1].equity_.to_dollars();
+            if (previous > constants::EPSILON) {
+                returns.push_back((equity_curve[i].equity_.to_dollars() / previous) - 1.0);
+            }
+        }
+        return returns;
+    }
+
+    double calculate_quantile(std::vector<double>& values, double quantile) {
+        if (values.empty()) {
+            return 0;
+        }
+
+        const auto rank = static_cast<size_t>(quantile * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), values.end());
+        return values[rank];
+    }
+
+}  // namespace simulators::report
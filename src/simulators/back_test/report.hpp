@@ -0,0 +1,84 @@
+#ifndef QUANT_SIMULATORS_BACK_TEST_REPORT_HPP
+#define QUANT_SIMULATORS_BACK_TEST_REPORT_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../../utils/money_utils.hpp"
+#include "./journal.hpp"
+#include "./models.hpp"
+#include "./state.hpp"
+
+using namespace money_utils;
+
+static constexpr double REPORT_TAIL_QUANTILE = 0.05;
+static constexpr double NANOSECONDS_PER_YEAR = 365.25 * 24 * 60 * 60 * 1e9;
+
+namespace simulators {
+
+    // Whole run figures from the equity curve. Returns, volatility and the ratios are annualized from the mean spacing
+    // of the snapshots with no risk free rate; value at risk and its conditional are per snapshot, at
+    // REPORT_TAIL_QUANTILE.
+    struct BackTestMetrics {
+        Money initial_capital_;
+        Money final_equity_;
+        double total_return_ = 0;
+        double annualized_return_ = 0;
+        double annualized_volatility_ = 0;
+        double sharpe_ratio_ = 0;
+        double sortino_ratio_ = 0;
+        double calmar_ratio_ = 0;
+        double max_drawdown_ = 0;
+        double tail_ratio_ = 0;
+        double value_at_risk_ = 0;
+        double conditional_value_at_risk_ = 0;
+        uint64_t fill_count_ = 0;
+        uint64_t snapshot_count_ = 0;
+    };
+
+    // Gross P&L at fill prices, with the open position marked to the last close.
+    struct SymbolPnl {
+        std::string symbol_;
+        uint64_t fill_count_ = 0;
+        double bought_quantity_ = 0;
+        double sold_quantity_ = 0;
+        Money pnl_;
+    };
+
+    // Orders the executor refused, by its reason.
+    struct RejectionCount {
+        std::string reason_;
+        uint64_t count_ = 0;
+    };
+
+    // In streaming mode the equity curve and fills are read back from the journals, so the curve is the sampled one.
+    struct BackTestReport {
+        std::string plugin_name_;
+        BackTestMetrics metrics_;
+        std::vector<models::EquitySnapshot> equity_curve_;
+        std::vector<FillRecord> fills_;
+        std::vector<SymbolPnl> symbol_pnls_;
+        // Sorted by reason.
+        std::vector<RejectionCount> rejections_;
+    };
+
+    namespace report {
+
+        [[nodiscard]] BackTestMetrics calculate_metrics(std::span<const models::EquitySnapshot> equity_curve, Money initial_capital, double max_drawdown,
+                                                        uint64_t fill_count);
+        // Sorted by symbol.
+        [[nodiscard]] std::vector<SymbolPnl> calculate_symbol_pnls(std::span<const FillRecord> fills, const State& state);
+        // Returns between consecutive snapshots.
+        [[nodiscard]] std::vector<double> calculate_period_returns(std::span<const models::EquitySnapshot> equity_curve);
+        // Nearest rank quantile, 0 for no values. Reorders values.
+        [[nodiscard]] double calculate_quantile(std::vector<double>& values, double quantile);
+
+    }  // namespace report
+
+}  // namespace simulators
+
+#endif
@@ -3,14 +3,13 @@
 
 #pragma once
 
-#include "../plugins/manifest/manifest.hpp"
+#include "./execution_policy.hpp"
 #include "./models.hpp"
 #include "./state.hpp"
 
 namespace simulators::slippage_calc {
 
-    [[nodiscard]] int64_t calculate_slippage_time_ns(const models::Order& order, const plugins::manifest::HostParams& host_params,
-                                                     const simulators::State& state);
+    [[nodiscard]] int64_t calculate_slippage_time_ns(const models::Order& order, const ExecutionPolicy& policy, const simulators::State& state);
 
 }  // namespace simulators::slippage_calc
 
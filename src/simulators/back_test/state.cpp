@@ -3,6 +3,7 @@
 #include "../../utils/constants.hpp"
 #include "../plugins/manifest/manifest.hpp"
 #include "./equity_calculator.hpp"
+#include "./journal.hpp"
 #include "./models.hpp"
 
 namespace simulators {
@@ -11,6 +12,7 @@ namespace simulators {
         margin_in_use_ = Money(0);
         peak_equity_ = Money(host_params.initial_capital_);
         max_drawdown_ = 0.0;
+        indicators_.configure(host_params.indicators_);
     }
 
     std::optional<std::pair<std::string, double>> State::populate_active_fills(const models::Fill& fill, double current_qty, bool comparison) {
@@ -40,6 +42,9 @@ namespace simulators {
 
         fills_.emplace_back(execution_result.fill_);
         new_fills_.emplace_back(execution_result.fill_);
+        if (streaming_ != nullptr) {
+            streaming_->fills_.append(FillRecord::from_fill(execution_result.fill_));
+        }
 
         const auto pos_it = positions_.find(execution_result.fill_.symbol_);
         const double current_qty = (pos_it != positions_.end()) ? pos_it->second.quantity_ : 0.0;
@@ -63,11 +68,17 @@ namespace simulators {
 
         if (!execution_result.exit_orders_.empty()) {
             for (const auto& exit_order : execution_result.exit_orders_) {
-                exit_orders_.emplace_back(exit_order);
+                if (streaming_ == nullptr) {
+                    exit_orders_.emplace_back(exit_order);
+                }
                 new_exit_orders_.emplace_back(exit_order);
             }
         }
 
+        if (streaming_ != nullptr) {
+            release_closed_fills();
+        }
+
         if (execution_result.position_.quantity_ == 0) {
             positions_.erase(execution_result.position_.symbol_);
         } else {
@@ -88,6 +99,9 @@ namespace simulators {
         }
 
         if (equity_curve_.empty() || equity_curve_.back().timestamp_ns_ != current_timestamp_ns_) {
+            if (streaming_ != nullptr && !equity_curve_.empty()) {
+                finish_equity_snapshot(equity_curve_.back());
+            }
             equity_curve_.emplace_back(models::EquitySnapshot{
                 .timestamp_ns_ = current_timestamp_ns_,
                 .equity_ = equity,
@@ -106,6 +120,9 @@ namespace simulators {
                 .conditional_value_at_risk_ = 0,
                 .conditional_value_at_risk_rolling_ = 0,
             });
+            if (streaming_ != nullptr) {
+                trim_equity_curve();
+            }
         } else {
             equity_curve_.back().equity_ = equity;
             equity_curve_.back().return_ = equity_calc::calculate_return(host_params, equity);
@@ -113,6 +130,41 @@ namespace simulators {
         }
     }
 
+    void State::close_journals() {
+        if (streaming_ == nullptr) {
+            return;
+        }
+
+        if (!equity_curve_.empty()) {
+            streaming_->equity_curve_.append(equity_curve_.back());
+        }
+        streaming_->close();
+    }
+
+    // Every fill was journaled when it was made; once closed, nothing looks it up again.
+    void State::release_closed_fills() {
+        std::erase_if(fills_, [this](const models::Fill& fill) { return !active_buy_fills_.contains(fill.uuid_) && !active_sell_fills_.contains(fill.uuid_); });
+    }
+
+    void State::finish_equity_snapshot(const models::EquitySnapshot& equity_snapshot) {
+        if (streaming_->equity_snapshots_finished_ % streaming_->options_.equity_stride_ == 0) {
+            streaming_->equity_curve_.append(equity_snapshot);
+        }
+        streaming_->equity_snapshots_finished_++;
+    }
+
+    // Trimmed once the curve doubles the window, so each snapshot is moved about once.
+    void State::trim_equity_curve() {
+        const size_t window = streaming_->options_.equity_window_;
+        if (equity_curve_.size() < 2 * window) {
+            return;
+        }
+
+        const size_t dropped = equity_curve_.size() - window;
+        equity_curve_.erase(equity_curve_.begin(), equity_curve_.begin() + static_cast<std::ptrdiff_t>(dropped));
+        equity_snapshots_dropped_ += dropped;
+    }
+
     void State::clear_previous_bar_state() {
         new_fills_.clear();
         new_exit_orders_.clear();
@@ -127,6 +179,7 @@ namespace simulators {
             .low_ = Money::from_dollars(bar.low_),
         };
         current_bar_volumes_[bar.symbol_] = static_cast<int64_t>(bar.volume_);
+        indicators_.update(bar);
     }
 
     void State::reduce_active_buy_fills_fifo(const std::string& symbol, double quantity) {
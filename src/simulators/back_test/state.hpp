@@ -5,10 +5,13 @@
 
 #include "../../http/api/stock_api.hpp"
 #include "../plugins/manifest/manifest.hpp"
+#include "../indicators/indicators.hpp"
 #include "./models.hpp"
 
 namespace simulators {
 
+    struct StreamingJournals;
+
     struct CurrentBarPrices {
         Money close_;
         Money open_;
@@ -35,6 +38,12 @@ namespace simulators {
         std::map<std::string, double> active_leverage_for_fills_;
         Money peak_equity_;
         double max_drawdown_;
+        indicators::IndicatorSet indicators_;
+        // Set in streaming mode: fills_ then holds only the open fills, equity_curve_ only the last snapshots and
+        // exit_orders_ nothing, with the rest in the journals. See StreamingOptions.
+        StreamingJournals* streaming_ = nullptr;
+        // Snapshots trimmed off the front of equity_curve_ so far, so a converter caching it sees the window move.
+        uint64_t equity_snapshots_dropped_ = 0;
 
         [[nodiscard]] Money get_symbol_close(const std::string& symbol) const { return current_bar_prices_.at(symbol).close_; }
 
@@ -70,8 +79,15 @@ namespace simulators {
         void reduce_active_sell_fills_fifo(const std::string& symbol, double quantity);
         [[nodiscard]] std::optional<std::pair<std::string, double>> populate_active_fills(const models::Fill& fill, double current_qty, bool comparison);
         void record_bar_equity_snapshot(const plugins::manifest::HostParams& host_params);
+        // Journals the newest equity snapshot, which no later bar finishes, and closes the journals.
+        void close_journals();
 
         [[nodiscard]] Money recalculate_margin_in_use() const;
+
+       private:
+        void release_closed_fills();
+        void finish_equity_snapshot(const models::EquitySnapshot& equity_snapshot);
+        void trim_equity_curve();
     };
 
 }  // namespace simulators
@@ -0,0 +1,427 @@
+#include "indicators.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace simulators::indicators {
+
+    void ExponentialMovingAverage::update(double value) {
+        ++count_;
+
+        if (count_ < period_) {
+            seed_sum_ += value;
+            return;
+        }
+
+        if (count_ == period_) {
+            value_ = (seed_sum_ + value) / static_cast<double>(period_);
+            return;
+        }
+
+        value_ += alpha_ * (value - value_);
+    }
+
+    void WeightedMovingAverage::update(double value) {
+        // Once full, every value loses one weight step: W' = W + n * x - S, where S is the sum before the push.
+        if (window_.is_full()) {
+            weighted_sum_ += static_cast<double>(window_.capacity()) * value - sum_;
+        } else {
+            weighted_sum_ += static_cast<double>(window_.size() + 1) * value;
+        }
+        sum_ += value - window_.push(value);
+    }
+
+    double WeightedMovingAverage::value() const {
+        const auto n = static_cast<double>(window_.size());
+        return n == 0 ? 0.0 : weighted_sum_ / (n * (n + 1.0) / 2.0);
+    }
+
+    void RollingStandardDeviation::update(double value) {
+        const double evicted = window_.push(value);
+        sum_ += value - evicted;
+        sum_of_squares_ += value * value - evicted * evicted;
+    }
+
+    double RollingStandardDeviation::value() const {
+        if (window_.size() == 0) {
+            return 0.0;
+        }
+
+        const double mean_value = mean();
+        const double variance = (sum_of_squares_ / static_cast<double>(window_.size())) - (mean_value * mean_value);
+        // Cancellation in the running sums can leave a tiny negative variance on flat series.
+        return std::sqrt(std::max(variance, 0.0));
+    }
+
+    namespace {
+        class SmaIndicator : public IIndicator {
+           public:
+            explicit SmaIndicator(size_t period) : sma_(period) {}
+            void update(const http::stock_api::AggregateBarResult& bar) override { sma_.update(bar.close_); }
+            [[nodiscard]] bool is_ready() const override { return sma_.is_ready(); }
+            [[nodiscard]] IndicatorOutputs get_outputs() const override { return {sma_.value(), 0.0, 0.0}; }
+
+           private:
+            SimpleMovingAverage sma_;
+        };
+
+        class EmaIndicator : public IIndicator {
+           public:
+            explicit EmaIndicator(size_t period) : ema_(period) {}
+            void update(const http::stock_api::AggregateBarResult& bar) override { ema_.update(bar.close_); }
+            [[nodiscard]] bool is_ready() const override { return ema_.is_ready(); }
+            [[nodiscard]] IndicatorOutputs get_outputs() const override { return {ema_.value(), 0.0, 0.0}; }
+
+           private:
+            ExponentialMovingAverage ema_;
+        };
+
+        class WmaIndicator : public IIndicator {
+           public:
+            explicit WmaIndicator(size_t period) : wma_(period) {}
+            void update(const http::stock_api::AggregateBarResult& bar) override { wma_.update(bar.close_); }
+            [[nodiscard]] bool is_ready() const override { return wma_.is_ready(); }
+            [[nodiscard]] IndicatorOutputs get_outputs() const override { return {wma_.value(), 0.0, 0.0}; }
+
+           private:
+            WeightedMovingAverage wma_;
+        };
+
+        class StdDevIndicator : public IIndicator {
+           public:
+            explicit StdDevIndicator(size_t period) : std_(period) {}
+            void update(const http::stock_api::AggregateBarResult& bar) override { std_.update(bar.close_); }
+            [[nodiscard]] bool is_ready() const override { return std_.is_ready(); }
+            [[nodiscard]] IndicatorOutputs get_outputs() const override { return {std_.value(), 0.0, 0.0}; }
+
+           private:
+            RollingStandardDeviation std_;
+        };
+
+        // Wilder's RSI: simple averages over the first `period` changes, then Wilder smoothing.
+        class RsiIndicator : public IIndicator {
+           public:
+            explicit RsiIndicator(size_t period) : period_(period) {}
+
+            void update(const http::stock_api::AggregateBarResult& bar) override {
+                if (!has_previous_) {
+                    previous_close_ = bar.close_;
+                    has_previous_ = true;
+                    return;
+                }
+
+                const double change = bar.close_ - previous_close_;
+                previous_close_ = bar.close_;
+                const double gain = std::max(change, 0.0);
+                const double loss = std::max(-change, 0.0);
+                const auto period = static_cast<double>(period_);
+
+                ++changes_;
+                if (changes_ <= period_) {
+                    average_gain_ += gain / period;
+                    average_loss_ += loss / period;
+                    return;
+                }
+
+                average_gain_ = (average_gain_ * (period - 1.0) + gain) / period;
+                average_loss_ = (average_loss_ * (period - 1.0) + loss) / period;
+            }
+
+            [[nodiscard]] bool is_ready() const override { return changes_ >= period_; }
+
+            [[nodiscard]] IndicatorOutputs get_outputs() const override {
+                if (average_loss_ == 0.0) {
+                    return {average_gain_ == 0.0 ? 50.0 : 100.0, 0.0, 0.0};
+                }
+                return {100.0 - (100.0 / (1.0 + (average_gain_ / average_loss_))), 0.0, 0.0};
+            }
+
+           private:
+            size_t period_;
+            size_t changes_ = 0;
+            bool has_previous_ = false;
+            double previous_close_ = 0.0;
+            double average_gain_ = 0.0;
+            double average_loss_ = 0.0;
+        };
+
+        // Wilder's ATR, seeded with the simple average of the first `period` true ranges.
+        class AtrIndicator : public IIndicator {
+           public:
+            explicit AtrIndicator(size_t period) : period_(period) {}
+
+            void update(const http::stock_api::AggregateBarResult& bar) override {
+                double true_range = bar.high_ - bar.low_;
+                if (has_previous_) {
+                    true_range = std::max({true_range, std::abs(bar.high_ - previous_close_), std::abs(bar.low_ - previous_close_)});
+                }
+                previous_close_ = bar.close_;
+                has_previous_ = true;
+
+                const auto period = static_cast<double>(period_);
+                ++count_;
+                if (count_ <= period_) {
+                    value_ += true_range / period;
+                    return;
+                }
+
+                value_ = (value_ * (period - 1.0) + true_range) / period;
+            }
+
+            [[nodiscard]] bool is_ready() const override { return count_ >= period_; }
+            [[nodiscard]] IndicatorOutputs get_outputs() const override { return {value_, 0.0, 0.0}; }
+
+           private:
+            size_t period_;
+            size_t count_ = 0;
+            bool has_previous_ = false;
+            double previous_close_ = 0.0;
+            double value_ = 0.0;
+        };
+
+        class MacdIndicator : public IIndicator {
+           public:
+            MacdIndicator(size_t fast_period, size_t slow_period, size_t signal_period) : fast_(fast_period), slow_(slow_period), signal_(signal_period) {}
+
+            void update(const http::stock_api::AggregateBarResult& bar) override {
+                fast_.update(bar.close_);
+                slow_.update(bar.close_);
+
+                // The signal line only averages MACD values where both EMAs are seeded.
+                if (fast_.is_ready() && slow_.is_ready()) {
+                    signal_.update(fast_.value() - slow_.value());
+                }
+            }
+
+            [[nodiscard]] bool is_ready() const override { return signal_.is_ready(); }
+
+            [[nodiscard]] IndicatorOutputs get_outputs() const override {
+                const double macd = fast_.value() - slow_.value();
+                return {macd, signal_.value(), macd - signal_.value()};
+            }
+
+           private:
+            ExponentialMovingAverage fast_;
+            ExponentialMovingAverage slow_;
+            ExponentialMovingAverage signal_;
+        };
+
+        class BollingerIndicator : public IIndicator {
+           public:
+            BollingerIndicator(size_t period, double multiplier) : std_(period), multiplier_(multiplier) {}
+            void update(const http::stock_api::AggregateBarResult& bar) override { std_.update(bar.close_); }
+            [[nodiscard]] bool is_ready() const override { return std_.is_ready(); }
+
+            [[nodiscard]] IndicatorOutputs get_outputs() const override {
+                const double middle = std_.mean();
+                const double width = multiplier_ * std_.value();
+                return {middle, middle + width, middle - width};
+            }
+
+           private:
+            RollingStandardDeviation std_;
+            double multiplier_;
+        };
+
+        class MinIndicator : public IIndicator {
+           public:
+            explicit MinIndicator(size_t period) : min_(period) {}
+            void update(const http::stock_api::AggregateBarResult& bar) override { min_.update(bar.low_); }
+            [[nodiscard]] bool is_ready() const override { return min_.is_ready(); }
+            [[nodiscard]] IndicatorOutputs get_outputs() const override { return {min_.value(), 0.0, 0.0}; }
+
+           private:
+            RollingExtreme<std::less<>> min_;
+        };
+
+        class MaxIndicator : public IIndicator {
+           public:
+            explicit MaxIndicator(size_t period) : max_(period) {}
+            void update(const http::stock_api::AggregateBarResult& bar) override { max_.update(bar.high_); }
+            [[nodiscard]] bool is_ready() const override { return max_.is_ready(); }
+            [[nodiscard]] IndicatorOutputs get_outputs() const override { return {max_.value(), 0.0, 0.0}; }
+
+           private:
+            RollingExtreme<std::greater<>> max_;
+        };
+
+        // Typical price weighted by volume, over the last `period` bars or cumulatively when period is 0.
+        class VwapIndicator : public IIndicator {
+           public:
+            explicit VwapIndicator(size_t period) {
+                if (period > 0) {
+                    price_volumes_ = std::make_unique<RollingWindow>(period);
+                    volumes_ = std::make_unique<RollingWindow>(period);
+                }
+            }
+
+            void update(const http::stock_api::AggregateBarResult& bar) override {
+                const double typical_price = (bar.high_ + bar.low_ + bar.close_) / 3.0;
+                const double price_volume = typical_price * bar.volume_;
+
+                if (price_volumes_ != nullptr) {
+                    price_volume_sum_ += price_volume - price_volumes_->push(price_volume);
+                    volume_sum_ += bar.volume_ - volumes_->push(bar.volume_);
+                } else {
+                    price_volume_sum_ += price_volume;
+                    volume_sum_ += bar.volume_;
+                }
+                last_typical_price_ = typical_price;
+                ++count_;
+            }
+
+            [[nodiscard]] bool is_ready() const override { return price_volumes_ != nullptr ? price_volumes_->is_full() : count_ > 0; }
+
+            [[nodiscard]] IndicatorOutputs get_outputs() const override {
+                return {volume_sum_ > 0.0 ? price_volume_sum_ / volume_sum_ : last_typical_price_, 0.0, 0.0};
+            }
+
+           private:
+            std::unique_ptr<RollingWindow> price_volumes_;
+            std::unique_ptr<RollingWindow> volumes_;
+            double price_volume_sum_ = 0.0;
+            double volume_sum_ = 0.0;
+            double last_typical_price_ = 0.0;
+            size_t count_ = 0;
+        };
+
+        size_t require_period(int period, const std::string& name) {
+            if (period <= 0) {
+                throw std::runtime_error("Indicator " + name + " requires a positive period");
+            }
+            return static_cast<size_t>(period);
+        }
+
+        // Only the parameters an indicator reads take part in its identity, so specs differing in ignored fields share.
+        std::string create_computation_key(const plugins::manifest::IndicatorSpec& spec) {
+            std::string key = spec.name_ + "|" + spec.symbol_ + "|";
+
+            switch (IndicatorSet::parse_type(spec.name_)) {
+                case INDICATOR_TYPE_MACD:
+                    return key + std::to_string(spec.fast_period_) + "|" + std::to_string(spec.slow_period_) + "|" + std::to_string(spec.signal_period_);
+                case INDICATOR_TYPE_BOLLINGER:
+                    return key + std::to_string(spec.period_) + "|" + std::to_string(spec.multiplier_);
+                default:
+                    return key + std::to_string(spec.period_);
+            }
+        }
+    }  // namespace
+
+    CIndicatorType IndicatorSet::parse_type(const std::string& name) {
+        if (name == "sma") {
+            return INDICATOR_TYPE_SMA;
+        }
+        if (name == "ema") {
+            return INDICATOR_TYPE_EMA;
+        }
+        if (name == "wma") {
+            return INDICATOR_TYPE_WMA;
+        }
+        if (name == "stddev") {
+            return INDICATOR_TYPE_STDDEV;
+        }
+        if (name == "rsi") {
+            return INDICATOR_TYPE_RSI;
+        }
+        if (name == "atr") {
+            return INDICATOR_TYPE_ATR;
+        }
+        if (name == "macd") {
+            return INDICATOR_TYPE_MACD;
+        }
+        if (name == "bollinger") {
+            return INDICATOR_TYPE_BOLLINGER;
+        }
+        if (name == "min") {
+            return INDICATOR_TYPE_MIN;
+        }
+        if (name == "max") {
+            return INDICATOR_TYPE_MAX;
+        }
+        if (name == "vwap") {
+            return INDICATOR_TYPE_VWAP;
+        }
+        throw std::runtime_error("Unknown indicator: " + name);
+    }
+
+    std::unique_ptr<IIndicator> IndicatorSet::create(const plugins::manifest::IndicatorSpec& spec) {
+        switch (parse_type(spec.name_)) {
+            case INDICATOR_TYPE_SMA:
+                return std::make_unique<SmaIndicator>(require_period(spec.period_, spec.name_));
+            case INDICATOR_TYPE_EMA:
+                return std::make_unique<EmaIndicator>(require_period(spec.period_, spec.name_));
+            case INDICATOR_TYPE_WMA:
+                return std::make_unique<WmaIndicator>(require_period(spec.period_, spec.name_));
+            case INDICATOR_TYPE_STDDEV:
+                return std::make_unique<StdDevIndicator>(require_period(spec.period_, spec.name_));
+            case INDICATOR_TYPE_RSI:
+                return std::make_unique<RsiIndicator>(require_period(spec.period_, spec.name_));
+            case INDICATOR_TYPE_ATR:
+                return std::make_unique<AtrIndicator>(require_period(spec.period_, spec.name_));
+            case INDICATOR_TYPE_MACD:
+                return std::make_unique<MacdIndicator>(require_period(spec.fast_period_, spec.name_), require_period(spec.slow_period_, spec.name_),
+                                                       require_period(spec.signal_period_, spec.name_));
+            case INDICATOR_TYPE_BOLLINGER:
+                return std::make_unique<BollingerIndicator>(require_period(spec.period_, spec.name_), spec.multiplier_);
+            case INDICATOR_TYPE_MIN:
+                return std::make_unique<MinIndicator>(require_period(spec.period_, spec.name_));
+            case INDICATOR_TYPE_MAX:
+                return std::make_unique<MaxIndicator>(require_period(spec.period_, spec.name_));
+            case INDICATOR_TYPE_VWAP:
+                return std::make_unique<VwapIndicator>(static_cast<size_t>(std::max(spec.period_, 0)));
+        }
+        throw std::runtime_error("Unknown indicator: " + spec.name_);
+    }
+
+    void IndicatorSet::configure(const std::vector<plugins::manifest::IndicatorSpec>& specs) {
+        symbols_.clear();
+        computations_.clear();
+        computations_by_symbol_.clear();
+        c_values_.clear();
+        c_values_.reserve(specs.size());
+
+        std::unordered_map<std::string, size_t> computation_by_key;
+
+        for (size_t handle = 0; handle < specs.size(); ++handle) {
+            const auto& spec = specs[handle];
+            const std::string key = create_computation_key(spec);
+
+            auto [it, inserted] = computation_by_key.try_emplace(key, computations_.size());
+            if (inserted) {
+                computations_.push_back(Computation{.indicator_ = create(spec), .handles_ = {}});
+                computations_by_symbol_[spec.symbol_].push_back(it->second);
+            }
+            computations_[it->second].handles_.push_back(handle);
+
+            symbols_.push_back(std::make_unique<std::string>(spec.symbol_));
+            c_values_.push_back(CIndicatorValue{.symbol_ = symbols_.back()->c_str(), .type_ = parse_type(spec.name_), .is_ready_ = false, .values_ = {}});
+        }
+    }
+
+    void IndicatorSet::update(const http::stock_api::AggregateBarResult& bar) {
+        const auto it = computations_by_symbol_.find(bar.symbol_);
+        if (it == computations_by_symbol_.end()) {
+            return;
+        }
+
+        for (const size_t index : it->second) {
+            auto& computation = computations_[index];
+            computation.indicator_->update(bar);
+
+            const bool is_ready = computation.indicator_->is_ready();
+            const IndicatorOutputs outputs = computation.indicator_->get_outputs();
+
+            for (const size_t handle : computation.handles_) {
+                auto& c_value = c_values_[handle];
+                c_value.is_ready_ = is_ready;
+                std::copy(outputs.begin(), outputs.end(), std::begin(c_value.values_));
+            }
+        }
+    }
+
+}  // namespace simulators::indicators
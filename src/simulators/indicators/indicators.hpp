@@ -0,0 +1,184 @@
+#ifndef QUANT_FORGE_SIMULATORS_INDICATORS_INDICATORS_HPP
+#define QUANT_FORGE_SIMULATORS_INDICATORS_INDICATORS_HPP
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../http/api/stock_api.hpp"
+#include "../../plugins/abi/abi.h"
+#include "../../plugins/manifest/manifest.hpp"
+
+namespace simulators::indicators {
+
+    using IndicatorOutputs = std::array<double, INDICATOR_MAX_OUTPUTS>;
+
+    // Streaming indicators: every update is O(1) (amortized for the min/max deque) and memory is bounded by the period.
+    class IIndicator {
+       public:
+        IIndicator() = default;
+        virtual ~IIndicator() = default;
+
+        IIndicator(const IIndicator&) = delete;
+        IIndicator& operator=(const IIndicator&) = delete;
+        IIndicator(IIndicator&&) = delete;
+        IIndicator& operator=(IIndicator&&) = delete;
+
+        virtual void update(const http::stock_api::AggregateBarResult& bar) = 0;
+        [[nodiscard]] virtual bool is_ready() const = 0;
+        [[nodiscard]] virtual IndicatorOutputs get_outputs() const = 0;
+    };
+
+    // Fixed capacity ring of the last `capacity` values, the only history any indicator keeps.
+    class RollingWindow {
+       public:
+        explicit RollingWindow(size_t capacity) : values_(capacity, 0.0) {}
+
+        // Returns the value that fell out of the window, or 0.0 while the window is still filling.
+        double push(double value) {
+            double evicted = 0.0;
+            if (count_ == values_.size()) {
+                evicted = values_[head_];
+            } else {
+                ++count_;
+            }
+            values_[head_] = value;
+            head_ = (head_ + 1) % values_.size();
+            return evicted;
+        }
+
+        [[nodiscard]] bool is_full() const { return count_ == values_.size(); }
+        [[nodiscard]] size_t size() const { return count_; }
+        [[nodiscard]] size_t capacity() const { return values_.size(); }
+
+       private:
+        std::vector<double> values_;
+        size_t head_ = 0;
+        size_t count_ = 0;
+    };
+
+    class SimpleMovingAverage {
+       public:
+        explicit SimpleMovingAverage(size_t period) : window_(period) {}
+        void update(double value) { sum_ += value - window_.push(value); }
+        [[nodiscard]] bool is_ready() const { return window_.is_full(); }
+        [[nodiscard]] double value() const { return window_.size() == 0 ? 0.0 : sum_ / static_cast<double>(window_.size()); }
+
+       private:
+        RollingWindow window_;
+        double sum_ = 0.0;
+    };
+
+    // Seeded with the simple average of the first `period` values.
+    class ExponentialMovingAverage {
+       public:
+        explicit ExponentialMovingAverage(size_t period) : period_(period), alpha_(2.0 / (static_cast<double>(period) + 1.0)) {}
+        void update(double value);
+        [[nodiscard]] bool is_ready() const { return count_ >= period_; }
+        [[nodiscard]] double value() const { return value_; }
+
+       private:
+        size_t period_;
+        double alpha_;
+        size_t count_ = 0;
+        double seed_sum_ = 0.0;
+        double value_ = 0.0;
+    };
+
+    class WeightedMovingAverage {
+       public:
+        explicit WeightedMovingAverage(size_t period) : window_(period) {}
+        void update(double value);
+        [[nodiscard]] bool is_ready() const { return window_.is_full(); }
+        [[nodiscard]] double value() const;
+
+       private:
+        RollingWindow window_;
+        double sum_ = 0.0;
+        double weighted_sum_ = 0.0;
+    };
+
+    // Population standard deviation over the window.
+    class RollingStandardDeviation {
+       public:
+        explicit RollingStandardDeviation(size_t period) : window_(period) {}
+        void update(double value);
+        [[nodiscard]] bool is_ready() const { return window_.is_full(); }
+        [[nodiscard]] double mean() const { return window_.size() == 0 ? 0.0 : sum_ / static_cast<double>(window_.size()); }
+        [[nodiscard]] double value() const;
+
+       private:
+        RollingWindow window_;
+        double sum_ = 0.0;
+        double sum_of_squares_ = 0.0;
+    };
+
+    // Monotonic deque: the front is always the extreme of the last `period` values.
+    template <typename Compare>
+    class RollingExtreme {
+       public:
+        explicit RollingExtreme(size_t period) : period_(period) {}
+
+        void update(double value) {
+            while (!deque_.empty() && !Compare{}(deque_.back().second, value)) {
+                deque_.pop_back();
+            }
+            deque_.emplace_back(index_, value);
+            while (deque_.front().first + period_ <= index_) {
+                deque_.pop_front();
+            }
+            ++index_;
+        }
+
+        [[nodiscard]] bool is_ready() const { return index_ >= period_; }
+        [[nodiscard]] double value() const { return deque_.empty() ? 0.0 : deque_.front().second; }
+
+       private:
+        size_t period_;
+        size_t index_ = 0;
+        std::deque<std::pair<size_t, double>> deque_;
+    };
+
+    // Owns the indicator computations of one back test. Identical specs share one computation, and each spec keeps its
+    // manifest index as the handle plugins use to read CState::indicators_.
+    class IndicatorSet {
+       public:
+        IndicatorSet() = default;
+        ~IndicatorSet() = default;
+
+        IndicatorSet(const IndicatorSet&) = delete;
+        IndicatorSet& operator=(const IndicatorSet&) = delete;
+        IndicatorSet(IndicatorSet&&) = default;
+        IndicatorSet& operator=(IndicatorSet&&) = default;
+
+        void configure(const std::vector<plugins::manifest::IndicatorSpec>& specs);
+        void update(const http::stock_api::AggregateBarResult& bar);
+        [[nodiscard]] const std::vector<CIndicatorValue>& get_c_values() const { return c_values_; }
+        [[nodiscard]] size_t get_computation_count() const { return computations_.size(); }
+
+        [[nodiscard]] static CIndicatorType parse_type(const std::string& name);
+        [[nodiscard]] static std::unique_ptr<IIndicator> create(const plugins::manifest::IndicatorSpec& spec);
+
+       private:
+        struct Computation {
+            std::unique_ptr<IIndicator> indicator_;
+            std::vector<size_t> handles_;
+        };
+
+        // Boxed so the symbol_ pointers handed out in c_values_ survive the vector growing.
+        std::vector<std::unique_ptr<std::string>> symbols_;
+        std::vector<Computation> computations_;
+        std::unordered_map<std::string, std::vector<size_t>> computations_by_symbol_;
+        std::vector<CIndicatorValue> c_values_;
+    };
+
+}  // namespace simulators::indicators
+
+#endif
@@ -1,19 +1,78 @@
 #include "monte_carlo_engine.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "../../forge/stores/data_store.hpp"
 #include "../../plugins/loaders/interface.hpp"
+#include "../../utils/constants.hpp"
+#include "../../utils/profiler.hpp"
+#include "../back_test/report.hpp"
+
+static constexpr double MEDIAN_QUANTILE = 0.5;
 
 namespace simulators {
     MonteCarloEngine::MonteCarloEngine(const plugins::loaders::IPluginLoader* plugin, const forge::DataStore* data_store)
         : plugin_(plugin), data_store_(data_store) {}
 
-    void MonteCarloEngine::run() {
-        report_ = {
-            .some_value_ = "some_value",
-            .another_value_ = "another_value",
+    void MonteCarloEngine::run(const BackTestReport& back_test_report) {
+        PROFILE_SCOPE("bootstrap_paths");
+
+        report_ = {.plugin_name_ = plugin_ != nullptr ? plugin_->get_plugin_name() : back_test_report.plugin_name_};
+
+        const auto returns = report::calculate_period_returns(back_test_report.equity_curve_);
+        if (returns.empty()) {
+            return;
+        }
+
+        // The manifest's parser leaves an absent monte_carlo_runs or monte_carlo_seed at 0, which takes the default.
+        size_t path_count = constants::DEFAULT_MONTE_CARLO_PATHS;
+        uint64_t seed = constants::MONTE_CARLO_SEED;
+        if (plugin_ != nullptr) {
+            const auto host_params = plugin_->get_host_params();
+            if (host_params.monte_carlo_runs_ > 0) {
+                path_count = static_cast<size_t>(host_params.monte_carlo_runs_);
+            }
+            if (host_params.monte_carlo_seed_ != 0) {
+                seed = static_cast<uint64_t>(host_params.monte_carlo_seed_);
+            }
+        }
+
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<size_t> pick(0, returns.size() - 1);
+
+        report_.final_returns_.reserve(path_count);
+        report_.max_drawdowns_.reserve(path_count);
+
+        for (size_t path = 0; path < path_count; ++path) {
+            double growth = 1.0;
+            double peak = 1.0;
+            double max_drawdown = 0.0;
+            for (size_t i = 0; i < returns.size(); ++i) {
+                growth *= 1.0 + returns[pick(rng)];
+                peak = std::max(peak, growth);
+                max_drawdown = std::max(max_drawdown, (peak - growth) / peak);
+            }
+            report_.final_returns_.push_back(growth - 1.0);
+            report_.max_drawdowns_.push_back(max_drawdown);
+        }
+
+        auto final_returns = report_.final_returns_;
+        auto max_drawdowns = report_.max_drawdowns_;
+        const auto losses = std::count_if(final_returns.begin(), final_returns.end(), [](double final_return) { return final_return < 0; });
+
+        report_.summary_ = MonteCarloSummary{
+            .final_return_p5_ = report::calculate_quantile(final_returns, REPORT_TAIL_QUANTILE),
+            .final_return_p50_ = report::calculate_quantile(final_returns, MEDIAN_QUANTILE),
+            .final_return_p95_ = report::calculate_quantile(final_returns, 1.0 - REPORT_TAIL_QUANTILE),
+            .max_drawdown_p50_ = report::calculate_quantile(max_drawdowns, MEDIAN_QUANTILE),
+            .max_drawdown_p95_ = report::calculate_quantile(max_drawdowns, 1.0 - REPORT_TAIL_QUANTILE),
+            .probability_of_loss_ = static_cast<double>(losses) / static_cast<double>(final_returns.size()),
         };
     }
 
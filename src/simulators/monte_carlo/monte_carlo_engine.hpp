@@ -5,20 +5,37 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../../forge/stores/data_store.hpp"
 #include "../../plugins/loaders/interface.hpp"
+#include "../back_test/report.hpp"
 
 namespace simulators {
+    // Quantiles over the paths; the tails are at REPORT_TAIL_QUANTILE.
+    struct MonteCarloSummary {
+        double final_return_p5_ = 0;
+        double final_return_p50_ = 0;
+        double final_return_p95_ = 0;
+        double max_drawdown_p50_ = 0;
+        double max_drawdown_p95_ = 0;
+        double probability_of_loss_ = 0;
+    };
+
+    // Distributions hold one value per path, in path order.
     struct MonteCarloReport {
-        std::string some_value_;
-        std::string another_value_;
+        std::string plugin_name_;
+        MonteCarloSummary summary_;
+        std::vector<double> final_returns_;
+        std::vector<double> max_drawdowns_;
     };
 
     class MonteCarloEngine {
        public:
         MonteCarloEngine(const plugins::loaders::IPluginLoader* plugin, const forge::DataStore* data_store);
-        void run();
+        // Each path draws as many period returns as the back test had, with replacement, and compounds them. Seeded,
+        // so a rerun draws the same paths.
+        void run(const BackTestReport& back_test_report);
         [[nodiscard]] const MonteCarloReport& get_report();
 
        private:
@@ -4,6 +4,8 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 namespace constants {
     inline constexpr int BASE_10 = 10;
@@ -23,6 +25,11 @@ namespace constants {
     inline constexpr std::array<int, 6> ROLLING_EQUITY_WINDOWS = {1, 7, 30, 90, 180, 365};
     inline constexpr double DEFAULT_POSITION_SIZE_VALUE = 0.01;
     inline constexpr double EPSILON = 0.0001;
+    inline constexpr size_t INSTRUCTION_BUFFER_CAPACITY = 64;
+    inline constexpr size_t DEFAULT_CHECKPOINT_INTERVAL_BARS = 100'000;
+    inline constexpr size_t DEFAULT_STREAMING_EQUITY_WINDOW = 10'000;
+    inline constexpr size_t DEFAULT_MONTE_CARLO_PATHS = 1'000;
+    inline constexpr uint64_t MONTE_CARLO_SEED = 42;
 
 }  // namespace constants
 
@@ -45,6 +45,9 @@ namespace data_structures {
 
         [[nodiscard]] size_t size() const { return data_.size(); }
 
+        // In heap order, so pushing them back in sequence rebuilds the same heap.
+        [[nodiscard]] const std::vector<T>& get_data() const { return data_; }
+
         void bubble_up(size_t idx) {
             while (idx > 0) {
                 size_t parent_idx = (idx - 1) / 2;
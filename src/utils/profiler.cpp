@@ -0,0 +1,235 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+static constexpr size_t MAX_TRACE_EVENTS_PER_THREAD = size_t{1} << 20;
+static constexpr double NANOSECONDS_PER_MICROSECOND = 1'000.0;
+static constexpr double NANOSECONDS_PER_MILLISECOND = 1'000'000.0;
+
+namespace profiler {
+    namespace {
+        struct TraceEvent {
+            const char* name_;
+            uint32_t plugin_id_;
+            uint64_t start_ticks_;
+            uint64_t end_ticks_;
+        };
+
+        struct Aggregate {
+            const char* name_;
+            uint32_t plugin_id_;
+            bool is_counter_;
+            uint64_t calls_;
+            uint64_t total_ticks_;
+        };
+
+        // Written only by its own thread. Owned by the registry so it outlives the thread for reporting.
+        struct ThreadBuffer {
+            uint32_t thread_id_ = 0;
+            uint32_t plugin_id_ = 0;
+            std::vector<TraceEvent> events_;
+            // A handful of distinct names per thread, so a linear scan beats hashing.
+            std::vector<Aggregate> aggregates_;
+        };
+
+        struct Registry {
+            std::mutex mutex_;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+            std::vector<std::string> plugin_names_ = {""};
+            uint64_t start_ticks_ = read_ticks();
+            std::chrono::steady_clock::time_point start_time_ = std::chrono::steady_clock::now();
+        };
+
+        Registry& get_registry() {
+            static Registry registry;
+            return registry;
+        }
+
+        ThreadBuffer& get_thread_buffer() {
+            thread_local ThreadBuffer* buffer = [] {
+                auto& registry = get_registry();
+                const std::scoped_lock lock(registry.mutex_);
+                auto& owned = registry.buffers_.emplace_back(std::make_unique<ThreadBuffer>());
+                owned->thread_id_ = static_cast<uint32_t>(registry.buffers_.size());
+                return owned.get();
+            }();
+            return *buffer;
+        }
+
+        Aggregate& get_aggregate(ThreadBuffer& buffer, const char* name, bool is_counter) {
+            for (auto& aggregate : buffer.aggregates_) {
+                if (aggregate.name_ == name && aggregate.plugin_id_ == buffer.plugin_id_ && aggregate.is_counter_ == is_counter) {
+                    return aggregate;
+                }
+            }
+
+            return buffer.aggregates_.emplace_back(
+                Aggregate{.name_ = name, .plugin_id_ = buffer.plugin_id_, .is_counter_ = is_counter, .calls_ = 0, .total_ticks_ = 0});
+        }
+
+        // Calibrated over the whole run rather than up front, so nothing is measured at startup.
+        double get_ns_per_tick() {
+            const auto& registry = get_registry();
+            const uint64_t elapsed_ticks = read_ticks() - registry.start_ticks_;
+            const auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - registry.start_time_).count();
+
+            if (elapsed_ticks == 0 || elapsed_ns <= 0) {
+                return 1.0;
+            }
+
+            return static_cast<double>(elapsed_ns) / static_cast<double>(elapsed_ticks);
+        }
+
+        std::string escape_json(const std::string& value) {
+            std::string escaped;
+            escaped.reserve(value.size());
+
+            for (const char c : value) {
+                if (c == '"' || c == '\\') {
+                    escaped += '\\';
+                }
+                escaped += c;
+            }
+
+            return escaped;
+        }
+    }  // namespace
+
+    void record(const char* name, uint64_t start_ticks, uint64_t end_ticks) {
+        auto& buffer = get_thread_buffer();
+
+        auto& aggregate = get_aggregate(buffer, name, false);
+        aggregate.calls_++;
+        aggregate.total_ticks_ += end_ticks - start_ticks;
+
+        if (buffer.events_.size() < MAX_TRACE_EVENTS_PER_THREAD) {
+            buffer.events_.push_back(TraceEvent{.name_ = name, .plugin_id_ = buffer.plugin_id_, .start_ticks_ = start_ticks, .end_ticks_ = end_ticks});
+        }
+    }
+
+    void count(const char* name, uint64_t delta) {
+        auto& buffer = get_thread_buffer();
+        get_aggregate(buffer, name, true).calls_ += delta;
+    }
+
+    ScopedPlugin::ScopedPlugin(const std::string& plugin_name) {
+        auto& buffer = get_thread_buffer();
+        previous_plugin_id_ = buffer.plugin_id_;
+
+        auto& registry = get_registry();
+        const std::scoped_lock lock(registry.mutex_);
+
+        const auto it = std::ranges::find(registry.plugin_names_, plugin_name);
+        if (it != registry.plugin_names_.end()) {
+            buffer.plugin_id_ = static_cast<uint32_t>(it - registry.plugin_names_.begin());
+        } else {
+            buffer.plugin_id_ = static_cast<uint32_t>(registry.plugin_names_.size());
+            registry.plugin_names_.push_back(plugin_name);
+        }
+    }
+
+    ScopedPlugin::~ScopedPlugin() { get_thread_buffer().plugin_id_ = previous_plugin_id_; }
+
+    std::vector<ProfileEntry> get_summary() {
+        auto& registry = get_registry();
+        const double ns_per_tick = get_ns_per_tick();
+        const std::scoped_lock lock(registry.mutex_);
+
+        std::map<std::tuple<uint32_t, std::string, bool>, ProfileEntry> entries;
+
+        for (const auto& buffer : registry.buffers_) {
+            for (const auto& aggregate : buffer->aggregates_) {
+                auto& entry = entries[{aggregate.plugin_id_, aggregate.name_, aggregate.is_counter_}];
+                entry.plugin_name_ = registry.plugin_names_[aggregate.plugin_id_];
+                entry.name_ = aggregate.name_;
+                entry.is_counter_ = aggregate.is_counter_;
+                entry.calls_ += aggregate.calls_;
+                entry.total_ns_ += static_cast<uint64_t>(static_cast<double>(aggregate.total_ticks_) * ns_per_tick);
+            }
+        }
+
+        std::vector<ProfileEntry> summary;
+        summary.reserve(entries.size());
+        for (auto& [key, entry] : entries) {
+            summary.push_back(std::move(entry));
+        }
+
+        std::ranges::stable_sort(summary, [](const ProfileEntry& a, const ProfileEntry& b) {
+            if (a.plugin_name_ != b.plugin_name_) {
+                return a.plugin_name_ < b.plugin_name_;
+            }
+            return a.total_ns_ > b.total_ns_;
+        });
+
+        return summary;
+    }
+
+    void write_summary(std::ostream& out) {
+        const auto summary = get_summary();
+
+        out << "\nProfile\n";
+        out << std::left << std::setw(24) << "plugin" << std::setw(32) << "scope" << std::right << std::setw(14) << "calls" << std::setw(14) << "total ms"
+            << std::setw(14) << "avg us" << "\n";
+
+        for (const auto& entry : summary) {
+            out << std::left << std::setw(24) << (entry.plugin_name_.empty() ? "(host)" : entry.plugin_name_) << std::setw(32) << entry.name_ << std::right
+                << std::setw(14) << entry.calls_;
+
+            if (entry.is_counter_) {
+                out << std::setw(14) << "-" << std::setw(14) << "-" << "\n";
+                continue;
+            }
+
+            const double total_ms = static_cast<double>(entry.total_ns_) / NANOSECONDS_PER_MILLISECOND;
+            const double avg_us =
+                entry.calls_ == 0 ? 0.0 : static_cast<double>(entry.total_ns_) / NANOSECONDS_PER_MICROSECOND / static_cast<double>(entry.calls_);
+            out << std::fixed << std::setprecision(3) << std::setw(14) << total_ms << std::setw(14) << avg_us << "\n";
+        }
+    }
+
+    void write_chrome_trace(const std::filesystem::path& path) {
+        auto& registry = get_registry();
+        const double ns_per_tick = get_ns_per_tick();
+        const std::scoped_lock lock(registry.mutex_);
+
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Failed to open trace file: " + path.string());
+        }
+
+        const auto to_us = [&](uint64_t ticks) { return static_cast<double>(ticks) * ns_per_tick / NANOSECONDS_PER_MICROSECOND; };
+
+        out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+        bool is_first = true;
+        for (const auto& buffer : registry.buffers_) {
+            for (const auto& event : buffer->events_) {
+                out << (is_first ? "\n" : ",\n");
+                is_first = false;
+
+                // Ticks taken before the registry existed would wrap, so they are clamped to the start of the trace.
+                const uint64_t start_ticks = std::max(event.start_ticks_, registry.start_ticks_);
+                out << "{\"name\":\"" << event.name_ << "\",\"cat\":\"" << escape_json(registry.plugin_names_[event.plugin_id_])
+                    << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id_ << ",\"ts\":" << to_us(start_ticks - registry.start_ticks_)
+                    << ",\"dur\":" << to_us(event.end_ticks_ - std::min(event.end_ticks_, start_ticks)) << "}";
+            }
+        }
+
+        out << "\n]}\n";
+    }
+
+}  // namespace profiler
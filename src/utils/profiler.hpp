@@ -0,0 +1,95 @@
+#ifndef QUANT_FORGE_UTILS_PROFILER_HPP
+#define QUANT_FORGE_UTILS_PROFILER_HPP
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Hot-path timers and counters, built only with -DQUANT_FORGE_PROFILE=ON. Otherwise the PROFILE_* macros expand to
+// nothing, so instrumented code pays nothing for them.
+//
+//   PROFILE_PLUGIN(name)  attributes everything measured on this thread to a plugin until the end of the scope
+//   PROFILE_SCOPE("name") times the rest of the enclosing scope; "name" must be a string literal
+//   PROFILE_COUNT("name") bumps a counter
+#ifdef QUANT_FORGE_PROFILE
+#define QUANT_FORGE_PROFILE_CONCAT_INNER(a, b) a##b
+#define QUANT_FORGE_PROFILE_CONCAT(a, b) QUANT_FORGE_PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_PLUGIN(plugin_name) const profiler::ScopedPlugin QUANT_FORGE_PROFILE_CONCAT(profile_plugin_, __LINE__)(plugin_name)
+#define PROFILE_SCOPE(name) const profiler::ScopedTimer QUANT_FORGE_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define PROFILE_COUNT(name) profiler::count(name)
+#else
+#define PROFILE_PLUGIN(plugin_name) static_cast<void>(0)
+#define PROFILE_SCOPE(name) static_cast<void>(0)
+#define PROFILE_COUNT(name) static_cast<void>(0)
+#endif
+
+namespace profiler {
+
+    struct ProfileEntry {
+        std::string plugin_name_;
+        std::string name_;
+        bool is_counter_ = false;
+        uint64_t calls_ = 0;
+        uint64_t total_ns_ = 0;
+    };
+
+    // TSC ticks where available; they are converted to nanoseconds only when a report is written.
+    [[nodiscard]] inline uint64_t read_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    void record(const char* name, uint64_t start_ticks, uint64_t end_ticks);
+    void count(const char* name, uint64_t delta = 1);
+
+    class ScopedTimer {
+       public:
+        explicit ScopedTimer(const char* name) : name_(name), start_ticks_(read_ticks()) {}
+
+        ~ScopedTimer() { record(name_, start_ticks_, read_ticks()); }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+        ScopedTimer(ScopedTimer&&) = delete;
+        ScopedTimer& operator=(ScopedTimer&&) = delete;
+
+       private:
+        const char* name_;
+        uint64_t start_ticks_;
+    };
+
+    class ScopedPlugin {
+       public:
+        explicit ScopedPlugin(const std::string& plugin_name);
+
+        ~ScopedPlugin();
+        ScopedPlugin(const ScopedPlugin&) = delete;
+        ScopedPlugin& operator=(const ScopedPlugin&) = delete;
+        ScopedPlugin(ScopedPlugin&&) = delete;
+        ScopedPlugin& operator=(ScopedPlugin&&) = delete;
+
+       private:
+        uint32_t previous_plugin_id_;
+    };
+
+    // Readers expect the measured threads to have been joined, as they are once ForgeEngine's pools go out of scope.
+    [[nodiscard]] std::vector<ProfileEntry> get_summary();
+    void write_summary(std::ostream& out);
+    // Chrome trace-event JSON, for chrome://tracing or Perfetto. Each thread keeps a bounded number of events, while
+    // the summary covers every call.
+    void write_chrome_trace(const std::filesystem::path& path);
+
+}  // namespace profiler
+
+#endif
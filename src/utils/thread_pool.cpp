@@ -68,4 +68,6 @@ namespace concurrency {
 
         completion_cv_.wait(lock, [this]() { return tasks_.empty() && active_tasks_ == 0; });
     }
+
+    size_t ThreadPool::get_thread_count() const { return threads_.size(); }
 };  // namespace concurrency
@@ -24,6 +24,7 @@ namespace concurrency {
 
         void enqueue(std::function<void()> next_task);
         void wait_all();
+        [[nodiscard]] size_t get_thread_count() const;
 
        private:
         std::vector<std::thread> threads_;  // reserve
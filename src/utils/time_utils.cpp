@@ -1,8 +1,15 @@
 #include "time_utils.hpp"
 
 #include <chrono>
+#include <cstdio>
+#include <stdexcept>
 #include <string>
 
+#include "constants.hpp"
+
+static constexpr size_t DATE_ONLY_LENGTH = 10;
+static constexpr int64_t MILLISECONDS_PER_SECOND = 1000;
+
 namespace time_utils {
     bool is_within_market_hours(const int64_t& timestamp_ns) {
         auto tp = std::chrono::system_clock::time_point(duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(timestamp_ns)));
@@ -22,4 +29,48 @@ namespace time_utils {
 
         return true;
     }
+
+    int64_t parse_datetime_ms(const std::string& datetime) {
+        if (!datetime.empty() && datetime.find('-') == std::string::npos) {
+            return std::stoll(datetime);
+        }
+
+        int year = 0;
+        unsigned month = 0;
+        unsigned day = 0;
+        int hour = 0;
+        int minute = 0;
+        int second = 0;
+
+        // NOLINTNEXTLINE(cert-err34-c)
+        const int matched = std::sscanf(datetime.c_str(), "%d-%u-%uT%d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+
+        if (matched != 3 && matched != 6) {
+            throw std::runtime_error("Invalid datetime: " + datetime);
+        }
+
+        const std::chrono::year_month_day ymd{std::chrono::year{year}, std::chrono::month{month}, std::chrono::day{day}};
+
+        if (!ymd.ok()) {
+            throw std::runtime_error("Invalid datetime: " + datetime);
+        }
+
+        const auto tp = std::chrono::sys_days{ymd} + std::chrono::hours{hour} + std::chrono::minutes{minute} + std::chrono::seconds{second};
+
+        return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+    }
+
+    int64_t parse_datetime_end_ms(const std::string& datetime) {
+        const int64_t ms = parse_datetime_ms(datetime);
+
+        if (datetime.size() == DATE_ONLY_LENGTH) {
+            return ms + (constants::ONE_DAY_S * MILLISECONDS_PER_SECOND) - 1;
+        }
+
+        return ms;
+    }
+
+    int64_t now_ms() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
 }  // namespace time_utils
@@ -9,6 +9,15 @@ namespace time_utils {
     constexpr int MARKET_CLOSE_HOUR = 16;
 
     [[nodiscard]] bool is_within_market_hours(const int64_t& timestamp_ns);
+
+    // Accepts "YYYY-MM-DD", "YYYY-MM-DDTHH:MM:SSZ" (UTC) or a raw unix millisecond timestamp.
+    [[nodiscard]] int64_t parse_datetime_ms(const std::string& datetime);
+
+    // Same as parse_datetime_ms, but a bare "YYYY-MM-DD" resolves to the last millisecond of that day, matching how
+    // providers treat an inclusive end date.
+    [[nodiscard]] int64_t parse_datetime_end_ms(const std::string& datetime);
+
+    [[nodiscard]] int64_t now_ms();
 }  // namespace time_utils
 
 #endif
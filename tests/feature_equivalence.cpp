@@ -0,0 +1,209 @@
+// Runs every strategy on the same synthetic market under a set of policies, each allowing at most one feature, once on
+// the variant run() picks for the policy and once on AllFeatures, and fails if their event logs or report metrics
+// differ. Both variants are allowed under every policy, so a divergence means the narrower one compiled out something
+// that still mattered. Registered with ctest.
+//
+//   quant_forge_feature_equivalence [--symbols N] [--bars N] [--seed N]
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../benchmarks/in_process_loader.hpp"
+#include "../benchmarks/strategies.hpp"
+#include "../benchmarks/synthetic_market.hpp"
+#include "../src/forge/stores/data_store.hpp"
+#include "../src/plugins/manifest/manifest.hpp"
+#include "../src/simulators/back_test/back_test_engine.hpp"
+#include "../src/simulators/back_test/event_log.hpp"
+#include "../src/simulators/back_test/features.hpp"
+#include "../src/simulators/back_test/report.hpp"
+#include "../src/utils/money_utils.hpp"
+
+static constexpr double INITIAL_CAPITAL = 100'000'000.0;
+
+namespace {
+    using benchmarks::strategies::StrategyKind;
+
+    // Cash-only, long-only and market orders only, before a scenario turns one feature back on.
+    plugins::manifest::HostParams make_host_params(const benchmarks::market::SyntheticMarketOptions& market) {
+        plugins::manifest::HostParams host_params{};
+        host_params.initial_capital_ = money_utils::Money::from_dollars(INITIAL_CAPITAL).to_abi_int64();
+        host_params.allow_fractional_shares_ = true;
+        host_params.allow_short_selling_ = false;
+        host_params.allow_limit_orders_ = false;
+        host_params.allow_exit_orders_ = false;
+
+        const auto symbols = benchmarks::market::make_symbols(market.symbol_count_);
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            host_params.symbols_.emplace_back(i == 0, static_cast<int>(market.timespan_s_), symbols[i], "second");
+        }
+
+        return host_params;
+    }
+
+    struct Scenario {
+        std::string_view name_;
+        std::function<void(plugins::manifest::HostParams&)> enable_;
+    };
+
+    // MinimalFeatures first, then each feature on its own, so run() lands on a different single-feature variant each time.
+    const std::array<Scenario, 6> SCENARIOS = {{
+        {.name_ = "minimal", .enable_ = [](plugins::manifest::HostParams&) {}},
+        {.name_ = "leverage",
+         .enable_ =
+             [](plugins::manifest::HostParams& host_params) {
+                 host_params.max_leverage_ = 2.0;
+                 host_params.initial_margin_pct_ = 0.5;
+             }},
+        {.name_ = "shorting", .enable_ = [](plugins::manifest::HostParams& host_params) { host_params.allow_short_selling_ = true; }},
+        {.name_ = "partial_fills", .enable_ = [](plugins::manifest::HostParams& host_params) { host_params.fill_max_pct_of_volume_ = 0.01; }},
+        {.name_ = "limit_orders", .enable_ = [](plugins::manifest::HostParams& host_params) { host_params.allow_limit_orders_ = true; }},
+        {.name_ = "exit_orders", .enable_ = [](plugins::manifest::HostParams& host_params) { host_params.allow_exit_orders_ = true; }},
+    }};
+
+    struct Recording {
+        simulators::EventLog event_log_;
+        simulators::BackTestReport report_;
+    };
+
+    // Runs AllFeatures when is_all_features is set, and otherwise whichever variant run() picks for the host params.
+    Recording record(StrategyKind kind, uint64_t seed, const plugins::manifest::HostParams& host_params, const forge::DataStore& data_store,
+                     bool is_all_features) {
+        const auto create = [kind, seed](const SimulatorContext&) { return benchmarks::strategies::create_strategy(kind, seed); };
+        benchmarks::InProcessLoader loader(std::string(benchmarks::strategies::to_string(kind)), host_params, create);
+        loader.load_plugin(SimulatorContext{.api_version_ = PLUGIN_API_VERSION});
+        loader.on_init();
+
+        Recording recording;
+        simulators::BackTestEngine engine(&loader, &data_store);
+        engine.set_event_log(&recording.event_log_);
+        if (is_all_features) {
+            engine.run_with_features<simulators::AllFeatures>();
+        } else {
+            engine.run();
+        }
+        recording.report_ = engine.get_report();
+        return recording;
+    }
+
+    // The first metric that differs, compared exactly: both variants should do the same arithmetic in the same order.
+    std::optional<std::string_view> find_metric_divergence(const simulators::BackTestReport& expected, const simulators::BackTestReport& actual) {
+        const auto& lhs = expected.metrics_;
+        const auto& rhs = actual.metrics_;
+        if (!(lhs.final_equity_ == rhs.final_equity_)) {
+            return "final_equity";
+        }
+        if (lhs.fill_count_ != rhs.fill_count_) {
+            return "fill_count";
+        }
+        if (lhs.snapshot_count_ != rhs.snapshot_count_) {
+            return "snapshot_count";
+        }
+
+        const std::array<std::pair<std::string_view, std::pair<double, double>>, 10> ratios = {{
+            {"total_return", {lhs.total_return_, rhs.total_return_}},
+            {"annualized_return", {lhs.annualized_return_, rhs.annualized_return_}},
+            {"annualized_volatility", {lhs.annualized_volatility_, rhs.annualized_volatility_}},
+            {"sharpe_ratio", {lhs.sharpe_ratio_, rhs.sharpe_ratio_}},
+            {"sortino_ratio", {lhs.sortino_ratio_, rhs.sortino_ratio_}},
+            {"calmar_ratio", {lhs.calmar_ratio_, rhs.calmar_ratio_}},
+            {"max_drawdown", {lhs.max_drawdown_, rhs.max_drawdown_}},
+            {"tail_ratio", {lhs.tail_ratio_, rhs.tail_ratio_}},
+            {"value_at_risk", {lhs.value_at_risk_, rhs.value_at_risk_}},
+            {"conditional_value_at_risk", {lhs.conditional_value_at_risk_, rhs.conditional_value_at_risk_}},
+        }};
+        for (const auto& [name, values] : ratios) {
+            // Bitwise, so a NaN on both sides still counts as equal.
+            if (std::bit_cast<uint64_t>(values.first) != std::bit_cast<uint64_t>(values.second)) {
+                return name;
+            }
+        }
+
+        if (expected.rejections_.size() != actual.rejections_.size()) {
+            return "rejections";
+        }
+        for (size_t i = 0; i < expected.rejections_.size(); ++i) {
+            if (expected.rejections_[i].reason_ != actual.rejections_[i].reason_ || expected.rejections_[i].count_ != actual.rejections_[i].count_) {
+                return "rejections";
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    benchmarks::market::SyntheticMarketOptions parse_args(int argc, char** argv) {
+        benchmarks::market::SyntheticMarketOptions market;
+        const std::vector<std::string_view> args(argv + 1, argv + argc);
+
+        for (size_t i = 0; i < args.size(); ++i) {
+            const std::string_view arg = args[i];
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("Missing value for " + std::string(arg));
+            }
+            const std::string value(args[++i]);
+
+            if (arg == "--symbols") {
+                market.symbol_count_ = std::stoul(value);
+            } else if (arg == "--bars") {
+                market.bars_per_symbol_ = std::stoul(value);
+            } else if (arg == "--seed") {
+                market.seed_ = std::stoull(value);
+            } else {
+                throw std::runtime_error("Unknown argument: " + std::string(arg));
+            }
+        }
+
+        return market;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const auto market = parse_args(argc, argv);
+
+        bool is_all_equivalent = true;
+        for (const auto kind : benchmarks::strategies::ALL_STRATEGIES) {
+            const std::string plugin_name(benchmarks::strategies::to_string(kind));
+
+            forge::DataStore data_store;
+            benchmarks::market::load_into(data_store, plugin_name, market);
+
+            for (const auto& scenario : SCENARIOS) {
+                auto host_params = make_host_params(market);
+                scenario.enable_(host_params);
+
+                const auto expected = record(kind, market.seed_, host_params, data_store, true);
+                const auto actual = record(kind, market.seed_, host_params, data_store, false);
+
+                std::cout << plugin_name << " [" << scenario.name_ << "]: " << expected.event_log_.get_events().size() << " events, ";
+                const auto event_divergence = simulators::find_first_divergence(expected.event_log_, actual.event_log_);
+                const auto metric_divergence = find_metric_divergence(expected.report_, actual.report_);
+                if (event_divergence.has_value()) {
+                    std::cout << "diverges from AllFeatures at event " << event_divergence.value() << "\n";
+                    is_all_equivalent = false;
+                } else if (metric_divergence.has_value()) {
+                    std::cout << "report differs from AllFeatures in " << metric_divergence.value() << "\n";
+                    is_all_equivalent = false;
+                } else {
+                    std::cout << "identical\n";
+                }
+            }
+        }
+
+        return is_all_equivalent ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,253 @@
+// Runs a plugin that reads SMA, EMA and RSI through CState::indicators_ on every bar and checks each against the same
+// indicator recomputed from scratch over the closes it has seen so far. Registered with ctest.
+//
+//   quant_forge_indicators [--bars N] [--seed N]
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../benchmarks/in_process_loader.hpp"
+#include "../benchmarks/synthetic_market.hpp"
+#include "../src/forge/stores/data_store.hpp"
+#include "../src/plugins/abi/abi.h"
+#include "../src/plugins/manifest/manifest.hpp"
+#include "../src/simulators/back_test/back_test_engine.hpp"
+#include "../src/utils/money_utils.hpp"
+
+static constexpr double INITIAL_CAPITAL = 100'000.0;
+static constexpr int SMA_PERIOD = 20;
+static constexpr int EMA_PERIOD = 12;
+static constexpr int RSI_PERIOD = 14;
+// The host keeps running sums where the reference sums afresh, so the two only agree up to rounding.
+static constexpr double RELATIVE_TOLERANCE = 1e-9;
+
+namespace {
+    // Handles are manifest indices; the last spec repeats the first, so the two share one computation.
+    enum IndicatorHandle : uint8_t { SMA_HANDLE, EMA_HANDLE, RSI_HANDLE, REPEATED_SMA_HANDLE, HANDLE_COUNT };
+
+    struct CheckResults {
+        size_t bar_count_ = 0;
+        size_t checked_count_ = 0;
+        std::vector<std::string> failures_;
+    };
+
+    struct IndicatorReader {
+        CheckResults* results_;
+        std::vector<double> closes_;
+    };
+
+    constexpr PluginResult OK_RESULT = {.code_ = 0, .message_ = nullptr, .instructions_ = nullptr, .instructions_count_ = 0};
+
+    double reference_sma(const std::vector<double>& closes, size_t period) {
+        double sum = 0.0;
+        for (size_t i = closes.size() - period; i < closes.size(); ++i) {
+            sum += closes[i];
+        }
+        return sum / static_cast<double>(period);
+    }
+
+    // Seeded with the simple average of the first `period` closes.
+    double reference_ema(const std::vector<double>& closes, size_t period) {
+        double ema = 0.0;
+        for (size_t i = 0; i < period; ++i) {
+            ema += closes[i];
+        }
+        ema /= static_cast<double>(period);
+
+        const double alpha = 2.0 / (static_cast<double>(period) + 1.0);
+        for (size_t i = period; i < closes.size(); ++i) {
+            ema += alpha * (closes[i] - ema);
+        }
+        return ema;
+    }
+
+    // Wilder's RSI: simple averages over the first `period` changes, then Wilder smoothing.
+    double reference_rsi(const std::vector<double>& closes, size_t period) {
+        const auto n = static_cast<double>(period);
+        double average_gain = 0.0;
+        double average_loss = 0.0;
+        for (size_t i = 1; i < closes.size(); ++i) {
+            const double change = closes[i] - closes[i - 1];
+            const double gain = std::max(change, 0.0);
+            const double loss = std::max(-change, 0.0);
+            if (i <= period) {
+                average_gain += gain / n;
+                average_loss += loss / n;
+            } else {
+                average_gain = (average_gain * (n - 1.0) + gain) / n;
+                average_loss = (average_loss * (n - 1.0) + loss) / n;
+            }
+        }
+
+        if (average_loss == 0.0) {
+            return average_gain == 0.0 ? 50.0 : 100.0;
+        }
+        return 100.0 - (100.0 / (1.0 + (average_gain / average_loss)));
+    }
+
+    void check(IndicatorReader& reader, const CState& state, IndicatorHandle handle, std::string_view name, bool is_ready, double expected) {
+        auto& results = *reader.results_;
+        const CIndicatorValue& indicator = state.indicators_[handle];
+        const std::string where = std::string(name) + " at bar " + std::to_string(reader.closes_.size());
+
+        if (indicator.is_ready_ != is_ready) {
+            results.failures_.push_back(where + ": is_ready_ is " + (indicator.is_ready_ ? "true" : "false"));
+            return;
+        }
+        if (!is_ready) {
+            return;
+        }
+
+        const double actual = indicator.values_[0];
+        if (std::abs(actual - expected) > RELATIVE_TOLERANCE * std::max(1.0, std::abs(expected))) {
+            results.failures_.push_back(where + ": " + std::to_string(actual) + ", expected " + std::to_string(expected));
+        }
+        ++results.checked_count_;
+    }
+
+    void destroy(void* self) { delete static_cast<IndicatorReader*>(self); }
+
+    PluginResult on_start(void* /*self*/) { return OK_RESULT; }
+
+    PluginResult on_bar_into(void* self, const Bar* bar, const CState* state, CInstructionBuffer* /*out*/) {
+        auto& reader = *static_cast<IndicatorReader*>(self);
+        auto& results = *reader.results_;
+        ++results.bar_count_;
+
+        if (state->indicators_count_ != HANDLE_COUNT) {
+            results.failures_.push_back("indicators_count_ is " + std::to_string(state->indicators_count_));
+            return OK_RESULT;
+        }
+
+        // The host updates its indicators with the bar before handing it over, so the reference includes it as well.
+        reader.closes_.push_back(bar->close_);
+        const auto& closes = reader.closes_;
+        const auto count = closes.size();
+
+        const bool is_sma_ready = count >= SMA_PERIOD;
+        const double sma = is_sma_ready ? reference_sma(closes, SMA_PERIOD) : 0.0;
+        check(reader, *state, SMA_HANDLE, "sma", is_sma_ready, sma);
+        check(reader, *state, REPEATED_SMA_HANDLE, "repeated sma", is_sma_ready, sma);
+
+        const bool is_ema_ready = count >= EMA_PERIOD;
+        check(reader, *state, EMA_HANDLE, "ema", is_ema_ready, is_ema_ready ? reference_ema(closes, EMA_PERIOD) : 0.0);
+
+        const bool is_rsi_ready = count > RSI_PERIOD;
+        check(reader, *state, RSI_HANDLE, "rsi", is_rsi_ready, is_rsi_ready ? reference_rsi(closes, RSI_PERIOD) : 0.0);
+
+        return OK_RESULT;
+    }
+
+    PluginResult on_end(void* /*self*/, const char** json_out) {
+        *json_out = nullptr;
+        return OK_RESULT;
+    }
+
+    PluginExport create_indicator_reader(CheckResults* results) {
+        return PluginExport{
+            .api_version_ = PLUGIN_API_VERSION_V1_SIZED,
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+            .instance_ = new IndicatorReader{.results_ = results, .closes_ = {}},
+            .vtable_ =
+                PluginVTable{
+                    .destroy = destroy,
+                    .on_init = nullptr,
+                    .on_start = on_start,
+                    .on_bar = nullptr,
+                    .on_end = on_end,
+                    .free_string = nullptr,
+                    .vtable_size_ = sizeof(PluginVTable),
+                    .precompute_signals = nullptr,
+                    .on_bar_into = on_bar_into,
+                    .save_state = nullptr,
+                    .restore_state = nullptr,
+                },
+        };
+    }
+
+    plugins::manifest::HostParams make_host_params(const benchmarks::market::SyntheticMarketOptions& market) {
+        plugins::manifest::HostParams host_params{};
+        host_params.initial_capital_ = money_utils::Money::from_dollars(INITIAL_CAPITAL).to_abi_int64();
+        host_params.allow_fractional_shares_ = true;
+
+        const std::string symbol = benchmarks::market::make_symbols(market.symbol_count_).front();
+        host_params.symbols_.emplace_back(true, static_cast<int>(market.timespan_s_), symbol, "second");
+
+        const auto make_spec = [&symbol](std::string name, int period) {
+            plugins::manifest::IndicatorSpec spec;
+            spec.name_ = std::move(name);
+            spec.symbol_ = symbol;
+            spec.period_ = period;
+            return spec;
+        };
+        host_params.indicators_ = {make_spec("sma", SMA_PERIOD), make_spec("ema", EMA_PERIOD), make_spec("rsi", RSI_PERIOD), make_spec("sma", SMA_PERIOD)};
+
+        return host_params;
+    }
+
+    benchmarks::market::SyntheticMarketOptions parse_args(int argc, char** argv) {
+        benchmarks::market::SyntheticMarketOptions market;
+        market.symbol_count_ = 1;
+        market.bars_per_symbol_ = 500;
+        const std::vector<std::string_view> args(argv + 1, argv + argc);
+
+        for (size_t i = 0; i < args.size(); ++i) {
+            const std::string_view arg = args[i];
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("Missing value for " + std::string(arg));
+            }
+            const std::string value(args[++i]);
+
+            if (arg == "--bars") {
+                market.bars_per_symbol_ = std::stoul(value);
+            } else if (arg == "--seed") {
+                market.seed_ = std::stoull(value);
+            } else {
+                throw std::runtime_error("Unknown argument: " + std::string(arg));
+            }
+        }
+
+        return market;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const auto market = parse_args(argc, argv);
+        const std::string plugin_name = "indicator_reader";
+
+        forge::DataStore data_store;
+        benchmarks::market::load_into(data_store, plugin_name, market);
+
+        CheckResults results;
+        benchmarks::InProcessLoader loader(plugin_name, make_host_params(market), [&results](const SimulatorContext&) { return create_indicator_reader(&results); });
+        loader.load_plugin(SimulatorContext{.api_version_ = PLUGIN_API_VERSION});
+        loader.on_init();
+
+        simulators::BackTestEngine engine(&loader, &data_store);
+        engine.run();
+
+        std::cout << results.bar_count_ << " bars, " << results.checked_count_ << " indicator values checked\n";
+        for (const auto& failure : results.failures_) {
+            std::cout << failure << "\n";
+        }
+
+        if (results.bar_count_ != market.bars_per_symbol_ || results.checked_count_ == 0) {
+            std::cout << "The plugin did not see every bar\n";
+            return 1;
+        }
+        return results.failures_.empty() ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal Error: " << e.what() << std::endl;
+        return 1;
+    }
+}